@@ -533,6 +533,49 @@ public:
   Graft(const DataObject *)
   {}
 
+  /** Returns a hash of the content of the data object, or an empty string
+   * when the content cannot be hashed. Two data objects of the same type
+   * with the same hash have the same content. The hash is computed by
+   * ComputeContentHash() and kept until the data object is modified or
+   * generated again. It is used by the PipelineResultCache to identify the
+   * inputs of the process objects. */
+  std::string
+  GetContentHash() const;
+
+  /** Sets the hash of the content of the data object, returned by
+   * GetContentHash() until the data object is modified or generated again.
+   * The process objects using the PipelineResultCache set the hash of their
+   * outputs from the hash of their inputs and parameters, so the outputs do
+   * not have to be hashed. */
+  void
+  SetContentHash(const std::string & hash);
+
+  /** Returns a new data object of the same type, holding a copy of the
+   * content of this one, including its bulk data, or nullptr when the data
+   * object cannot be copied. The default implementation returns nullptr. */
+  virtual Pointer
+  CreateDeepCopy() const
+  {
+    return nullptr;
+  }
+
+  /** Returns the number of bytes of the bulk data held by the data object
+   * (e.g. the pixels of an image). The default implementation returns 0. */
+  virtual SizeValueType
+  GetBulkDataNumberOfBytes() const
+  {
+    return 0;
+  }
+
+  /** Returns the number of bytes of bulk data needed to hold the requested
+   * region of the data object. Used to predict the memory needed to update
+   * a pipeline, before executing it. The default implementation returns 0. */
+  virtual SizeValueType
+  GetRequestedBulkDataNumberOfBytes() const
+  {
+    return 0;
+  }
+
 protected:
   DataObject();
   ~DataObject() override;
@@ -543,6 +586,20 @@ protected:
   virtual void
   PropagateResetPipeline();
 
+  /** Computes the hash returned by GetContentHash(). Subclasses which can
+   * hash their content should override it, and include their type in the
+   * hash. The default implementation returns an empty string. */
+  virtual std::string
+  ComputeContentHash() const
+  {
+    return {};
+  }
+
+  /** Returns the MD5 hash of a buffer, as an hexadecimal string. Large
+   * buffers are hashed in blocks, in parallel. */
+  static std::string
+  HashBytes(const void * buffer, size_t numberOfBytes);
+
 private:
   /** Who generated this data? */
   WeakPointer<ProcessObject> m_Source{};
@@ -564,6 +621,12 @@ private:
    * This does not include the MTime of this data object. */
   ModifiedTimeType m_PipelineMTime{};
 
+  /** The hash returned by GetContentHash(), valid while the modification
+   * and update times of the data object are not later than
+   * m_ContentHashTime. */
+  mutable std::string      m_ContentHash{};
+  mutable ModifiedTimeType m_ContentHashTime{};
+
   /** Static member that controls global data release after use by filter. */
   static bool * m_GlobalReleaseDataFlag;
 
@@ -339,6 +339,19 @@ public:
   [[nodiscard]] unsigned int
   GetNumberOfComponentsPerPixel() const override;
 
+  /** Returns a new image with the information, the regions and a copy of
+   * the pixels of this one. */
+  DataObject::Pointer
+  CreateDeepCopy() const override;
+
+  /** Returns the number of bytes of the pixel buffer. */
+  SizeValueType
+  GetBulkDataNumberOfBytes() const override;
+
+  /** Returns the number of bytes of the pixels of the requested region. */
+  SizeValueType
+  GetRequestedBulkDataNumberOfBytes() const override;
+
   /** Returns (image1 == image2).
    * \note `operator==` and `operator!=` are defined as function templates
    * (rather than as non-templates), just to allow template instantiation of
@@ -399,6 +412,11 @@ protected:
   void
   Graft(const DataObject * data) override;
 
+  /** Hashes the information and the pixels of the image. Returns an empty
+   * string for the pixel types which are not trivially copyable. */
+  std::string
+  ComputeContentHash() const override;
+
   ~Image() override = default;
 
   /** Compute helper matrices used to transform Index coordinates to
@@ -29,6 +29,7 @@
 #define itkImage_hxx
 
 #include "itkProcessObject.h"
+#include "itkImageBufferAllocator.h"
 #include <algorithm>
 
 namespace itk
@@ -41,7 +42,15 @@ Image<TPixel, VImageDimension>::Allocate(bool initializePixels)
   this->ComputeOffsetTable();
   SizeValueType num = static_cast<SizeValueType>(this->GetOffsetTable()[VImageDimension]);
 
-  m_Buffer->Reserve(num, initializePixels);
+  if (initializePixels && ImageBufferAllocator::ShouldInitializeInParallel(num * sizeof(TPixel)))
+  {
+    m_Buffer->Reserve(num, false);
+    ImageBufferAllocator::InitializeInParallel(m_Buffer->GetBufferPointer(), this->GetBufferedRegion());
+  }
+  else
+  {
+    m_Buffer->Reserve(num, initializePixels);
+  }
 }
 
 
@@ -124,6 +133,63 @@ Image<TPixel, VImageDimension>::Graft(const DataObject * data)
 }
 
 
+template <typename TPixel, unsigned int VImageDimension>
+DataObject::Pointer
+Image<TPixel, VImageDimension>::CreateDeepCopy() const
+{
+  LightObject::Pointer anotherObject = this->CreateAnother();
+  const Pointer        copy = dynamic_cast<Self *>(anotherObject.GetPointer());
+  if (copy.IsNull())
+  {
+    return nullptr;
+  }
+  copy->Graft(this);
+  if (m_Buffer)
+  {
+    auto container = PixelContainer::New();
+    container->Reserve(m_Buffer->Size(), false);
+    std::copy_n(m_Buffer->GetBufferPointer(), m_Buffer->Size(), container->GetBufferPointer());
+    copy->SetPixelContainer(container);
+  }
+  return copy.GetPointer();
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+Image<TPixel, VImageDimension>::GetBulkDataNumberOfBytes() const -> SizeValueType
+{
+  return m_Buffer ? static_cast<SizeValueType>(m_Buffer->Size() * sizeof(TPixel)) : 0;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+Image<TPixel, VImageDimension>::GetRequestedBulkDataNumberOfBytes() const -> SizeValueType
+{
+  return static_cast<SizeValueType>(this->GetRequestedRegion().GetNumberOfPixels() * sizeof(TPixel));
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+std::string
+Image<TPixel, VImageDimension>::ComputeContentHash() const
+{
+  if constexpr (std::is_trivially_copyable_v<TPixel>)
+  {
+    if (m_Buffer)
+    {
+      return this->HashImageContent(m_Buffer->GetBufferPointer(), m_Buffer->Size() * sizeof(TPixel));
+    }
+    return this->HashImageContent(nullptr, 0);
+  }
+  else
+  {
+    return {};
+  }
+}
+
+
 template <typename TPixel, unsigned int VImageDimension>
 void
 Image<TPixel, VImageDimension>::ComputeIndexToPhysicalPointMatrices()
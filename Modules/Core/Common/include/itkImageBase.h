@@ -918,6 +918,12 @@ protected:
   void
   Graft(const DataObject * data) override;
 
+  /** Returns a hash of the type, the regions, the geometry and the number of
+   * components per pixel of the image, and of the given pixel buffer. Used
+   * by the subclasses to implement ComputeContentHash(). */
+  std::string
+  HashImageContent(const void * buffer, size_t numberOfBytes) const;
+
 private:
   OffsetValueType m_OffsetTable[VImageDimension + 1]{};
 
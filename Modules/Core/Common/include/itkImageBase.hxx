@@ -35,6 +35,7 @@
 #include <cstring>
 #include "itkMath.h"
 #include "itkMathDeterminant.h"
+#include <typeinfo>
 
 namespace itk
 {
@@ -337,6 +338,27 @@ ImageBase<VImageDimension>::Graft(const DataObject * data)
 }
 
 
+template <unsigned int VImageDimension>
+std::string
+ImageBase<VImageDimension>::HashImageContent(const void * buffer, size_t numberOfBytes) const
+{
+  std::string content = typeid(*this).name();
+  const auto  append = [&content](const auto & value) {
+    content.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  append(m_LargestPossibleRegion.GetIndex());
+  append(m_LargestPossibleRegion.GetSize());
+  append(m_BufferedRegion.GetIndex());
+  append(m_BufferedRegion.GetSize());
+  append(m_Spacing);
+  append(m_Origin);
+  append(m_Direction);
+  append(this->GetNumberOfComponentsPerPixel());
+  content += Self::HashBytes(buffer, numberOfBytes);
+  return Self::HashBytes(content.data(), content.size());
+}
+
+
 template <unsigned int VImageDimension>
 bool
 ImageBase<VImageDimension>::RequestedRegionIsOutsideOfTheBufferedRegion()
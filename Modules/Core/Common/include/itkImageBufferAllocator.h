@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocator_h
+#define itkImageBufferAllocator_h
+
+#include "itkImageRegion.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkPlatformMultiThreader.h"
+#include "itkSingletonMacro.h"
+#include "ITKCommonExport.h"
+#include <algorithm>
+
+namespace itk
+{
+
+struct ImageBufferAllocatorGlobals;
+
+/** \class ImageBufferAllocator
+ * \brief Global allocation policy for the pixel buffers of images.
+ *
+ * ImportImageContainer, which holds the pixel buffer of Image and
+ * VectorImage, asks this class how to allocate its memory. By default
+ * the policy is disabled, and buffers are allocated with new[], as they
+ * always were. When the policy is enabled:
+ *
+ * - Buffers are aligned to GlobalDefaultAlignment bytes, e.g. 64 bytes
+ *   for a cache line, which is also the width of AVX-512 registers.
+ * - Buffers of at least LargeBufferSize bytes are aligned to the huge
+ *   page size and, on Linux, advised to be backed by transparent huge
+ *   pages when GlobalDefaultUseHugePages is on.
+ * - When GlobalDefaultParallelInitialization is on, Image::Allocate(true)
+ *   and VectorImage::Allocate(true) initialize large buffers in parallel,
+ *   one piece of the static region split of the threaded filters per
+ *   thread. On NUMA systems the pages of each piece are then placed
+ *   together, and the pieces are spread over the threads; see
+ *   InitializeInParallel() for what is, and is not, guaranteed.
+ *
+ * A buffer allocated by this class must be released by Deallocate().
+ * An application which takes over the memory of an image (by turning
+ * ContainerManageMemory off) must therefore use Deallocate() instead of
+ * delete[] while the policy is enabled.
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocator
+{
+public:
+  /** Buffers of at least this number of bytes are considered large.
+   * This is the size of a transparent huge page on x86-64 and AArch64 Linux. */
+  static constexpr SizeValueType LargeBufferSize = SizeValueType{ 2 } << 20;
+
+  /** Set/Get the alignment, in bytes, of the allocated buffers. Must be
+   * zero or a power of two. Zero means that no alignment is requested. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalDefaultAlignment(SizeValueType alignment);
+  static SizeValueType
+  GetGlobalDefaultAlignment();
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether large buffers should be backed by huge pages. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalDefaultUseHugePages(bool useHugePages);
+  static bool
+  GetGlobalDefaultUseHugePages();
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether large buffers should be initialized in parallel, so
+   * that their pages are first touched by the threads which process them. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalDefaultParallelInitialization(bool parallelInitialization);
+  static bool
+  GetGlobalDefaultParallelInitialization();
+  /** @ITKEndGrouping */
+
+  /** Returns true if ImportImageContainer should allocate its buffers by
+   * Allocate() rather than by new[], i.e. if an alignment is requested or
+   * if huge pages are requested. */
+  static bool
+  GetGlobalDefaultAllocatorEnabled();
+
+  /** Returns true if large buffers of this number of bytes should be
+   * initialized in parallel. */
+  static bool
+  ShouldInitializeInParallel(SizeValueType numberOfBytes);
+
+  /** Allocates an uninitialized buffer according to the current policy.
+   * Throws a MemoryAllocationError if the memory cannot be allocated. */
+  static void *
+  Allocate(SizeValueType numberOfBytes);
+
+  /** Returns true if the buffer was allocated by Allocate() and has not
+   * been deallocated yet. */
+  static bool
+  IsAllocated(const void * buffer);
+
+  /** Releases a buffer allocated by Allocate(). Returns false, and does
+   * nothing, if the buffer was not allocated by Allocate(). */
+  static bool
+  Deallocate(void * buffer);
+
+  /** Value-initializes a buffer in parallel. The buffered region is split
+   * along its slowest dimension, as ImageSource::SplitRequestedRegion splits
+   * it among the work units of the threaded filters, into at most the
+   * global default number of threads pieces. Each piece is initialized by
+   * its own thread of a PlatformMultiThreader, so the pages of a piece are
+   * first touched, and thereby placed, by a single thread, and the pieces
+   * are spread over as many threads as the filters use.
+   *
+   * This does not guarantee that the thread which processes a piece later
+   * runs on the NUMA node where the piece was placed: neither the threaders
+   * nor the operating system bind threads to nodes, and the thread pool
+   * assigns chunks to threads dynamically. The buffer holds
+   * numberOfComponents contiguous elements for each pixel of the buffered
+   * region. */
+  template <typename TElement, unsigned int VDimension>
+  static void
+  InitializeInParallel(TElement *                      buffer,
+                       const ImageRegion<VDimension> & bufferedRegion,
+                       SizeValueType                   numberOfComponents = 1)
+  {
+    const auto         splitter = ImageRegionSplitterSlowDimension::New();
+    const ThreadIdType numberOfPieces = splitter->GetNumberOfSplits(
+      bufferedRegion, std::max<ThreadIdType>(1, MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+
+    const auto multiThreader = PlatformMultiThreader::New();
+    multiThreader->SetMaximumNumberOfThreads(numberOfPieces);
+    multiThreader->SetNumberOfWorkUnits(numberOfPieces);
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfPieces,
+      [buffer, &bufferedRegion, numberOfComponents, &splitter, numberOfPieces](SizeValueType piece) {
+        ImageRegion<VDimension> region = bufferedRegion;
+        splitter->GetSplit(static_cast<unsigned int>(piece), numberOfPieces, region);
+        if (region.GetNumberOfPixels() == 0)
+        {
+          return;
+        }
+        // The pieces are contiguous in the buffer: they are split along the
+        // slowest dimension of size greater than one.
+        SizeValueType offset = 0;
+        SizeValueType stride = numberOfComponents;
+        for (unsigned int d = 0; d < VDimension; ++d)
+        {
+          offset += static_cast<SizeValueType>(region.GetIndex(d) - bufferedRegion.GetIndex(d)) * stride;
+          stride *= bufferedRegion.GetSize(d);
+        }
+        std::fill_n(buffer + offset, region.GetNumberOfPixels() * numberOfComponents, TElement{});
+      },
+      nullptr);
+  }
+
+private:
+  itkGetGlobalDeclarationMacro(ImageBufferAllocatorGlobals, PimplGlobals);
+
+  static ImageBufferAllocatorGlobals * m_PimplGlobals;
+};
+
+} // namespace itk
+
+#endif
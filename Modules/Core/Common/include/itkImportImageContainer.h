@@ -36,6 +36,10 @@ namespace itk
  *
  * \tparam TElement The element type stored in the container.
  *
+ * The memory allocated by the container itself follows the global policy
+ * of ImageBufferAllocator, which may align the buffer or back it by huge
+ * pages.
+ *
  * \ingroup ImageObjects
  * \ingroup IOFilters
  * \ingroup ITKCommon
@@ -207,10 +211,20 @@ protected:
   }
 
 private:
+  // Whether a buffer returned by AllocateElements comes from
+  // ImageBufferAllocator. Looked up once per allocation, so that releasing
+  // the buffer does not need a lookup.
+  static bool
+  IsAllocatedByImageBufferAllocator(const TElement * buffer);
+
   TElement *         m_ImportPointer{};
   TElementIdentifier m_Size{};
   TElementIdentifier m_Capacity{};
   bool               m_ContainerManageMemory{ true };
+
+  /** Whether m_ImportPointer must be released by ImageBufferAllocator
+   * rather than by delete[]. */
+  bool m_AllocatedByImageBufferAllocator{ false };
 };
 } // end namespace itk
 
@@ -28,7 +28,10 @@
 #ifndef itkImportImageContainer_hxx
 #define itkImportImageContainer_hxx
 
+#include "itkImageBufferAllocator.h"
 #include <algorithm> // For copy_n.
+#include <memory>    // For uninitialized_value_construct_n and destroy_n.
+#include <limits>
 
 namespace itk
 {
@@ -61,6 +64,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
 
       m_ImportPointer = temp;
       m_ContainerManageMemory = true;
+      m_AllocatedByImageBufferAllocator = IsAllocatedByImageBufferAllocator(temp);
       m_Capacity = size;
       m_Size = size;
       this->Modified();
@@ -74,6 +78,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   else
   {
     m_ImportPointer = this->AllocateElements(size, UseValueInitialization);
+    m_AllocatedByImageBufferAllocator = IsAllocatedByImageBufferAllocator(m_ImportPointer);
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -101,6 +106,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
 
       m_ImportPointer = temp;
       m_ContainerManageMemory = true;
+      m_AllocatedByImageBufferAllocator = IsAllocatedByImageBufferAllocator(temp);
       m_Capacity = size;
       m_Size = size;
 
@@ -155,6 +161,32 @@ TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
                                                                      bool              UseValueInitialization) const
 {
+  if (ImageBufferAllocator::GetGlobalDefaultAllocatorEnabled())
+  {
+    if (size > std::numeric_limits<SizeValueType>::max() / sizeof(TElement))
+    {
+      throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+    }
+    auto * const data = static_cast<TElement *>(ImageBufferAllocator::Allocate(size * sizeof(TElement)));
+    try
+    {
+      if (UseValueInitialization)
+      {
+        std::uninitialized_value_construct_n(data, size);
+      }
+      else
+      {
+        std::uninitialized_default_construct_n(data, size);
+      }
+    }
+    catch (...)
+    {
+      ImageBufferAllocator::Deallocate(data);
+      throw;
+    }
+    return data;
+  }
+
   TElement * data = nullptr;
 
   try
@@ -181,6 +213,15 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
   return data;
 }
 
+template <typename TElementIdentifier, typename TElement>
+bool
+ImportImageContainer<TElementIdentifier, TElement>::IsAllocatedByImageBufferAllocator(const TElement * buffer)
+{
+  // Not conditional on the policy being enabled: the policy may have been
+  // disabled by another thread since the buffer was allocated.
+  return ImageBufferAllocator::IsAllocated(buffer);
+}
+
 template <typename TElementIdentifier, typename TElement>
 void
 ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
@@ -188,9 +229,18 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_AllocatedByImageBufferAllocator)
+    {
+      std::destroy_n(m_ImportPointer, m_Capacity);
+      ImageBufferAllocator::Deallocate(m_ImportPointer);
+    }
+    else
+    {
+      delete[] m_ImportPointer;
+    }
   }
   m_ImportPointer = nullptr;
+  m_AllocatedByImageBufferAllocator = false;
   m_Capacity = 0;
   m_Size = 0;
 }
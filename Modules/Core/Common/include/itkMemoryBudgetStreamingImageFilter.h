@@ -0,0 +1,159 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryBudgetStreamingImageFilter_h
+#define itkMemoryBudgetStreamingImageFilter_h
+
+#include "itkStreamingImageFilter.h"
+#include <map>
+#include <vector>
+
+namespace itk
+{
+/** \class MemoryBudgetStreamingImageFilter
+ * \brief Streams the upstream pipeline in as few pieces as possible, within a
+ * memory budget.
+ *
+ * Before each update, this filter predicts the peak memory used to update
+ * the upstream pipeline for a number of stream divisions: it propagates the
+ * requested region of the largest piece through the pipeline, so each filter
+ * enlarges it as it needs in GenerateInputRequestedRegion(), and adds the
+ * bulk data of the data objects which are held at the same time. The
+ * smallest number of stream divisions whose predicted peak memory does not
+ * exceed MaximumNumberOfBytes is used. When the budget cannot be met, e.g.
+ * because a filter requires its whole input, the number of stream divisions
+ * with the smallest predicted peak memory is used, and a warning is issued.
+ *
+ * When ReleaseIntermediateData is on (the default), the ReleaseDataFlag of
+ * the streamed intermediate data objects is turned on during the update, so
+ * they are released as soon as they are consumed, and computed again if they
+ * are needed again. The flags are restored after the update. The data
+ * objects which are not streamed (their requested region is the same for
+ * each piece) are kept, so they are computed only once.
+ *
+ * PlanStreaming() can be called before Update() to get the number of stream
+ * divisions and the predicted peak memory. The prediction is an upper bound
+ * for the filters which run in place.
+ *
+ * \sa StreamingImageFilter
+ * \ingroup ITKSystemObjects
+ * \ingroup DataProcessing
+ * \ingroup ITKCommon
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage>
+class ITK_TEMPLATE_EXPORT MemoryBudgetStreamingImageFilter : public StreamingImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryBudgetStreamingImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = MemoryBudgetStreamingImageFilter;
+  using Superclass = StreamingImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryBudgetStreamingImageFilter);
+
+  using typename Superclass::InputImageType;
+  using typename Superclass::InputImageRegionType;
+  using typename Superclass::OutputImageType;
+  using typename Superclass::OutputImageRegionType;
+
+  /** Set/Get the maximum number of bytes of bulk data held while updating
+   * the pipeline, including the output of this filter and the data objects
+   * which are not generated by the pipeline. Default is 1 GiB. */
+  /** @ITKStartGrouping */
+  itkSetMacro(MaximumNumberOfBytes, SizeValueType);
+  itkGetConstMacro(MaximumNumberOfBytes, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether the streamed intermediate data objects are released
+   * as soon as they are consumed. Default is on. */
+  /** @ITKStartGrouping */
+  itkSetMacro(ReleaseIntermediateData, bool);
+  itkGetConstMacro(ReleaseIntermediateData, bool);
+  itkBooleanMacro(ReleaseIntermediateData);
+  /** @ITKEndGrouping */
+
+  /** Chooses the number of stream divisions from the memory budget, sets
+   * NumberOfStreamDivisions, and returns it. Called by Update(). */
+  unsigned int
+  PlanStreaming();
+
+  /** The peak memory predicted by the last call to PlanStreaming(). */
+  itkGetConstMacro(PredictedPeakNumberOfBytes, SizeValueType);
+
+  /** Predicts the peak memory used to update the pipeline with the given
+   * number of stream divisions. */
+  SizeValueType
+  PredictPeakNumberOfBytes(unsigned int numberOfStreamDivisions);
+
+  /** Plans the streaming, then streams the upstream pipeline. */
+  void
+  UpdateOutputData(DataObject * output) override;
+
+protected:
+  MemoryBudgetStreamingImageFilter() = default;
+  ~MemoryBudgetStreamingImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Requested bulk data of the upstream data objects. */
+  using NumberOfBytesMapType = std::map<DataObject *, SizeValueType>;
+
+  /** Propagates the region through the upstream pipeline, and returns the
+   * requested bulk data of each upstream data object. */
+  NumberOfBytesMapType
+  PropagateRegion(const InputImageRegionType & region);
+
+  /** Predicts the peak memory for the given number of stream divisions,
+   * from the requested bulk data of the upstream data objects for the
+   * whole output. Returns the intermediate data objects to release. */
+  SizeValueType
+  ComputePeakNumberOfBytes(unsigned int                 numberOfStreamDivisions,
+                           const NumberOfBytesMapType & wholeNumberOfBytes,
+                           std::vector<DataObject *> &  releasedData);
+
+  /** The peak memory while updating the data object, besides the data objects
+   * which are not released. */
+  SizeValueType
+  ComputeReleasedPeakNumberOfBytes(DataObject *                      data,
+                                   const NumberOfBytesMapType &      numberOfBytes,
+                                   const std::vector<DataObject *> & releasedData) const;
+
+  /** The region requested to this filter, or its largest possible region
+   * when the requested region is not set yet. */
+  OutputImageRegionType
+  GetStreamedRegion();
+
+  SizeValueType             m_MaximumNumberOfBytes{ SizeValueType{ 1 } << 30 };
+  bool                      m_ReleaseIntermediateData{ true };
+  SizeValueType             m_PredictedPeakNumberOfBytes{ 0 };
+  std::vector<DataObject *> m_ReleasedData{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkMemoryBudgetStreamingImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,294 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryBudgetStreamingImageFilter_hxx
+#define itkMemoryBudgetStreamingImageFilter_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+auto
+MemoryBudgetStreamingImageFilter<TInputImage, TOutputImage>::GetStreamedRegion() -> OutputImageRegionType
+{
+  OutputImageType * output = this->GetOutput();
+  if (output->GetRequestedRegion().GetNumberOfPixels() == 0)
+  {
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+  return output->GetRequestedRegion();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+MemoryBudgetStreamingImageFilter<TInputImage, TOutputImage>::PropagateRegion(const InputImageRegionType & region)
+  -> NumberOfBytesMapType
+{
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  input->SetRequestedRegion(region);
+  input->PropagateRequestedRegion();
+
+  // Visit the data objects of the upstream pipeline
+  NumberOfBytesMapType      numberOfBytes;
+  std::vector<DataObject *> dataToVisit{ input };
+  while (!dataToVisit.empty())
+  {
+    DataObject * const data = dataToVisit.back();
+    dataToVisit.pop_back();
+    const auto source = data->GetSource();
+    // The data objects which are not generated hold their whole buffer
+    const SizeValueType dataNumberOfBytes =
+      source ? data->GetRequestedBulkDataNumberOfBytes() : data->GetBulkDataNumberOfBytes();
+    if (!numberOfBytes.emplace(data, dataNumberOfBytes).second || !source)
+    {
+      continue;
+    }
+    for (const auto & sourceData : source->GetInputs())
+    {
+      if (sourceData)
+      {
+        dataToVisit.push_back(sourceData);
+      }
+    }
+    for (const auto & sourceData : source->GetOutputs())
+    {
+      if (sourceData)
+      {
+        dataToVisit.push_back(sourceData);
+      }
+    }
+  }
+  return numberOfBytes;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+SizeValueType
+MemoryBudgetStreamingImageFilter<TInputImage, TOutputImage>::ComputePeakNumberOfBytes(
+  unsigned int                 numberOfStreamDivisions,
+  const NumberOfBytesMapType & wholeNumberOfBytes,
+  std::vector<DataObject *> &  releasedData)
+{
+  const OutputImageRegionType region = this->GetStreamedRegion();
+  const unsigned int numberOfPieces = this->GetRegionSplitter()->GetNumberOfSplits(region, numberOfStreamDivisions);
+
+  // The first piece is one of the largest ones
+  InputImageRegionType pieceRegion = region;
+  this->GetRegionSplitter()->GetSplit(0, numberOfPieces, pieceRegion);
+  const NumberOfBytesMapType numberOfBytes =
+    numberOfPieces > 1 ? this->PropagateRegion(pieceRegion) : wholeNumberOfBytes;
+
+  // The output of this filter, the data objects which are not generated, and
+  // the ones which are not streamed or not released are held during the
+  // whole update
+  SizeValueType keptNumberOfBytes = this->GetOutput()->GetRequestedBulkDataNumberOfBytes();
+  releasedData.clear();
+  for (const auto & [data, dataNumberOfBytes] : numberOfBytes)
+  {
+    const auto wholeData = wholeNumberOfBytes.find(data);
+    const bool streamed =
+      numberOfPieces == 1 || (wholeData != wholeNumberOfBytes.end() && wholeData->second != dataNumberOfBytes);
+    if (data->GetSource() && streamed && (m_ReleaseIntermediateData || data->ShouldIReleaseData()))
+    {
+      releasedData.push_back(data);
+    }
+    else
+    {
+      keptNumberOfBytes += dataNumberOfBytes;
+    }
+  }
+  std::sort(releasedData.begin(), releasedData.end());
+
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  return keptNumberOfBytes + this->ComputeReleasedPeakNumberOfBytes(input, numberOfBytes, releasedData);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+SizeValueType
+MemoryBudgetStreamingImageFilter<TInputImage, TOutputImage>::ComputeReleasedPeakNumberOfBytes(
+  DataObject *                      data,
+  const NumberOfBytesMapType &      numberOfBytes,
+  const std::vector<DataObject *> & releasedData) const
+{
+  const auto source = data->GetSource();
+  if (!source)
+  {
+    return 0;
+  }
+  const auto releasedNumberOfBytes = [&numberOfBytes, &releasedData](DataObject * sourceData) -> SizeValueType {
+    if (!std::binary_search(releasedData.begin(), releasedData.end(), sourceData))
+    {
+      return 0;
+    }
+    return numberOfBytes.at(sourceData);
+  };
+
+  // The inputs are updated one after the other, and are all held while the
+  // source generates its outputs
+  SizeValueType peakNumberOfBytes = 0;
+  SizeValueType heldNumberOfBytes = 0;
+  for (const auto & input : source->GetInputs())
+  {
+    if (input)
+    {
+      peakNumberOfBytes = std::max(
+        peakNumberOfBytes, heldNumberOfBytes + this->ComputeReleasedPeakNumberOfBytes(input, numberOfBytes, releasedData));
+      heldNumberOfBytes += releasedNumberOfBytes(input);
+    }
+  }
+  for (const auto & output : source->GetOutputs())
+  {
+    if (output)
+    {
+      heldNumberOfBytes += releasedNumberOfBytes(output);
+    }
+  }
+  return std::max(peakNumberOfBytes, heldNumberOfBytes);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+SizeValueType
+MemoryBudgetStreamingImageFilter<TInputImage, TOutputImage>::PredictPeakNumberOfBytes(
+  unsigned int numberOfStreamDivisions)
+{
+  this->UpdateOutputInformation();
+  const NumberOfBytesMapType wholeNumberOfBytes = this->PropagateRegion(this->GetStreamedRegion());
+  std::vector<DataObject *>  releasedData;
+  return this->ComputePeakNumberOfBytes(numberOfStreamDivisions, wholeNumberOfBytes, releasedData);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+unsigned int
+MemoryBudgetStreamingImageFilter<TInputImage, TOutputImage>::PlanStreaming()
+{
+  this->UpdateOutputInformation();
+  const OutputImageRegionType region = this->GetStreamedRegion();
+  const NumberOfBytesMapType  wholeNumberOfBytes = this->PropagateRegion(region);
+  const unsigned int          maximumNumberOfDivisions =
+    this->GetRegionSplitter()->GetNumberOfSplits(region, NumericTraits<unsigned int>::max());
+
+  std::vector<DataObject *> releasedData;
+  unsigned int              bestNumberOfDivisions = 1;
+  SizeValueType             bestPeak = this->ComputePeakNumberOfBytes(1, wholeNumberOfBytes, releasedData);
+  m_ReleasedData = releasedData;
+
+  // Double the number of divisions until the budget is met, then look for
+  // the smallest number of divisions within the budget
+  unsigned int exceedingNumberOfDivisions = 1;
+  for (unsigned int numberOfDivisions = 1;
+       bestPeak > m_MaximumNumberOfBytes && numberOfDivisions < maximumNumberOfDivisions;)
+  {
+    numberOfDivisions = std::min(2 * numberOfDivisions, maximumNumberOfDivisions);
+    const SizeValueType peak = this->ComputePeakNumberOfBytes(numberOfDivisions, wholeNumberOfBytes, releasedData);
+    if (peak < bestPeak)
+    {
+      bestNumberOfDivisions = numberOfDivisions;
+      bestPeak = peak;
+      m_ReleasedData = releasedData;
+    }
+    if (peak > m_MaximumNumberOfBytes)
+    {
+      exceedingNumberOfDivisions = numberOfDivisions;
+      continue;
+    }
+    while (exceedingNumberOfDivisions + 1 < bestNumberOfDivisions)
+    {
+      const unsigned int middle =
+        exceedingNumberOfDivisions + (bestNumberOfDivisions - exceedingNumberOfDivisions) / 2;
+      const SizeValueType middlePeak = this->ComputePeakNumberOfBytes(middle, wholeNumberOfBytes, releasedData);
+      if (middlePeak <= m_MaximumNumberOfBytes)
+      {
+        bestNumberOfDivisions = middle;
+        bestPeak = middlePeak;
+        m_ReleasedData = releasedData;
+      }
+      else
+      {
+        exceedingNumberOfDivisions = middle;
+      }
+    }
+  }
+
+  if (bestPeak > m_MaximumNumberOfBytes)
+  {
+    itkWarningMacro("The predicted peak memory, " << bestPeak << " bytes with " << bestNumberOfDivisions
+                                                  << " stream divisions, exceeds MaximumNumberOfBytes, "
+                                                  << m_MaximumNumberOfBytes << " bytes.");
+  }
+  m_PredictedPeakNumberOfBytes = bestPeak;
+  this->SetNumberOfStreamDivisions(bestNumberOfDivisions);
+  return bestNumberOfDivisions;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+MemoryBudgetStreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * output)
+{
+  if (this->m_Updating)
+  {
+    return;
+  }
+
+  this->PlanStreaming();
+
+  std::vector<std::pair<DataObject *, bool>> releaseDataFlags;
+  for (DataObject * data : m_ReleasedData)
+  {
+    releaseDataFlags.emplace_back(data, data->GetReleaseDataFlag());
+    data->ReleaseDataFlagOn();
+  }
+  m_ReleasedData.clear();
+  const auto restoreReleaseDataFlags = [&releaseDataFlags] {
+    for (const auto & [data, flag] : releaseDataFlags)
+    {
+      data->SetReleaseDataFlag(flag);
+    }
+  };
+
+  try
+  {
+    Superclass::UpdateOutputData(output);
+  }
+  catch (...)
+  {
+    restoreReleaseDataFlags();
+    throw;
+  }
+  restoreReleaseDataFlags();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+MemoryBudgetStreamingImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "MaximumNumberOfBytes: " << m_MaximumNumberOfBytes << std::endl;
+  itkPrintSelfBooleanMacro(ReleaseIntermediateData);
+  os << indent << "PredictedPeakNumberOfBytes: " << m_PredictedPeakNumberOfBytes << std::endl;
+}
+} // end namespace itk
+
+#endif
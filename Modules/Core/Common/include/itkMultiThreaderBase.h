@@ -39,6 +39,7 @@
 #include <functional>
 #include <thread>
 #include "itkProgressReporter.h"
+#include "itkPipelineTracer.h"
 
 
 namespace itk
@@ -354,7 +355,9 @@ ITK_GCC_PRAGMA_DIAG_POP()
       VDimension,
       requestedRegion.GetIndex().m_InternalArray,
       requestedRegion.GetSize().m_InternalArray,
-      [&funcP](const IndexValueType index[], const SizeValueType size[]) {
+      [&funcP, filter](const IndexValueType index[], const SizeValueType size[]) {
+        PipelineTracer::Scope scope("ParallelizeImageRegion", filter);
+        scope.SetRegion(VDimension, index, size);
         ImageRegion<VDimension> region;
         for (unsigned int d = 0; d < VDimension; ++d)
         {
@@ -402,7 +405,8 @@ ITK_GCC_PRAGMA_DIAG_POP()
         SplitDimension,
         splitIndex.m_InternalArray,
         splitSize.m_InternalArray,
-        [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[], const SizeValueType size[]) {
+        [restrictedDirection, &requestedRegion, &funcP, filter](const IndexValueType index[],
+                                                                const SizeValueType  size[]) {
           ImageRegion<VDimension> restrictedRequestedRegion;
           restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
           restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
@@ -415,6 +419,10 @@ ITK_GCC_PRAGMA_DIAG_POP()
               ++splitDimension;
             }
           }
+          PipelineTracer::Scope scope("ParallelizeImageRegion", filter);
+          scope.SetRegion(VDimension,
+                          restrictedRequestedRegion.GetIndex().m_InternalArray,
+                          restrictedRequestedRegion.GetSize().m_InternalArray);
           funcP(restrictedRequestedRegion);
         },
         filter);
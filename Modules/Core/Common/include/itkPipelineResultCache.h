@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineResultCache_h
+#define itkPipelineResultCache_h
+
+#include "itkDataObject.h"
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace itk
+{
+struct PipelineResultCacheGlobals;
+
+/** \class PipelineResultCache
+ * \brief Keeps the outputs of process objects, to reuse them when a process
+ * object is executed again on the same inputs with the same parameters.
+ *
+ * The process objects whose UseResultCache flag is on look for their outputs
+ * in this cache before executing, with a key computed from their type, their
+ * parameters and the content of their inputs (see
+ * ProcessObject::ComputeResultCacheKey()). This avoids executing again the
+ * process objects whose modification time changed without change of their
+ * results, e.g. when pipelines are rebuilt with the same parameters, or
+ * when only the parameters of the last filters of a pipeline are tuned.
+ *
+ * The cache holds copies of the outputs, so that they are not affected by
+ * the modifications of the outputs of the process objects. Find() returns
+ * these copies themselves, which must not be modified: the process objects
+ * graft copies of them onto their outputs. When the outputs held exceed MaximumNumberOfBytes,
+ * the least recently used ones are released.
+ *
+ * There is a single instance of the cache, shared by all the process objects.
+ * Its methods can be called from several threads.
+ *
+ * \sa ProcessObject::SetUseResultCache()
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineResultCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PipelineResultCache);
+
+  /** Standard class type aliases. */
+  using Self = PipelineResultCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PipelineResultCache);
+
+  /** Returns the single instance of the cache. */
+  /** @ITKStartGrouping */
+  static Pointer
+  New();
+  static Pointer
+  GetInstance();
+  /** @ITKEndGrouping */
+
+  /** The outputs of a process object, by output name. */
+  using OutputsType = std::map<DataObject::DataObjectIdentifierType, DataObject::Pointer>;
+
+  /** Set/Get the maximum number of bytes of bulk data held by the cache.
+   * Default is 1 GiB. */
+  /** @ITKStartGrouping */
+  void
+  SetMaximumNumberOfBytes(SizeValueType numberOfBytes);
+  SizeValueType
+  GetMaximumNumberOfBytes() const;
+  /** @ITKEndGrouping */
+
+  /** Returns the outputs cached with the key, or an empty map. They are
+   * shared with the other users of the cache, and must not be modified. */
+  OutputsType
+  Find(const std::string & key);
+
+  /** Caches copies of the outputs with the key, replacing the outputs
+   * previously cached with the same key. Nothing is cached when one of the
+   * outputs cannot be copied, or when the outputs exceed
+   * MaximumNumberOfBytes. */
+  void
+  Insert(const std::string & key, const OutputsType & outputs);
+
+  /** Releases all the cached outputs, and resets the numbers of hits and
+   * misses. */
+  void
+  Clear();
+
+  /** Number of sets of outputs in the cache, and number of bytes of bulk
+   * data they hold. */
+  /** @ITKStartGrouping */
+  SizeValueType
+  GetNumberOfEntries() const;
+  SizeValueType
+  GetNumberOfBytes() const;
+  /** @ITKEndGrouping */
+
+  /** Number of calls to Find() which found, and did not find the key. */
+  /** @ITKStartGrouping */
+  SizeValueType
+  GetNumberOfHits() const;
+  SizeValueType
+  GetNumberOfMisses() const;
+  /** @ITKEndGrouping */
+
+protected:
+  PipelineResultCache();
+  ~PipelineResultCache() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  itkGetGlobalDeclarationMacro(PipelineResultCacheGlobals, PimplGlobals);
+
+  struct Entry
+  {
+    OutputsType                      Outputs;
+    SizeValueType                    NumberOfBytes;
+    std::list<std::string>::iterator LeastRecentlyUsedPosition;
+  };
+
+  /** Releases the least recently used entries until the cache holds at most
+   * the given number of bytes. Must be called with the lock held. */
+  void
+  ReleaseEntries(SizeValueType numberOfBytes);
+
+  std::map<std::string, Entry> m_Entries{};
+  std::list<std::string>       m_LeastRecentlyUsedKeys{};
+  SizeValueType                m_MaximumNumberOfBytes{ SizeValueType{ 1 } << 30 };
+  SizeValueType                m_NumberOfBytes{ 0 };
+  SizeValueType                m_NumberOfHits{ 0 };
+  SizeValueType                m_NumberOfMisses{ 0 };
+  mutable std::mutex           m_Mutex{};
+
+  static PipelineResultCacheGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,187 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineTracer_h
+#define itkPipelineTracer_h
+
+#include "itkObject.h"
+#include "itkIntTypes.h"
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+class ProcessObject;
+struct PipelineTracerGlobals;
+
+/** \class PipelineTracer
+ * \brief Records the execution of the process objects and of the chunks of
+ * their multithreaded work, and writes them as a Chrome trace.
+ *
+ * When tracing is enabled, each call to ProcessObject::GenerateData() and
+ * each chunk of MultiThreaderBase::ParallelizeImageRegion() and
+ * ParallelizeImageRegionRestrictDirection() is recorded as an event, with
+ * the name of the class of the process object, the thread which executed it,
+ * its wall clock and CPU time, and the region of the chunk, or the number of
+ * bytes of bulk data of the outputs of the process object.
+ *
+ * The events are written by WriteChromeTrace() in the Trace Event format,
+ * which can be opened by chrome://tracing or https://ui.perfetto.dev to see
+ * the load imbalance between the threads and the serial parts of a pipeline.
+ *
+ * Tracing is disabled by default, and costs a single atomic load per event
+ * when disabled. It is enabled by SetEnabled(), or by setting the
+ * ITK_PIPELINE_TRACE_FILE environment variable to the name of a file: the
+ * events are then written to this file when the tracer is destroyed, at
+ * exit.
+ *
+ * There is a single instance of the tracer. Its methods can be called from
+ * several threads.
+ *
+ * \sa TimeProbesCollectorBase
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineTracer : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PipelineTracer);
+
+  /** Standard class type aliases. */
+  using Self = PipelineTracer;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PipelineTracer);
+
+  /** Returns the single instance of the tracer. */
+  /** @ITKStartGrouping */
+  static Pointer
+  New();
+  static Pointer
+  GetInstance();
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether the events are recorded. */
+  /** @ITKStartGrouping */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+  /** @ITKEndGrouping */
+
+  /** An event, with its times in microseconds. The start time is relative
+   * to the construction of the tracer. */
+  struct Event
+  {
+    std::string  Name;
+    std::string  Category;
+    std::string  Arguments;
+    int64_t      StartTime;
+    int64_t      Duration;
+    int64_t      CPUDuration;
+    unsigned int ThreadIndex;
+  };
+
+  /** Records the execution of a scope, when tracing is enabled. */
+  class ITKCommon_EXPORT Scope
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(Scope);
+
+    /** Starts the event. The process object may be null. */
+    Scope(const char * category, const ProcessObject * processObject);
+
+    /** Records the event. */
+    ~Scope();
+
+    /** Sets the region processed in the scope. */
+    void
+    SetRegion(unsigned int dimension, const IndexValueType index[], const SizeValueType size[]);
+
+    /** Sets the number of bytes allocated in the scope. */
+    void
+    SetNumberOfBytes(SizeValueType numberOfBytes);
+
+  private:
+    const char *          m_Category;
+    const ProcessObject * m_ProcessObject;
+    std::string           m_Arguments{};
+    int64_t               m_StartTime{ 0 };
+    int64_t               m_StartCPUTime{ 0 };
+    bool                  m_Enabled;
+  };
+
+  /** Records an event. */
+  void
+  AddEvent(Event event);
+
+  /** Returns a copy of the recorded events. */
+  std::vector<Event>
+  GetEvents() const;
+
+  /** Number of recorded events. */
+  SizeValueType
+  GetNumberOfEvents() const;
+
+  /** Removes the recorded events. */
+  void
+  Clear();
+
+  /** Writes the recorded events in the Chrome Trace Event format. */
+  /** @ITKStartGrouping */
+  void
+  WriteChromeTrace(std::ostream & os) const;
+  void
+  WriteChromeTrace(const std::string & fileName) const;
+  /** @ITKEndGrouping */
+
+  /** Time in microseconds since the construction of the tracer, and CPU time
+   * of the calling thread in microseconds. */
+  /** @ITKStartGrouping */
+  int64_t
+  GetTime() const;
+  static int64_t
+  GetThreadCPUTime();
+  /** @ITKEndGrouping */
+
+  /** Index of the calling thread, in the order of their first event. */
+  static unsigned int
+  GetThreadIndex();
+
+protected:
+  PipelineTracer();
+  ~PipelineTracer() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  itkGetGlobalDeclarationMacro(PipelineTracerGlobals, PimplGlobals);
+
+  std::vector<Event>                    m_Events{};
+  std::string                           m_TraceFileName{};
+  std::chrono::steady_clock::time_point m_StartTime{};
+  mutable std::mutex                    m_Mutex{};
+
+  static PipelineTracerGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
@@ -33,6 +33,8 @@
 
 namespace itk
 {
+struct PoolMultiThreaderGlobals;
+
 /** \class PoolMultiThreader
  * \brief A class for performing multithreaded execution with a thread
  * pool back end
@@ -82,7 +84,10 @@ public:
                    ArrayThreadingFunctorType aFunc,
                    ProcessObject *           filter) override;
 
-  /** Break up region into smaller chunks, and call the function with chunks as parameters. */
+  /** Break up region into smaller chunks, and call the function with chunks as parameters.
+   * When NumberOfPixelsPerTile is not zero, regions of more than NumberOfWorkUnits times
+   * NumberOfPixelsPerTile pixels are split into tiles of about NumberOfPixelsPerTile pixels, which the
+   * threads claim one after the other. */
   void
   ParallelizeImageRegion(unsigned int         dimension,
                          const IndexValueType index[],
@@ -95,6 +100,26 @@ public:
   void
   SetMaximumNumberOfThreads(ThreadIdType numberOfThreads) override;
 
+  /** Set/Get the number of pixels of the tiles processed by ParallelizeImageRegion. The tiles are made of
+   * whole scanlines when possible. Small tiles balance the load between the threads when the cost of the
+   * pixels varies, e.g. with masks or narrow bands, at the cost of more calls to the function. Zero splits
+   * the regions into NumberOfWorkUnits pieces. The default is GetGlobalDefaultNumberOfPixelsPerTile(). */
+  /** @ITKStartGrouping */
+  itkSetMacro(NumberOfPixelsPerTile, SizeValueType);
+  itkGetConstMacro(NumberOfPixelsPerTile, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the value which is used to initialize the NumberOfPixelsPerTile in the constructor, so that all
+   * the filters split their regions into tiles, e.g. with 16384. It is picked up from the
+   * ITK_GLOBAL_DEFAULT_NUMBER_OF_PIXELS_PER_TILE environment variable, and is zero otherwise. If
+   * SetGlobalDefaultNumberOfPixelsPerTile is ever used, its value is respected over the environment variable. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalDefaultNumberOfPixelsPerTile(SizeValueType numberOfPixelsPerTile);
+  static SizeValueType
+  GetGlobalDefaultNumberOfPixelsPerTile();
+  /** @ITKEndGrouping */
+
 #ifndef ITK_FUTURE_LEGACY_REMOVE
   struct ITK_FUTURE_DEPRECATED(
     "PoolMultiThreader now uses a slightly different private `InternalWorkUnitInfo` struct instead!")
@@ -124,6 +149,11 @@ private:
    *  to void so that user data can be passed to each thread. */
   InternalWorkUnitInfo m_ThreadInfoArray[ITK_MAX_THREADS]{};
 
+  SizeValueType m_NumberOfPixelsPerTile{ 0 };
+
+  itkGetGlobalDeclarationMacro(PoolMultiThreaderGlobals, PimplGlobals);
+  static PoolMultiThreaderGlobals * m_PimplGlobals;
+
   /** Friends of Multithreader.
    * ProcessObject is a friend so that it can call PrintSelf() on its
    * Multithreader. */
@@ -498,6 +498,27 @@ public:
   itkBooleanMacro(ReleaseDataBeforeUpdateFlag);
   /** @ITKEndGrouping */
 
+  /** Turn on/off the use of the PipelineResultCache. When on, and when the
+   * class of the process object provides a key by ComputeResultCacheKey(),
+   * the outputs are looked for in the cache before executing the process
+   * object, with a key computed from the type, the parameters and the
+   * content of the inputs of the process object, and are cached after the
+   * execution. The process object is then not executed again
+   * when it is updated with the same inputs and parameters, even if its
+   * modification time changed or if it was created again. Only the outputs
+   * which can be copied and hashed (e.g. images and simple decorators) are
+   * cached, and the results which the process object holds in other members
+   * are not restored. When no key is provided, the process object is
+   * executed as usual and a warning is displayed. Among the ITK filters,
+   * BinaryThresholdImageFilter, ThresholdImageFilter, MedianImageFilter and
+   * SmoothingRecursiveGaussianImageFilter provide a key. Default value is
+   * off. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseResultCache, bool);
+  itkGetConstMacro(UseResultCache, bool);
+  itkBooleanMacro(UseResultCache);
+  /** @ITKEndGrouping */
+
   /** Get/Set the number of work units to create when executing. */
   /** @ITKStartGrouping */
   itkVirtualSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
@@ -907,6 +928,28 @@ protected:
   virtual void
   RestoreInputReleaseDataFlags();
 
+  /** Computes the key identifying the outputs in the PipelineResultCache, or
+   * returns an empty string when the outputs must not be cached. The default
+   * implementation returns an empty string, so that only the process objects
+   * whose class opts in are cached: the override returns
+   * MakeResultCacheKey() of all the parameters affecting the outputs, or
+   * MakeResultCacheKeyFromPrintSelf() when PrintSelf() prints all of them. */
+  virtual std::string
+  ComputeResultCacheKey() const;
+
+  /** Hashes the type of the process object, the specified parameters and the
+   * content hash of each input into a key of the PipelineResultCache.
+   * Returns an empty string when the content of an input cannot be hashed. */
+  std::string
+  MakeResultCacheKey(const std::string & parameters) const;
+
+  /** Makes a key by MakeResultCacheKey() with the parameters printed by
+   * PrintSelf() below the ProcessObject ones. The floating point values are
+   * printed with max_digits10 digits, so that distinct values give distinct
+   * keys. */
+  std::string
+  MakeResultCacheKeyFromPrintSelf() const;
+
   /**
    * When true, the MultiThreader will report course grain progress. If set to false, a progress must be explicitly
    * updated in derived filters.
@@ -971,6 +1014,14 @@ protected:
 
 private:
   DataObjectIdentifierType MakeNameFromIndex(DataObjectPointerArraySizeType) const;
+
+  /** Grafts onto the outputs copies of the outputs found in the
+   * PipelineResultCache with the key. Returns false, without modifying the
+   * outputs, when they are not all found, or do not cover the requested
+   * regions. */
+  bool
+  GraftCachedOutputs(const std::string & key);
+
   DataObjectPointerArraySizeType
   MakeIndexFromName(const DataObjectIdentifierType &) const;
 
@@ -1014,6 +1065,8 @@ private:
   /** Memory management ivars */
   bool m_ReleaseDataBeforeUpdateFlag{};
 
+  bool m_UseResultCache{ false };
+
   /** Friends of ProcessObject */
   friend class DataObject;
 
@@ -100,12 +100,31 @@ public:
     return m_Component;
   }
   /** @ITKEndGrouping */
+
+  /** Graft the content of one decorator onto another: the contained object
+   * is copied when the DataObject is a decorator of the same type. */
+  /** @ITKStartGrouping */
+  void
+  Graft(const DataObject * data) override;
+  void
+  Graft(const Self * data);
+  /** @ITKEndGrouping */
+
+  /** Returns a new decorator holding a copy of the contained object. */
+  DataObject::Pointer
+  CreateDeepCopy() const override;
+
 protected:
   SimpleDataObjectDecorator() = default;
   ~SimpleDataObjectDecorator() override = default;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Hashes the bytes of the contained object when they represent its value
+   * (e.g. for arithmetic types), otherwise returns an empty string. */
+  std::string
+  ComputeContentHash() const override;
+
 protected:
 private:
   ComponentType m_Component{};
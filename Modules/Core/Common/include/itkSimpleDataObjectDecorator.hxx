@@ -29,6 +29,8 @@
 #define itkSimpleDataObjectDecorator_hxx
 
 #include "itkMath.h"
+#include <type_traits>
+#include <typeinfo>
 
 namespace itk
 {
@@ -47,6 +49,62 @@ SimpleDataObjectDecorator<T>::Set(const T & val)
   }
 }
 
+/**
+ *
+ */
+template <typename T>
+void
+SimpleDataObjectDecorator<T>::Graft(const DataObject * data)
+{
+  this->Graft(dynamic_cast<const Self *>(data));
+}
+
+/**
+ *
+ */
+template <typename T>
+void
+SimpleDataObjectDecorator<T>::Graft(const Self * data)
+{
+  if (data && data->m_Initialized)
+  {
+    this->m_Component = data->m_Component;
+    this->m_Initialized = true;
+    this->Modified();
+  }
+}
+
+/**
+ *
+ */
+template <typename T>
+DataObject::Pointer
+SimpleDataObjectDecorator<T>::CreateDeepCopy() const
+{
+  auto copy = Self::New();
+  copy->Graft(this);
+  return copy.GetPointer();
+}
+
+/**
+ *
+ */
+template <typename T>
+std::string
+SimpleDataObjectDecorator<T>::ComputeContentHash() const
+{
+  if constexpr (std::is_arithmetic_v<T> || std::has_unique_object_representations_v<T>)
+  {
+    std::string content = typeid(*this).name();
+    content.append(reinterpret_cast<const char *>(&m_Component), sizeof(m_Component));
+    return Self::HashBytes(content.data(), content.size());
+  }
+  else
+  {
+    return {};
+  }
+}
+
 /**
  *
  */
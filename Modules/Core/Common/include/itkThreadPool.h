@@ -21,10 +21,11 @@
 #include "itkConfigure.h"
 #include "itkIntTypes.h"
 
-#include <deque>
+#include <atomic>
 #include <functional>
 #include <future>
 #include <condition_variable>
+#include <memory>
 #include <thread>
 
 #include "itkObject.h"
@@ -41,9 +42,16 @@ namespace itk
  *
  * Thread pool is called and initialized from within the PoolMultiThreader.
  * Initially the thread pool is started with GlobalDefaultNumberOfThreads.
- * The jobs are submitted via AddWork method.
+ * The jobs are submitted via AddWork or AddDetachedWork methods.
  *
- * This implementation heavily borrows from:
+ * Every worker thread owns a work queue. Jobs submitted from a worker thread
+ * (nested parallelism) are pushed onto that worker's own queue, jobs submitted
+ * from any other thread are distributed round-robin over the worker queues.
+ * A worker takes jobs from the back of its own queue, and when that is empty
+ * it steals jobs from the front of the other workers' queues. This avoids
+ * funneling all submissions and all workers through a single lock.
+ *
+ * The original implementation heavily borrowed from:
  * https://github.com/progschj/ThreadPool
  *
  * \ingroup OSSystemObjects
@@ -92,14 +100,22 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
       [function, arguments...]() -> return_type { return function(arguments...); });
 
     std::future<return_type> res = task->get_future();
-    {
-      const std::lock_guard<std::mutex> lockGuard(this->GetMutex());
-      m_WorkQueue.emplace_back([task]() { (*task)(); });
-    }
-    m_Condition.notify_one();
+    this->AddDetachedWork([task]() { (*task)(); });
     return res;
   }
 
+  /** Add this job to the thread pool queue, without creating an std::future
+   * for it. The caller is responsible for synchronizing with the completion
+   * of the job. A job whose callable fits into the small buffer of
+   * std::function (e.g. a lambda capturing a pointer or a std::shared_ptr)
+   * is enqueued without any heap allocation. Exceptions must not escape the job. */
+  void
+  AddDetachedWork(std::function<void()> task);
+
+  /** Returns true if the calling thread is one of the threads of this pool. */
+  static bool
+  IsWorkerThread();
+
   /** Can call this method if we want to add extra threads to the pool. */
   void
   AddThreads(ThreadIdType count);
@@ -137,7 +153,7 @@ protected:
   void
   CleanUp();
 
-  ~ThreadPool() override { this->CleanUp(); }
+  ~ThreadPool() override;
 
   static void
   PrepareForFork();
@@ -148,13 +164,33 @@ private:
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(ThreadPoolGlobals, PimplGlobals);
 
-  /** This is a list of jobs submitted to the thread pool.
-   * This is the only place where the jobs are submitted.
-   * Filled by AddWork, emptied by ThreadExecute. */
-  std::deque<std::function<void()>> m_WorkQueue; // guarded by m_PimplGlobals->m_Mutex
+  /** Work queue owned by one worker thread, defined in the .cxx file. */
+  struct WorkerQueue;
+
+  /** Pops a job from the worker's own queue, or steals one from another
+   * worker's queue. Returns false if all queues are empty. */
+  bool
+  TryGetTask(ThreadIdType workerIndex, std::function<void()> & task);
+
+  /** The work queues, one per worker thread. Allocated once with
+   * ITK_MAX_THREADS entries so that AddThreads never relocates a queue that
+   * another thread is accessing. Filled by AddDetachedWork, emptied by ThreadExecute. */
+  std::unique_ptr<WorkerQueue[]> m_WorkQueues;
+
+  /** Number of queues which are owned by a running worker thread. */
+  std::atomic<ThreadIdType> m_NumberOfWorkQueues{ 0 };
+
+  /** Round-robin counter used to distribute jobs submitted by non-worker threads. */
+  std::atomic<ThreadIdType> m_NextWorkQueue{ 0 };
+
+  /** Total number of jobs in all the work queues. */
+  std::atomic<SizeValueType> m_NumberOfPendingTasks{ 0 };
+
+  /** Number of worker threads which are waiting on m_Condition. */
+  std::atomic<ThreadIdType> m_NumberOfSleepingThreads{ 0 };
 
   /** When a thread is idle, it is waiting on m_Condition.
-   * AddWork signals it to resume a (random) thread. */
+   * AddDetachedWork signals it to resume a (random) thread. */
   std::condition_variable m_Condition;
 
   /** Vector to hold all thread handles.
@@ -169,7 +205,7 @@ private:
 
   /** The continuously running thread function */
   static void
-  ThreadExecute();
+  ThreadExecute(ThreadIdType workerIndex);
 };
 
 } // namespace itk
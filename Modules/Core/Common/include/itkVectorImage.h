@@ -373,6 +373,19 @@ public:
   [[nodiscard]] unsigned int
   GetNumberOfComponentsPerPixel() const override;
 
+  /** Returns a new image with the information, the regions and a copy of
+   * the pixels of this one. */
+  DataObject::Pointer
+  CreateDeepCopy() const override;
+
+  /** Returns the number of bytes of the pixel buffer. */
+  SizeValueType
+  GetBulkDataNumberOfBytes() const override;
+
+  /** Returns the number of bytes of the pixels of the requested region. */
+  SizeValueType
+  GetRequestedBulkDataNumberOfBytes() const override;
+
   void
   SetNumberOfComponentsPerPixel(unsigned int n) override;
 
@@ -384,6 +397,11 @@ protected:
   ~VectorImage() override = default;
   void
   Graft(const DataObject * data) override;
+
+  /** Hashes the information and the pixels of the image. Returns an empty
+   * string for the pixel types which are not trivially copyable. */
+  std::string
+  ComputeContentHash() const override;
   using Superclass::Graft;
 
 private:
@@ -28,6 +28,8 @@
 #ifndef itkVectorImage_hxx
 #define itkVectorImage_hxx
 #include "itkProcessObject.h"
+#include "itkImageBufferAllocator.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -45,7 +47,17 @@ VectorImage<TPixel, VImageDimension>::Allocate(const bool UseValueInitialization
   this->ComputeOffsetTable();
   SizeValueType num = this->GetOffsetTable()[VImageDimension];
 
-  m_Buffer->Reserve(num * m_VectorLength, UseValueInitialization);
+  if (UseValueInitialization &&
+      ImageBufferAllocator::ShouldInitializeInParallel(num * m_VectorLength * sizeof(InternalPixelType)))
+  {
+    m_Buffer->Reserve(num * m_VectorLength, false);
+    ImageBufferAllocator::InitializeInParallel(
+      m_Buffer->GetBufferPointer(), this->GetBufferedRegion(), m_VectorLength);
+  }
+  else
+  {
+    m_Buffer->Reserve(num * m_VectorLength, UseValueInitialization);
+  }
 }
 
 template <typename TPixel, unsigned int VImageDimension>
@@ -134,6 +146,64 @@ VectorImage<TPixel, VImageDimension>::Graft(const DataObject * data)
   this->Graft(imgData);
 }
 
+//----------------------------------------------------------------------------
+template <typename TPixel, unsigned int VImageDimension>
+DataObject::Pointer
+VectorImage<TPixel, VImageDimension>::CreateDeepCopy() const
+{
+  LightObject::Pointer anotherObject = this->CreateAnother();
+  const Pointer        copy = dynamic_cast<Self *>(anotherObject.GetPointer());
+  if (copy.IsNull())
+  {
+    return nullptr;
+  }
+  copy->Graft(this);
+  if (m_Buffer)
+  {
+    auto container = PixelContainer::New();
+    container->Reserve(m_Buffer->Size(), false);
+    std::copy_n(m_Buffer->GetBufferPointer(), m_Buffer->Size(), container->GetBufferPointer());
+    copy->SetPixelContainer(container);
+  }
+  return copy.GetPointer();
+}
+
+//----------------------------------------------------------------------------
+template <typename TPixel, unsigned int VImageDimension>
+auto
+VectorImage<TPixel, VImageDimension>::GetBulkDataNumberOfBytes() const -> SizeValueType
+{
+  return m_Buffer ? static_cast<SizeValueType>(m_Buffer->Size() * sizeof(InternalPixelType)) : 0;
+}
+
+//----------------------------------------------------------------------------
+template <typename TPixel, unsigned int VImageDimension>
+auto
+VectorImage<TPixel, VImageDimension>::GetRequestedBulkDataNumberOfBytes() const -> SizeValueType
+{
+  return static_cast<SizeValueType>(this->GetRequestedRegion().GetNumberOfPixels() * m_VectorLength *
+                                    sizeof(InternalPixelType));
+}
+
+//----------------------------------------------------------------------------
+template <typename TPixel, unsigned int VImageDimension>
+std::string
+VectorImage<TPixel, VImageDimension>::ComputeContentHash() const
+{
+  if constexpr (std::is_trivially_copyable_v<InternalPixelType>)
+  {
+    if (m_Buffer)
+    {
+      return this->HashImageContent(m_Buffer->GetBufferPointer(), m_Buffer->Size() * sizeof(InternalPixelType));
+    }
+    return this->HashImageContent(nullptr, 0);
+  }
+  else
+  {
+    return {};
+  }
+}
+
 //----------------------------------------------------------------------------
 template <typename TPixel, unsigned int VImageDimension>
 unsigned int
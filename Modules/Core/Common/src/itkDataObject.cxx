@@ -27,6 +27,9 @@
  *=========================================================================*/
 #include "itkProcessObject.h"
 #include "itkSingleton.h"
+#include "itkMultiThreaderBase.h"
+#include "itksys/MD5.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -121,6 +124,7 @@ DataObject::Initialize()
   // We don't modify ourselves because the "ReleaseData" methods depend upon
   // no modification when initialized.
   //
+  m_ContentHash.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -374,6 +378,74 @@ DataObject::DataHasBeenGenerated()
   this->m_UpdateMTime.Modified();
 }
 
+//----------------------------------------------------------------------------
+std::string
+DataObject::GetContentHash() const
+{
+  const ModifiedTimeType time = std::max(this->GetMTime(), m_UpdateMTime.GetMTime());
+  if (m_ContentHash.empty() || m_ContentHashTime != time)
+  {
+    m_ContentHash = this->ComputeContentHash();
+    m_ContentHashTime = time;
+  }
+  return m_ContentHash;
+}
+
+void
+DataObject::SetContentHash(const std::string & hash)
+{
+  m_ContentHash = hash;
+  m_ContentHashTime = std::max(this->GetMTime(), m_UpdateMTime.GetMTime());
+}
+
+std::string
+DataObject::HashBytes(const void * buffer, size_t numberOfBytes)
+{
+  const auto hash = [](const void * bytes, size_t size) {
+    itksysMD5 * md5 = itksysMD5_New();
+    itksysMD5_Initialize(md5);
+    // itksysMD5_Append takes an int length
+    constexpr size_t maximumAppendSize = size_t{ 1 } << 30;
+    for (size_t offset = 0; offset < size; offset += maximumAppendSize)
+    {
+      itksysMD5_Append(md5,
+                       static_cast<const unsigned char *>(bytes) + offset,
+                       static_cast<int>(std::min(maximumAppendSize, size - offset)));
+    }
+    char hex[32];
+    itksysMD5_FinalizeHex(md5, hex);
+    itksysMD5_Delete(md5);
+    return std::string(hex, 32);
+  };
+
+  // Large buffers are hashed in blocks of fixed size, so the hash does not
+  // depend on the number of threads, and the hashes of the blocks are hashed
+  constexpr size_t blockSize = size_t{ 4 } << 20;
+  if (numberOfBytes <= 4 * blockSize)
+  {
+    return hash(buffer, numberOfBytes);
+  }
+  const size_t             numberOfBlocks = (numberOfBytes + blockSize - 1) / blockSize;
+  std::vector<std::string> blockHashes(numberOfBlocks);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      const size_t offset = block * blockSize;
+      blockHashes[block] =
+        hash(static_cast<const unsigned char *>(buffer) + offset, std::min(blockSize, numberOfBytes - offset));
+    },
+    nullptr);
+
+  std::string concatenated;
+  concatenated.reserve(32 * numberOfBlocks);
+  for (const std::string & blockHash : blockHashes)
+  {
+    concatenated += blockHash;
+  }
+  return hash(concatenated.data(), concatenated.size());
+}
+
 //----------------------------------------------------------------------------
 ModifiedTimeType
 DataObject::GetUpdateMTime() const
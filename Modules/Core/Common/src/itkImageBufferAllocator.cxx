@@ -0,0 +1,225 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_set>
+
+#if defined(_WIN32)
+#  include <malloc.h>
+#elif defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+
+struct ImageBufferAllocatorGlobals
+{
+  ImageBufferAllocatorGlobals() = default;
+
+  std::atomic<SizeValueType> m_Alignment{ 0 };
+  std::atomic<bool>          m_UseHugePages{ false };
+  std::atomic<bool>          m_ParallelInitialization{ false };
+
+  // The buffers which are currently allocated by Allocate().
+  std::mutex                       m_Mutex;
+  std::unordered_set<const void *> m_Buffers; // guarded by m_Mutex
+
+  // The size of m_Buffers, readable without locking m_Mutex.
+  std::atomic<SizeValueType> m_NumberOfBuffers{ 0 };
+};
+
+ImageBufferAllocatorGlobals *
+ImageBufferAllocator::GetPimplGlobalsPointer()
+{
+  if (m_PimplGlobals == nullptr)
+  {
+    // Unlike most globals, these are intentionally never deleted: the buffers of
+    // images which are destroyed during static destruction must still be
+    // recognized, so that they are released by the matching function.
+    m_PimplGlobals = Singleton<ImageBufferAllocatorGlobals>("ImageBufferAllocator", [] {});
+  }
+  return m_PimplGlobals;
+}
+
+void
+ImageBufferAllocator::SetGlobalDefaultAlignment(SizeValueType alignment)
+{
+  if ((alignment & (alignment - 1)) != 0)
+  {
+    itkGenericExceptionMacro("Alignment must be zero or a power of two, but it is " << alignment);
+  }
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_Alignment = alignment;
+}
+
+SizeValueType
+ImageBufferAllocator::GetGlobalDefaultAlignment()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Alignment;
+}
+
+void
+ImageBufferAllocator::SetGlobalDefaultUseHugePages(bool useHugePages)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_UseHugePages = useHugePages;
+}
+
+bool
+ImageBufferAllocator::GetGlobalDefaultUseHugePages()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_UseHugePages;
+}
+
+void
+ImageBufferAllocator::SetGlobalDefaultParallelInitialization(bool parallelInitialization)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_ParallelInitialization = parallelInitialization;
+}
+
+bool
+ImageBufferAllocator::GetGlobalDefaultParallelInitialization()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_ParallelInitialization;
+}
+
+bool
+ImageBufferAllocator::GetGlobalDefaultAllocatorEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Alignment > 0 || m_PimplGlobals->m_UseHugePages;
+}
+
+bool
+ImageBufferAllocator::ShouldInitializeInParallel(SizeValueType numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_ParallelInitialization && numberOfBytes >= LargeBufferSize;
+}
+
+void *
+ImageBufferAllocator::Allocate(SizeValueType numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const bool    hugePages = m_PimplGlobals->m_UseHugePages && numberOfBytes >= LargeBufferSize;
+  SizeValueType alignment = std::max<SizeValueType>(m_PimplGlobals->m_Alignment, alignof(std::max_align_t));
+  if (hugePages)
+  {
+    alignment = std::max(alignment, LargeBufferSize);
+  }
+
+  // Allocate at least one byte, so that every allocation has a unique address
+  const SizeValueType bytes = std::max<SizeValueType>(numberOfBytes, 1);
+  void *              buffer = nullptr;
+#if defined(_WIN32)
+  buffer = _aligned_malloc(bytes, alignment);
+#else
+  if (posix_memalign(&buffer, alignment, bytes) != 0)
+  {
+    buffer = nullptr;
+  }
+#endif
+  if (buffer == nullptr)
+  {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (hugePages)
+  {
+    // Only a hint: the kernel might not support transparent huge pages.
+    madvise(buffer, bytes, MADV_HUGEPAGE);
+  }
+#endif
+
+  try
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    m_PimplGlobals->m_Buffers.insert(buffer);
+    ++m_PimplGlobals->m_NumberOfBuffers;
+  }
+  catch (...)
+  {
+#if defined(_WIN32)
+    _aligned_free(buffer);
+#else
+    free(buffer);
+#endif
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+  return buffer;
+}
+
+bool
+ImageBufferAllocator::IsAllocated(const void * buffer)
+{
+  if (buffer == nullptr)
+  {
+    return false;
+  }
+  itkInitGlobalsMacro(PimplGlobals);
+  if (m_PimplGlobals->m_NumberOfBuffers == 0)
+  {
+    // The common case of an application which never enabled the allocator
+    return false;
+  }
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_Buffers.count(buffer) > 0;
+}
+
+bool
+ImageBufferAllocator::Deallocate(void * buffer)
+{
+  if (buffer == nullptr)
+  {
+    return false;
+  }
+  itkInitGlobalsMacro(PimplGlobals);
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    if (m_PimplGlobals->m_Buffers.erase(buffer) == 0)
+    {
+      return false;
+    }
+    --m_PimplGlobals->m_NumberOfBuffers;
+  }
+#if defined(_WIN32)
+  _aligned_free(buffer);
+#else
+  free(buffer);
+#endif
+  return true;
+}
+
+ImageBufferAllocatorGlobals * ImageBufferAllocator::m_PimplGlobals;
+
+} // namespace itk
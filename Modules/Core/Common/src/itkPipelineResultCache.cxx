@@ -0,0 +1,220 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineResultCache.h"
+#include "itkSingleton.h"
+
+namespace itk
+{
+
+struct PipelineResultCacheGlobals
+{
+  PipelineResultCache::Pointer m_Instance{ nullptr };
+  std::recursive_mutex         m_StaticInstanceLock;
+};
+
+namespace
+{
+// Copies of the outputs, or an empty map if one of them cannot be copied
+PipelineResultCache::OutputsType
+CopyOutputs(const PipelineResultCache::OutputsType & outputs)
+{
+  PipelineResultCache::OutputsType copies;
+  for (const auto & [name, output] : outputs)
+  {
+    DataObject::Pointer copy = output ? output->CreateDeepCopy() : nullptr;
+    if (copy.IsNull())
+    {
+      return {};
+    }
+    copies[name] = copy;
+  }
+  return copies;
+}
+} // namespace
+
+PipelineResultCache::PipelineResultCache() = default;
+
+PipelineResultCache::~PipelineResultCache() = default;
+
+PipelineResultCache::Pointer
+PipelineResultCache::GetInstance()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::recursive_mutex> lockGuard(m_PimplGlobals->m_StaticInstanceLock);
+  if (!m_PimplGlobals->m_Instance)
+  {
+    m_PimplGlobals->m_Instance = new PipelineResultCache;
+    // Remove extra reference from construction.
+    m_PimplGlobals->m_Instance->UnRegister();
+  }
+  return m_PimplGlobals->m_Instance;
+}
+
+itkGetGlobalSimpleMacro(PipelineResultCache, PipelineResultCacheGlobals, PimplGlobals);
+
+PipelineResultCacheGlobals * PipelineResultCache::m_PimplGlobals;
+
+PipelineResultCache::Pointer
+PipelineResultCache::New()
+{
+  return GetInstance();
+}
+
+void
+PipelineResultCache::SetMaximumNumberOfBytes(SizeValueType numberOfBytes)
+{
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    if (m_MaximumNumberOfBytes == numberOfBytes)
+    {
+      return;
+    }
+    m_MaximumNumberOfBytes = numberOfBytes;
+    this->ReleaseEntries(numberOfBytes);
+  }
+  this->Modified();
+}
+
+SizeValueType
+PipelineResultCache::GetMaximumNumberOfBytes() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_MaximumNumberOfBytes;
+}
+
+PipelineResultCache::OutputsType
+PipelineResultCache::Find(const std::string & key)
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  const auto                        found = m_Entries.find(key);
+  if (found == m_Entries.end())
+  {
+    ++m_NumberOfMisses;
+    return {};
+  }
+  ++m_NumberOfHits;
+  m_LeastRecentlyUsedKeys.splice(
+    m_LeastRecentlyUsedKeys.end(), m_LeastRecentlyUsedKeys, found->second.LeastRecentlyUsedPosition);
+  return found->second.Outputs;
+}
+
+void
+PipelineResultCache::Insert(const std::string & key, const OutputsType & outputs)
+{
+  SizeValueType numberOfBytes = 0;
+  for (const auto & output : outputs)
+  {
+    if (output.second)
+    {
+      numberOfBytes += output.second->GetBulkDataNumberOfBytes();
+    }
+  }
+  if (key.empty() || outputs.empty() || numberOfBytes > this->GetMaximumNumberOfBytes())
+  {
+    return;
+  }
+
+  OutputsType copies = CopyOutputs(outputs);
+  if (copies.empty())
+  {
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  if (numberOfBytes > m_MaximumNumberOfBytes)
+  {
+    return;
+  }
+  // Outputs cached with the same key, e.g. for another requested region, are replaced
+  const auto found = m_Entries.find(key);
+  if (found != m_Entries.end())
+  {
+    m_NumberOfBytes -= found->second.NumberOfBytes;
+    m_LeastRecentlyUsedKeys.erase(found->second.LeastRecentlyUsedPosition);
+    m_Entries.erase(found);
+  }
+  this->ReleaseEntries(m_MaximumNumberOfBytes - numberOfBytes);
+  m_LeastRecentlyUsedKeys.push_back(key);
+  m_Entries[key] = Entry{ std::move(copies), numberOfBytes, std::prev(m_LeastRecentlyUsedKeys.end()) };
+  m_NumberOfBytes += numberOfBytes;
+}
+
+void
+PipelineResultCache::Clear()
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  m_Entries.clear();
+  m_LeastRecentlyUsedKeys.clear();
+  m_NumberOfBytes = 0;
+  m_NumberOfHits = 0;
+  m_NumberOfMisses = 0;
+}
+
+void
+PipelineResultCache::ReleaseEntries(SizeValueType numberOfBytes)
+{
+  while (m_NumberOfBytes > numberOfBytes && !m_LeastRecentlyUsedKeys.empty())
+  {
+    const auto found = m_Entries.find(m_LeastRecentlyUsedKeys.front());
+    m_NumberOfBytes -= found->second.NumberOfBytes;
+    m_Entries.erase(found);
+    m_LeastRecentlyUsedKeys.pop_front();
+  }
+}
+
+SizeValueType
+PipelineResultCache::GetNumberOfEntries() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return static_cast<SizeValueType>(m_Entries.size());
+}
+
+SizeValueType
+PipelineResultCache::GetNumberOfBytes() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_NumberOfBytes;
+}
+
+SizeValueType
+PipelineResultCache::GetNumberOfHits() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_NumberOfHits;
+}
+
+SizeValueType
+PipelineResultCache::GetNumberOfMisses() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_NumberOfMisses;
+}
+
+void
+PipelineResultCache::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  os << indent << "MaximumNumberOfBytes: " << m_MaximumNumberOfBytes << std::endl;
+  os << indent << "NumberOfEntries: " << m_Entries.size() << std::endl;
+  os << indent << "NumberOfBytes: " << m_NumberOfBytes << std::endl;
+  os << indent << "NumberOfHits: " << m_NumberOfHits << std::endl;
+  os << indent << "NumberOfMisses: " << m_NumberOfMisses << std::endl;
+}
+} // end namespace itk
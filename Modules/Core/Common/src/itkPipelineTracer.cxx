@@ -0,0 +1,339 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineTracer.h"
+#include "itkProcessObject.h"
+#include "itkSingleton.h"
+#include "itksys/SystemTools.hxx"
+#include <atomic>
+#include <fstream>
+#include <set>
+
+#if defined(WIN32) || defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <ctime>
+#endif // defined(WIN32) || defined(_WIN32)
+
+namespace itk
+{
+
+struct PipelineTracerGlobals
+{
+  PipelineTracer::Pointer   m_Instance{ nullptr };
+  std::recursive_mutex      m_StaticInstanceLock;
+  std::atomic<bool>         m_Enabled{ itksys::SystemTools::HasEnv("ITK_PIPELINE_TRACE_FILE") };
+  std::atomic<unsigned int> m_NumberOfThreads{ 0 };
+};
+
+namespace
+{
+// Writes the string as a JSON string
+void
+WriteJSONString(std::ostream & os, const std::string & value)
+{
+  os << '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          os << ' ';
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+} // namespace
+
+PipelineTracer::PipelineTracer()
+  : m_StartTime(std::chrono::steady_clock::now())
+{
+  itksys::SystemTools::GetEnv("ITK_PIPELINE_TRACE_FILE", m_TraceFileName);
+}
+
+PipelineTracer::~PipelineTracer()
+{
+  if (!m_TraceFileName.empty())
+  {
+    std::ofstream file(m_TraceFileName);
+    if (file)
+    {
+      this->WriteChromeTrace(file);
+    }
+  }
+}
+
+PipelineTracer::Pointer
+PipelineTracer::GetInstance()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::recursive_mutex> lockGuard(m_PimplGlobals->m_StaticInstanceLock);
+  if (!m_PimplGlobals->m_Instance)
+  {
+    m_PimplGlobals->m_Instance = new PipelineTracer;
+    // Remove extra reference from construction.
+    m_PimplGlobals->m_Instance->UnRegister();
+  }
+  return m_PimplGlobals->m_Instance;
+}
+
+itkGetGlobalSimpleMacro(PipelineTracer, PipelineTracerGlobals, PimplGlobals);
+
+PipelineTracerGlobals * PipelineTracer::m_PimplGlobals;
+
+PipelineTracer::Pointer
+PipelineTracer::New()
+{
+  return GetInstance();
+}
+
+void
+PipelineTracer::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_Enabled = enabled;
+}
+
+bool
+PipelineTracer::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled.load(std::memory_order_relaxed);
+}
+
+void
+PipelineTracer::AddEvent(Event event)
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  m_Events.push_back(std::move(event));
+}
+
+std::vector<PipelineTracer::Event>
+PipelineTracer::GetEvents() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_Events;
+}
+
+SizeValueType
+PipelineTracer::GetNumberOfEvents() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_Events.size();
+}
+
+void
+PipelineTracer::Clear()
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  m_Events.clear();
+}
+
+void
+PipelineTracer::WriteChromeTrace(std::ostream & os) const
+{
+  const std::vector<Event> events = this->GetEvents();
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  std::set<unsigned int> threadIndices;
+  const char *           separator = "\n";
+  for (const Event & event : events)
+  {
+    os << separator << "{\"name\":";
+    WriteJSONString(os, event.Name);
+    os << ",\"cat\":";
+    WriteJSONString(os, event.Category);
+    os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.ThreadIndex << ",\"ts\":" << event.StartTime
+       << ",\"dur\":" << event.Duration << ",\"tdur\":" << event.CPUDuration << ",\"args\":{\"cpu_us\":"
+       << event.CPUDuration;
+    if (!event.Arguments.empty())
+    {
+      os << ',' << event.Arguments;
+    }
+    os << "}}";
+    threadIndices.insert(event.ThreadIndex);
+    separator = ",\n";
+  }
+
+  // Names the threads, the thread of index 0 being the first one to record an event
+  for (const unsigned int threadIndex : threadIndices)
+  {
+    os << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadIndex
+       << ",\"args\":{\"name\":\"ITK thread " << threadIndex << "\"}}";
+    separator = ",\n";
+  }
+  os << "\n]}\n";
+}
+
+void
+PipelineTracer::WriteChromeTrace(const std::string & fileName) const
+{
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    itkExceptionMacro("Cannot open " << fileName << " for writing.");
+  }
+  this->WriteChromeTrace(file);
+  if (!file)
+  {
+    itkExceptionMacro("Cannot write the trace to " << fileName << '.');
+  }
+}
+
+int64_t
+PipelineTracer::GetTime() const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_StartTime).count();
+}
+
+int64_t
+PipelineTracer::GetThreadCPUTime()
+{
+#if defined(WIN32) || defined(_WIN32)
+  FILETIME creationTime;
+  FILETIME exitTime;
+  FILETIME kernelTime;
+  FILETIME userTime;
+  if (!::GetThreadTimes(::GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+  {
+    return 0;
+  }
+  // Converts a FILETIME, in intervals of 100 nanoseconds, to microseconds.
+  const auto convertToMicroseconds = [](const FILETIME fileTime) {
+    return static_cast<int64_t>((uint64_t{ fileTime.dwHighDateTime } << 32 | uint64_t{ fileTime.dwLowDateTime }) / 10);
+  };
+  return convertToMicroseconds(kernelTime) + convertToMicroseconds(userTime);
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+  {
+    return 0;
+  }
+  return int64_t{ time.tv_sec } * 1000000 + time.tv_nsec / 1000;
+#else
+  return 0;
+#endif
+}
+
+unsigned int
+PipelineTracer::GetThreadIndex()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  thread_local const unsigned int threadIndex = m_PimplGlobals->m_NumberOfThreads++;
+  return threadIndex;
+}
+
+void
+PipelineTracer::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Enabled: " << (GetEnabled() ? "On" : "Off") << std::endl;
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << std::endl;
+  os << indent << "TraceFileName: " << m_TraceFileName << std::endl;
+}
+
+PipelineTracer::Scope::Scope(const char * category, const ProcessObject * processObject)
+  : m_Category(category)
+  , m_ProcessObject(processObject)
+  , m_Enabled(PipelineTracer::GetEnabled())
+{
+  if (m_Enabled)
+  {
+    m_StartTime = PipelineTracer::GetInstance()->GetTime();
+    m_StartCPUTime = PipelineTracer::GetThreadCPUTime();
+  }
+}
+
+PipelineTracer::Scope::~Scope()
+{
+  if (!m_Enabled)
+  {
+    return;
+  }
+  const int64_t cpuTime = PipelineTracer::GetThreadCPUTime();
+  const auto    tracer = PipelineTracer::GetInstance();
+
+  Event event;
+  event.Name = m_ProcessObject ? m_ProcessObject->GetNameOfClass() : m_Category;
+  event.Category = m_Category;
+  event.Arguments = std::move(m_Arguments);
+  event.StartTime = m_StartTime;
+  event.Duration = tracer->GetTime() - m_StartTime;
+  event.CPUDuration = cpuTime - m_StartCPUTime;
+  event.ThreadIndex = PipelineTracer::GetThreadIndex();
+  if (m_ProcessObject && !m_ProcessObject->GetObjectName().empty())
+  {
+    std::ostringstream name;
+    WriteJSONString(name, m_ProcessObject->GetObjectName());
+    event.Arguments += (event.Arguments.empty() ? "\"object\":" : ",\"object\":") + name.str();
+  }
+  tracer->AddEvent(std::move(event));
+}
+
+void
+PipelineTracer::Scope::SetRegion(unsigned int dimension, const IndexValueType index[], const SizeValueType size[])
+{
+  if (!m_Enabled)
+  {
+    return;
+  }
+  std::ostringstream arguments;
+  SizeValueType      numberOfPixels = 1;
+  arguments << "\"index\":[";
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    arguments << (d > 0 ? "," : "") << index[d];
+    numberOfPixels *= size[d];
+  }
+  arguments << "],\"size\":[";
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    arguments << (d > 0 ? "," : "") << size[d];
+  }
+  arguments << "],\"pixels\":" << numberOfPixels;
+  m_Arguments = arguments.str();
+}
+
+void
+PipelineTracer::Scope::SetNumberOfBytes(SizeValueType numberOfBytes)
+{
+  if (m_Enabled)
+  {
+    m_Arguments = "\"bytes\":" + std::to_string(numberOfBytes);
+  }
+}
+} // end namespace itk
@@ -29,10 +29,19 @@
 #include "itkNumericTraits.h"
 #include "itkProcessObject.h"
 #include "itkImageSourceCommon.h"
+#include "itkSingleton.h"
+#include "itksys/SystemTools.hxx"
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <condition_variable>
 #include <exception>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <string>
+#include <vector>
 
 namespace itk
 {
@@ -74,11 +83,245 @@ public:
 private:
   std::exception_ptr m_FirstCaughtException;
 };
+
+// A parallel section splits the work into a number of chunks. The calling
+// thread and up to one helper job per pool thread claim chunks from a shared
+// atomic counter, so a thread which finishes early simply takes the next
+// chunk instead of idling. The section is shared with the helper jobs by
+// std::shared_ptr, so helper jobs which only start after all the chunks are
+// done can still safely find out that there is nothing left for them to do.
+class ParallelSection
+{
+public:
+  ParallelSection(ThreadIdType numberOfChunks, std::function<void(ThreadIdType)> chunkFunction)
+    : m_NumberOfChunks(numberOfChunks)
+    , m_ChunkFunction(std::move(chunkFunction))
+  {}
+
+  /** Claims and processes one chunk. Returns false if all chunks were already claimed. */
+  bool
+  ProcessNextChunk()
+  {
+    const ThreadIdType chunk = m_NextChunk++;
+    if (chunk >= m_NumberOfChunks)
+    {
+      return false;
+    }
+    try
+    {
+      m_ChunkFunction(chunk);
+    }
+    catch (...)
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+      if (m_FirstCaughtException == nullptr)
+      {
+        m_FirstCaughtException = std::current_exception();
+      }
+    }
+    if (++m_NumberOfCompletedChunks == m_NumberOfChunks)
+    {
+      {
+        const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+      }
+      m_Condition.notify_all();
+    }
+    return true;
+  }
+
+  /** Processes chunks until all of them are claimed. Executed by the helper jobs. */
+  void
+  ProcessChunks()
+  {
+    while (this->ProcessNextChunk())
+    {
+    }
+  }
+
+  /** Waits until all the chunks are completed, or the timeout expires.
+   * Returns the number of completed chunks. */
+  ThreadIdType
+  WaitForCompletion(std::chrono::milliseconds timeout)
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Condition.wait_for(lock, timeout, [this] { return m_NumberOfCompletedChunks.load() == m_NumberOfChunks; });
+    return m_NumberOfCompletedChunks.load();
+  }
+
+  void
+  RethrowFirstCaughtException()
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    if (m_FirstCaughtException != nullptr)
+    {
+      std::rethrow_exception(m_FirstCaughtException);
+    }
+  }
+
+  ThreadIdType
+  GetNumberOfChunks() const
+  {
+    return m_NumberOfChunks;
+  }
+
+private:
+  const ThreadIdType                      m_NumberOfChunks;
+  const std::function<void(ThreadIdType)> m_ChunkFunction;
+  std::atomic<ThreadIdType>               m_NextChunk{ 0 };
+  std::atomic<ThreadIdType>               m_NumberOfCompletedChunks{ 0 };
+  std::mutex                              m_Mutex;
+  std::condition_variable                 m_Condition;
+  std::exception_ptr                      m_FirstCaughtException; // guarded by m_Mutex
+};
+
+// Processes all the chunks of the section, using the calling thread and the thread pool.
+// Progress is reported and exceptions are rethrown on the calling thread.
+void
+ExecuteParallelSection(const std::shared_ptr<ParallelSection> & section,
+                       ThreadPool &                             threadPool,
+                       ThreadIdType                             maximumNumberOfThreads,
+                       ProcessObject *                          filter)
+{
+  const ThreadIdType chunkCount = section->GetNumberOfChunks();
+
+  // One helper job per pool thread is enough, as each of them processes chunks until none are left.
+  // The helper jobs only capture a std::shared_ptr, so enqueueing them does not allocate.
+  const ThreadIdType helperCount = std::min<ThreadIdType>(chunkCount - 1, maximumNumberOfThreads);
+  for (ThreadIdType i = 0; i < helperCount; ++i)
+  {
+    threadPool.AddDetachedWork([section] { section->ProcessChunks(); });
+  }
+
+  ProgressReporter reporter(filter, 0, chunkCount);
+  ExceptionHandler exceptionHandler;
+  ThreadIdType     reportedChunks = 0;
+
+  // execute this thread's share, which might be all of the chunks when the pool is busy
+  while (section->ProcessNextChunk())
+  {
+    exceptionHandler.TryAndCatch([&reporter] { reporter.CompletedPixel(); });
+    ++reportedChunks;
+  }
+
+  // now wait for the other computations to finish
+  ThreadIdType completedChunks = 0;
+  do
+  {
+    completedChunks = section->WaitForCompletion(threadCompletionPollingInterval);
+    for (; reportedChunks < completedChunks; ++reportedChunks)
+    {
+      exceptionHandler.TryAndCatch([&reporter] { reporter.CompletedPixel(); });
+    }
+    if (filter && completedChunks < chunkCount)
+    {
+      exceptionHandler.TryAndCatch([filter] { filter->IncrementProgress(0); });
+    }
+  } while (completedChunks < chunkCount);
+
+  section->RethrowFirstCaughtException();
+  exceptionHandler.RethrowFirstCaughtException();
+}
+
+// Tiles of the region, of at most numberOfPixelsPerTile pixels when possible. The tiles are made of whole
+// scanlines, and are split along the outermost dimensions first, so each tile is as contiguous in memory as
+// possible. Consecutive tiles are consecutive in memory.
+class RegionTiling
+{
+public:
+  RegionTiling(const ImageIORegion & region, SizeValueType numberOfPixelsPerTile)
+    : m_Region(region)
+    , m_TileSize(region.GetSize())
+    , m_NumberOfTiles(region.GetImageDimension(), 1)
+  {
+    const unsigned int dimension = region.GetImageDimension();
+    numberOfPixelsPerTile = std::max<SizeValueType>(numberOfPixelsPerTile, 1);
+    SizeValueType tilePixels = region.GetNumberOfPixels();
+    for (unsigned int d = dimension - 1; d < dimension && tilePixels > numberOfPixelsPerTile; --d)
+    {
+      // Scanlines are only split in one dimensional regions
+      if (d == 0 && dimension > 1)
+      {
+        break;
+      }
+      const SizeValueType innerPixels = tilePixels / m_TileSize[d];
+      m_TileSize[d] = std::max<SizeValueType>(numberOfPixelsPerTile / innerPixels, 1);
+      m_NumberOfTiles[d] = (region.GetSize(d) + m_TileSize[d] - 1) / m_TileSize[d];
+      tilePixels = innerPixels * m_TileSize[d];
+    }
+  }
+
+  SizeValueType
+  GetNumberOfTiles() const
+  {
+    return std::accumulate(
+      m_NumberOfTiles.begin(), m_NumberOfTiles.end(), SizeValueType{ 1 }, std::multiplies<SizeValueType>());
+  }
+
+  ImageIORegion
+  GetTile(SizeValueType tile) const
+  {
+    ImageIORegion tileRegion = m_Region;
+    for (unsigned int d = 0; d < m_Region.GetImageDimension(); ++d)
+    {
+      const SizeValueType tileIndex = tile % m_NumberOfTiles[d];
+      tile /= m_NumberOfTiles[d];
+      const SizeValueType offset = tileIndex * m_TileSize[d];
+      tileRegion.SetIndex(d, m_Region.GetIndex(d) + static_cast<IndexValueType>(offset));
+      tileRegion.SetSize(d, std::min(m_TileSize[d], m_Region.GetSize(d) - offset));
+    }
+    return tileRegion;
+  }
+
+private:
+  const ImageIORegion        m_Region;
+  std::vector<SizeValueType> m_TileSize;
+  std::vector<SizeValueType> m_NumberOfTiles;
+};
 } // namespace
 
 
+struct PoolMultiThreaderGlobals
+{
+  std::mutex    m_Mutex;
+  bool          m_GlobalDefaultNumberOfPixelsPerTileIsInitialized{ false };
+  SizeValueType m_GlobalDefaultNumberOfPixelsPerTile{ 0 };
+};
+
+itkGetGlobalSimpleMacro(PoolMultiThreader, PoolMultiThreaderGlobals, PimplGlobals);
+PoolMultiThreaderGlobals * PoolMultiThreader::m_PimplGlobals;
+
+void
+PoolMultiThreader::SetGlobalDefaultNumberOfPixelsPerTile(SizeValueType numberOfPixelsPerTile)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_GlobalDefaultNumberOfPixelsPerTile = numberOfPixelsPerTile;
+  m_PimplGlobals->m_GlobalDefaultNumberOfPixelsPerTileIsInitialized = true;
+}
+
+SizeValueType
+PoolMultiThreader::GetGlobalDefaultNumberOfPixelsPerTile()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  if (!m_PimplGlobals->m_GlobalDefaultNumberOfPixelsPerTileIsInitialized)
+  {
+    std::string envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_NUMBER_OF_PIXELS_PER_TILE", envVar))
+    {
+      m_PimplGlobals->m_GlobalDefaultNumberOfPixelsPerTile =
+        static_cast<SizeValueType>(std::strtoull(envVar.c_str(), nullptr, 10));
+    }
+    m_PimplGlobals->m_GlobalDefaultNumberOfPixelsPerTileIsInitialized = true;
+  }
+  return m_PimplGlobals->m_GlobalDefaultNumberOfPixelsPerTile;
+}
+
 PoolMultiThreader::PoolMultiThreader()
   : m_ThreadPool(ThreadPool::GetInstance())
+  , m_NumberOfPixelsPerTile(GetGlobalDefaultNumberOfPixelsPerTile())
 {
   for (ThreadIdType i = 0; i < ITK_MAX_THREADS; ++i)
   {
@@ -171,47 +414,19 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
       ++chunkSize; // we want slightly bigger chunks to be processed first
     }
 
-    auto lambda = [aFunc](SizeValueType start, SizeValueType end) {
-      for (SizeValueType ii = start; ii < end; ++ii)
-      {
-        aFunc(ii);
-      }
-    };
-
-    SizeValueType workUnit = 1;
-    for (SizeValueType i = firstIndex + chunkSize; i < lastIndexPlus1; i += chunkSize)
-    {
-      m_ThreadInfoArray[workUnit++].Future = m_ThreadPool->AddWork(lambda, i, std::min(i + chunkSize, lastIndexPlus1));
-    }
-    itkAssertOrThrowMacro(workUnit <= m_NumberOfWorkUnits, "Number of work units was somehow miscounted!");
-
-    ProgressReporter reporter(filter, 0, workUnit);
-
-    // execute this thread's share
-    ExceptionHandler exceptionHandler;
-    exceptionHandler.TryAndCatch([lambda, firstIndex, chunkSize, &reporter] {
-      lambda(firstIndex, firstIndex + chunkSize);
-      reporter.CompletedPixel();
-    });
+    const auto chunkCount = static_cast<ThreadIdType>((lastIndexPlus1 - firstIndex + chunkSize - 1) / chunkSize);
+    itkAssertOrThrowMacro(chunkCount <= m_NumberOfWorkUnits, "Number of work units was somehow miscounted!");
 
-    // now wait for the other computations to finish
-    for (SizeValueType i = 1; i < workUnit; ++i)
-    {
-      exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-        std::future_status status;
-        do
+    auto section = std::make_shared<ParallelSection>(
+      chunkCount, [&aFunc, firstIndex, lastIndexPlus1, chunkSize](ThreadIdType chunk) {
+        const SizeValueType start = firstIndex + chunk * chunkSize;
+        const SizeValueType end = std::min(start + chunkSize, lastIndexPlus1);
+        for (SizeValueType ii = start; ii < end; ++ii)
         {
-          status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-          if (filter && status == std::future_status::timeout)
-          {
-            filter->IncrementProgress(0);
-          }
-        } while (status != std::future_status::ready);
-        reporter.CompletedPixel();
+          aFunc(ii);
+        }
       });
-    }
-
-    exceptionHandler.RethrowFirstCaughtException();
+    ExecuteParallelSection(section, *m_ThreadPool, m_MaximumNumberOfThreads, filter);
   }
   else if (firstIndex + 1 == lastIndexPlus1)
   {
@@ -250,58 +465,32 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
     {
       funcP(index, size); // process whole region
     }
+    else if (const RegionTiling tiling(region, m_NumberOfPixelsPerTile);
+             m_NumberOfPixelsPerTile > 0 && tiling.GetNumberOfTiles() > m_NumberOfWorkUnits &&
+             tiling.GetNumberOfTiles() <= NumericTraits<ThreadIdType>::max())
+    {
+      // Many more tiles than threads: the threads which process cheap tiles take more of them
+      const auto processTile = [&funcP, &tiling](ThreadIdType tile) {
+        const ImageIORegion tileRegion = tiling.GetTile(tile);
+        funcP(&tileRegion.GetIndex()[0], &tileRegion.GetSize()[0]);
+      };
+      auto section =
+        std::make_shared<ParallelSection>(static_cast<ThreadIdType>(tiling.GetNumberOfTiles()), processTile);
+      ExecuteParallelSection(section, *m_ThreadPool, m_MaximumNumberOfThreads, filter);
+    }
     else
     {
       const ImageRegionSplitterBase * splitter = ImageSourceCommon::GetGlobalDefaultSplitter();
       const ThreadIdType              splitCount = splitter->GetNumberOfSplits(region, m_NumberOfWorkUnits);
-      ProgressReporter                reporter(filter, 0, splitCount);
       itkAssertOrThrowMacro(splitCount <= m_NumberOfWorkUnits, "Split count is greater than number of work units!");
-      ImageIORegion iRegion;
-      ThreadIdType  total = 0;
-      for (ThreadIdType i = 1; i < splitCount; ++i)
-      {
-        iRegion = region;
-        total = splitter->GetSplit(i, splitCount, iRegion);
-        if (i < total)
-        {
-          m_ThreadInfoArray[i].Future =
-            m_ThreadPool->AddWork([funcP, iRegion]() { funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]); });
-        }
-        else
-        {
-          itkExceptionMacro("Could not get work unit "
-                            << i << " even though we checked possible number of splits beforehand!");
-        }
-      }
-      iRegion = region;
-      splitter->GetSplit(0, splitCount, iRegion);
-
-      // execute this thread's share
-      ExceptionHandler exceptionHandler;
-      exceptionHandler.TryAndCatch([funcP, iRegion, &reporter] {
-        funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
-        reporter.CompletedPixel();
-      });
 
-      // now wait for the other computations to finish
-      for (ThreadIdType i = 1; i < splitCount; ++i)
-      {
-        exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-          std::future_status status;
-          do
-          {
-            status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-            if (filter && status == std::future_status::timeout)
-            {
-              filter->IncrementProgress(0);
-            }
-          } while (status != std::future_status::ready);
-          m_ThreadInfoArray[i].Future.get();
-          reporter.CompletedPixel();
+      auto section =
+        std::make_shared<ParallelSection>(splitCount, [&funcP, &region, splitter, splitCount](ThreadIdType split) {
+          ImageIORegion iRegion = region;
+          splitter->GetSplit(split, splitCount, iRegion);
+          funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
         });
-      }
-
-      exceptionHandler.RethrowFirstCaughtException();
+      ExecuteParallelSection(section, *m_ThreadPool, m_MaximumNumberOfThreads, filter);
     }
   }
 }
@@ -310,6 +499,10 @@ void
 PoolMultiThreader::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfPixelsPerTile: " << m_NumberOfPixelsPerTile << std::endl;
+  os << indent << "GlobalDefaultNumberOfPixelsPerTile: " << m_PimplGlobals->m_GlobalDefaultNumberOfPixelsPerTile
+     << std::endl;
 }
 
 } // namespace itk
@@ -31,7 +31,11 @@
 #include <cstdio>
 #include <sstream>
 #include <algorithm>
+#include <limits>
 #include "itkMultiThreaderBase.h"
+#include "itkPipelineResultCache.h"
+#include "itkPipelineTracer.h"
+#include <typeinfo>
 
 namespace itk
 {
@@ -1261,6 +1265,7 @@ ProcessObject::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "NumberOfRequiredOutputs: " << m_NumberOfRequiredOutputs << std::endl;
   os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
   itkPrintSelfBooleanMacro(ReleaseDataBeforeUpdateFlag);
+  itkPrintSelfBooleanMacro(UseResultCache);
   itkPrintSelfBooleanMacro(AbortGenerateData);
   os << indent << "Progress: " << progressFixedToFloat(m_Progress) << std::endl;
   os << indent << "Multithreader: " << std::endl;
@@ -1679,9 +1684,38 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
   m_AbortGenerateData = false;
   m_Progress = 0u;
 
+  std::string resultCacheKey;
   try
   {
-    this->GenerateData();
+    if (m_UseResultCache)
+    {
+      resultCacheKey = this->ComputeResultCacheKey();
+      if (resultCacheKey.empty())
+      {
+        itkWarningMacro("UseResultCache is on, but the outputs are not cached: the class does not provide a key by "
+                        "ComputeResultCacheKey(), or the content of an input cannot be hashed.");
+      }
+    }
+    if (resultCacheKey.empty() || !this->GraftCachedOutputs(resultCacheKey))
+    {
+      {
+        PipelineTracer::Scope scope("GenerateData", this);
+        this->GenerateData();
+        if (PipelineTracer::GetEnabled())
+        {
+          SizeValueType numberOfBytes = 0;
+          for (const auto & output : m_Outputs)
+          {
+            numberOfBytes += output.second ? output.second->GetBulkDataNumberOfBytes() : 0;
+          }
+          scope.SetNumberOfBytes(numberOfBytes);
+        }
+      }
+      if (!resultCacheKey.empty() && !m_AbortGenerateData)
+      {
+        PipelineResultCache::GetInstance()->Insert(resultCacheKey, m_Outputs);
+      }
+    }
   }
   catch (const ProcessAborted &)
   {
@@ -1720,6 +1754,13 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
     if (output.second)
     {
       output.second->DataHasBeenGenerated();
+      // The content of the outputs is identified by the inputs and the
+      // parameters, so the downstream process objects do not hash it
+      if (!resultCacheKey.empty() && !m_AbortGenerateData)
+      {
+        const std::string outputKey = resultCacheKey + output.first;
+        output.second->SetContentHash(DataObject::HashBytes(outputKey.data(), outputKey.size()));
+      }
     }
   }
 
@@ -1738,6 +1779,127 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
 }
 
 
+bool
+ProcessObject::GraftCachedOutputs(const std::string & key)
+{
+  const PipelineResultCache::OutputsType cachedOutputs = PipelineResultCache::GetInstance()->Find(key);
+  if (cachedOutputs.empty())
+  {
+    return false;
+  }
+
+  for (const auto & output : m_Outputs)
+  {
+    if (output.second)
+    {
+      const auto cachedOutput = cachedOutputs.find(output.first);
+      if (cachedOutput == cachedOutputs.end())
+      {
+        return false;
+      }
+      // The cached outputs are shared with other threads, so the requested
+      // region is checked on another object referring to the same data
+      const DataObject::Pointer probe = static_cast<DataObject *>(cachedOutput->second->CreateAnother().GetPointer());
+      probe->Graft(cachedOutput->second);
+      probe->SetRequestedRegion(output.second);
+      if (probe->RequestedRegionIsOutsideOfTheBufferedRegion())
+      {
+        return false;
+      }
+    }
+  }
+
+  // Copies are grafted, so that the cached outputs are not modified by the
+  // process objects which modify their inputs in place
+  for (const auto & output : m_Outputs)
+  {
+    if (output.second)
+    {
+      output.second->Graft(cachedOutputs.find(output.first)->second->CreateDeepCopy());
+    }
+  }
+  this->UpdateProgress(1.0f);
+  return true;
+}
+
+
+std::string
+ProcessObject::ComputeResultCacheKey() const
+{
+  return {};
+}
+
+
+std::string
+ProcessObject::MakeResultCacheKey(const std::string & parameters) const
+{
+  std::string key = typeid(*this).name();
+  key += '\n';
+  key += parameters;
+  key += '\n';
+  for (const auto & input : m_Inputs)
+  {
+    key += input.first;
+    key += ':';
+    if (input.second)
+    {
+      const std::string inputHash = input.second->GetContentHash();
+      if (inputHash.empty())
+      {
+        return {};
+      }
+      key += inputHash;
+    }
+    key += '\n';
+  }
+  return DataObject::HashBytes(key.data(), key.size());
+}
+
+
+std::string
+ProcessObject::MakeResultCacheKeyFromPrintSelf() const
+{
+  // The parameters are the lines printed by the subclasses, below the
+  // ProcessObject ones which only describe the pipeline connections
+  std::ostringstream processObjectStream;
+  processObjectStream.precision(std::numeric_limits<double>::max_digits10);
+  this->ProcessObject::PrintSelf(processObjectStream, Indent());
+  std::ostringstream parametersStream;
+  parametersStream.precision(std::numeric_limits<double>::max_digits10);
+  this->PrintSelf(parametersStream, Indent());
+  const std::string processObjectText = processObjectStream.str();
+  const std::string parametersText = parametersStream.str();
+  if (parametersText.compare(0, processObjectText.size(), processObjectText) != 0)
+  {
+    return {};
+  }
+
+  std::string        key;
+  std::istringstream parameters(parametersText.substr(processObjectText.size()));
+  for (std::string line; std::getline(parameters, line);)
+  {
+    // Skip the bookkeeping of the objects printed as parameters, which
+    // changes when they are created again with the same parameters
+    if (line.find("Reference Count:") != std::string::npos || line.find("Modified Time:") != std::string::npos ||
+        line.find("PipelineMTime:") != std::string::npos || line.find("UpdateMTime:") != std::string::npos ||
+        line.find("RealTimeStamp:") != std::string::npos)
+    {
+      continue;
+    }
+    // Skip the address printed in the header of these objects
+    const size_t addressPosition = line.rfind(" (");
+    if (addressPosition != std::string::npos && line.back() == ')' && line.size() >= addressPosition + 11 &&
+        line.find_first_not_of("0123456789abcdefABCDEFx", addressPosition + 2) == line.size() - 1)
+    {
+      line.erase(addressPosition);
+    }
+    key += line;
+    key += '\n';
+  }
+  return this->MakeResultCacheKey(key);
+}
+
+
 void
 ProcessObject::CacheInputReleaseDataFlags()
 {
@@ -27,12 +27,26 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <deque>
 #include <mutex>
 
 
 namespace itk
 {
 
+namespace
+{
+// Index of the work queue owned by the calling thread, or -1 when the calling
+// thread does not belong to the thread pool.
+thread_local int threadPoolWorkerIndex = -1;
+} // namespace
+
+struct ThreadPool::WorkerQueue
+{
+  std::mutex                        m_Mutex;
+  std::deque<std::function<void()>> m_Tasks; // guarded by m_Mutex
+};
+
 struct ThreadPoolGlobals
 {
   ThreadPoolGlobals() = default;
@@ -105,6 +119,7 @@ ThreadPool::SetDoNotWaitForThreads(bool doNotWaitForThreads)
 }
 
 ThreadPool::ThreadPool()
+  : m_WorkQueues(new WorkerQueue[ITK_MAX_THREADS])
 {
   // m_PimplGlobals->m_Mutex not needed to be acquired here because construction only occurs via GetInstance which is
   // protected by call_once.
@@ -115,8 +130,14 @@ ThreadPool::ThreadPool()
   m_Threads.reserve(threadCount);
   for (ThreadIdType i = 0; i < threadCount; ++i)
   {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
+    m_Threads.emplace_back(&ThreadPool::ThreadExecute, i % ITK_MAX_THREADS);
   }
+  m_NumberOfWorkQueues = std::min<ThreadIdType>(threadCount, ITK_MAX_THREADS);
+}
+
+ThreadPool::~ThreadPool()
+{
+  this->CleanUp();
 }
 
 void
@@ -126,8 +147,105 @@ ThreadPool::AddThreads(ThreadIdType count)
   m_Threads.reserve(m_Threads.size() + count);
   for (ThreadIdType i = 0; i < count; ++i)
   {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
+    const auto workerIndex = static_cast<ThreadIdType>(m_Threads.size() % ITK_MAX_THREADS);
+    m_Threads.emplace_back(&ThreadPool::ThreadExecute, workerIndex);
+  }
+  m_NumberOfWorkQueues = std::min<ThreadIdType>(static_cast<ThreadIdType>(m_Threads.size()), ITK_MAX_THREADS);
+}
+
+void
+ThreadPool::AddDetachedWork(std::function<void()> task)
+{
+  ThreadIdType queueIndex = 0;
+  if (threadPoolWorkerIndex >= 0)
+  {
+    // nested parallelism: keep the job close to the thread which created it
+    queueIndex = static_cast<ThreadIdType>(threadPoolWorkerIndex);
+  }
+  else
+  {
+    const ThreadIdType queueCount = std::max<ThreadIdType>(1, m_NumberOfWorkQueues.load());
+    queueIndex = m_NextWorkQueue.fetch_add(1, std::memory_order_relaxed) % queueCount;
+  }
+
+  WorkerQueue & queue = m_WorkQueues[queueIndex];
+  {
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    queue.m_Tasks.emplace_back(std::move(task));
+    ++m_NumberOfPendingTasks;
+  }
+
+  // A worker increments m_NumberOfSleepingThreads while holding the global mutex,
+  // before it checks m_NumberOfPendingTasks. So either that worker sees the new job,
+  // or we see the sleeping worker here and wake it up through the global mutex.
+  if (m_NumberOfSleepingThreads.load() > 0)
+  {
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    }
+    m_Condition.notify_one();
+  }
+}
+
+bool
+ThreadPool::IsWorkerThread()
+{
+  return threadPoolWorkerIndex >= 0;
+}
+
+bool
+ThreadPool::TryGetTask(ThreadIdType workerIndex, std::function<void()> & task)
+{
+  {
+    // Newest job first from our own queue, it is most likely to be in cache
+    WorkerQueue &                     queue = m_WorkQueues[workerIndex];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    if (!queue.m_Tasks.empty())
+    {
+      task = std::move(queue.m_Tasks.back());
+      queue.m_Tasks.pop_back();
+      --m_NumberOfPendingTasks;
+      return true;
+    }
   }
+
+  // Steal the oldest job from some other queue. The first pass skips the
+  // queues which are locked by another thread. If any was, the second pass
+  // waits for their locks: returning false while a job may still be queued
+  // would make the caller spin, as it only sleeps when no job is pending.
+  const ThreadIdType queueCount = m_NumberOfWorkQueues.load();
+  bool               someQueueWasLocked = false;
+  for (const bool blocking : { false, true })
+  {
+    if (blocking && !someQueueWasLocked)
+    {
+      break;
+    }
+    for (ThreadIdType i = 0; i < queueCount; ++i)
+    {
+      const ThreadIdType victimIndex = (workerIndex + 1 + i) % queueCount;
+      if (victimIndex == workerIndex)
+      {
+        continue;
+      }
+      WorkerQueue &                      victim = m_WorkQueues[victimIndex];
+      const std::unique_lock<std::mutex> lock = blocking ? std::unique_lock<std::mutex>(victim.m_Mutex)
+                                                         : std::unique_lock<std::mutex>(victim.m_Mutex, std::try_to_lock);
+      if (!lock.owns_lock())
+      {
+        someQueueWasLocked = true;
+      }
+      else if (!victim.m_Tasks.empty())
+      {
+        task = std::move(victim.m_Tasks.front());
+        victim.m_Tasks.pop_front();
+        --m_NumberOfPendingTasks;
+        return true;
+      }
+    }
+  }
+
+  return false;
 }
 
 std::mutex &
@@ -140,7 +258,7 @@ int
 ThreadPool::GetNumberOfCurrentlyIdleThreads() const
 {
   const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
-  return static_cast<int>(m_Threads.size()) - static_cast<int>(m_WorkQueue.size()); // lousy approximation
+  return static_cast<int>(m_Threads.size()) - static_cast<int>(m_NumberOfPendingTasks.load()); // lousy approximation
 }
 
 void
@@ -182,30 +300,34 @@ ThreadPool::ResumeFromFork()
   ThreadPool *       instance = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
   const ThreadIdType threadCount = instance->m_Threads.size();
   instance->m_Threads.clear();
+  instance->m_NumberOfWorkQueues = 0;
   instance->m_Stopping = false;
   instance->AddThreads(threadCount);
 }
 
 void
-ThreadPool::ThreadExecute()
+ThreadPool::ThreadExecute(ThreadIdType workerIndex)
 {
   // plain pointer does not increase reference count
   ThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  threadPoolWorkerIndex = static_cast<int>(workerIndex);
 
   while (true)
   {
     std::function<void()> task;
 
+    if (!threadPool->TryGetTask(workerIndex, task))
     {
       std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
-      threadPool->m_Condition.wait(mutexHolder,
-                                   [threadPool] { return threadPool->m_Stopping || !threadPool->m_WorkQueue.empty(); });
-      if (threadPool->m_Stopping && threadPool->m_WorkQueue.empty())
+      ++threadPool->m_NumberOfSleepingThreads;
+      threadPool->m_Condition.wait(
+        mutexHolder, [threadPool] { return threadPool->m_Stopping || threadPool->m_NumberOfPendingTasks.load() > 0; });
+      --threadPool->m_NumberOfSleepingThreads;
+      if (threadPool->m_Stopping && threadPool->m_NumberOfPendingTasks.load() == 0)
       {
         return;
       }
-      task = std::move(threadPool->m_WorkQueue.front());
-      threadPool->m_WorkQueue.pop_front();
+      continue; // some queue has a job now, go and get it
     }
 
     task(); // execute the task
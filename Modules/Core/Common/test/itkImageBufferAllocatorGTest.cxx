@@ -0,0 +1,252 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageBufferAllocator.h"
+#include "itkImage.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkImportImageContainer.h"
+#include "itkMultiThreaderBase.h"
+#include "itkVectorImage.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+// Restores the default (disabled) allocation policy when going out of scope.
+class PolicyGuard
+{
+public:
+  PolicyGuard() = default;
+  ~PolicyGuard()
+  {
+    itk::ImageBufferAllocator::SetGlobalDefaultAlignment(0);
+    itk::ImageBufferAllocator::SetGlobalDefaultUseHugePages(false);
+    itk::ImageBufferAllocator::SetGlobalDefaultParallelInitialization(false);
+  }
+};
+
+// Element which records the thread that value-initialized it.
+struct ThreadRecordingElement
+{
+  ThreadRecordingElement() = default;
+  ThreadRecordingElement(const ThreadRecordingElement &) = default;
+  ThreadRecordingElement &
+  operator=(const ThreadRecordingElement &)
+  {
+    m_ThreadId = std::this_thread::get_id();
+    return *this;
+  }
+
+  std::thread::id m_ThreadId{};
+};
+
+bool
+IsAligned(const void * pointer, std::uintptr_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+} // namespace
+
+
+TEST(ImageBufferAllocator, IsDisabledByDefault)
+{
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultAlignment(), 0u);
+  EXPECT_FALSE(itk::ImageBufferAllocator::GetGlobalDefaultUseHugePages());
+  EXPECT_FALSE(itk::ImageBufferAllocator::GetGlobalDefaultParallelInitialization());
+  EXPECT_FALSE(itk::ImageBufferAllocator::GetGlobalDefaultAllocatorEnabled());
+
+  // The container still uses new[], so that applications may delete[] the buffers they take over.
+  const auto container = itk::ImportImageContainer<itk::SizeValueType, float>::New();
+  container->Reserve(100);
+  EXPECT_FALSE(itk::ImageBufferAllocator::IsAllocated(container->GetBufferPointer()));
+}
+
+
+TEST(ImageBufferAllocator, ThrowsOnInvalidAlignment)
+{
+  const PolicyGuard guard;
+  EXPECT_THROW(itk::ImageBufferAllocator::SetGlobalDefaultAlignment(48), itk::ExceptionObject);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultAlignment(), 0u);
+}
+
+
+TEST(ImageBufferAllocator, AllocateAndDeallocate)
+{
+  const PolicyGuard guard;
+  itk::ImageBufferAllocator::SetGlobalDefaultAlignment(128);
+
+  void * const buffer = itk::ImageBufferAllocator::Allocate(1000);
+  EXPECT_TRUE(IsAligned(buffer, 128));
+  EXPECT_TRUE(itk::ImageBufferAllocator::IsAllocated(buffer));
+  EXPECT_TRUE(itk::ImageBufferAllocator::Deallocate(buffer));
+  EXPECT_FALSE(itk::ImageBufferAllocator::IsAllocated(buffer));
+
+  // Memory which was not allocated by the allocator is left alone.
+  int notAllocated{};
+  EXPECT_FALSE(itk::ImageBufferAllocator::Deallocate(&notAllocated));
+  EXPECT_FALSE(itk::ImageBufferAllocator::Deallocate(nullptr));
+}
+
+
+TEST(ImageBufferAllocator, AlignsImageBuffers)
+{
+  const PolicyGuard guard;
+  itk::ImageBufferAllocator::SetGlobalDefaultAlignment(64);
+  EXPECT_TRUE(itk::ImageBufferAllocator::GetGlobalDefaultAllocatorEnabled());
+
+  using ImageType = itk::Image<short, 3>;
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(ImageType::SizeType::Filled(7)));
+  image->AllocateInitialized();
+  const auto * const buffer = image->GetBufferPointer();
+  EXPECT_TRUE(IsAligned(buffer, 64));
+  EXPECT_TRUE(itk::ImageBufferAllocator::IsAllocated(buffer));
+  EXPECT_TRUE(std::all_of(buffer, buffer + image->GetBufferedRegion().GetNumberOfPixels(), [](short pixel) {
+    return pixel == 0;
+  }));
+
+  using VectorImageType = itk::VectorImage<float, 2>;
+  const auto vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(VectorImageType::RegionType(VectorImageType::SizeType::Filled(5)));
+  vectorImage->SetVectorLength(3);
+  vectorImage->Allocate();
+  EXPECT_TRUE(IsAligned(vectorImage->GetBufferPointer(), 64));
+}
+
+
+TEST(ImageBufferAllocator, ContainerKeepsDataAndReleasesForeignMemory)
+{
+  const PolicyGuard guard;
+  itk::ImageBufferAllocator::SetGlobalDefaultAlignment(64);
+
+  using ContainerType = itk::ImportImageContainer<itk::SizeValueType, double>;
+  const auto container = ContainerType::New();
+  container->Reserve(10, true);
+  (*container)[9] = 9.0;
+
+  // Growing the container copies the data into another aligned buffer
+  container->Reserve(1000);
+  EXPECT_TRUE(IsAligned(container->GetBufferPointer(), 64));
+  EXPECT_EQ((*container)[9], 9.0);
+
+  container->Squeeze();
+  EXPECT_EQ((*container)[9], 9.0);
+
+  // A buffer allocated by new[] is still released by delete[]
+  container->SetImportPointer(new double[20], 20, true);
+  EXPECT_FALSE(itk::ImageBufferAllocator::IsAllocated(container->GetBufferPointer()));
+  container->Initialize();
+  EXPECT_EQ(container->GetBufferPointer(), nullptr);
+}
+
+
+TEST(ImageBufferAllocator, AlignsLargeBuffersToHugePages)
+{
+  const PolicyGuard guard;
+  itk::ImageBufferAllocator::SetGlobalDefaultUseHugePages(true);
+  EXPECT_TRUE(itk::ImageBufferAllocator::GetGlobalDefaultAllocatorEnabled());
+
+  void * const buffer = itk::ImageBufferAllocator::Allocate(itk::ImageBufferAllocator::LargeBufferSize);
+  EXPECT_TRUE(IsAligned(buffer, itk::ImageBufferAllocator::LargeBufferSize));
+  EXPECT_TRUE(itk::ImageBufferAllocator::Deallocate(buffer));
+}
+
+
+TEST(ImageBufferAllocator, InitializesLargeBuffersInParallel)
+{
+  const PolicyGuard guard;
+  itk::ImageBufferAllocator::SetGlobalDefaultParallelInitialization(true);
+  EXPECT_FALSE(itk::ImageBufferAllocator::ShouldInitializeInParallel(itk::ImageBufferAllocator::LargeBufferSize - 1));
+  EXPECT_TRUE(itk::ImageBufferAllocator::ShouldInitializeInParallel(itk::ImageBufferAllocator::LargeBufferSize));
+
+  using ImageType = itk::Image<float, 3>;
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType({ 3, -2, 5 }, { 130, 67, 61 }));
+  image->AllocateInitialized();
+  const float * const buffer = image->GetBufferPointer();
+  EXPECT_TRUE(std::all_of(
+    buffer, buffer + image->GetBufferedRegion().GetNumberOfPixels(), [](float pixel) { return pixel == 0.0f; }));
+
+  using VectorImageType = itk::VectorImage<unsigned char, 2>;
+  const auto vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(VectorImageType::RegionType(VectorImageType::SizeType{ { 1031, 1029 } }));
+  vectorImage->SetVectorLength(3);
+  vectorImage->AllocateInitialized();
+  const unsigned char * const vectorBuffer = vectorImage->GetBufferPointer();
+  EXPECT_TRUE(std::all_of(vectorBuffer,
+                          vectorBuffer + 3 * vectorImage->GetBufferedRegion().GetNumberOfPixels(),
+                          [](unsigned char component) { return component == 0; }));
+}
+
+
+TEST(ImageBufferAllocator, InitializesEachPieceOfTheFilterSplitByItsOwnThread)
+{
+  const itk::ThreadIdType numberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(4);
+
+  const itk::ImageRegion<3>           bufferedRegion({ 3, -2, 5 }, { 20, 10, 8 });
+  std::vector<ThreadRecordingElement> buffer(bufferedRegion.GetNumberOfPixels());
+  itk::ImageBufferAllocator::InitializeInParallel(buffer.data(), bufferedRegion);
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+
+  // The buffer is split as the threaded filters split it: four pieces of two slices
+  const auto splitter = itk::ImageRegionSplitterSlowDimension::New();
+  ASSERT_EQ(splitter->GetNumberOfSplits(bufferedRegion, 4), 4u);
+
+  std::set<std::thread::id> threadIds;
+  const itk::SizeValueType  sliceSize = 20 * 10;
+  for (unsigned int piece = 0; piece < 4; ++piece)
+  {
+    itk::ImageRegion<3> region = bufferedRegion;
+    splitter->GetSplit(piece, 4, region);
+    const itk::SizeValueType offset = (region.GetIndex(2) - bufferedRegion.GetIndex(2)) * sliceSize;
+    const std::thread::id    threadId = buffer[offset].m_ThreadId;
+    EXPECT_NE(threadId, std::thread::id{});
+    EXPECT_TRUE(std::all_of(buffer.begin() + offset,
+                            buffer.begin() + offset + region.GetNumberOfPixels(),
+                            [threadId](const ThreadRecordingElement & element) {
+                              return element.m_ThreadId == threadId;
+                            }));
+    threadIds.insert(threadId);
+  }
+  // Each piece has its own thread, not only the calling thread
+  EXPECT_EQ(threadIds.size(), 4u);
+}
+
+
+TEST(ImageBufferAllocator, ContainerReleasesItsBufferAfterThePolicyIsDisabled)
+{
+  const PolicyGuard guard;
+  itk::ImageBufferAllocator::SetGlobalDefaultAlignment(64);
+
+  const auto container = itk::ImportImageContainer<itk::SizeValueType, float>::New();
+  container->Reserve(100);
+  const float * const buffer = container->GetBufferPointer();
+  EXPECT_TRUE(itk::ImageBufferAllocator::IsAllocated(buffer));
+
+  // The container remembers how its buffer was allocated
+  itk::ImageBufferAllocator::SetGlobalDefaultAlignment(0);
+  container->Initialize();
+  EXPECT_FALSE(itk::ImageBufferAllocator::IsAllocated(buffer));
+}
@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMemoryBudgetStreamingImageFilter.h"
+#include "itkAddImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkGTest.h"
+#include <numeric>
+#include <vector>
+
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using AddFilterType = itk::AddImageFilter<ImageType, ImageType, ImageType>;
+using StreamingFilterType = itk::MemoryBudgetStreamingImageFilter<ImageType>;
+
+// Number of bytes of the images, and of one of their slices
+constexpr itk::SizeValueType imageNumberOfBytes = 16 * 16 * 16 * sizeof(float);
+constexpr itk::SizeValueType sliceNumberOfBytes = imageNumberOfBytes / 16;
+
+ImageType::Pointer
+MakeRampImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(itk::MakeSize(16, 16, 16));
+  image->Allocate();
+  std::iota(image->GetBufferPointer(), image->GetBufferPointer() + 16 * 16 * 16, 0.0f);
+  return image;
+}
+
+// A chain of filters adding 1 to the input, without running in place. The
+// filters are returned, as the data objects do not keep their source alive.
+std::vector<AddFilterType::Pointer>
+MakeAddChain(const ImageType * input, unsigned int numberOfFilters)
+{
+  std::vector<AddFilterType::Pointer> chain;
+  for (unsigned int i = 0; i < numberOfFilters; ++i)
+  {
+    auto add = AddFilterType::New();
+    add->SetInput1(chain.empty() ? input : chain.back()->GetOutput());
+    add->SetConstant2(1.0f);
+    add->InPlaceOff();
+    chain.push_back(add);
+  }
+  return chain;
+}
+} // namespace
+
+
+TEST(MemoryBudgetStreamingImageFilter, PredictsPeakMemory)
+{
+  const auto input = MakeRampImage();
+  const auto chain = MakeAddChain(input, 3);
+  auto       streamer = StreamingFilterType::New();
+  streamer->SetInput(chain.back()->GetOutput());
+
+  // The output and the input are held, and two intermediate images at most
+  // are held while the last filter executes
+  EXPECT_EQ(4 * imageNumberOfBytes, streamer->PredictPeakNumberOfBytes(1));
+  EXPECT_EQ(2 * imageNumberOfBytes + 2 * 4 * sliceNumberOfBytes, streamer->PredictPeakNumberOfBytes(4));
+  EXPECT_EQ(2 * imageNumberOfBytes + 2 * sliceNumberOfBytes, streamer->PredictPeakNumberOfBytes(100));
+
+  // All the intermediate images are held when they are not released
+  streamer->ReleaseIntermediateDataOff();
+  EXPECT_EQ(5 * imageNumberOfBytes, streamer->PredictPeakNumberOfBytes(1));
+  EXPECT_EQ(2 * imageNumberOfBytes + 3 * 4 * sliceNumberOfBytes, streamer->PredictPeakNumberOfBytes(4));
+}
+
+TEST(MemoryBudgetStreamingImageFilter, PredictsEnlargedRequestedRegions)
+{
+  const auto input = MakeRampImage();
+  const auto chain = MakeAddChain(input, 1);
+
+  using DilateFilterType = itk::GrayscaleDilateImageFilter<ImageType, ImageType, itk::FlatStructuringElement<3>>;
+  auto dilate = DilateFilterType::New();
+  dilate->SetInput(chain.back()->GetOutput());
+  dilate->SetKernel(itk::FlatStructuringElement<3>::Box(itk::MakeSize(1, 1, 1)));
+
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(dilate->GetOutput());
+
+  // The first piece of 4 slices needs 5 slices of the output of the first filter
+  EXPECT_EQ(2 * imageNumberOfBytes + (4 + 5) * sliceNumberOfBytes, streamer->PredictPeakNumberOfBytes(4));
+}
+
+TEST(MemoryBudgetStreamingImageFilter, StreamsWithinBudget)
+{
+  const auto input = MakeRampImage();
+  const auto chain = MakeAddChain(input, 3);
+
+  const auto referenceChain = MakeAddChain(input, 3);
+  auto       reference = StreamingFilterType::New();
+  reference->SetInput(referenceChain.back()->GetOutput());
+  reference->Update();
+  EXPECT_EQ(1u, reference->GetNumberOfStreamDivisions());
+
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(chain.back()->GetOutput());
+  streamer->SetMaximumNumberOfBytes(3 * imageNumberOfBytes);
+  EXPECT_EQ(2u, streamer->PlanStreaming());
+  EXPECT_EQ(3 * imageNumberOfBytes, streamer->GetPredictedPeakNumberOfBytes());
+
+  streamer->SetMaximumNumberOfBytes(2 * imageNumberOfBytes + 5 * sliceNumberOfBytes);
+  streamer->Update();
+  EXPECT_EQ(8u, streamer->GetNumberOfStreamDivisions());
+  EXPECT_LE(streamer->GetPredictedPeakNumberOfBytes(), streamer->GetMaximumNumberOfBytes());
+  EXPECT_EQ(*reference->GetOutput(), *streamer->GetOutput());
+  EXPECT_EQ(3.0f, streamer->GetOutput()->GetPixel(itk::MakeIndex(0, 0, 0)));
+
+  // The flags of the intermediate images are restored
+  EXPECT_FALSE(chain.front()->GetOutput()->GetReleaseDataFlag());
+}
+
+TEST(MemoryBudgetStreamingImageFilter, UsesSmallestPeakWhenBudgetCannotBeMet)
+{
+  const auto input = MakeRampImage();
+  const auto chain = MakeAddChain(input, 2);
+  auto       streamer = StreamingFilterType::New();
+  streamer->SetInput(chain.back()->GetOutput());
+  streamer->SetMaximumNumberOfBytes(imageNumberOfBytes);
+
+  const bool globalWarningDisplay = itk::Object::GetGlobalWarningDisplay();
+  itk::Object::GlobalWarningDisplayOff();
+  streamer->Update();
+  itk::Object::SetGlobalWarningDisplay(globalWarningDisplay);
+
+  EXPECT_EQ(16u, streamer->GetNumberOfStreamDivisions());
+  EXPECT_EQ(2 * imageNumberOfBytes + 2 * sliceNumberOfBytes, streamer->GetPredictedPeakNumberOfBytes());
+  EXPECT_EQ(2.0f, streamer->GetOutput()->GetPixel(itk::MakeIndex(0, 0, 0)));
+}
@@ -0,0 +1,323 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPipelineResultCache.h"
+#include "itkAddImageFilter.h"
+#include "itkImageToImageFilter.h"
+#include "itkGTest.h"
+#include <cmath>
+#include <numeric>
+
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+
+// Adds Shift to the pixels, and counts its executions. Opts in the cache with the parameters it prints.
+class ShiftImageFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ShiftImageFilter);
+
+  using Self = ShiftImageFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(ShiftImageFilter);
+
+  itkSetMacro(Shift, float);
+  itkGetConstMacro(Shift, float);
+
+  static unsigned int NumberOfExecutions;
+
+protected:
+  ShiftImageFilter() = default;
+  ~ShiftImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, itk::Indent indent) const override
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "Shift: " << m_Shift << std::endl;
+  }
+
+  std::string
+  ComputeResultCacheKey() const override
+  {
+    return this->MakeResultCacheKeyFromPrintSelf();
+  }
+
+  void
+  GenerateData() override
+  {
+    ++NumberOfExecutions;
+    this->AllocateOutputs();
+    const ImageType * input = this->GetInput();
+    ImageType *       output = this->GetOutput();
+    const size_t      numberOfPixels = output->GetBufferedRegion().GetNumberOfPixels();
+    for (size_t i = 0; i < numberOfPixels; ++i)
+    {
+      output->GetBufferPointer()[i] = input->GetBufferPointer()[i] + m_Shift;
+    }
+  }
+
+private:
+  float m_Shift{ 0 };
+};
+
+unsigned int ShiftImageFilter::NumberOfExecutions = 0;
+
+using AddFilterType = itk::AddImageFilter<ImageType, ImageType, ImageType>;
+
+// An AddImageFilter which opts in the cache
+class CachedAddImageFilter : public AddFilterType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CachedAddImageFilter);
+
+  using Self = CachedAddImageFilter;
+  using Superclass = AddFilterType;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(CachedAddImageFilter);
+
+protected:
+  CachedAddImageFilter() = default;
+  ~CachedAddImageFilter() override = default;
+
+  std::string
+  ComputeResultCacheKey() const override
+  {
+    return this->MakeResultCacheKeyFromPrintSelf();
+  }
+};
+
+ImageType::Pointer
+MakeRampImage(float start = 0)
+{
+  auto image = ImageType::New();
+  image->SetRegions(itk::MakeSize(20, 10));
+  image->SetSpacing(itk::MakeVector(0.5, 2.0));
+  image->Allocate();
+  std::iota(image->GetBufferPointer(), image->GetBufferPointer() + 200, start);
+  return image;
+}
+
+ImageType::Pointer
+Shift(const ImageType * input, float shift, bool useResultCache = true)
+{
+  auto filter = ShiftImageFilter::New();
+  filter->SetInput(input);
+  filter->SetShift(shift);
+  filter->SetUseResultCache(useResultCache);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+itk::PipelineResultCache::Pointer
+MakeEmptyCache()
+{
+  auto cache = itk::PipelineResultCache::GetInstance();
+  cache->Clear();
+  cache->SetMaximumNumberOfBytes(itk::SizeValueType{ 1 } << 30);
+  ShiftImageFilter::NumberOfExecutions = 0;
+  return cache;
+}
+} // namespace
+
+
+TEST(PipelineResultCache, IsSingleton)
+{
+  EXPECT_EQ(itk::PipelineResultCache::GetInstance(), itk::PipelineResultCache::New());
+  EXPECT_FALSE(ShiftImageFilter::New()->GetUseResultCache());
+}
+
+TEST(PipelineResultCache, ReusesOutputsAcrossPipelineRebuilds)
+{
+  const auto cache = MakeEmptyCache();
+  const auto input = MakeRampImage();
+
+  const auto first = Shift(input, 3);
+  EXPECT_EQ(1u, ShiftImageFilter::NumberOfExecutions);
+  EXPECT_EQ(1u, cache->GetNumberOfEntries());
+  EXPECT_EQ(200 * sizeof(float), cache->GetNumberOfBytes());
+
+  // A new filter with the same parameters, on an input with the same content
+  const auto second = Shift(MakeRampImage(), 3);
+  EXPECT_EQ(1u, ShiftImageFilter::NumberOfExecutions);
+  EXPECT_EQ(1u, cache->GetNumberOfHits());
+  EXPECT_EQ(*first, *second);
+  EXPECT_NE(first->GetBufferPointer(), second->GetBufferPointer());
+  EXPECT_EQ(first->GetContentHash(), second->GetContentHash());
+  EXPECT_FALSE(first->GetContentHash().empty());
+
+  // The cached output is not affected by the modifications of the outputs
+  second->GetBufferPointer()[0] = -5;
+  EXPECT_EQ(*first, *Shift(MakeRampImage(), 3));
+  EXPECT_EQ(1u, ShiftImageFilter::NumberOfExecutions);
+
+  // Another parameter, or another input
+  Shift(input, 4);
+  EXPECT_EQ(2u, ShiftImageFilter::NumberOfExecutions);
+  Shift(MakeRampImage(1), 3);
+  EXPECT_EQ(3u, ShiftImageFilter::NumberOfExecutions);
+  EXPECT_EQ(3u, cache->GetNumberOfEntries());
+
+  // The same input, modified
+  input->GetBufferPointer()[17] = -1;
+  input->Modified();
+  Shift(input, 3);
+  EXPECT_EQ(4u, ShiftImageFilter::NumberOfExecutions);
+
+  // Parameters which differ only beyond the default precision of the streams
+  Shift(input, 1.0f);
+  Shift(input, std::nextafter(1.0f, 2.0f));
+  EXPECT_EQ(6u, ShiftImageFilter::NumberOfExecutions);
+}
+
+TEST(PipelineResultCache, IsOptIn)
+{
+  const auto cache = MakeEmptyCache();
+  const auto input = MakeRampImage();
+
+  Shift(input, 3, false);
+  Shift(input, 3, false);
+  EXPECT_EQ(2u, ShiftImageFilter::NumberOfExecutions);
+  EXPECT_EQ(0u, cache->GetNumberOfEntries());
+
+  // A filter whose class does not provide a key is not cached
+  for (int i = 0; i < 2; ++i)
+  {
+    auto add = AddFilterType::New();
+    add->SetInput1(input);
+    add->SetConstant2(1);
+    add->SetUseResultCache(true);
+    add->Update();
+  }
+  EXPECT_EQ(0u, cache->GetNumberOfEntries());
+  EXPECT_EQ(0u, cache->GetNumberOfMisses());
+}
+
+TEST(PipelineResultCache, ReusesOutputsOfInPlaceFilters)
+{
+  const auto cache = MakeEmptyCache();
+
+  const auto run = [](const ImageType * input, float constant) {
+    auto shift = ShiftImageFilter::New();
+    shift->SetInput(input);
+    shift->SetShift(1);
+    shift->SetUseResultCache(true);
+    auto add = CachedAddImageFilter::New();
+    add->SetInput1(shift->GetOutput());
+    add->SetConstant2(constant);
+    add->InPlaceOn();
+    add->SetUseResultCache(true);
+    add->Update();
+    return ImageType::Pointer(add->GetOutput());
+  };
+
+  const auto input = MakeRampImage();
+  const auto first = run(input, 10);
+  EXPECT_EQ(11.0f, first->GetPixel(itk::MakeIndex(0, 0)));
+  EXPECT_EQ(2u, cache->GetNumberOfEntries());
+
+  const auto second = run(input, 10);
+  EXPECT_EQ(1u, ShiftImageFilter::NumberOfExecutions);
+  EXPECT_EQ(*first, *second);
+
+  // Only the second filter is executed again
+  const auto third = run(input, 20);
+  EXPECT_EQ(1u, ShiftImageFilter::NumberOfExecutions);
+  EXPECT_EQ(21.0f, third->GetPixel(itk::MakeIndex(0, 0)));
+  EXPECT_EQ(11.0f, first->GetPixel(itk::MakeIndex(0, 0)));
+}
+
+TEST(PipelineResultCache, ReleasesLeastRecentlyUsedOutputs)
+{
+  const auto cache = MakeEmptyCache();
+  cache->SetMaximumNumberOfBytes(2 * 200 * sizeof(float));
+
+  const auto input = MakeRampImage();
+  Shift(input, 1);
+  Shift(input, 2);
+  Shift(input, 1);
+  EXPECT_EQ(2u, ShiftImageFilter::NumberOfExecutions);
+
+  // The output for the shift 2 is the least recently used one
+  Shift(input, 3);
+  EXPECT_EQ(2u, cache->GetNumberOfEntries());
+  EXPECT_EQ(2 * 200 * sizeof(float), cache->GetNumberOfBytes());
+  Shift(input, 1);
+  EXPECT_EQ(3u, ShiftImageFilter::NumberOfExecutions);
+  Shift(input, 2);
+  EXPECT_EQ(4u, ShiftImageFilter::NumberOfExecutions);
+
+  // Outputs larger than the cache are not cached
+  cache->SetMaximumNumberOfBytes(100);
+  EXPECT_EQ(0u, cache->GetNumberOfEntries());
+  Shift(input, 5);
+  EXPECT_EQ(0u, cache->GetNumberOfEntries());
+}
+
+TEST(PipelineResultCache, HoldsCopiesOfTheOutputs)
+{
+  const auto cache = MakeEmptyCache();
+
+  auto                                  image = MakeRampImage();
+  itk::PipelineResultCache::OutputsType outputs;
+  outputs["Primary"] = image;
+  cache->Insert("key", outputs);
+
+  image->GetBufferPointer()[0] = 100;
+  const auto found = cache->Find("key");
+  ASSERT_EQ(1u, found.size());
+  const auto * copy = dynamic_cast<const ImageType *>(found.at("Primary").GetPointer());
+  ASSERT_NE(nullptr, copy);
+  EXPECT_NE(image.GetPointer(), copy);
+  EXPECT_EQ(0.0f, copy->GetPixel(itk::MakeIndex(0, 0)));
+  EXPECT_EQ(image->GetSpacing(), copy->GetSpacing());
+
+  // The copy is returned as such, it is not copied again
+  EXPECT_EQ(copy, cache->Find("key").at("Primary").GetPointer());
+
+  EXPECT_TRUE(cache->Find("other key").empty());
+  EXPECT_EQ(2u, cache->GetNumberOfHits());
+  EXPECT_EQ(1u, cache->GetNumberOfMisses());
+}
+
+TEST(PipelineResultCache, HashesImageContent)
+{
+  const auto first = MakeRampImage();
+  const auto second = MakeRampImage();
+  EXPECT_EQ(first->GetContentHash(), second->GetContentHash());
+
+  second->SetSpacing(itk::MakeVector(1.0, 1.0));
+  EXPECT_NE(first->GetContentHash(), second->GetContentHash());
+
+  // Large buffers are hashed in blocks
+  auto large = ImageType::New();
+  large->SetRegions(itk::MakeSize(2500, 2000));
+  large->AllocateInitialized();
+  const std::string hash = large->GetContentHash();
+  EXPECT_EQ(32u, hash.size());
+  large->GetBufferPointer()[4'000'000] = 1;
+  large->Modified();
+  EXPECT_NE(hash, large->GetContentHash());
+}
@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPipelineTracer.h"
+#include "itkAddImageFilter.h"
+#include "itkGTest.h"
+#include <sstream>
+
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using AddFilterType = itk::AddImageFilter<ImageType, ImageType, ImageType>;
+
+// Runs a filter adding 1 to an image of 64x32 pixels, in 4 work units
+void
+RunAddFilter(const std::string & objectName = "")
+{
+  auto image = ImageType::New();
+  image->SetRegions(itk::MakeSize(64, 32));
+  image->AllocateInitialized();
+
+  auto add = AddFilterType::New();
+  add->SetInput1(image);
+  add->SetConstant2(1.0f);
+  add->SetObjectName(objectName);
+  add->SetNumberOfWorkUnits(4);
+  add->Update();
+}
+
+// Enables the tracer during the lifetime of the object
+class TracingEnabled
+{
+public:
+  TracingEnabled()
+    : m_WasEnabled(itk::PipelineTracer::GetEnabled())
+  {
+    itk::PipelineTracer::GetInstance()->Clear();
+    itk::PipelineTracer::SetEnabled(true);
+  }
+  ~TracingEnabled() { itk::PipelineTracer::SetEnabled(m_WasEnabled); }
+
+private:
+  bool m_WasEnabled;
+};
+} // namespace
+
+
+TEST(PipelineTracer, IsSingleton)
+{
+  EXPECT_EQ(itk::PipelineTracer::GetInstance(), itk::PipelineTracer::New());
+}
+
+TEST(PipelineTracer, RecordsNothingWhenDisabled)
+{
+  const bool wasEnabled = itk::PipelineTracer::GetEnabled();
+  itk::PipelineTracer::SetEnabled(false);
+  itk::PipelineTracer::GetInstance()->Clear();
+  RunAddFilter();
+  EXPECT_EQ(0u, itk::PipelineTracer::GetInstance()->GetNumberOfEvents());
+  itk::PipelineTracer::SetEnabled(wasEnabled);
+}
+
+TEST(PipelineTracer, RecordsGenerateDataAndChunks)
+{
+  const TracingEnabled tracingEnabled;
+  RunAddFilter();
+
+  const auto                 events = itk::PipelineTracer::GetInstance()->GetEvents();
+  itk::SizeValueType         numberOfChunkPixels = 0;
+  unsigned int               numberOfChunks = 0;
+  unsigned int               numberOfGenerateData = 0;
+  itk::PipelineTracer::Event generateData{};
+  for (const auto & event : events)
+  {
+    EXPECT_EQ("AddImageFilter", event.Name);
+    EXPECT_GE(event.Duration, 0);
+    EXPECT_GE(event.CPUDuration, 0);
+    if (event.Category == "ParallelizeImageRegion")
+    {
+      ++numberOfChunks;
+      const auto pixels = event.Arguments.find("\"pixels\":");
+      ASSERT_NE(std::string::npos, pixels);
+      numberOfChunkPixels += std::stoul(event.Arguments.substr(pixels + 9));
+    }
+    else
+    {
+      EXPECT_EQ("GenerateData", event.Category);
+      generateData = event;
+      ++numberOfGenerateData;
+    }
+  }
+  EXPECT_EQ(1u, numberOfGenerateData);
+  EXPECT_EQ(4u, numberOfChunks);
+  EXPECT_EQ(64u * 32u, numberOfChunkPixels);
+  EXPECT_EQ("\"bytes\":" + std::to_string(64 * 32 * sizeof(float)), generateData.Arguments);
+
+  // The chunks are executed within GenerateData
+  for (const auto & event : events)
+  {
+    EXPECT_GE(event.StartTime, generateData.StartTime);
+    EXPECT_LE(event.StartTime + event.Duration, generateData.StartTime + generateData.Duration);
+  }
+}
+
+TEST(PipelineTracer, WritesChromeTrace)
+{
+  const TracingEnabled tracingEnabled;
+  RunAddFilter("my \"add\"");
+
+  std::ostringstream trace;
+  itk::PipelineTracer::GetInstance()->WriteChromeTrace(trace);
+  const std::string json = trace.str();
+  EXPECT_EQ(0u, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"AddImageFilter\",\"cat\":\"GenerateData\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"cat\":\"ParallelizeImageRegion\""));
+  EXPECT_NE(std::string::npos, json.find("\"index\":[0,0],\"size\":[64,8],\"pixels\":512"));
+  EXPECT_NE(std::string::npos, json.find("\"object\":\"my \\\"add\\\"\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"thread_name\",\"ph\":\"M\""));
+  EXPECT_EQ("\n]}\n", json.substr(json.size() - 4));
+
+  EXPECT_THROW(itk::PipelineTracer::GetInstance()->WriteChromeTrace("/nonexistent/directory/trace.json"),
+               itk::ExceptionObject);
+}
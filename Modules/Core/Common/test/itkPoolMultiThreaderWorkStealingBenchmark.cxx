@@ -0,0 +1,79 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPoolMultiThreader.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkTimeProbe.h"
+
+#include <cmath>
+
+// Benchmarks a fine-grained per-pixel operation on the thread pool with an
+// increasing number of work units. The timings are printed, they are not
+// compared against anything. Registered as RUN_SERIAL, so that other tests do
+// not compete for the cores.
+int
+itkPoolMultiThreaderWorkStealingBenchmark(int argc, char * argv[])
+{
+  using ImageType = itk::Image<float, 3>;
+  using RegionType = ImageType::RegionType;
+
+  const itk::PoolMultiThreader::Pointer threader = itk::PoolMultiThreader::New();
+
+  // The templated ParallelizeImageRegion is hidden by the PoolMultiThreader overrides
+  itk::MultiThreaderBase * const mt = threader.GetPointer();
+
+  const unsigned int imageSize = (argc > 1) ? static_cast<unsigned int>(std::stoi(argv[1])) : 96;
+  auto               image = ImageType::New();
+  image->SetRegions(RegionType(ImageType::SizeType::Filled(imageSize)));
+  image->AllocateInitialized();
+  const RegionType region = image->GetLargestPossibleRegion();
+
+  const itk::ThreadIdType threadCount = threader->GetMaximumNumberOfThreads();
+  std::cout << "Benchmark on " << region.GetSize() << " pixels with " << threadCount << " pool threads" << std::endl;
+  double singleWorkUnitTime = 0.0;
+  for (itk::ThreadIdType workUnits = 1; workUnits <= std::min<itk::ThreadIdType>(64 * threadCount, ITK_MAX_THREADS);
+       workUnits *= 2)
+  {
+    threader->SetNumberOfWorkUnits(workUnits);
+    itk::TimeProbe probe;
+    for (unsigned int repetition = 0; repetition < 5; ++repetition)
+    {
+      probe.Start();
+      mt->ParallelizeImageRegion<3>(
+        region,
+        [&image](const RegionType & piece) {
+          for (itk::ImageRegionIterator<ImageType> it(image, piece); !it.IsAtEnd(); ++it)
+          {
+            it.Set(std::sqrt(it.Get() + 1.0f));
+          }
+        },
+        nullptr);
+      probe.Stop();
+    }
+    if (workUnits == 1)
+    {
+      singleWorkUnitTime = probe.GetMean();
+    }
+    std::cout << "  work units: " << workUnits << "  mean time: " << probe.GetMean() << ' ' << probe.GetUnit()
+              << "  speedup: " << singleWorkUnitTime / probe.GetMean() << std::endl;
+  }
+
+  std::cout << "Benchmark finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPoolMultiThreader.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+#include <atomic>
+
+// Checks the correctness of nested parallel sections, of the scanline tiles
+// and of the exception propagation on the thread pool.
+int
+itkPoolMultiThreaderWorkStealingTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 3>;
+  using RegionType = ImageType::RegionType;
+
+  const itk::PoolMultiThreader::Pointer threader = itk::PoolMultiThreader::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(threader, PoolMultiThreader, MultiThreaderBase);
+
+  // The templated ParallelizeImageRegion is hidden by the PoolMultiThreader overrides
+  itk::MultiThreaderBase * const mt = threader.GetPointer();
+
+  constexpr unsigned int imageSize = 96;
+  auto                   image = ImageType::New();
+  image->SetRegions(RegionType(ImageType::SizeType::Filled(imageSize)));
+  image->AllocateInitialized();
+  const RegionType region = image->GetLargestPossibleRegion();
+
+  // Nested parallelism: every slice is processed by an inner parallel section,
+  // which is started from within a job of the outer parallel section.
+  {
+    const itk::MultiThreaderBase::Pointer inner = itk::PoolMultiThreader::New();
+    std::atomic<itk::SizeValueType>       pixelCount{ 0 };
+    threader->ParallelizeArray(
+      0,
+      imageSize,
+      [&](itk::SizeValueType z) {
+        RegionType slice = region;
+        slice.SetIndex(2, static_cast<itk::IndexValueType>(z));
+        slice.SetSize(2, 1);
+        inner->ParallelizeImageRegion<3>(
+          slice,
+          [&](const RegionType & piece) {
+            for (itk::ImageRegionIterator<ImageType> it(image, piece); !it.IsAtEnd(); ++it)
+            {
+              it.Set(it.Get() + 1.0f);
+            }
+            pixelCount += piece.GetNumberOfPixels();
+          },
+          nullptr);
+      },
+      nullptr);
+
+    ITK_TEST_EXPECT_EQUAL(pixelCount.load(), region.GetNumberOfPixels());
+    for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != 1.0f)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Pixel " << it.GetIndex() << " was processed " << it.Get() << " times instead of once."
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // When enabled, large regions are split into tiles of whole scanlines, each of them processed once.
+  threader->SetNumberOfWorkUnits(4);
+  ITK_TEST_SET_GET_VALUE(0, threader->GetNumberOfPixelsPerTile());
+  for (const itk::SizeValueType numberOfPixelsPerTile : { 0, 1, 2 * 96 * 96 + 1 })
+  {
+    threader->SetNumberOfPixelsPerTile(numberOfPixelsPerTile);
+    const RegionType slab(ImageType::IndexType{ { 1, 2, 3 } }, ImageType::SizeType{ { 90, 80, 70 } });
+    std::atomic<itk::SizeValueType> pieceCount{ 0 };
+    std::atomic<bool>               piecesAreScanlines{ true };
+    image->FillBuffer(0.0f);
+    mt->ParallelizeImageRegion<3>(
+      slab,
+      [&](const RegionType & piece) {
+        for (itk::ImageRegionIterator<ImageType> it(image, piece); !it.IsAtEnd(); ++it)
+        {
+          it.Set(it.Get() + 1.0f);
+        }
+        piecesAreScanlines = piecesAreScanlines && piece.GetIndex(0) == 1 && piece.GetSize(0) == 90;
+        ++pieceCount;
+      },
+      nullptr);
+
+    const itk::SizeValueType expectedPieceCount =
+      (numberOfPixelsPerTile == 0) ? 4 : ((numberOfPixelsPerTile == 1) ? 80 * 70 : 35);
+    std::cout << "Pixels per tile: " << numberOfPixelsPerTile << "  pieces: " << pieceCount << std::endl;
+    ITK_TEST_EXPECT_EQUAL(pieceCount.load(), expectedPieceCount);
+    ITK_TEST_EXPECT_TRUE(piecesAreScanlines.load());
+    for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != (slab.IsInside(it.GetIndex()) ? 1.0f : 0.0f))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Pixel " << it.GetIndex() << " was processed " << it.Get() << " times." << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  threader->SetNumberOfPixelsPerTile(0);
+
+  // The global default initializes the threaders created afterwards.
+  const itk::SizeValueType globalDefaultNumberOfPixelsPerTile =
+    itk::PoolMultiThreader::GetGlobalDefaultNumberOfPixelsPerTile();
+  itk::PoolMultiThreader::SetGlobalDefaultNumberOfPixelsPerTile(16384);
+  ITK_TEST_SET_GET_VALUE(itk::SizeValueType{ 16384 }, itk::PoolMultiThreader::GetGlobalDefaultNumberOfPixelsPerTile());
+  ITK_TEST_SET_GET_VALUE(itk::SizeValueType{ 16384 }, itk::PoolMultiThreader::New()->GetNumberOfPixelsPerTile());
+  ITK_TEST_SET_GET_VALUE(itk::SizeValueType{ 0 }, threader->GetNumberOfPixelsPerTile());
+  itk::PoolMultiThreader::SetGlobalDefaultNumberOfPixelsPerTile(globalDefaultNumberOfPixelsPerTile);
+
+  // An exception thrown from any chunk reaches the calling thread.
+  threader->SetNumberOfWorkUnits(16);
+  ITK_TRY_EXPECT_EXCEPTION(mt->ParallelizeImageRegion<3>(
+    region,
+    [](const RegionType & piece) {
+      if (piece.GetIndex(2) > 0)
+      {
+        itkGenericExceptionMacro("Expected exception from a helper chunk");
+      }
+    },
+    nullptr));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
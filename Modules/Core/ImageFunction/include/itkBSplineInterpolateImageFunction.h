@@ -163,6 +163,17 @@ public:
     return this->EvaluateAtContinuousIndexInternal(x, m_ThreadedEvaluateIndex[threadId], m_ThreadedWeights[threadId]);
   }
 
+  /** Evaluate the function at a ContinuousIndex position, using working
+   * space managed by the caller, which may then be reused for many calls.
+   * Both matrices must have ImageDimension rows and SplineOrder + 1 columns. */
+  OutputType
+  EvaluateAtContinuousIndex(const ContinuousIndexType & x,
+                            vnl_matrix<long> &          evaluateIndex,
+                            vnl_matrix<double> &        weights) const
+  {
+    return this->EvaluateAtContinuousIndexInternal(x, evaluateIndex, weights);
+  }
+
   CovariantVectorType
   EvaluateDerivative(const PointType & point) const
   {
@@ -226,7 +237,7 @@ public:
     this->EvaluateValueAndDerivativeAtContinuousIndex(index, value, deriv, threadId);
   }
 
-  void
+  virtual void
   EvaluateValueAndDerivativeAtContinuousIndex(const ContinuousIndexType & x,
                                               OutputType &                value,
                                               CovariantVectorType &       deriv) const
@@ -260,6 +271,24 @@ public:
                                                               m_ThreadedWeightsDerivative[threadId]);
   }
 
+  /** Evaluate the function at each of an array of ContinuousIndex positions,
+   * allocating the working space once for all of them. A subclass that
+   * overrides EvaluateAtContinuousIndex gets it called per index instead. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
+  /** Evaluate the function and its derivative at each of an array of
+   * ContinuousIndex positions, allocating the working space once for all of
+   * them. A subclass that overrides EvaluateValueAndDerivativeAtContinuousIndex
+   * gets it called per index instead. */
+  virtual void
+  EvaluateValueAndDerivativeAtContinuousIndices(const ContinuousIndexType * indices,
+                                                OutputType *                values,
+                                                CovariantVectorType *       derivatives,
+                                                SizeValueType               numberOfIndices) const;
+
   /** Get/Sets the Spline Order, supports 0th - 5th order splines. The default
    *  is a 3rd order spline. */
   void
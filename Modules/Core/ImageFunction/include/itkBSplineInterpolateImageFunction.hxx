@@ -35,6 +35,7 @@
 #include "itkMath.h"
 #include "itkMatrix.h"
 #include "itkPrintHelper.h"
+#include <typeinfo> // For typeid.
 
 namespace itk
 {
@@ -477,6 +478,58 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Appl
   }
 }
 
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateAtContinuousIndices(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  SizeValueType               numberOfIndices) const
+{
+  if (typeid(*this) != typeid(Self))
+  {
+    // A subclass, which may override EvaluateAtContinuousIndex
+    Superclass::EvaluateAtContinuousIndices(indices, values, numberOfIndices);
+    return;
+  }
+
+  vnl_matrix<long>   evaluateIndex(ImageDimension, (m_SplineOrder + 1));
+  vnl_matrix<double> weights(ImageDimension, (m_SplineOrder + 1));
+
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    values[i] = this->EvaluateAtContinuousIndexInternal(indices[i], evaluateIndex, weights);
+  }
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::
+  EvaluateValueAndDerivativeAtContinuousIndices(const ContinuousIndexType * indices,
+                                                OutputType *                values,
+                                                CovariantVectorType *       derivatives,
+                                                SizeValueType               numberOfIndices) const
+{
+  if (typeid(*this) != typeid(Self))
+  {
+    // A subclass, which may override EvaluateValueAndDerivativeAtContinuousIndex
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      this->EvaluateValueAndDerivativeAtContinuousIndex(indices[i], values[i], derivatives[i]);
+    }
+    return;
+  }
+
+  vnl_matrix<long>   evaluateIndex(ImageDimension, (m_SplineOrder + 1));
+  vnl_matrix<double> weights(ImageDimension, (m_SplineOrder + 1));
+  vnl_matrix<double> weightsDerivative(ImageDimension, (m_SplineOrder + 1));
+
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    this->EvaluateValueAndDerivativeAtContinuousIndexInternal(
+      indices[i], values[i], derivatives[i], evaluateIndex, weights, weightsDerivative);
+  }
+}
+
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
 auto
 BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateAtContinuousIndexInternal(
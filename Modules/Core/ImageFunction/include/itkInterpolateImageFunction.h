@@ -113,6 +113,25 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override = 0;
 
+  /** Interpolate the image at a contiguous array of continuous index positions
+   *
+   * Writes the interpolated image intensity at each of the indices to the
+   * corresponding element of values, paying the cost of a virtual function
+   * call once for all of them. No bounds checking is done.
+   *
+   * The default implementation calls EvaluateAtContinuousIndex() for each
+   * index. Subclasses may override it to share work between the indices. */
+  virtual void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+    }
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
@@ -21,6 +21,7 @@
 #include "itkInterpolateImageFunction.h"
 #include "itkVariableLengthVector.h"
 #include <algorithm> // For max.
+#include <typeinfo>  // For typeid.
 
 namespace itk
 {
@@ -104,6 +105,28 @@ public:
     return this->EvaluateOptimized(Dispatch<ImageDimension>(), index);
   }
 
+  /** Evaluate the function at each of an array of ContinuousIndex positions,
+   * without a virtual function call for each of them. For the objects of a
+   * subclass, which may override EvaluateAtContinuousIndex, it is called for
+   * each of them. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override
+  {
+    if (typeid(*this) != typeid(Self))
+    {
+      // A subclass, which may override EvaluateAtContinuousIndex
+      Superclass::EvaluateAtContinuousIndices(indices, values, numberOfIndices);
+      return;
+    }
+
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateOptimized(Dispatch<ImageDimension>(), indices[i]);
+    }
+  }
+
   SizeType
   GetRadius() const override
   {
@@ -311,6 +311,14 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override;
 
+  /** Evaluate the function at each of an array of ContinuousIndex positions,
+   * using the same neighborhood iterator for all of them, unless this is an
+   * object of a derived class, for which EvaluateAtContinuousIndex is called. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
   SizeType
   GetRadius() const override
   {
@@ -328,6 +336,19 @@ private:
   // Internal type alias
   using IteratorType = ConstNeighborhoodIterator<ImageType, TBoundaryCondition>;
 
+  /** Evaluates the function at a ContinuousIndex position, by means of the
+   * specified iterator, which is moved to the position. */
+  OutputType
+  EvaluateAtContinuousIndexInternal(const ContinuousIndexType & index, IteratorType & nit) const;
+
+  /** Makes an iterator over the neighborhoods of the input image. */
+  IteratorType
+  MakeNeighborhoodIterator() const
+  {
+    auto radius = Size<ImageDimension>::Filled(VRadius);
+    return IteratorType(radius, this->GetInputImage(), this->GetInputImage()->GetBufferedRegion());
+  }
+
   // Constant to store twice the radius
   static constexpr unsigned int m_WindowSize{ 2 * VRadius };
 
@@ -20,6 +20,7 @@
 
 
 #include "itkMath.h"
+#include <typeinfo> // For typeid.
 
 namespace itk
 {
@@ -108,6 +109,44 @@ template <typename TInputImage,
 auto
 WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBoundaryCondition, TCoordinate>::
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const -> OutputType
+{
+  IteratorType nit = this->MakeNeighborhoodIterator();
+  return this->EvaluateAtContinuousIndexInternal(index, nit);
+}
+
+template <typename TInputImage,
+          unsigned int VRadius,
+          typename TWindowFunction,
+          typename TBoundaryCondition,
+          typename TCoordinate>
+void
+WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBoundaryCondition, TCoordinate>::
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+{
+  if (typeid(*this) != typeid(Self))
+  {
+    // A subclass, which may override EvaluateAtContinuousIndex
+    Superclass::EvaluateAtContinuousIndices(indices, values, numberOfIndices);
+    return;
+  }
+
+  IteratorType nit = this->MakeNeighborhoodIterator();
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    values[i] = this->EvaluateAtContinuousIndexInternal(indices[i], nit);
+  }
+}
+
+template <typename TInputImage,
+          unsigned int VRadius,
+          typename TWindowFunction,
+          typename TBoundaryCondition,
+          typename TCoordinate>
+auto
+WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBoundaryCondition, TCoordinate>::
+  EvaluateAtContinuousIndexInternal(const ContinuousIndexType & index, IteratorType & nit) const -> OutputType
 {
   IndexType baseIndex;
   double    distance[ImageDimension];
@@ -121,8 +160,6 @@ WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBou
   }
 
   // Position the neighborhood at the index of interest
-  auto         radius = Size<ImageDimension>::Filled(VRadius);
-  IteratorType nit(radius, this->GetInputImage(), this->GetInputImage()->GetBufferedRegion());
   nit.SetLocation(baseIndex);
 
   // Compute the sinc function for each dimension
@@ -0,0 +1,244 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkGaussianInterpolateImageFunction.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkWindowedSincInterpolateImageFunction.h"
+#include "itkGTest.h"
+#include "itkImage.h"
+#include <vector>
+
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeImage()
+{
+  auto image = TImage::New();
+  image->SetRegions(TImage::SizeType::Filled(9));
+  image->Allocate();
+  typename TImage::PixelType * const buffer = image->GetBufferPointer();
+  for (itk::SizeValueType i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+  {
+    buffer[i] = static_cast<typename TImage::PixelType>((i * 37) % 101);
+  }
+  return image;
+}
+
+// Continuous indices inside the buffer of MakeImage(), including indices of
+// pixels and indices on the last pixel, along each dimension.
+template <typename TContinuousIndex>
+std::vector<TContinuousIndex>
+MakeContinuousIndices()
+{
+  std::vector<TContinuousIndex> indices;
+  for (unsigned int i = 0; i < 41; ++i)
+  {
+    TContinuousIndex index;
+    for (unsigned int d = 0; d < TContinuousIndex::Dimension; ++d)
+    {
+      index[d] = (i % 4 == 0) ? (i + d) % 9 : 0.19 * i + 0.03 * d;
+    }
+    index[0] = (i == 40) ? 8.0 : index[0];
+    indices.push_back(index);
+  }
+  return indices;
+}
+
+template <typename TInterpolator>
+void
+Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex()
+{
+  using ImageType = typename TInterpolator::InputImageType;
+  using ContinuousIndexType = typename TInterpolator::ContinuousIndexType;
+
+  const auto image = MakeImage<ImageType>();
+  const auto interpolator = TInterpolator::New();
+  interpolator->SetInputImage(image);
+
+  const std::vector<ContinuousIndexType>          indices = MakeContinuousIndices<ContinuousIndexType>();
+  std::vector<typename TInterpolator::OutputType> values(indices.size());
+  interpolator->EvaluateAtContinuousIndices(indices.data(), values.data(), indices.size());
+  for (unsigned int i = 0; i < indices.size(); ++i)
+  {
+    ASSERT_TRUE(interpolator->IsInsideBuffer(indices[i])) << indices[i];
+    EXPECT_EQ(values[i], interpolator->EvaluateAtContinuousIndex(indices[i])) << indices[i];
+  }
+}
+
+// An interpolator of a user, which adds one to each value of the interpolator it derives from.
+template <typename TInterpolator>
+class IncrementingInterpolator : public TInterpolator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IncrementingInterpolator);
+
+  using Self = IncrementingInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+
+  using typename TInterpolator::ContinuousIndexType;
+  using typename TInterpolator::OutputType;
+  using TInterpolator::EvaluateAtContinuousIndex;
+
+  OutputType
+  EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override
+  {
+    return TInterpolator::EvaluateAtContinuousIndex(index) + 1;
+  }
+
+protected:
+  IncrementingInterpolator() = default;
+  ~IncrementingInterpolator() override = default;
+};
+
+// A B-spline interpolator of a user, which adds one to each value it evaluates with its derivative.
+template <typename TImage>
+class IncrementingBSplineInterpolator : public itk::BSplineInterpolateImageFunction<TImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IncrementingBSplineInterpolator);
+
+  using Self = IncrementingBSplineInterpolator;
+  using Superclass = itk::BSplineInterpolateImageFunction<TImage>;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+
+  using typename Superclass::ContinuousIndexType;
+  using typename Superclass::CovariantVectorType;
+  using typename Superclass::OutputType;
+  using Superclass::EvaluateValueAndDerivativeAtContinuousIndex;
+
+  void
+  EvaluateValueAndDerivativeAtContinuousIndex(const ContinuousIndexType & index,
+                                              OutputType &                value,
+                                              CovariantVectorType &       derivative) const override
+  {
+    Superclass::EvaluateValueAndDerivativeAtContinuousIndex(index, value, derivative);
+    value += 1;
+  }
+
+protected:
+  IncrementingBSplineInterpolator() = default;
+  ~IncrementingBSplineInterpolator() override = default;
+};
+} // namespace
+
+
+TEST(InterpolateImageFunction, EvaluateAtContinuousIndicesEqualsEvaluateAtContinuousIndex)
+{
+  using ImageType2D = itk::Image<short, 2>;
+  using ImageType3D = itk::Image<float, 3>;
+  using ImageType4D = itk::Image<unsigned char, 4>;
+
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    itk::LinearInterpolateImageFunction<ImageType2D>>();
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    itk::LinearInterpolateImageFunction<ImageType3D>>();
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    itk::LinearInterpolateImageFunction<ImageType4D>>();
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    itk::BSplineInterpolateImageFunction<ImageType2D>>();
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    itk::BSplineInterpolateImageFunction<ImageType3D>>();
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    itk::WindowedSincInterpolateImageFunction<ImageType2D, 3>>();
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    itk::WindowedSincInterpolateImageFunction<ImageType3D, 2>>();
+
+  // The default implementation
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    itk::GaussianInterpolateImageFunction<ImageType3D>>();
+}
+
+
+TEST(BSplineInterpolateImageFunction, EvaluateValueAndDerivativeAtContinuousIndices)
+{
+  using ImageType = itk::Image<float, 3>;
+  using InterpolatorType = itk::BSplineInterpolateImageFunction<ImageType>;
+  using ContinuousIndexType = InterpolatorType::ContinuousIndexType;
+
+  const auto interpolator = InterpolatorType::New();
+  interpolator->SetSplineOrder(2);
+  interpolator->SetInputImage(MakeImage<ImageType>());
+
+  const std::vector<ContinuousIndexType>             indices = MakeContinuousIndices<ContinuousIndexType>();
+  std::vector<InterpolatorType::OutputType>          values(indices.size());
+  std::vector<InterpolatorType::CovariantVectorType> derivatives(indices.size());
+  interpolator->EvaluateValueAndDerivativeAtContinuousIndices(
+    indices.data(), values.data(), derivatives.data(), indices.size());
+  for (unsigned int i = 0; i < indices.size(); ++i)
+  {
+    InterpolatorType::OutputType          value;
+    InterpolatorType::CovariantVectorType derivative;
+    interpolator->EvaluateValueAndDerivativeAtContinuousIndex(indices[i], value, derivative);
+    EXPECT_EQ(values[i], value) << indices[i];
+    EXPECT_EQ(derivatives[i], derivative) << indices[i];
+  }
+}
+
+
+// Checks that the values of a subclass which overrides EvaluateAtContinuousIndex, without overriding
+// EvaluateAtContinuousIndices, are evaluated by its EvaluateAtContinuousIndex.
+TEST(InterpolateImageFunction, EvaluateAtContinuousIndicesCallsEvaluateAtContinuousIndexOfSubclass)
+{
+  using ImageType = itk::Image<float, 3>;
+
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    IncrementingInterpolator<itk::LinearInterpolateImageFunction<ImageType>>>();
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    IncrementingInterpolator<itk::BSplineInterpolateImageFunction<ImageType>>>();
+  Expect_EvaluateAtContinuousIndices_equals_EvaluateAtContinuousIndex<
+    IncrementingInterpolator<itk::WindowedSincInterpolateImageFunction<ImageType, 2>>>();
+}
+
+
+// Checks that the values and derivatives of a subclass which overrides EvaluateValueAndDerivativeAtContinuousIndex,
+// without overriding EvaluateValueAndDerivativeAtContinuousIndices, are evaluated by its
+// EvaluateValueAndDerivativeAtContinuousIndex.
+TEST(BSplineInterpolateImageFunction, EvaluateValueAndDerivativeAtContinuousIndicesCallsSubclass)
+{
+  using ImageType = itk::Image<float, 2>;
+  using InterpolatorType = IncrementingBSplineInterpolator<ImageType>;
+  using ContinuousIndexType = InterpolatorType::ContinuousIndexType;
+
+  const auto interpolator = InterpolatorType::New();
+  interpolator->SetInputImage(MakeImage<ImageType>());
+  const auto bsplineInterpolator = itk::BSplineInterpolateImageFunction<ImageType>::New();
+  bsplineInterpolator->SetInputImage(MakeImage<ImageType>());
+
+  const std::vector<ContinuousIndexType>             indices = MakeContinuousIndices<ContinuousIndexType>();
+  std::vector<InterpolatorType::OutputType>          values(indices.size());
+  std::vector<InterpolatorType::CovariantVectorType> derivatives(indices.size());
+  interpolator->EvaluateValueAndDerivativeAtContinuousIndices(
+    indices.data(), values.data(), derivatives.data(), indices.size());
+  for (unsigned int i = 0; i < indices.size(); ++i)
+  {
+    InterpolatorType::OutputType          value;
+    InterpolatorType::CovariantVectorType derivative;
+    bsplineInterpolator->EvaluateValueAndDerivativeAtContinuousIndex(indices[i], value, derivative);
+    EXPECT_EQ(values[i], value + 1) << indices[i];
+    EXPECT_EQ(derivatives[i], derivative) << indices[i];
+  }
+}
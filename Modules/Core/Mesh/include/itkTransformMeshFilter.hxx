@@ -19,6 +19,8 @@
 #define itkTransformMeshFilter_hxx
 
 #include "itkMacro.h"
+#include "itkVectorContainer.h"
+#include <type_traits> // For is_same.
 
 namespace itk
 {
@@ -84,15 +86,32 @@ TransformMeshFilter<TInputMesh, TOutputMesh, TTransform>::GenerateData()
   outPoints->Squeeze(); // in case the previous mesh had
                         // allocated a larger memory
 
-  typename InputPointsContainer::ConstIterator inputPoint = inPoints->Begin();
-  typename OutputPointsContainer::Iterator     outputPoint = outPoints->Begin();
-
-  while (inputPoint != inPoints->End())
+  // Points stored contiguously are transformed by a single call.
+  using InputPointType = typename InputPointsContainer::Element;
+  using OutputPointType = typename OutputPointsContainer::Element;
+  if constexpr (std::is_same_v<InputPointsContainer,
+                               VectorContainer<typename InputPointsContainer::ElementIdentifier, InputPointType>> &&
+                std::is_same_v<OutputPointsContainer,
+                               VectorContainer<typename OutputPointsContainer::ElementIdentifier, OutputPointType>> &&
+                std::is_same_v<InputPointType, typename TransformType::InputPointType> &&
+                std::is_same_v<OutputPointType, typename TransformType::OutputPointType>)
+  {
+    m_Transform->TransformPoints(inPoints->CastToSTLConstContainer().data(),
+                                 outPoints->CastToSTLContainer().data(),
+                                 inPoints->Size());
+  }
+  else
   {
-    outputPoint.Value() = m_Transform->TransformPoint(inputPoint.Value());
+    typename InputPointsContainer::ConstIterator inputPoint = inPoints->Begin();
+    typename OutputPointsContainer::Iterator     outputPoint = outPoints->Begin();
+
+    while (inputPoint != inPoints->End())
+    {
+      outputPoint.Value() = m_Transform->TransformPoint(inputPoint.Value());
 
-    ++inputPoint;
-    ++outputPoint;
+      ++inputPoint;
+      ++outputPoint;
+    }
   }
 
   // Create duplicate references to the rest of data on the mesh
@@ -266,6 +266,9 @@ public:
   ScalarType
   Metric() const;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   /** Construct an AffineTransform object
    *
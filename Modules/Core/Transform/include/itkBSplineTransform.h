@@ -239,6 +239,15 @@ public:
                  ParameterIndexArrayType & indices,
                  bool &                    inside) const override;
   /** @ITKEndGrouping */
+
+  /** Transform an array of points, reusing the same weights and indices for
+   * all of them. The points of the objects of subclasses, which may override
+   * TransformPoint, are transformed one by one by TransformPoint. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /** Compute the Jacobian in one position. */
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override;
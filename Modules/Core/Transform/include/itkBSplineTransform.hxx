@@ -591,6 +591,31 @@ BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoint
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  this->template TransformPointsIfExactly<Self>(
+    inputPoints,
+    outputPoints,
+    numberOfPoints,
+    [this](const InputPointType * input, OutputPointType * output, SizeValueType count) {
+      WeightsType             weights;
+      ParameterIndexArrayType indices;
+      bool                    inside = false;
+
+      for (SizeValueType i = 0; i < count; ++i)
+      {
+        // The input point is copied, as it may be overwritten by the output point.
+        const InputPointType point = input[i];
+        this->Self::TransformPoint(point, output[i], weights, indices, inside);
+      }
+    });
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeJacobianWithRespectToParameters(
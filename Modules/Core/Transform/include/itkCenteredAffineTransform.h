@@ -112,6 +112,9 @@ public:
   InverseTransformBasePointer
   GetInverseTransform() const override;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   /** Construct an CenteredAffineTransform object */
   CenteredAffineTransform();
@@ -119,6 +119,9 @@ public:
   InverseTransformBasePointer
   GetInverseTransform() const override;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   CenteredEuler3DTransform();
   CenteredEuler3DTransform(const MatrixType & matrix, const OutputPointType & offset);
@@ -167,6 +167,9 @@ public:
   void
   CloneTo(Pointer & result) const;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   CenteredRigid2DTransform();
   ~CenteredRigid2DTransform() override = default;
@@ -173,6 +173,9 @@ public:
   void
   CloneTo(Pointer & result) const;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   CenteredSimilarity2DTransform();
   CenteredSimilarity2DTransform(unsigned int spaceDimension, unsigned int parametersDimension);
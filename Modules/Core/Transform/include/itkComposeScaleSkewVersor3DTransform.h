@@ -151,6 +151,9 @@ public:
   void
   ComputeJacobianWithRespectToParameters(const InputPointType & p, JacobianType & jacobian) const override;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   ComposeScaleSkewVersor3DTransform();
 #if !defined(ITK_LEGACY_REMOVE)
@@ -271,6 +271,15 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Transform an array of points, by applying each transform of the queue
+   * to all of the points in turn. The points of the objects of subclasses,
+   * which may override TransformPoint, are transformed one by one by
+   * TransformPoint. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
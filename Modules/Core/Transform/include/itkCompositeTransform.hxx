@@ -20,6 +20,9 @@
 
 
 #include "itkPrintHelper.h"
+
+#include <algorithm> // For copy_n.
+
 namespace itk
 {
 
@@ -71,6 +74,31 @@ CompositeTransform<TParametersValueType, VDimension>::TransformPoint(const Input
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                      OutputPointType *      outputPoints,
+                                                                      SizeValueType          numberOfPoints) const
+{
+  this->template TransformPointsIfExactly<Self>(
+    inputPoints,
+    outputPoints,
+    numberOfPoints,
+    [this](const InputPointType * input, OutputPointType * output, SizeValueType count) {
+      if (output != input)
+      {
+        std::copy_n(input, count, output);
+      }
+
+      /* Apply in reverse queue order.  */
+      for (auto it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it)
+      {
+        (*it)->TransformPoints(output, output, count);
+      }
+    });
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 CompositeTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & inputVector) const
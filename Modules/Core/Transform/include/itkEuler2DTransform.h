@@ -124,6 +124,9 @@ public:
     this->ComputeMatrixParameters();
   }
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   Euler2DTransform(unsigned int parametersDimension);
   Euler2DTransform();
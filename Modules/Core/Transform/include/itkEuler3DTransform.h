@@ -146,6 +146,9 @@ public:
   void
   SetIdentity() override;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   Euler3DTransform(const MatrixType & matrix, const OutputPointType & offset);
   Euler3DTransform(unsigned int parametersDimension);
@@ -25,6 +25,19 @@
 
 #include <iostream>
 
+/** Overrides TransformPoints in a subclass x of MatrixOffsetTransformBase
+ * which keeps the TransformPoint of MatrixOffsetTransformBase, so that the
+ * points of the objects of exactly this subclass are transformed by the loop
+ * of MatrixOffsetTransformBase::TransformPoints(). */
+#define itkMatrixOffsetTransformPointsMacro(x)                                             \
+  void TransformPoints(const InputPointType * inputPoints,                                 \
+                       OutputPointType *      outputPoints,                                \
+                       SizeValueType          numberOfPoints) const override               \
+  {                                                                                        \
+    this->template TransformPointsIfExactly<x>(inputPoints, outputPoints, numberOfPoints); \
+  }                                                                                        \
+  ITK_MACROEND_NOOP_STATEMENT
+
 namespace itk
 {
 
@@ -390,6 +403,19 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
+  /** Transform an array of points, by the same arithmetic as TransformPoint,
+   * in a loop without function calls. A subclass may override TransformPoint,
+   * so the loop is only used when this object is exactly a
+   * MatrixOffsetTransformBase; the points of the objects of other classes are
+   * transformed one by one by TransformPoint. The subclasses which keep the
+   * TransformPoint of this class override TransformPoints with
+   * itkMatrixOffsetTransformPointsMacro(Self), to use the loop for their
+   * own type. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   using Superclass::TransformVector;
 
   OutputVectorType
@@ -495,6 +521,17 @@ protected:
   const InverseMatrixType &
   GetInverseMatrix() const;
 
+  /** Transforms the points with the matrix and offset when this object is
+   * exactly of type TTransform, and one by one with the virtual
+   * TransformPoint otherwise, see Transform::TransformPointsIfExactly(). */
+  template <typename TTransform>
+  void
+  TransformPointsIfExactly(const InputPointType * inputPoints,
+                           OutputPointType *      outputPoints,
+                           SizeValueType          numberOfPoints) const;
+
+  using Superclass::TransformPointsIfExactly;
+
 protected:
   /** Construct an MatrixOffsetTransformBase object
    *
@@ -130,6 +130,53 @@ MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimensio
 }
 
 
+template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
+void
+MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  this->TransformPointsIfExactly<Self>(inputPoints, outputPoints, numberOfPoints);
+}
+
+
+template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
+template <typename TTransform>
+void
+MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformPointsIfExactly(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  // Local copies, which the compiler may keep in registers, as the output
+  // points cannot alias them.
+  const MatrixType       matrix = m_Matrix;
+  const OutputVectorType offset = m_Offset;
+
+  this->Superclass::template TransformPointsIfExactly<TTransform>(
+    inputPoints,
+    outputPoints,
+    numberOfPoints,
+    [&matrix, &offset](const InputPointType * input, OutputPointType * output, SizeValueType count) {
+      for (SizeValueType i = 0; i < count; ++i)
+      {
+        // The input point is copied, as it may be overwritten by the output point.
+        const InputPointType point = input[i];
+        for (unsigned int r = 0; r < VOutputDimension; ++r)
+        {
+          ScalarType sum{};
+          for (unsigned int c = 0; c < VInputDimension; ++c)
+          {
+            sum += matrix(r, c) * point[c];
+          }
+          output[i][r] = sum + offset[r];
+        }
+      }
+    });
+}
+
+
 template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
 auto
 MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformVector(
@@ -140,6 +140,9 @@ public:
   void
   ComputeJacobianWithRespectToParameters(const InputPointType & p, JacobianType & jacobian) const override;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
 #if !defined(ITK_LEGACY_REMOVE)
   [[deprecated("Removed unused constructor")]] QuaternionRigidTransform(const MatrixType &       matrix,
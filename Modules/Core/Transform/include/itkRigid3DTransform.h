@@ -155,6 +155,9 @@ public:
     const TParametersValueType tolerance = MatrixOrthogonalityTolerance<TParametersValueType>::GetTolerance());
 
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
 #if !defined(ITK_LEGACY_REMOVE)
   [[deprecated("Removed unused constructor")]] Rigid3DTransform(const MatrixType &       matrix,
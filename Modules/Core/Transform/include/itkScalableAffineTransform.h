@@ -129,6 +129,9 @@ public:
   InverseTransformBasePointer
   GetInverseTransform() const override;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   /** Construct an ScalableAffineTransform object
    *
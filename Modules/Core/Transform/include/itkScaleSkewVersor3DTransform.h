@@ -154,6 +154,9 @@ public:
   void
   ComputeJacobianWithRespectToParameters(const InputPointType & p, JacobianType & jacobian) const override;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   ScaleSkewVersor3DTransform();
 #if !defined(ITK_LEGACY_REMOVE)
@@ -117,6 +117,31 @@ ScaleTransform<TParametersValueType, VDimension>::TransformPoint(const InputPoin
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+ScaleTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                  OutputPointType *      outputPoints,
+                                                                  SizeValueType          numberOfPoints) const
+{
+  const InputPointType center = this->GetCenter();
+  const ScaleType      scale = m_Scale;
+
+  this->template TransformPointsIfExactly<Self>(
+    inputPoints,
+    outputPoints,
+    numberOfPoints,
+    [&center, &scale](const InputPointType * input, OutputPointType * output, SizeValueType count) {
+      for (SizeValueType i = 0; i < count; ++i)
+      {
+        for (unsigned int j = 0; j < SpaceDimension; ++j)
+        {
+          output[i][j] = (input[i][j] - center[j]) * scale[j] + center[j];
+        }
+      }
+    });
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 ScaleTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & vect) const
@@ -138,6 +138,9 @@ public:
   void
   ComputeJacobianWithRespectToParameters(const InputPointType & p, JacobianType & jacobian) const override;
 
+  /** \see MatrixOffsetTransformBase::TransformPoints() */
+  itkMatrixOffsetTransformPointsMacro(Self);
+
 protected:
   ScaleVersor3DTransform();
 #if !defined(ITK_LEGACY_REMOVE)
@@ -19,6 +19,7 @@
 #define itkTransform_h
 
 #include <type_traits> // For std::enable_if
+#include <typeinfo>    // For typeid
 #include "itkTransformBase.h"
 #include "itkVector.h"
 #include "itkSymmetricSecondRankTensor.h"
@@ -180,6 +181,18 @@ public:
   virtual OutputPointType
   TransformPoint(const InputPointType &) const = 0;
 
+  /** Method to transform a contiguous array of points, so that the cost of
+   * the virtual function call is paid once for all of them, rather than for
+   * each point. outputPoints may be the same array as inputPoints, when the
+   * types of the points are the same. The default implementation calls
+   * TransformPoint for each point; transforms override it with a loop the
+   * compiler can optimize.
+   * \warning This method must be thread-safe, as TransformPoint. */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const;
+
   /**  Method to transform a vector. */
   virtual OutputVectorType
   TransformVector(const InputVectorType &) const
@@ -580,6 +593,27 @@ protected:
   PreservationOfPrincipalDirectionDiffusionTensor3DReorientation(const InputDiffusionTensor3DType &,
                                                                  const InverseJacobianPositionType &) const;
 
+  /** Transforms the points by the specified loop when this object is exactly of type TTransform, and one by one with
+   * the virtual TransformPoint otherwise, as a subclass of TTransform may override TransformPoint. Helper function for
+   * the implementation of `TransformPoints()` in derived transform classes. The loop is called as
+   * `loop(inputPoints, outputPoints, numberOfPoints)`. */
+  template <typename TTransform, typename TLoop>
+  void
+  TransformPointsIfExactly(const InputPointType * inputPoints,
+                           OutputPointType *      outputPoints,
+                           SizeValueType          numberOfPoints,
+                           const TLoop &          loop) const
+  {
+    if (typeid(*this) == typeid(TTransform))
+    {
+      loop(inputPoints, outputPoints, numberOfPoints);
+    }
+    else
+    {
+      this->Transform::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    }
+  }
+
   /** Returns the inverse of the specified transform. Returns null if it cannot invert the transform. Helper function
    * for the implementation of `GetInverseTransform()` in derived transform classes. */
   template <typename TTransform>
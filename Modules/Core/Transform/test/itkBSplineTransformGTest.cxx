@@ -25,6 +25,7 @@
 #include "itkImageRegionConstIterator.h"
 
 #include <algorithm> // For generate.
+#include <vector>
 
 namespace
 {
@@ -84,6 +85,31 @@ bspline_eq(const itk::BSplineTransform<TParametersValueType, VDimension, VSpline
   }
 }
 
+// A B-spline transform of a user, which shifts each point it transforms by one.
+class ShiftedBSplineTransform : public itk::BSplineTransform<double, 2, 3>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ShiftedBSplineTransform);
+
+  using Self = ShiftedBSplineTransform;
+  using Superclass = itk::BSplineTransform<double, 2, 3>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(ShiftedBSplineTransform);
+
+  using Superclass::TransformPoint;
+
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override
+  {
+    return Superclass::TransformPoint(point) + itk::MakeFilled<OutputVectorType>(1.0);
+  }
+
+protected:
+  ShiftedBSplineTransform() = default;
+};
+
 } // namespace
 
 TEST(ITKBSplineTransform, Construction)
@@ -201,3 +227,71 @@ TEST(ITKBSplineTransform, NumberOfWeights)
   testNumberOfWeights(*itk::BSplineTransform<float, 2>::New());
   testNumberOfWeights(*itk::BSplineTransform<float, 2, 2>::New());
 }
+
+
+// Checks that transforming an array of points yields the same points as transforming each of them, both inside and
+// outside the transform domain.
+TEST(ITKBSplineTransform, TransformPointsEqualsTransformPoint)
+{
+  using BSplineType = itk::BSplineTransform<double, 2, 3>;
+  using PointType = BSplineType::InputPointType;
+
+  const auto bspline = BSplineType::New();
+  bspline->SetTransformDomainOrigin(itk::MakePoint(-1.0, 2.0));
+  bspline->SetTransformDomainPhysicalDimensions(itk::MakeVector(10.0, 8.0));
+  bspline->SetTransformDomainMeshSize(itk::MakeSize(4, 3));
+
+  BSplineType::ParametersType parameters(bspline->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.1 * (i % 7) - 0.25;
+  }
+  bspline->SetParameters(parameters);
+
+  std::vector<PointType> inputPoints;
+  for (double x = -3.0; x < 11.0; x += 0.7)
+  {
+    inputPoints.push_back(itk::MakePoint(x, 0.45 * x + 1.0));
+  }
+
+  std::vector<PointType> outputPoints(inputPoints.size());
+  bspline->TransformPoints(inputPoints.data(), outputPoints.data(), inputPoints.size());
+  for (unsigned int i = 0; i < inputPoints.size(); ++i)
+  {
+    EXPECT_EQ(outputPoints[i], bspline->TransformPoint(inputPoints[i])) << inputPoints[i];
+  }
+
+  std::vector<PointType> points = inputPoints;
+  bspline->TransformPoints(points.data(), points.data(), points.size());
+  EXPECT_EQ(points, outputPoints);
+}
+
+
+// Checks that the points of a subclass which overrides TransformPoint, without overriding TransformPoints, are
+// transformed by its TransformPoint.
+TEST(ITKBSplineTransform, TransformPointsCallsTransformPointOfSubclass)
+{
+  const auto bspline = ShiftedBSplineTransform::New();
+  bspline->SetTransformDomainOrigin(itk::MakePoint(-1.0, 2.0));
+  bspline->SetTransformDomainPhysicalDimensions(itk::MakeVector(10.0, 8.0));
+  bspline->SetTransformDomainMeshSize(itk::MakeSize(4, 3));
+
+  ShiftedBSplineTransform::ParametersType parameters(bspline->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.1 * (i % 7) - 0.25;
+  }
+  bspline->SetParameters(parameters);
+
+  std::vector<itk::Point<double, 2>> points;
+  for (double x = -3.0; x < 11.0; x += 1.3)
+  {
+    points.push_back(itk::MakePoint(x, 0.45 * x + 1.0));
+  }
+  const std::vector<itk::Point<double, 2>> inputPoints = points;
+  bspline->TransformPoints(points.data(), points.data(), points.size());
+  for (unsigned int i = 0; i < inputPoints.size(); ++i)
+  {
+    EXPECT_EQ(points[i], bspline->TransformPoint(inputPoints[i])) << inputPoints[i];
+  }
+}
@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkCompositeTransform.h"
+
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkEuler2DTransform.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+// A composite transform of a user, which shifts each point it transforms by one.
+class ShiftedCompositeTransform : public itk::CompositeTransform<double, 2>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ShiftedCompositeTransform);
+
+  using Self = ShiftedCompositeTransform;
+  using Superclass = itk::CompositeTransform<double, 2>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(ShiftedCompositeTransform);
+
+  using Superclass::TransformPoint;
+
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override
+  {
+    return Superclass::TransformPoint(point) + itk::MakeFilled<OutputVectorType>(1.0);
+  }
+
+protected:
+  ShiftedCompositeTransform() = default;
+};
+} // namespace
+
+
+
+// Checks that transforming an array of points yields the same points as transforming each of them.
+TEST(CompositeTransform, TransformPointsEqualsTransformPoint)
+{
+  using CompositeTransformType = itk::CompositeTransform<double, 2>;
+  using PointType = CompositeTransformType::InputPointType;
+
+  const auto affine = itk::AffineTransform<double, 2>::New();
+  affine->Scale(itk::MakeVector(1.25, 0.8));
+  affine->Shear(0, 1, 0.2);
+  affine->Translate(itk::MakeVector(-0.5, 1.5));
+
+  const auto bspline = itk::BSplineTransform<double, 2, 3>::New();
+  bspline->SetTransformDomainOrigin(itk::MakePoint(-2.0, -1.0));
+  bspline->SetTransformDomainPhysicalDimensions(itk::MakeVector(9.0, 7.0));
+  bspline->SetTransformDomainMeshSize(itk::MakeSize(3, 3));
+  auto parameters = bspline->GetParameters();
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.05 * (i % 5) - 0.1;
+  }
+  bspline->SetParameters(parameters);
+
+  const auto rigid = itk::Euler2DTransform<double>::New();
+  rigid->SetAngle(0.3);
+  rigid->SetCenter(itk::MakePoint(1.0, 2.0));
+
+  const auto composite = CompositeTransformType::New();
+  composite->AddTransform(affine);
+  composite->AddTransform(bspline);
+  composite->AddTransform(rigid);
+
+  std::vector<PointType> inputPoints;
+  for (double x = -4.0; x < 9.0; x += 0.9)
+  {
+    inputPoints.push_back(itk::MakePoint(x, 3.0 - 0.6 * x));
+  }
+
+  std::vector<PointType> outputPoints(inputPoints.size());
+  composite->TransformPoints(inputPoints.data(), outputPoints.data(), inputPoints.size());
+  for (unsigned int i = 0; i < inputPoints.size(); ++i)
+  {
+    EXPECT_EQ(outputPoints[i], composite->TransformPoint(inputPoints[i])) << inputPoints[i];
+  }
+
+  std::vector<PointType> points = inputPoints;
+  composite->TransformPoints(points.data(), points.data(), points.size());
+  EXPECT_EQ(points, outputPoints);
+
+  // An empty composite transform is the identity
+  const auto emptyComposite = CompositeTransformType::New();
+  emptyComposite->TransformPoints(inputPoints.data(), outputPoints.data(), inputPoints.size());
+  EXPECT_EQ(outputPoints, inputPoints);
+}
+
+
+// Checks that the points of a subclass which overrides TransformPoint, without overriding TransformPoints, are
+// transformed by its TransformPoint.
+TEST(CompositeTransform, TransformPointsCallsTransformPointOfSubclass)
+{
+  const auto affine = itk::AffineTransform<double, 2>::New();
+  affine->Scale(itk::MakeVector(1.25, 0.8));
+  affine->Translate(itk::MakeVector(-0.5, 1.5));
+
+  const auto composite = ShiftedCompositeTransform::New();
+  composite->AddTransform(affine);
+
+  std::vector<itk::Point<double, 2>> points{ itk::MakePoint(1.0, 2.0), itk::MakePoint(-3.0, 0.5) };
+  const std::vector<itk::Point<double, 2>> inputPoints = points;
+  composite->TransformPoints(points.data(), points.data(), points.size());
+  for (unsigned int i = 0; i < inputPoints.size(); ++i)
+  {
+    EXPECT_EQ(points[i], affine->TransformPoint(inputPoints[i]) + itk::MakeVector(1.0, 1.0));
+  }
+}
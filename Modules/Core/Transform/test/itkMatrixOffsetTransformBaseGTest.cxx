@@ -19,7 +19,13 @@
 // First include the header file to be tested:
 #include "itkMatrixOffsetTransformBase.h"
 
+#include "itkAffineTransform.h"
+#include "itkAzimuthElevationToCartesianTransform.h"
+#include "itkEuler2DTransform.h"
+#include "itkScaleTransform.h"
+
 #include <gtest/gtest.h>
+#include <vector>
 
 
 namespace
@@ -60,6 +66,64 @@ Assert_SetFixedParameters_throws_when_size_is_less_than_NDimensions()
   }
 }
 
+
+template <typename TTransform>
+void
+Expect_TransformPoints_equals_TransformPoint(const TTransform & transform)
+{
+  using InputPointType = typename TTransform::InputPointType;
+  using OutputPointType = typename TTransform::OutputPointType;
+
+  std::vector<InputPointType> inputPoints(17);
+  for (unsigned int i = 0; i < inputPoints.size(); ++i)
+  {
+    for (unsigned int d = 0; d < InputPointType::Dimension; ++d)
+    {
+      inputPoints[i][d] = 0.37 * i - 1.3 * d + 0.01 * i * i;
+    }
+  }
+
+  std::vector<OutputPointType> outputPoints(inputPoints.size());
+  transform.TransformPoints(inputPoints.data(), outputPoints.data(), inputPoints.size());
+  for (unsigned int i = 0; i < inputPoints.size(); ++i)
+  {
+    EXPECT_EQ(outputPoints[i], transform.TransformPoint(inputPoints[i]));
+  }
+
+  // The points may also be transformed in place
+  std::vector<InputPointType> points = inputPoints;
+  transform.TransformPoints(points.data(), points.data(), points.size());
+  EXPECT_EQ(points, outputPoints);
+}
+
+
+// An affine transform of a user, which shifts each point it transforms by one.
+class ShiftedAffineTransform : public itk::AffineTransform<double, 2>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ShiftedAffineTransform);
+
+  using Self = ShiftedAffineTransform;
+  using Superclass = itk::AffineTransform<double, 2>;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(ShiftedAffineTransform);
+
+  using Superclass::TransformPoint;
+
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override
+  {
+    return Superclass::TransformPoint(point) + itk::MakeFilled<OutputVectorType>(1.0);
+  }
+
+protected:
+  ShiftedAffineTransform() = default;
+  ~ShiftedAffineTransform() override = default;
+};
+
 } // namespace
 
 
@@ -77,3 +141,60 @@ TEST(MatrixOffsetTransformBase, SetFixedParametersThrowsWhenSizeIsLessThanNDimen
   Assert_SetFixedParameters_throws_when_size_is_less_than_NDimensions<3>();
   Assert_SetFixedParameters_throws_when_size_is_less_than_NDimensions<4>();
 }
+
+
+// Checks that transforming an array of points yields the same points as transforming each of them.
+TEST(MatrixOffsetTransformBase, TransformPointsEqualsTransformPoint)
+{
+  const auto transform = itk::MatrixOffsetTransformBase<double, 3, 3>::New();
+  auto       matrix = transform->GetMatrix();
+  for (unsigned int r = 0; r < 3; ++r)
+  {
+    for (unsigned int c = 0; c < 3; ++c)
+    {
+      matrix(r, c) = 1.1 * r - 0.7 * c + (r == c ? 1.3 : 0.1);
+    }
+  }
+  transform->SetMatrix(matrix);
+  transform->SetCenter(itk::MakePoint(0.5, -2.0, 3.25));
+  transform->SetTranslation(itk::MakeVector(4.0, 0.125, -7.5));
+  Expect_TransformPoints_equals_TransformPoint(*transform);
+
+  const auto floatTransform = itk::MatrixOffsetTransformBase<float, 2, 2>::New();
+  floatTransform->SetOffset(itk::MakeVector(1.5f, -0.25f));
+  Expect_TransformPoints_equals_TransformPoint(*floatTransform);
+
+  // Subclasses which override TransformPoint
+  const auto scaleTransform = itk::ScaleTransform<double, 2>::New();
+  scaleTransform->SetScale(itk::MakeFilled<itk::ScaleTransform<double, 2>::ScaleType>(1.7));
+  scaleTransform->SetCenter(itk::MakePoint(0.3, 0.9));
+  Expect_TransformPoints_equals_TransformPoint(*scaleTransform);
+
+  const auto azimuthElevationTransform = itk::AzimuthElevationToCartesianTransform<double, 3>::New();
+  azimuthElevationTransform->SetAzimuthElevationToCartesianParameters(0.5, 2.0, 11, 13);
+  Expect_TransformPoints_equals_TransformPoint(*azimuthElevationTransform);
+}
+
+
+// Checks that the points of a subclass which overrides TransformPoint, without overriding TransformPoints, are
+// transformed by its TransformPoint.
+TEST(MatrixOffsetTransformBase, TransformPointsCallsTransformPointOfSubclass)
+{
+  const auto transform = ShiftedAffineTransform::New();
+  transform->Scale(2.0);
+  transform->Translate(itk::MakeVector(0.5, -3.0));
+  Expect_TransformPoints_equals_TransformPoint(*transform);
+
+  const auto affineTransform = itk::AffineTransform<double, 2>::New();
+  affineTransform->SetParameters(transform->GetParameters());
+  std::vector<itk::Point<double, 2>> points{ itk::MakePoint(1.0, 2.0) };
+  transform->TransformPoints(points.data(), points.data(), points.size());
+  EXPECT_EQ(points.front(), affineTransform->TransformPoint(itk::MakePoint(1.0, 2.0)) + itk::MakeVector(1.0, 1.0));
+
+  // The subclasses which keep the TransformPoint of the base class
+  const auto euler2DTransform = itk::Euler2DTransform<double>::New();
+  euler2DTransform->SetAngle(0.3);
+  euler2DTransform->SetTranslation(itk::MakeVector(-1.5, 2.5));
+  Expect_TransformPoints_equals_TransformPoint(*euler2DTransform);
+  Expect_TransformPoints_equals_TransformPoint(*affineTransform);
+}
@@ -223,6 +223,15 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Transform an array of points, mapping each of them to a continuous
+   * index of the displacement field only once. The points of the objects of
+   * subclasses, which may override TransformPoint, are transformed one by one
+   * by TransformPoint. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /**  Method to transform a vector. */
   /** @ITKStartGrouping */
   using Superclass::TransformVector;
@@ -100,6 +100,54 @@ DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoint(con
   return outputPoint;
 }
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  if (!this->m_DisplacementField)
+  {
+    itkExceptionStringMacro("No displacement field is specified.");
+  }
+  if (!this->m_Interpolator)
+  {
+    itkExceptionStringMacro("No interpolator is specified.");
+  }
+
+  const DisplacementFieldType * const displacementField = this->m_DisplacementField;
+  const InterpolatorType * const      interpolator = this->m_Interpolator;
+
+  using ContinuousIndexType = typename InterpolatorType::ContinuousIndexType;
+
+  this->template TransformPointsIfExactly<Self>(
+    inputPoints,
+    outputPoints,
+    numberOfPoints,
+    [displacementField, interpolator](const InputPointType * input, OutputPointType * output, SizeValueType count) {
+      for (SizeValueType i = 0; i < count; ++i)
+      {
+        typename InterpolatorType::PointType point;
+        point.CastFrom(input[i]);
+
+        // Same test as IsInsideBuffer(point), which would map the point as well
+        const ContinuousIndexType cidx =
+          displacementField->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(
+            point);
+        output[i].CastFrom(point);
+        if (interpolator->IsInsideBuffer(cidx))
+        {
+          const typename InterpolatorType::OutputType displacement = interpolator->EvaluateAtContinuousIndex(cidx);
+          for (unsigned int ii = 0; ii < VDimension; ++ii)
+          {
+            output[i][ii] += displacement[ii];
+          }
+        }
+      }
+    });
+}
+
 template <typename TParametersValueType, unsigned int VDimension>
 bool
 DisplacementFieldTransform<TParametersValueType, VDimension>::GetInverse(Self * inverse) const
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDisplacementFieldTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkGTest.h"
+
+#include <vector>
+
+namespace
+{
+using TransformType = itk::DisplacementFieldTransform<double, 2>;
+using PointType = TransformType::InputPointType;
+
+// A displacement field transform of a user, which shifts each point it transforms by one.
+class ShiftedDisplacementFieldTransform : public TransformType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ShiftedDisplacementFieldTransform);
+
+  using Self = ShiftedDisplacementFieldTransform;
+  using Superclass = TransformType;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(ShiftedDisplacementFieldTransform);
+
+  using Superclass::TransformPoint;
+
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override
+  {
+    return Superclass::TransformPoint(point) + itk::MakeFilled<OutputVectorType>(1.0);
+  }
+
+protected:
+  ShiftedDisplacementFieldTransform() = default;
+};
+
+// Sets a displacement field, which varies over the field, to the transform.
+void
+SetDisplacementField(TransformType & transform)
+{
+  auto field = TransformType::DisplacementFieldType::New();
+  field->SetRegions(itk::MakeSize(11, 7));
+  field->SetOrigin(itk::MakePoint(-1.0, 0.5));
+  field->SetSpacing(itk::MakeVector(0.75, 1.25));
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TransformType::DisplacementFieldType> it(field, field->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    it.Set(itk::MakeVector(0.1 * it.GetIndex()[1] - 0.3, 0.05 * it.GetIndex()[0] * it.GetIndex()[1]));
+  }
+  transform.SetDisplacementField(field);
+}
+
+// Checks that transforming an array of points yields the same points as transforming each of them, both inside and
+// outside the displacement field.
+void
+Expect_TransformPoints_equals_TransformPoint(const TransformType & transform)
+{
+  std::vector<PointType> inputPoints;
+  for (double x = -3.0; x < 10.0; x += 0.6)
+  {
+    inputPoints.push_back(itk::MakePoint(x, 0.7 * x + 0.2));
+  }
+
+  std::vector<PointType> outputPoints(inputPoints.size());
+  transform.TransformPoints(inputPoints.data(), outputPoints.data(), inputPoints.size());
+  for (unsigned int i = 0; i < inputPoints.size(); ++i)
+  {
+    EXPECT_EQ(outputPoints[i], transform.TransformPoint(inputPoints[i])) << inputPoints[i];
+  }
+}
+} // namespace
+
+
+TEST(DisplacementFieldTransform, TransformPointsEqualsTransformPoint)
+{
+  const auto transform = TransformType::New();
+  SetDisplacementField(*transform);
+  Expect_TransformPoints_equals_TransformPoint(*transform);
+}
+
+
+// Checks that the points of a subclass which overrides TransformPoint, without overriding TransformPoints, are
+// transformed by its TransformPoint.
+TEST(DisplacementFieldTransform, TransformPointsCallsTransformPointOfSubclass)
+{
+  const auto transform = ShiftedDisplacementFieldTransform::New();
+  SetDisplacementField(*transform);
+  Expect_TransformPoints_equals_TransformPoint(*transform);
+
+  const auto             baseTransform = TransformType::New();
+  const PointType        point = itk::MakePoint(2.0, 3.0);
+  std::vector<PointType> points{ point };
+  baseTransform->SetDisplacementField(transform->GetModifiableDisplacementField());
+  transform->TransformPoints(points.data(), points.data(), points.size());
+  EXPECT_EQ(points.front(), baseTransform->TransformPoint(point) + itk::MakeVector(1.0, 1.0));
+}
@@ -0,0 +1,349 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkEuclideanDistanceTransform_h
+#define itkEuclideanDistanceTransform_h
+
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class EuclideanDistanceTransform
+ * \brief Exact squared Euclidean distance transform, in linear time, of an
+ * image buffer.
+ *
+ * The transform is computed in place on an image of real values, which are 0
+ * at the feature pixels and NumericTraits<DistanceType>::max() elsewhere.
+ * Afterwards, each pixel holds its squared distance to the nearest feature,
+ * or max() if the image has no feature.
+ *
+ * As in \cite maurer2003, the transform is separable: each dimension is
+ * processed in turn, by computing the lower envelope of the parabolas rooted
+ * at the pixels of each line. The lines of a dimension are independent and
+ * processed in parallel. The lines of dimension 0 are contiguous in memory;
+ * the lines of the other dimensions are processed in groups of
+ * LinesPerGroup lines which are adjacent along dimension 0, copied to a
+ * contiguous buffer and back, so that the memory is read by whole cache lines
+ * whatever the stride of the dimension.
+ *
+ * The distances along each dimension are weighted by the spacing, which is
+ * 1 by default. Optionally, the offset in the buffer of the nearest feature of
+ * each pixel, that is the Voronoi partition of the features, is computed in a
+ * second image with the same buffered region, -1 when there is no feature.
+ *
+ * This class is a computation engine for the distance map filters, not a
+ * filter: it neither allocates nor reports progress.
+ *
+ * \sa SignedMaurerDistanceMapImageFilter
+ * \ingroup ITKDistanceMap
+ */
+template <typename TDistanceImage>
+class EuclideanDistanceTransform
+{
+public:
+  static constexpr unsigned int ImageDimension = TDistanceImage::ImageDimension;
+
+  using DistanceImageType = TDistanceImage;
+  using DistanceType = typename DistanceImageType::PixelType;
+  using SpacingType = typename DistanceImageType::SpacingType;
+  using FeatureImageType = Image<OffsetValueType, ImageDimension>;
+
+  /** Number of lines of a dimension other than 0 which are gathered in a
+   * contiguous buffer. */
+  static constexpr SizeValueType LinesPerGroup = 16;
+
+  /** The distance image, and the optional nearest feature image, must be
+   * allocated, with the same buffered region. */
+  explicit EuclideanDistanceTransform(DistanceImageType * distance, FeatureImageType * nearestFeature = nullptr)
+    : m_Distance(distance)
+    , m_NearestFeature(nearestFeature)
+  {
+    m_Spacing.Fill(1.0);
+  }
+
+  /** Spacing weighting the distances along each dimension. */
+  void
+  SetSpacing(const SpacingType & spacing)
+  {
+    m_Spacing = spacing;
+  }
+
+  const SpacingType &
+  GetSpacing() const
+  {
+    return m_Spacing;
+  }
+
+  /** Transforms all the dimensions. */
+  void
+  Transform(MultiThreaderBase * multiThreader) const
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      this->TransformDimension(d, multiThreader);
+    }
+  }
+
+  /** Transforms the lines along a dimension. The dimensions must be
+   * transformed by increasing dimension, starting from 0. */
+  void
+  TransformDimension(unsigned int dimension, MultiThreaderBase * multiThreader) const
+  {
+    const auto &        size = m_Distance->GetBufferedRegion().GetSize();
+    const auto &        offsetTable = m_Distance->GetOffsetTable();
+    const SizeValueType lineLength = size[dimension];
+    if (lineLength == 0 || m_Distance->GetBufferedRegion().GetNumberOfPixels() == 0)
+    {
+      return;
+    }
+    const SizeValueType numberOfLines = m_Distance->GetBufferedRegion().GetNumberOfPixels() / lineLength;
+
+    // The groups of lines: single rows along dimension 0, and blocks of
+    // LinesPerGroup lines adjacent along dimension 0 otherwise.
+    const SizeValueType linesPerGroup = (dimension == 0) ? 1 : std::min(LinesPerGroup, size[0]);
+    const SizeValueType groupsPerRow = (dimension == 0) ? 1 : (size[0] + linesPerGroup - 1) / linesPerGroup;
+    const SizeValueType numberOfGroups = (dimension == 0) ? numberOfLines : groupsPerRow * (numberOfLines / size[0]);
+
+    // The groups are split into a few chunks per work unit, so that the line
+    // buffers are allocated once per chunk.
+    const SizeValueType numberOfChunks =
+      std::min<SizeValueType>(numberOfGroups, SizeValueType{ 8 } * multiThreader->GetNumberOfWorkUnits());
+
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [&](SizeValueType chunk) {
+        LineBuffers buffers(lineLength, linesPerGroup, m_NearestFeature != nullptr && dimension > 0);
+        const SizeValueType endGroup = numberOfGroups * (chunk + 1) / numberOfChunks;
+        for (SizeValueType group = numberOfGroups * chunk / numberOfChunks; group < endGroup; ++group)
+        {
+          if (dimension == 0)
+          {
+            this->TransformRow(group * lineLength, lineLength, buffers);
+          }
+          else
+          {
+            // Start of the group, from its position along dimension 0 and its
+            // index in the other dimensions than 0 and dimension.
+            SizeValueType   rest = group / groupsPerRow;
+            const auto      first = static_cast<OffsetValueType>((group % groupsPerRow) * linesPerGroup);
+            OffsetValueType start = first;
+            for (unsigned int k = 1; k < ImageDimension; ++k)
+            {
+              if (k != dimension)
+              {
+                start += static_cast<OffsetValueType>(rest % size[k]) * offsetTable[k];
+                rest /= size[k];
+              }
+            }
+            const SizeValueType numberOfLanes =
+              std::min(linesPerGroup, size[0] - static_cast<SizeValueType>(first));
+            this->TransformGroup(start, offsetTable[dimension], lineLength, numberOfLanes, dimension, buffers);
+          }
+        }
+      },
+      nullptr);
+  }
+
+private:
+  // Lower envelope of a line, and the lines of a group copied contiguously.
+  struct LineBuffers
+  {
+    LineBuffers(SizeValueType lineLength, SizeValueType linesPerGroup, bool withFeatures)
+      : m_Values(lineLength)
+      , m_Positions(lineLength)
+      , m_Sites(lineLength)
+      , m_GroupDistances(lineLength * linesPerGroup)
+      , m_GroupFeatures(withFeatures ? lineLength * linesPerGroup : 0)
+    {}
+
+    std::vector<DistanceType>    m_Values;
+    std::vector<DistanceType>    m_Positions;
+    std::vector<OffsetValueType> m_Sites;
+    std::vector<DistanceType>    m_GroupDistances;
+    std::vector<OffsetValueType> m_GroupFeatures;
+  };
+
+  // Whether the parabola rooted at (x2, d2) is hidden by the ones rooted at
+  // (x1, d1) and (xf, df), with x1 < x2 < xf.
+  static bool
+  Remove(DistanceType d1, DistanceType d2, DistanceType df, DistanceType x1, DistanceType x2, DistanceType xf)
+  {
+    const DistanceType a = x2 - x1;
+    const DistanceType b = xf - x2;
+    const DistanceType c = xf - x1;
+    return c * d2 - b * d1 - a * df - a * b * c > 0;
+  }
+
+  // Transforms a contiguous row along dimension 0. Its pixels are their own
+  // features.
+  void
+  TransformRow(SizeValueType start, SizeValueType lineLength, LineBuffers & buffers) const
+  {
+    DistanceType *    distances = m_Distance->GetBufferPointer() + start;
+    OffsetValueType * features = nullptr;
+    if (m_NearestFeature != nullptr)
+    {
+      features = m_NearestFeature->GetBufferPointer() + start;
+      for (SizeValueType i = 0; i < lineLength; ++i)
+      {
+        features[i] = static_cast<OffsetValueType>(start + i);
+      }
+    }
+    this->TransformLine(distances, features, lineLength, m_Spacing[0], buffers);
+  }
+
+  // Transforms numberOfLanes lines along a dimension other than 0, starting
+  // at adjacent pixels.
+  void
+  TransformGroup(OffsetValueType start,
+                 OffsetValueType stride,
+                 SizeValueType   lineLength,
+                 SizeValueType   numberOfLanes,
+                 unsigned int    dimension,
+                 LineBuffers &   buffers) const
+  {
+    DistanceType *    distances = m_Distance->GetBufferPointer() + start;
+    OffsetValueType * features = (m_NearestFeature != nullptr) ? m_NearestFeature->GetBufferPointer() + start : nullptr;
+    DistanceType *    groupDistances = buffers.m_GroupDistances.data();
+    OffsetValueType * groupFeatures = buffers.m_GroupFeatures.data();
+
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      const OffsetValueType offset = static_cast<OffsetValueType>(i) * stride;
+      for (SizeValueType lane = 0; lane < numberOfLanes; ++lane)
+      {
+        groupDistances[lane * lineLength + i] = distances[offset + lane];
+      }
+      if (features)
+      {
+        for (SizeValueType lane = 0; lane < numberOfLanes; ++lane)
+        {
+          groupFeatures[lane * lineLength + i] = features[offset + lane];
+        }
+      }
+    }
+
+    for (SizeValueType lane = 0; lane < numberOfLanes; ++lane)
+    {
+      this->TransformLine(groupDistances + lane * lineLength,
+                          features ? groupFeatures + lane * lineLength : nullptr,
+                          lineLength,
+                          m_Spacing[dimension],
+                          buffers);
+    }
+
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      const OffsetValueType offset = static_cast<OffsetValueType>(i) * stride;
+      for (SizeValueType lane = 0; lane < numberOfLanes; ++lane)
+      {
+        distances[offset + lane] = groupDistances[lane * lineLength + i];
+      }
+      if (features)
+      {
+        for (SizeValueType lane = 0; lane < numberOfLanes; ++lane)
+        {
+          features[offset + lane] = groupFeatures[lane * lineLength + i];
+        }
+      }
+    }
+  }
+
+  // Replaces the squared distances of a contiguous line, and the nearest
+  // features if any, by the ones of the lower envelope of their parabolas.
+  static void
+  TransformLine(DistanceType *    distances,
+                OffsetValueType * features,
+                SizeValueType     lineLength,
+                double            spacing,
+                LineBuffers &     buffers)
+  {
+    DistanceType *    g = buffers.m_Values.data();
+    DistanceType *    h = buffers.m_Positions.data();
+    OffsetValueType * sites = buffers.m_Sites.data();
+
+    // Parabolas of the lower envelope
+    SizeValueType numberOfParabolas = 0;
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      const DistanceType di = distances[i];
+      if (di == NumericTraits<DistanceType>::max())
+      {
+        continue;
+      }
+      const auto iw = static_cast<DistanceType>(static_cast<double>(i) * spacing);
+      while (numberOfParabolas >= 2 &&
+             Remove(g[numberOfParabolas - 2], g[numberOfParabolas - 1], di, h[numberOfParabolas - 2],
+                    h[numberOfParabolas - 1], iw))
+      {
+        --numberOfParabolas;
+      }
+      g[numberOfParabolas] = di;
+      h[numberOfParabolas] = iw;
+      if (features)
+      {
+        sites[numberOfParabolas] = features[i];
+      }
+      ++numberOfParabolas;
+    }
+
+    if (numberOfParabolas == 0)
+    {
+      if (features)
+      {
+        std::fill(features, features + lineLength, OffsetValueType{ -1 });
+      }
+      return;
+    }
+
+    // Distance of each pixel to the parabola of the envelope above it
+    SizeValueType l = 0;
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      const auto   iw = static_cast<DistanceType>(static_cast<double>(i) * spacing);
+      DistanceType d1 = g[l] + (h[l] - iw) * (h[l] - iw);
+      while (l + 1 < numberOfParabolas)
+      {
+        const DistanceType d2 = g[l + 1] + (h[l + 1] - iw) * (h[l + 1] - iw);
+        if (d1 <= d2)
+        {
+          break;
+        }
+        ++l;
+        d1 = d2;
+      }
+      distances[i] = d1;
+      if (features)
+      {
+        features[i] = sites[l];
+      }
+    }
+  }
+
+  DistanceImageType * m_Distance;
+  FeatureImageType *  m_NearestFeature;
+  SpacingType         m_Spacing{};
+};
+} // end namespace itk
+
+#endif
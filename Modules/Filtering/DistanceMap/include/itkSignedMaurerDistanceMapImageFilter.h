@@ -50,8 +50,11 @@ namespace itk
  *  the itk::DanielssonDistanceImageFilter class except it does not return
  *  the Voronoi map.
  *
- *  For algorithmic details see \cite maurer2003.
+ *  For algorithmic details see \cite maurer2003. The distances to the
+ *  boundary are computed by EuclideanDistanceTransform, which processes the
+ *  lines of each dimension in parallel.
  *
+ * \sa EuclideanDistanceTransform
  * \ingroup ImageFeatureExtraction
  * \ingroup ITKDistanceMap
  *
@@ -164,33 +167,13 @@ protected:
   void
   GenerateData() override;
 
-  unsigned int
-  SplitRequestedRegion(unsigned int i, unsigned int num, OutputImageRegionType & splitRegion) override;
-
-  void
-  ThreadedGenerateData(const OutputImageRegionType &, ThreadIdType) override;
-
-  void
-  DynamicThreadedGenerateData(const OutputImageRegionType &) override
-  {
-    itkExceptionStringMacro("This class requires threadId so it must use classic multi-threading model");
-  }
-
 private:
-  void
-       Voronoi(unsigned int, OutputIndexType idx, OutputImageType * output);
-  bool Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType);
-
   InputPixelType   m_BackgroundValue{};
   InputSpacingType m_Spacing{};
 
-  unsigned int m_CurrentDimension{ 0 };
-
   bool m_InsideIsPositive{ false };
   bool m_UseImageSpacing{ true };
   bool m_SquaredDistance{ false };
-
-  const InputImageType * m_InputCache{};
 };
 } // end namespace itk
 
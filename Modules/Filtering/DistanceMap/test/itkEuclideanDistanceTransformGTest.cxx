@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkEuclideanDistanceTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkPlatformMultiThreader.h"
+
+#include <gtest/gtest.h>
+#include <random>
+
+namespace
+{
+using DistanceImageType = itk::Image<double, 3>;
+using TransformType = itk::EuclideanDistanceTransform<DistanceImageType>;
+using FeatureImageType = TransformType::FeatureImageType;
+
+// Image of 0 at a few random features and max() elsewhere, with a region
+// which does not start at the origin.
+DistanceImageType::Pointer
+MakeFeatureImage(unsigned int numberOfFeatures)
+{
+  auto image = DistanceImageType::New();
+  image->SetRegions(DistanceImageType::RegionType(DistanceImageType::IndexType{ { 3, -2, 5 } },
+                                                  DistanceImageType::SizeType{ { 37, 23, 11 } }));
+  image->Allocate();
+  image->FillBuffer(itk::NumericTraits<double>::max());
+
+  std::mt19937 generator(7);
+  const auto   numberOfPixels = static_cast<int>(image->GetBufferedRegion().GetNumberOfPixels());
+  for (unsigned int n = 0; n < numberOfFeatures; ++n)
+  {
+    image->GetBufferPointer()[std::uniform_int_distribution<int>(0, numberOfPixels - 1)(generator)] = 0.0;
+  }
+  return image;
+}
+
+double
+SquaredDistance(const DistanceImageType::IndexType &   index1,
+                const DistanceImageType::IndexType &   index2,
+                const DistanceImageType::SpacingType & spacing)
+{
+  double squaredDistance = 0.0;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    const double difference = static_cast<double>(index1[d] - index2[d]) * spacing[d];
+    squaredDistance += difference * difference;
+  }
+  return squaredDistance;
+}
+
+// Compares the transform with a brute force search of the nearest feature.
+void
+CheckAgainstBruteForce(const DistanceImageType::SpacingType & spacing, itk::ThreadIdType numberOfWorkUnits)
+{
+  const DistanceImageType::Pointer image = MakeFeatureImage(20);
+
+  std::vector<DistanceImageType::IndexType> features;
+  for (itk::ImageRegionIteratorWithIndex<DistanceImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() == 0.0)
+    {
+      features.push_back(it.GetIndex());
+    }
+  }
+
+  auto nearestFeature = FeatureImageType::New();
+  nearestFeature->SetRegions(image->GetBufferedRegion());
+  nearestFeature->Allocate();
+
+  const auto multiThreader = itk::PlatformMultiThreader::New();
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  TransformType transform(image, nearestFeature);
+  transform.SetSpacing(spacing);
+  transform.Transform(multiThreader);
+
+  for (itk::ImageRegionIteratorWithIndex<DistanceImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    double expected = itk::NumericTraits<double>::max();
+    for (const auto & feature : features)
+    {
+      expected = std::min(expected, SquaredDistance(it.GetIndex(), feature, spacing));
+    }
+    ASSERT_NEAR(it.Get(), expected, 1e-9 * (1.0 + expected)) << " at " << it.GetIndex();
+
+    const itk::OffsetValueType feature = nearestFeature->GetPixel(it.GetIndex());
+    ASSERT_GE(feature, 0);
+    const DistanceImageType::IndexType featureIndex = image->ComputeIndex(feature);
+    EXPECT_EQ(image->GetPixel(featureIndex), 0.0);
+    EXPECT_NEAR(SquaredDistance(it.GetIndex(), featureIndex, spacing), expected, 1e-9 * (1.0 + expected));
+  }
+}
+} // namespace
+
+TEST(EuclideanDistanceTransform, MatchesBruteForce)
+{
+  CheckAgainstBruteForce(DistanceImageType::SpacingType(1.0), 1);
+  CheckAgainstBruteForce(DistanceImageType::SpacingType(1.0), 5);
+}
+
+TEST(EuclideanDistanceTransform, MatchesBruteForceWithAnisotropicSpacing)
+{
+  DistanceImageType::SpacingType spacing;
+  spacing[0] = 0.7;
+  spacing[1] = 1.3;
+  spacing[2] = 4.0;
+  CheckAgainstBruteForce(spacing, 3);
+}
+
+TEST(EuclideanDistanceTransform, WithoutFeatures)
+{
+  const DistanceImageType::Pointer image = MakeFeatureImage(0);
+
+  auto nearestFeature = FeatureImageType::New();
+  nearestFeature->SetRegions(image->GetBufferedRegion());
+  nearestFeature->Allocate();
+
+  TransformType(image, nearestFeature).Transform(itk::PlatformMultiThreader::New());
+
+  for (itk::ImageRegionIteratorWithIndex<DistanceImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    EXPECT_EQ(it.Get(), itk::NumericTraits<double>::max());
+    EXPECT_EQ(nearestFeature->GetPixel(it.GetIndex()), -1);
+  }
+}
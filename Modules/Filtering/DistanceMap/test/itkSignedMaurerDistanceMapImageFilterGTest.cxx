@@ -21,6 +21,7 @@
 #include "itkStdStreamStateSave.h"
 
 #include <gtest/gtest.h>
+#include <cmath>
 
 TEST(SignedMaurerDistanceMapImageFilter, Test)
 {
@@ -120,3 +121,39 @@ TEST(SignedMaurerDistanceMapImageFilter, Test)
   std::cout << "Use ImageSpacing Distance Map with squared distance turned off" << std::endl;
   ShowDistanceMap(outputDistance2D2);
 }
+
+
+// Tests that without any boundary in the input, the squared distances are the positive maximum, and the distances are
+// the signed square root of the maximum.
+TEST(SignedMaurerDistanceMapImageFilter, ImageWithoutBoundary)
+{
+  using InputImageType = itk::Image<unsigned char, 2>;
+  using OutputImageType = itk::Image<float, 2>;
+
+  constexpr float maximum = itk::NumericTraits<float>::max();
+  const auto      maximumDistance = static_cast<float>(std::sqrt(static_cast<double>(maximum)));
+
+  const auto input = InputImageType::New();
+  input->SetRegions(itk::MakeSize(6, 4));
+  input->Allocate();
+
+  for (const unsigned char inputValue : { 0, 1 })
+  {
+    input->FillBuffer(inputValue);
+    input->Modified();
+    for (const bool insideIsPositive : { false, true })
+    {
+      const auto filter = itk::SignedMaurerDistanceMapImageFilter<InputImageType, OutputImageType>::New();
+      filter->SetInput(input);
+      filter->SetInsideIsPositive(insideIsPositive);
+      filter->SquaredDistanceOn();
+      filter->Update();
+      EXPECT_EQ(filter->GetOutput()->GetPixel(itk::MakeIndex(2, 3)), maximum);
+
+      const bool positive = (inputValue != 0) == insideIsPositive;
+      filter->SquaredDistanceOff();
+      filter->Update();
+      EXPECT_EQ(filter->GetOutput()->GetPixel(itk::MakeIndex(2, 3)), positive ? maximumDistance : -maximumDistance);
+    }
+  }
+}
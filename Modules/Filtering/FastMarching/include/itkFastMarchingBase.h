@@ -22,11 +22,9 @@
 #include "itkIntTypes.h"
 #include "itkFastMarchingStoppingCriterionBase.h"
 #include "itkFastMarchingTraits.h"
+#include "itkIndexedDaryHeap.h"
 #include "ITKFastMarchingExport.h"
 
-#include <queue>
-#include <functional>
-
 namespace itk
 {
 /**
@@ -63,8 +61,9 @@ extern ITKFastMarching_EXPORT std::ostream &
  *
  * Updates are performed using an entropy satisfy scheme where only
  * "upwind" neighborhoods are used. This implementation of Fast Marching
- * uses a std::priority_queue to locate the next proper node to
- * update.
+ * uses an IndexedDaryHeap of the node identifiers to locate the next
+ * proper node to update. Since the value of a node already in the heap
+ * is updated in place, every trial node is in the heap only once.
  *
  * Fast Marching sweeps through N points in (N log N) steps to obtain
  * the arrival time value as the front propagates through the domain.
@@ -91,10 +90,6 @@ extern ITKFastMarching_EXPORT std::ostream &
  *    \li Superclass (itk::ImageToImageFilter or
  * itk::QuadEdgeMeshToQuadEdgeMeshFilter )
  *
- * \todo In the current implementation, std::priority_queue only allows
- * taking nodes out from the front and putting nodes in from the back.
- * Use itk::PriorityQueueContainer instead.
- *
  * \par Topology constraints:
  * Additional flexibility in this class includes the implementation of
  * topology constraints for image-based fast marching.  Further details
@@ -158,18 +153,6 @@ public:
   using StoppingCriterionType = FastMarchingStoppingCriterionBase<TInput, TOutput>;
   using StoppingCriterionPointer = typename StoppingCriterionType::Pointer;
 
-  /*
-  using ElementIdentifier = long;
-
-  using PriorityQueueElementType = MinPriorityQueueElementWrapper< NodeType,
-    OutputPixelType,
-    ElementIdentifier >;
-
-  using PriorityQueueType = PriorityQueueContainer< PriorityQueueElementType,
-    PriorityQueueElementType, OutputPixelType, ElementIdentifier >;
-  using PriorityQueuePointer = typename PriorityQueueType::Pointer;
-  */
-
   using TopologyCheckEnum = FastMarchingTraitsEnums::TopologyCheck;
 #if !defined(ITK_LEGACY_REMOVE)
   using TopologyCheckType = FastMarchingTraitsEnums::TopologyCheck;
@@ -255,13 +238,10 @@ protected:
 
   bool m_CollectPoints{};
 
-  // PriorityQueuePointer m_Heap;
-  using HeapContainerType = std::vector<NodePairType>;
-  using NodeComparerType = std::greater<NodePairType>;
-
-  using PriorityQueueType = std::priority_queue<NodePairType, HeapContainerType, NodeComparerType>;
+  /** Heap of the trial nodes, by the identifiers returned by GetNodeIdentifier(). */
+  using HeapType = IndexedDaryHeap<OutputPixelType>;
 
-  PriorityQueueType m_Heap{};
+  HeapType m_Heap{};
 
   TopologyCheckEnum m_TopologyCheck{};
 
@@ -269,6 +249,17 @@ protected:
   [[nodiscard]] virtual IdentifierType
   GetTotalNumberOfNodes() const = 0;
 
+  /** \brief Get the identifier of a node in the heap of the trial nodes.
+   * The identifiers are the nodes themselves when they are integers, as
+   * point identifiers are. Other node types must override this method and
+   * GetNodeFromIdentifier(). */
+  [[nodiscard]] virtual IdentifierType
+  GetNodeIdentifier(const NodeType & iNode) const;
+
+  /** \brief Get the node of an identifier returned by GetNodeIdentifier() */
+  [[nodiscard]] virtual NodeType
+  GetNodeFromIdentifier(IdentifierType iIdentifier) const;
+
   /** \brief Get the output value (front value) for a given node */
   virtual const OutputPixelType
   GetOutputValue(OutputDomainType * oDomain, const NodeType & iNode) const = 0;
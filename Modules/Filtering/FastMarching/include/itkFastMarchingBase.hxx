@@ -23,6 +23,8 @@
 #include "itkProgressReporter.h"
 #include "itkMath.h"
 
+#include <type_traits>
+
 namespace itk
 {
 // -----------------------------------------------------------------------------
@@ -41,7 +43,6 @@ FastMarchingBase<TInput, TOutput>::FastMarchingBase()
   , m_TopologyCheck(TopologyCheckEnum::Nothing)
 {
   this->ProcessObject::SetNumberOfRequiredInputs(0);
-  // m_Heap = PriorityQueueType::New();
 }
 // -----------------------------------------------------------------------------
 
@@ -58,6 +59,39 @@ FastMarchingBase<TInput, TOutput>::PrintSelf(std::ostream & os, Indent indent) c
 
 // -----------------------------------------------------------------------------
 
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+IdentifierType
+FastMarchingBase<TInput, TOutput>::GetNodeIdentifier(const NodeType & iNode) const
+{
+  if constexpr (std::is_integral_v<NodeType>)
+  {
+    return static_cast<IdentifierType>(iNode);
+  }
+  else
+  {
+    itkExceptionMacro("GetNodeIdentifier() is not implemented for this node type");
+  }
+}
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+auto
+FastMarchingBase<TInput, TOutput>::GetNodeFromIdentifier(IdentifierType iIdentifier) const -> NodeType
+{
+  if constexpr (std::is_integral_v<NodeType>)
+  {
+    return static_cast<NodeType>(iIdentifier);
+  }
+  else
+  {
+    itkExceptionMacro("GetNodeFromIdentifier() is not implemented for node identifier " << iIdentifier);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 // -----------------------------------------------------------------------------
 template <typename TInput, typename TOutput>
 void
@@ -88,16 +122,7 @@ FastMarchingBase<TInput, TOutput>::Initialize(OutputDomainType * oDomain)
   }
 
   // make sure the heap is empty
-  while (!m_Heap.empty())
-  {
-    m_Heap.pop();
-  }
-  /*
-  while ( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }
-  */
+  m_Heap.Clear();
 
   this->InitializeOutput(oDomain);
 
@@ -124,50 +149,41 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
 
   try
   {
-    // while( !m_Heap->Empty() )
-    while (!m_Heap.empty())
+    while (!m_Heap.IsEmpty())
     {
-      // PriorityQueueElementType element = m_Heap->Peek();
-      // m_Heap->Pop();
-      //
-      // NodeType current_node = element.m_Element;
-      // OutputPixelType current_value = element.m_Priority;
-
-
-      NodePairType current_node_pair = m_Heap.top();
-      m_Heap.pop();
+      // The heap holds the current value of every trial node, there is no
+      // outdated value to skip.
+      const auto [current_identifier, current_heap_value] = m_Heap.Pop();
 
-      const NodeType current_node = current_node_pair.GetNode();
-      current_value = this->GetOutputValue(output, current_node);
+      const NodeType     current_node = this->GetNodeFromIdentifier(current_identifier);
+      const NodePairType current_node_pair(current_node, current_heap_value);
+      current_value = current_heap_value;
 
-      if (Math::ExactlyEquals(current_value, current_node_pair.GetValue()))
+      // is this node already alive ?
+      if (this->GetLabelValueForGivenNode(current_node) != Traits::Alive)
       {
-        // is this node already alive ?
-        if (this->GetLabelValueForGivenNode(current_node) != Traits::Alive)
+        m_StoppingCriterion->SetCurrentNodePair(current_node_pair);
+
+        if (m_StoppingCriterion->IsSatisfied())
         {
-          m_StoppingCriterion->SetCurrentNodePair(current_node_pair);
+          break;
+        }
 
-          if (m_StoppingCriterion->IsSatisfied())
+        if (this->CheckTopology(output, current_node))
+        {
+          if (m_CollectPoints)
           {
-            break;
+            m_ProcessedPoints->push_back(current_node_pair);
           }
 
-          if (this->CheckTopology(output, current_node))
-          {
-            if (m_CollectPoints)
-            {
-              m_ProcessedPoints->push_back(current_node_pair);
-            }
-
-            // set this node as alive
-            this->SetLabelValueForGivenNode(current_node, Traits::Alive);
+          // set this node as alive
+          this->SetLabelValueForGivenNode(current_node, Traits::Alive);
 
-            // update its neighbors
-            this->UpdateNeighbors(output, current_node);
-          }
+          // update its neighbors
+          this->UpdateNeighbors(output, current_node);
         }
-        progress.CompletedPixel();
       }
+      progress.CompletedPixel();
     }
   }
   catch (const ProcessAborted &)
@@ -178,14 +194,7 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
     // it.
     //
     // RELEASE MEMORY!!!
-    while (!m_Heap.empty())
-    {
-      m_Heap.pop();
-    }
-    /*while( !m_Heap->Empty() )
-      {
-      m_Heap->Pop();
-      }*/
+    m_Heap.Clear();
 
     throw ProcessAborted(__FILE__, __LINE__);
   }
@@ -193,14 +202,7 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
   m_TargetReachedValue = current_value;
 
   // let's release some useless memory...
-  while (!m_Heap.empty())
-  {
-    m_Heap.pop();
-  }
-  /*while( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }*/
+  m_Heap.Clear();
 }
 // -----------------------------------------------------------------------------
 
@@ -107,6 +107,11 @@ void
 FastMarchingExtensionImageFilterBase<TInput, TOutput, TAuxValue, VAuxDimension>::InitializeOutput(
   OutputImageType * oImage)
 {
+  if (this->m_UseFastIterativeMethod)
+  {
+    itkExceptionStringMacro("The fast iterative method does not compute the auxiliary values");
+  }
+
   this->Superclass::InitializeOutput(oImage);
 
   if (!m_AuxiliaryAliveValues)
@@ -223,10 +228,7 @@ FastMarchingExtensionImageFilterBase<TInput, TOutput, TAuxValue, VAuxDimension>:
     // insert point into trial heap
     this->m_LabelImage->SetPixel(iNode, Traits::Trial);
 
-    // node.SetValue( outputPixel );
-    // node.SetIndex( index );
-    // m_TrialHeap.push(node);
-    this->m_Heap.push(NodePairType(iNode, outputPixel));
+    this->m_Heap.Push(this->GetNodeIdentifier(iNode), outputPixel);
 
     // update auxiliary values
     for (unsigned int k = 0; k < AuxDimension; ++k)
@@ -58,6 +58,11 @@ namespace itk
  *
  * Implementation of this class is based on \cite sethian1999a.
  *
+ * For large images, the arrival times can instead be computed with the
+ * Fast Iterative Method (see SetUseFastIterativeMethod()), which updates
+ * blocks of pixels in parallel until their values converge, instead of
+ * freezing the nodes one at a time in increasing order.
+ *
  * For an alternative implementation, see itk::FastMarchingImageFilter.
  *
  * \tparam TTraits traits
@@ -157,6 +162,26 @@ public:
   itkGetConstReferenceMacro(OverrideOutputInformation, bool);
   itkBooleanMacro(OverrideOutputInformation);
   /** @ITKEndGrouping */
+
+  /** Set/Get whether the arrival times are computed with the Fast Iterative
+   * Method \cite jeong2008a rather than by marching the nodes in order.
+   *
+   * The image is split into blocks of about 4096 pixels. The blocks reached
+   * by the front are swept in parallel, using the current value of all their
+   * neighbors, until their values no longer decrease, and the neighbor
+   * blocks of the blocks whose border changed are swept next. The values
+   * converge to the ones of the fast marching, up to the rounding of the
+   * values. The stopping criterion is then applied to the nodes sorted by
+   * value, so the alive, trial and processed nodes are the ones of the fast
+   * marching. The nodes above the threshold of a
+   * FastMarchingThresholdStoppingCriterion are not propagated.
+   *
+   * Topology checks are not supported by this method. Default is false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseFastIterativeMethod, bool);
+  itkGetConstReferenceMacro(UseFastIterativeMethod, bool);
+  itkBooleanMacro(UseFastIterativeMethod);
+  /** @ITKEndGrouping */
 protected:
   FastMarchingImageFilterBase();
 
@@ -174,6 +199,14 @@ protected:
   OutputSpacingType   m_OutputSpacing{};
   OutputDirectionType m_OutputDirection{};
   bool                m_OverrideOutputInformation{ false };
+  bool                m_UseFastIterativeMethod{ false };
+
+  void
+  GenerateData() override;
+
+  /** Computes the output with the Fast Iterative Method. */
+  void
+  GenerateDataWithFastIterativeMethod();
 
   /** Generate the output image meta information. */
   void
@@ -189,6 +222,14 @@ protected:
   [[nodiscard]] IdentifierType
   GetTotalNumberOfNodes() const override;
 
+  /** The identifier of a node is its offset in the buffered region */
+  /** @ITKStartGrouping */
+  [[nodiscard]] IdentifierType
+  GetNodeIdentifier(const NodeType & iNode) const override;
+  [[nodiscard]] NodeType
+  GetNodeFromIdentifier(IdentifierType iIdentifier) const override;
+  /** @ITKEndGrouping */
+
   void
   SetOutputValue(OutputImageType * oImage, const NodeType & iNode, const OutputPixelType & iValue) override;
 
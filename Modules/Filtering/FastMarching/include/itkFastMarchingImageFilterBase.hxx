@@ -21,7 +21,10 @@
 
 
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkConnectedComponentImageFilter.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkProgressReporter.h"
 #include "itkRelabelComponentImageFilter.h"
 
 #include <algorithm>
@@ -103,6 +106,307 @@ FastMarchingImageFilterBase<TInput, TOutput>::EnlargeOutputRequestedRegion(DataO
   }
 }
 
+template <typename TInput, typename TOutput>
+void
+FastMarchingImageFilterBase<TInput, TOutput>::GenerateData()
+{
+  if (m_UseFastIterativeMethod)
+  {
+    this->GenerateDataWithFastIterativeMethod();
+  }
+  else
+  {
+    Superclass::GenerateData();
+  }
+}
+
+template <typename TInput, typename TOutput>
+void
+FastMarchingImageFilterBase<TInput, TOutput>::GenerateDataWithFastIterativeMethod()
+{
+  if (this->m_TopologyCheck != Superclass::TopologyCheckEnum::Nothing)
+  {
+    itkExceptionStringMacro("Topology checks are not supported by the fast iterative method");
+  }
+
+  OutputImageType * output = this->GetOutput();
+
+  this->Initialize(output);
+
+  // The trial points keep their value until they are alive, they are not
+  // popped from the heap by this method.
+  this->m_Heap.Clear();
+
+  this->m_StoppingCriterion->Reinitialize();
+
+  // The value of a node is larger than the values it is computed from, so the
+  // nodes above the threshold do not contribute to the nodes below it.
+  double maximumValue = this->m_LargeValue;
+  using ThresholdStoppingCriterionType = FastMarchingThresholdStoppingCriterion<TInput, TOutput>;
+  if (auto * thresholdCriterion =
+        dynamic_cast<ThresholdStoppingCriterionType *>(this->m_StoppingCriterion.GetPointer()))
+  {
+    maximumValue = std::min(maximumValue, static_cast<double>(thresholdCriterion->GetThreshold()));
+  }
+
+  OutputPixelType * const       values = output->GetBufferPointer();
+  unsigned char * const         labels = m_LabelImage->GetBufferPointer();
+  const OffsetValueType * const offsetTable = m_LabelImage->GetOffsetTable();
+  const OutputSizeType          regionSize = m_BufferedRegion.GetSize();
+
+  // Blocks of about 4096 pixels
+  const auto blockEdge =
+    std::max(SizeValueType{ 2 }, static_cast<SizeValueType>(std::round(std::pow(4096.0, 1.0 / ImageDimension))));
+  OutputSizeType numberOfBlocksPerDimension;
+  SizeValueType  numberOfBlocks = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    numberOfBlocksPerDimension[d] = (regionSize[d] + blockEdge - 1) / blockEdge;
+    numberOfBlocks *= numberOfBlocksPerDimension[d];
+  }
+  const auto getBlockIndex = [&numberOfBlocksPerDimension](SizeValueType block) {
+    OutputSizeType blockIndex;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      blockIndex[d] = block % numberOfBlocksPerDimension[d];
+      block /= numberOfBlocksPerDimension[d];
+    }
+    return blockIndex;
+  };
+  const auto getBlock = [&numberOfBlocksPerDimension](const OutputSizeType & blockIndex) {
+    SizeValueType block = 0;
+    for (unsigned int d = ImageDimension; d > 0; --d)
+    {
+      block = block * numberOfBlocksPerDimension[d - 1] + blockIndex[d - 1];
+    }
+    return block;
+  };
+
+  // A block is swept again when its values did not converge, and its face
+  // neighbors are swept when the values on their common face changed.
+  std::vector<char>         activeBlocks(numberOfBlocks, 0);
+  std::vector<char>         unconvergedBlocks(numberOfBlocks, 0);
+  std::vector<unsigned int> changedFaces(numberOfBlocks, 0);
+  const auto                activateFaces = [&](SizeValueType block, unsigned int faces) {
+    const OutputSizeType blockIndex = getBlockIndex(block);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if ((faces & (1u << (2 * d))) && blockIndex[d] > 0)
+      {
+        OutputSizeType neighbor = blockIndex;
+        --neighbor[d];
+        activeBlocks[getBlock(neighbor)] = 1;
+      }
+      if ((faces & (1u << (2 * d + 1))) && blockIndex[d] + 1 < numberOfBlocksPerDimension[d])
+      {
+        OutputSizeType neighbor = blockIndex;
+        ++neighbor[d];
+        activeBlocks[getBlock(neighbor)] = 1;
+      }
+    }
+  };
+
+  // The front starts from the trial points
+  for (auto pointsIter = this->m_TrialPoints->Begin(); pointsIter != this->m_TrialPoints->End(); ++pointsIter)
+  {
+    const NodeType node = pointsIter->Value().GetNode();
+    if (m_BufferedRegion.IsInside(node))
+    {
+      OutputSizeType blockIndex;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        blockIndex[d] = static_cast<SizeValueType>(node[d] - m_StartIndex[d]) / blockEdge;
+      }
+      const SizeValueType block = getBlock(blockIndex);
+      activeBlocks[block] = 1;
+      activateFaces(block, ~0u);
+    }
+  }
+
+  // Sweeps a block alternately forward and backward, until its values no
+  // longer decrease. Returns whether they converged, and sets the faces of
+  // the block on which values changed.
+  constexpr unsigned int maximumNumberOfSweeps = 4;
+  const auto             sweepBlock = [&](SizeValueType block) {
+    const OutputSizeType blockIndex = getBlockIndex(block);
+    OutputRegionType     blockRegion;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const SizeValueType begin = blockIndex[d] * blockEdge;
+      blockRegion.SetIndex(d, m_StartIndex[d] + static_cast<IndexValueType>(begin));
+      blockRegion.SetSize(d, std::min(blockEdge, regionSize[d] - begin));
+    }
+    const NodeType blockFirst = blockRegion.GetIndex();
+    const NodeType blockLast = blockRegion.GetUpperIndex();
+
+    unsigned int faces = 0;
+    bool         changed = true;
+    const auto   updateNode = [&](const NodeType & node) {
+      const OffsetValueType offset = m_LabelImage->ComputeOffset(node);
+      const unsigned char   label = labels[offset];
+      if (label == Traits::Alive || label == Traits::InitialTrial || label == Traits::Forbidden)
+      {
+        return;
+      }
+
+      InternalNodeStructureArray neighbors;
+      bool                       reached = false;
+      for (unsigned int j = 0; j < ImageDimension; ++j)
+      {
+        OutputPixelType       neighborValue = this->m_LargeValue;
+        const OffsetValueType stride = offsetTable[j];
+        if (node[j] > m_StartIndex[j] && labels[offset - stride] != Traits::Forbidden)
+        {
+          neighborValue = std::min(neighborValue, values[offset - stride]);
+        }
+        if (node[j] < m_LastIndex[j] && labels[offset + stride] != Traits::Forbidden)
+        {
+          neighborValue = std::min(neighborValue, values[offset + stride]);
+        }
+        neighbors[j].m_Value = neighborValue;
+        neighbors[j].m_Axis = j;
+        reached = reached || neighborValue < this->m_LargeValue;
+      }
+      if (!reached)
+      {
+        return;
+      }
+
+      const double solution = this->Solve(output, node, neighbors);
+      if (solution > maximumValue || !(static_cast<OutputPixelType>(solution) < values[offset]))
+      {
+        return;
+      }
+      values[offset] = static_cast<OutputPixelType>(solution);
+      changed = true;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        faces |= (node[d] == blockFirst[d]) ? (1u << (2 * d)) : 0u;
+        faces |= (node[d] == blockLast[d]) ? (1u << (2 * d + 1)) : 0u;
+      }
+    };
+
+    ImageRegionConstIteratorWithIndex<LabelImageType> it(m_LabelImage, blockRegion);
+    for (unsigned int sweep = 0; changed && sweep < maximumNumberOfSweeps; ++sweep)
+    {
+      changed = false;
+      if (sweep % 2 == 0)
+      {
+        for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+        {
+          updateNode(it.GetIndex());
+        }
+      }
+      else
+      {
+        for (it.GoToReverseBegin(); !it.IsAtReverseEnd(); --it)
+        {
+          updateNode(it.GetIndex());
+        }
+      }
+    }
+    unconvergedBlocks[block] = changed;
+    changedFaces[block] = faces;
+  };
+
+  // Face neighbor blocks have different colors, so the blocks of a color
+  // read the values of the blocks of the other color, but never write them.
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  std::vector<SizeValueType> blocks;
+  bool                       anyActiveBlock = true;
+  while (anyActiveBlock)
+  {
+    for (unsigned int color = 0; color < 2; ++color)
+    {
+      blocks.clear();
+      for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+      {
+        if (activeBlocks[block])
+        {
+          const OutputSizeType blockIndex = getBlockIndex(block);
+          SizeValueType        blockColor = 0;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            blockColor += blockIndex[d];
+          }
+          if (blockColor % 2 == color)
+          {
+            activeBlocks[block] = 0;
+            blocks.push_back(block);
+          }
+        }
+      }
+      multiThreader->ParallelizeArray(
+        0, blocks.size(), [&](SizeValueType i) { sweepBlock(blocks[i]); }, nullptr);
+      for (const SizeValueType block : blocks)
+      {
+        activeBlocks[block] = activeBlocks[block] || unconvergedBlocks[block];
+        activateFaces(block, changedFaces[block]);
+      }
+    }
+    anyActiveBlock = std::any_of(activeBlocks.begin(), activeBlocks.end(), [](char active) { return active != 0; });
+  }
+
+  // The stopping criterion is applied to the nodes by increasing value, as
+  // they would be made alive by the fast marching.
+  std::vector<std::pair<OutputPixelType, OffsetValueType>> reachedNodes;
+  const SizeValueType                                      numberOfPixels = m_BufferedRegion.GetNumberOfPixels();
+  for (SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    if (labels[i] == Traits::InitialTrial || (labels[i] == Traits::Far && values[i] < this->m_LargeValue))
+    {
+      reachedNodes.emplace_back(values[i], static_cast<OffsetValueType>(i));
+    }
+  }
+  std::sort(reachedNodes.begin(), reachedNodes.end());
+
+  ProgressReporter progress(this, 0, this->GetTotalNumberOfNodes());
+
+  OutputPixelType current_value{};
+  auto            reachedNode = reachedNodes.cbegin();
+  for (; reachedNode != reachedNodes.cend(); ++reachedNode)
+  {
+    const NodePairType current_node_pair(m_LabelImage->ComputeIndex(reachedNode->second), reachedNode->first);
+    current_value = reachedNode->first;
+
+    this->m_StoppingCriterion->SetCurrentNodePair(current_node_pair);
+    if (this->m_StoppingCriterion->IsSatisfied())
+    {
+      break;
+    }
+    if (this->m_CollectPoints)
+    {
+      this->m_ProcessedPoints->push_back(current_node_pair);
+    }
+    labels[reachedNode->second] = Traits::Alive;
+    progress.CompletedPixel();
+  }
+
+  // The nodes which are not alive are far, or trial with the value computed
+  // from their alive neighbors.
+  for (auto farNode = reachedNode; farNode != reachedNodes.cend(); ++farNode)
+  {
+    if (labels[farNode->second] == Traits::Far)
+    {
+      values[farNode->second] = this->m_LargeValue;
+    }
+  }
+  for (auto aliveNode = reachedNodes.cbegin(); aliveNode != reachedNode; ++aliveNode)
+  {
+    this->UpdateNeighbors(output, m_LabelImage->ComputeIndex(aliveNode->second));
+  }
+
+  // When all the nodes below the threshold are alive, the fast marching
+  // stops at the first trial node, which is above the threshold.
+  if (reachedNode == reachedNodes.cend() && !this->m_Heap.IsEmpty())
+  {
+    current_value = this->m_Heap.Top().second;
+  }
+  this->m_TargetReachedValue = current_value;
+  this->m_Heap.Clear();
+}
+
 template <typename TInput, typename TOutput>
 IdentifierType
 FastMarchingImageFilterBase<TInput, TOutput>::GetTotalNumberOfNodes() const
@@ -110,6 +414,20 @@ FastMarchingImageFilterBase<TInput, TOutput>::GetTotalNumberOfNodes() const
   return this->m_BufferedRegion.GetNumberOfPixels();
 }
 
+template <typename TInput, typename TOutput>
+IdentifierType
+FastMarchingImageFilterBase<TInput, TOutput>::GetNodeIdentifier(const NodeType & iNode) const
+{
+  return static_cast<IdentifierType>(m_LabelImage->ComputeOffset(iNode));
+}
+
+template <typename TInput, typename TOutput>
+auto
+FastMarchingImageFilterBase<TInput, TOutput>::GetNodeFromIdentifier(IdentifierType iIdentifier) const -> NodeType
+{
+  return m_LabelImage->ComputeIndex(static_cast<OffsetValueType>(iIdentifier));
+}
+
 template <typename TInput, typename TOutput>
 void
 FastMarchingImageFilterBase<TInput, TOutput>::SetOutputValue(OutputImageType *       oImage,
@@ -191,7 +509,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::UpdateValue(OutputImageType * oIma
     this->SetLabelValueForGivenNode(iNode, Traits::Trial);
 
     // Insert point into trial heap
-    this->m_Heap.push(NodePairType(iNode, outputPixel));
+    this->m_Heap.Push(this->GetNodeIdentifier(iNode), outputPixel);
   }
 }
 
@@ -549,8 +867,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::InitializeOutput(OutputImageType *
         outputPixel = pointsIter->Value().GetValue();
         this->SetOutputValue(oImage, idx, outputPixel);
 
-        // this->m_Heap->Push( PriorityQueueElementType( idx, pointsIter->second ) );
-        this->m_Heap.push(pointsIter->Value());
+        this->m_Heap.Push(this->GetNodeIdentifier(idx), outputPixel);
       }
       ++pointsIter;
     }
@@ -1002,6 +1319,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::PrintSelf(std::ostream & os, Inden
   os << indent << "OutputDirection: " << m_OutputDirection << std::endl;
 
   os << indent << "OverrideOutputInformation: " << m_OverrideOutputInformation << std::endl;
+  os << indent << "UseFastIterativeMethod: " << m_UseFastIterativeMethod << std::endl;
 
   itkPrintSelfObjectMacro(LabelImage);
 
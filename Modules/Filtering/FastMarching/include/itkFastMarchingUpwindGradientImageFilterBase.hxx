@@ -58,6 +58,11 @@ template <typename TInput, typename TOutput>
 void
 FastMarchingUpwindGradientImageFilterBase<TInput, TOutput>::InitializeOutput(OutputImageType * output)
 {
+  if (this->m_UseFastIterativeMethod)
+  {
+    itkExceptionStringMacro("The fast iterative method does not compute the gradient image");
+  }
+
   Superclass::InitializeOutput(output);
 
   // allocate memory for the GradientImage if requested
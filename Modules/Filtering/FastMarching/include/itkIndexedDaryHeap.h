@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIndexedDaryHeap_h
+#define itkIndexedDaryHeap_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class IndexedDaryHeap
+ * \brief Min-heap of identifiers with a priority each, which can change the
+ * priority of an identifier already in the heap.
+ *
+ * The identifiers are integers, such as the offset of a pixel in its buffer
+ * or a point identifier. Each of them is in the heap at most once: pushing an
+ * identifier which is already in the heap changes its priority (the usual
+ * decrease-key operation), instead of adding a duplicate which would have to
+ * be skipped when popped. The position of every identifier in the heap is
+ * stored in an array indexed by the identifier, which grows as needed up to
+ * the largest identifier pushed. The positions are 32-bit, i.e. 4 bytes per
+ * identifier, so the heap itself holds less than 2^32 - 1 identifiers at a
+ * time.
+ *
+ * The heap is a VArity-ary tree stored in a contiguous array of
+ * (priority, identifier) pairs: with the default 4 children per node, the
+ * children of a node are on a single cache line and the tree is half as
+ * deep as a binary tree.
+ *
+ * Identifiers of equal priority are popped by increasing identifier, so the
+ * order does not depend on the order of the pushes.
+ *
+ * \sa FastMarchingBase
+ * \ingroup ITKFastMarching
+ */
+template <typename TPriority, unsigned int VArity = 4>
+class IndexedDaryHeap
+{
+public:
+  static_assert(VArity >= 2, "The heap needs at least two children per node");
+
+  using PriorityType = TPriority;
+  using IdentifierType = SizeValueType;
+
+  static constexpr unsigned int Arity = VArity;
+
+  bool
+  IsEmpty() const
+  {
+    return m_Elements.empty();
+  }
+
+  SizeValueType
+  GetSize() const
+  {
+    return m_Elements.size();
+  }
+
+  /** Allocates the positions of the identifiers lower than numberOfIdentifiers.
+   * Optional: the positions grow as the identifiers are pushed. */
+  void
+  Reserve(SizeValueType numberOfIdentifiers)
+  {
+    if (numberOfIdentifiers > m_Positions.size())
+    {
+      m_Positions.resize(numberOfIdentifiers, NotInHeap);
+    }
+  }
+
+  bool
+  Contains(IdentifierType identifier) const
+  {
+    return identifier < m_Positions.size() && m_Positions[identifier] != NotInHeap;
+  }
+
+  /** Priority of an identifier which is in the heap. */
+  TPriority
+  GetPriority(IdentifierType identifier) const
+  {
+    return m_Elements[m_Positions[identifier]].m_Priority;
+  }
+
+  /** Inserts the identifier, or changes its priority if it is already in the heap. */
+  void
+  Push(IdentifierType identifier, TPriority priority)
+  {
+    this->Reserve(identifier + 1);
+    const Element element{ priority, identifier };
+    const PositionType position = m_Positions[identifier];
+    if (position == NotInHeap)
+    {
+      if (m_Elements.size() >= NotInHeap)
+      {
+        itkGenericExceptionMacro("IndexedDaryHeap cannot hold more than " << NotInHeap - 1 << " identifiers");
+      }
+      m_Elements.emplace_back();
+      this->SiftUp(m_Elements.size() - 1, element);
+    }
+    else if (Less(element, m_Elements[position]))
+    {
+      this->SiftUp(position, element);
+    }
+    else
+    {
+      this->SiftDown(position, element);
+    }
+  }
+
+  /** Identifier and priority of the lowest priority. The heap must not be empty. */
+  std::pair<IdentifierType, TPriority>
+  Top() const
+  {
+    return { m_Elements.front().m_Identifier, m_Elements.front().m_Priority };
+  }
+
+  /** Removes the identifier of lowest priority, and returns it with its
+   * priority. The heap must not be empty. */
+  std::pair<IdentifierType, TPriority>
+  Pop()
+  {
+    const Element top = m_Elements.front();
+    m_Positions[top.m_Identifier] = NotInHeap;
+    const Element last = m_Elements.back();
+    m_Elements.pop_back();
+    if (!m_Elements.empty())
+    {
+      this->SiftDown(0, last);
+    }
+    return { top.m_Identifier, top.m_Priority };
+  }
+
+  /** Removes all the identifiers, and releases the memory. */
+  void
+  Clear()
+  {
+    std::vector<Element>().swap(m_Elements);
+    std::vector<PositionType>().swap(m_Positions);
+  }
+
+private:
+  // Position in m_Elements. 32 bits, to halve the memory of the positions,
+  // which are indexed by identifier.
+  using PositionType = std::uint32_t;
+
+  static constexpr PositionType NotInHeap = std::numeric_limits<PositionType>::max();
+
+  struct Element
+  {
+    TPriority      m_Priority;
+    IdentifierType m_Identifier;
+  };
+
+  static bool
+  Less(const Element & left, const Element & right)
+  {
+    return left.m_Priority < right.m_Priority ||
+           (!(right.m_Priority < left.m_Priority) && left.m_Identifier < right.m_Identifier);
+  }
+
+  // Moves the hole at position towards the root until the element fits in it.
+  void
+  SiftUp(SizeValueType position, const Element & element)
+  {
+    while (position > 0)
+    {
+      const SizeValueType parent = (position - 1) / VArity;
+      if (!Less(element, m_Elements[parent]))
+      {
+        break;
+      }
+      this->Place(position, m_Elements[parent]);
+      position = parent;
+    }
+    this->Place(position, element);
+  }
+
+  // Moves the hole at position towards the leaves until the element fits in it.
+  void
+  SiftDown(SizeValueType position, const Element & element)
+  {
+    const SizeValueType size = m_Elements.size();
+    for (;;)
+    {
+      const SizeValueType firstChild = VArity * position + 1;
+      if (firstChild >= size)
+      {
+        break;
+      }
+      const SizeValueType endChild = std::min(firstChild + VArity, size);
+      SizeValueType       smallest = firstChild;
+      for (SizeValueType child = firstChild + 1; child < endChild; ++child)
+      {
+        if (Less(m_Elements[child], m_Elements[smallest]))
+        {
+          smallest = child;
+        }
+      }
+      if (!Less(m_Elements[smallest], element))
+      {
+        break;
+      }
+      this->Place(position, m_Elements[smallest]);
+      position = smallest;
+    }
+    this->Place(position, element);
+  }
+
+  void
+  Place(SizeValueType position, const Element & element)
+  {
+    m_Elements[position] = element;
+    m_Positions[element.m_Identifier] = static_cast<PositionType>(position);
+  }
+
+  std::vector<Element>      m_Elements{};
+  std::vector<PositionType> m_Positions{};
+};
+} // end namespace itk
+
+#endif
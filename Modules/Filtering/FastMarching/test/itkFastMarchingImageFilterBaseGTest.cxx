@@ -18,7 +18,10 @@
 
 #include "itkFastMarchingImageFilterBase.h"
 #include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkFastMarchingNumberOfElementsStoppingCriterion.h"
+#include "itkImageRegionConstIterator.h"
 #include "gtest/gtest.h"
+#include <random>
 
 namespace
 {
@@ -27,6 +30,46 @@ using FastMarchingType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
 using CriterionType = itk::FastMarchingThresholdStoppingCriterion<ImageType, ImageType>;
 using NodePairType = FastMarchingType::NodePairType;
 using NodePairContainerType = FastMarchingType::NodePairContainerType;
+
+using Image3DType = itk::Image<float, 3>;
+using FastMarching3DType = itk::FastMarchingImageFilterBase<Image3DType, Image3DType>;
+
+// Marches on a random speed image with anisotropic spacing, from a few trial
+// points, around a forbidden point.
+FastMarching3DType::Pointer
+MakeFastMarching3D(typename FastMarching3DType::StoppingCriterionType * criterion, bool useFastIterativeMethod)
+{
+  constexpr Image3DType::SizeType size{ { 45, 38, 21 } };
+
+  auto speedImage = Image3DType::New();
+  speedImage->SetRegions(size);
+  speedImage->SetSpacing(itk::MakeVector(1.0, 0.8, 1.5));
+  speedImage->Allocate();
+  std::mt19937                          generator(7);
+  std::uniform_real_distribution<float> speed(0.5f, 2.0f);
+  for (itk::ImageRegionIterator<Image3DType> it(speedImage, speedImage->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(speed(generator));
+  }
+
+  auto marcher = FastMarching3DType::New();
+  marcher->SetInput(speedImage);
+  marcher->SetStoppingCriterion(criterion);
+  marcher->SetCollectPoints(true);
+  marcher->SetUseFastIterativeMethod(useFastIterativeMethod);
+
+  auto trial = FastMarching3DType::NodePairContainerType::New();
+  trial->push_back(FastMarching3DType::NodePairType(itk::MakeIndex(3, 4, 5), 0.0));
+  trial->push_back(FastMarching3DType::NodePairType(itk::MakeIndex(40, 30, 2), 1.5));
+  trial->push_back(FastMarching3DType::NodePairType(itk::MakeIndex(20, 37, 20), 0.5));
+  marcher->SetTrialPoints(trial);
+
+  auto forbidden = FastMarching3DType::NodePairContainerType::New();
+  forbidden->push_back(FastMarching3DType::NodePairType(itk::MakeIndex(4, 4, 5), 0.0));
+  marcher->SetForbiddenPoints(forbidden);
+
+  return marcher;
+}
 } // namespace
 
 TEST(FastMarchingImageFilterBaseGTest, CornerSeedPropagatesAlongBothBoundaryAxes)
@@ -147,3 +190,104 @@ TEST(FastMarchingImageFilterBaseGTest, ZeroSpeedPixelStaysUnreachable)
 
   EXPECT_EQ(marcher->GetLabelImage()->GetPixel(itk::MakeIndex(1, 0)), FastMarchingType::Traits::Far);
 }
+
+TEST(FastMarchingImageFilterBaseGTest, FastIterativeMethodConvergesToFastMarching)
+{
+  auto criterion = itk::FastMarchingThresholdStoppingCriterion<Image3DType, Image3DType>::New();
+  criterion->SetThreshold(1e30);
+
+  const auto marcher = MakeFastMarching3D(criterion, false);
+  marcher->Update();
+  EXPECT_FALSE(marcher->GetUseFastIterativeMethod());
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 5 })
+  {
+    const auto iterativeMarcher = MakeFastMarching3D(criterion, true);
+    iterativeMarcher->SetNumberOfWorkUnits(numberOfWorkUnits);
+    iterativeMarcher->Update();
+
+    itk::ImageRegionConstIterator<Image3DType>                     expected(marcher->GetOutput(),
+                                                        marcher->GetOutput()->GetBufferedRegion());
+    itk::ImageRegionConstIterator<Image3DType>                     actual(iterativeMarcher->GetOutput(),
+                                                      iterativeMarcher->GetOutput()->GetBufferedRegion());
+    itk::ImageRegionConstIterator<FastMarching3DType::LabelImageType> expectedLabel(
+      marcher->GetLabelImage(), marcher->GetLabelImage()->GetBufferedRegion());
+    itk::ImageRegionConstIterator<FastMarching3DType::LabelImageType> actualLabel(
+      iterativeMarcher->GetLabelImage(), iterativeMarcher->GetLabelImage()->GetBufferedRegion());
+    for (; !expected.IsAtEnd(); ++expected, ++actual, ++expectedLabel, ++actualLabel)
+    {
+      ASSERT_NEAR(expected.Get(), actual.Get(), 1e-4f * expected.Get()) << " at " << expected.GetIndex();
+      ASSERT_EQ(expectedLabel.Get(), actualLabel.Get()) << " at " << expected.GetIndex();
+    }
+    EXPECT_EQ(marcher->GetProcessedPoints()->size(), iterativeMarcher->GetProcessedPoints()->size());
+    EXPECT_NEAR(marcher->GetTargetReachedValue(),
+                iterativeMarcher->GetTargetReachedValue(),
+                1e-4f * marcher->GetTargetReachedValue());
+  }
+}
+
+TEST(FastMarchingImageFilterBaseGTest, FastIterativeMethodAppliesStoppingCriteria)
+{
+  auto threshold = itk::FastMarchingThresholdStoppingCriterion<Image3DType, Image3DType>::New();
+  threshold->SetThreshold(9.0);
+  auto numberOfElements = itk::FastMarchingNumberOfElementsStoppingCriterion<Image3DType, Image3DType>::New();
+  numberOfElements->SetTargetNumberOfElements(5000);
+
+  for (FastMarching3DType::StoppingCriterionType * criterion :
+       std::initializer_list<FastMarching3DType::StoppingCriterionType *>{ threshold, numberOfElements })
+  {
+    const auto marcher = MakeFastMarching3D(criterion, false);
+    marcher->Update();
+    const auto iterativeMarcher = MakeFastMarching3D(criterion, true);
+    iterativeMarcher->Update();
+
+    // The nodes are made alive in the same order, except for the nodes whose
+    // values are within the rounding errors of each other.
+    const auto & processed = *marcher->GetProcessedPoints();
+    const auto & iterativeProcessed = *iterativeMarcher->GetProcessedPoints();
+    ASSERT_EQ(processed.size(), iterativeProcessed.size());
+    ASSERT_GT(processed.size(), 1000u);
+    for (size_t i = 0; i < processed.size(); ++i)
+    {
+      EXPECT_NEAR(processed[i].GetValue(), iterativeProcessed[i].GetValue(), 1e-4f * processed[i].GetValue());
+    }
+    EXPECT_NEAR(marcher->GetTargetReachedValue(),
+                iterativeMarcher->GetTargetReachedValue(),
+                1e-4f * marcher->GetTargetReachedValue());
+
+    // The nodes next to the alive nodes are trial, with the same values
+    unsigned int numberOfTrialNodes = 0;
+    for (itk::ImageRegionConstIteratorWithIndex<FastMarching3DType::LabelImageType> it(
+           marcher->GetLabelImage(), marcher->GetLabelImage()->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      const float expectedValue = marcher->GetOutput()->GetPixel(it.GetIndex());
+      if (it.Get() == FastMarching3DType::Traits::Trial && expectedValue > marcher->GetTargetReachedValue() + 1e-3f)
+      {
+        ++numberOfTrialNodes;
+        EXPECT_EQ(FastMarching3DType::Traits::Trial, iterativeMarcher->GetLabelImage()->GetPixel(it.GetIndex()));
+        EXPECT_NEAR(expectedValue, iterativeMarcher->GetOutput()->GetPixel(it.GetIndex()), 1e-4f * expectedValue);
+      }
+    }
+    EXPECT_GT(numberOfTrialNodes, 100u);
+  }
+}
+
+TEST(FastMarchingImageFilterBaseGTest, FastIterativeMethodRejectsTopologyChecks)
+{
+  auto criterion = CriterionType::New();
+  criterion->SetThreshold(100.0);
+
+  auto marcher = FastMarchingType::New();
+  marcher->SetOutputSize(ImageType::SizeType{ { 8, 8 } });
+  marcher->SetStoppingCriterion(criterion);
+  marcher->SetTopologyCheck(FastMarchingType::TopologyCheckEnum::Strict);
+  marcher->UseFastIterativeMethodOn();
+
+  auto trial = NodePairContainerType::New();
+  trial->push_back(NodePairType(itk::MakeIndex(0, 0), 0.0));
+  marcher->SetTrialPoints(trial);
+
+  EXPECT_THROW(marcher->Update(), itk::ExceptionObject);
+}
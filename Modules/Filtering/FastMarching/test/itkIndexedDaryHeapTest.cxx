@@ -0,0 +1,118 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkIndexedDaryHeap.h"
+
+#include <iostream>
+#include <random>
+#include <set>
+
+namespace
+{
+// Pushes, updates and pops random identifiers, and checks the heap against
+// a set of (priority, identifier) pairs.
+template <unsigned int VArity>
+bool
+PopsLikeOrderedSet()
+{
+  std::mt19937                          generator(42);
+  std::uniform_int_distribution<int>    priorityDistribution(0, 100);
+  std::uniform_int_distribution<size_t> identifierDistribution(0, 499);
+
+  itk::IndexedDaryHeap<float, VArity> heap;
+  std::set<std::pair<float, size_t>>  reference;
+  std::vector<float>                  priorities(500, -1.0f);
+
+  heap.Reserve(100);
+  for (unsigned int operation = 0; operation < 20000; ++operation)
+  {
+    if (generator() % 3 != 0 || reference.empty())
+    {
+      // Insertion, or increase or decrease of the priority of an identifier in the heap
+      const size_t identifier = identifierDistribution(generator);
+      const auto   priority = static_cast<float>(priorityDistribution(generator)) / 4.0f;
+      if (priorities[identifier] >= 0.0f)
+      {
+        reference.erase({ priorities[identifier], identifier });
+      }
+      heap.Push(identifier, priority);
+      reference.insert({ priority, identifier });
+      priorities[identifier] = priority;
+      if (!heap.Contains(identifier) || heap.GetPriority(identifier) != priority)
+      {
+        std::cerr << "Identifier " << identifier << " is not in the heap with priority " << priority << std::endl;
+        return false;
+      }
+    }
+    else
+    {
+      const auto top = heap.Top();
+      const auto [identifier, priority] = heap.Pop();
+      const auto expected = *reference.begin();
+      reference.erase(reference.begin());
+      priorities[expected.second] = -1.0f;
+      if (identifier != top.first || identifier != expected.second || priority != expected.first ||
+          heap.Contains(identifier))
+      {
+        std::cerr << "Popped " << identifier << " at " << priority << " instead of " << expected.second << " at "
+                  << expected.first << std::endl;
+        return false;
+      }
+    }
+    if (heap.GetSize() != reference.size())
+    {
+      std::cerr << "The heap has " << heap.GetSize() << " identifiers instead of " << reference.size() << std::endl;
+      return false;
+    }
+  }
+
+  heap.Clear();
+  if (!heap.IsEmpty() || heap.Contains(0))
+  {
+    std::cerr << "The heap is not empty after Clear()" << std::endl;
+    return false;
+  }
+
+  // The positions grow with the identifiers pushed, without Reserve()
+  heap.Push(1000000, 2.0f);
+  heap.Push(3, 1.0f);
+  if (heap.Contains(999999) || !heap.Contains(1000000) || heap.Pop().first != 3 || heap.Pop().first != 1000000)
+  {
+    std::cerr << "Failed to push identifiers beyond the reserved positions" << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkIndexedDaryHeapTest(int, char *[])
+{
+  bool success = true;
+  success = PopsLikeOrderedSet<2>() && success;
+  success = PopsLikeOrderedSet<4>() && success;
+  success = PopsLikeOrderedSet<7>() && success;
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
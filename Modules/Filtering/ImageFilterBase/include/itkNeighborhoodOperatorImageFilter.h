@@ -35,6 +35,15 @@ namespace itk
  * with the image region.  Apply the mirror()'d operator for
  * non-symmetric NeighborhoodOperators.
  *
+ * When the operator is one dimensional (its radius is zero along all
+ * the directions but one), as it is for the separable Gaussian and
+ * derivative operators, and the pixels are scalars, each line of the
+ * output region is computed at once: the input line is copied into a
+ * contiguous buffer padded by the boundary condition, and the operator
+ * is applied to the buffer one coefficient at a time. The result is
+ * the same as with the neighborhood inner product, but without the
+ * per-pixel neighborhood iterator and boundary checking overhead.
+ *
  * \ingroup ImageFilters
  *
  * \sa Image
@@ -172,6 +181,11 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Compute the output region line by line along the given direction, for
+   * an operator whose radius is zero in all the other directions. */
+  void
+  GenerateDataAlongLines(const OutputImageRegionType & outputRegionForThread, unsigned int direction);
+
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override
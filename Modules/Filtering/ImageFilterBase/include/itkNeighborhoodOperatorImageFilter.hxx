@@ -22,8 +22,13 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkNeighborhoodInnerProduct.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageLinearConstIteratorWithIndex.h"
+#include "itkImageLinearIteratorWithIndex.h"
 #include "itkConstNeighborhoodIterator.h"
 #include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -76,6 +81,35 @@ void
 NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if constexpr (std::is_arithmetic_v<InputPixelType> && std::is_arithmetic_v<OutputPixelType>)
+  {
+    // Look for a one dimensional operator
+    const auto   radius = m_Operator.GetRadius();
+    unsigned int direction = 0;
+    unsigned int numberOfNonZeroRadii = 0;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      if (radius[i] != 0)
+      {
+        direction = i;
+        ++numberOfNonZeroRadii;
+      }
+    }
+
+    // The boundary condition is evaluated on the largest possible region,
+    // while the neighborhood iterator uses it outside of the buffered region,
+    // so both must match along the operator direction
+    const InputImageType * input = this->GetInput();
+    const auto &           bufferedRegion = input->GetBufferedRegion();
+    const auto &           largestRegion = input->GetLargestPossibleRegion();
+    if (numberOfNonZeroRadii <= 1 && bufferedRegion.GetIndex(direction) == largestRegion.GetIndex(direction) &&
+        bufferedRegion.GetSize(direction) == largestRegion.GetSize(direction))
+    {
+      this->GenerateDataAlongLines(outputRegionForThread, direction);
+      return;
+    }
+  }
+
   using BFC = NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>;
   using FaceListType = typename BFC::FaceListType;
 
@@ -112,6 +146,105 @@ NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::
     }
   }
 }
+
+template <typename TInputImage, typename TOutputImage, typename TOperatorValueType>
+void
+NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::GenerateDataAlongLines(
+  const OutputImageRegionType & outputRegionForThread,
+  unsigned int                  direction)
+{
+  if constexpr (std::is_arithmetic_v<InputPixelType> && std::is_arithmetic_v<OutputPixelType>)
+  {
+    // Same types as in NeighborhoodInnerProduct, so the results are identical
+    using InputPixelRealType = typename NumericTraits<InputPixelType>::RealType;
+    using AccumulateRealType = typename NumericTraits<InputPixelRealType>::AccumulateType;
+    using OperatorRealType = typename NumericTraits<ComputingPixelType>::ValueType;
+
+    OutputImageType *      output = this->GetOutput();
+    const InputImageType * input = this->GetInput();
+
+    const auto           radius = static_cast<IndexValueType>(m_Operator.GetRadius(direction));
+    const auto           lineLength = static_cast<IndexValueType>(outputRegionForThread.GetSize(direction));
+    const IndexValueType bufferedBegin = input->GetBufferedRegion().GetIndex(direction);
+    const IndexValueType bufferedEnd = bufferedBegin + input->GetBufferedRegion().GetSize(direction);
+
+    TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+    if (lineLength == 0)
+    {
+      return;
+    }
+
+    // The operator coefficients along the line
+    std::vector<OperatorRealType> coefficients(m_Operator.Size());
+    for (size_t k = 0; k < coefficients.size(); ++k)
+    {
+      coefficients[k] = static_cast<OperatorRealType>(m_Operator[k]);
+    }
+
+    // The part of the input lines available in the buffer
+    const IndexValueType outputBegin = outputRegionForThread.GetIndex(direction);
+    const IndexValueType inputBegin = std::max(outputBegin - radius, bufferedBegin);
+    const IndexValueType inputEnd = std::min(outputBegin + lineLength + radius, bufferedEnd);
+
+    typename InputImageType::RegionType inputRegion = outputRegionForThread;
+    inputRegion.SetIndex(direction, inputBegin);
+    inputRegion.SetSize(direction, static_cast<SizeValueType>(inputEnd - inputBegin));
+
+    ImageLinearConstIteratorWithIndex<InputImageType> inputIt(input, inputRegion);
+    ImageLinearIteratorWithIndex<OutputImageType>     outputIt(output, outputRegionForThread);
+    inputIt.SetDirection(direction);
+    outputIt.SetDirection(direction);
+
+    std::vector<InputPixelRealType> line(lineLength + 2 * radius);
+    std::vector<AccumulateRealType> sums(lineLength);
+
+    for (inputIt.GoToBegin(), outputIt.GoToBegin(); !outputIt.IsAtEnd(); inputIt.NextLine(), outputIt.NextLine())
+    {
+      // Copy the input line, and use the boundary condition where it is out of the buffer
+      typename OutputImageType::IndexType index = outputIt.GetIndex();
+      const IndexValueType                lineBegin = index[direction] - radius;
+      for (IndexValueType k = 0; k < static_cast<IndexValueType>(line.size()); ++k)
+      {
+        index[direction] = lineBegin + k;
+        if (index[direction] < bufferedBegin || index[direction] >= bufferedEnd)
+        {
+          line[k] = static_cast<InputPixelRealType>(m_BoundsCondition->GetPixel(index, input));
+        }
+        else
+        {
+          line[k] = static_cast<InputPixelRealType>(inputIt.Get());
+          ++inputIt;
+        }
+      }
+
+      // Accumulate one coefficient at a time over the whole line, in the
+      // same order as the neighborhood inner product
+      std::fill(sums.begin(), sums.end(), AccumulateRealType{});
+      for (size_t k = 0; k < coefficients.size(); ++k)
+      {
+        const OperatorRealType     coefficient = coefficients[k];
+        const InputPixelRealType * shiftedLine = line.data() + k;
+        for (IndexValueType i = 0; i < lineLength; ++i)
+        {
+          sums[i] += static_cast<AccumulateRealType>(coefficient * shiftedLine[i]);
+        }
+      }
+
+      for (IndexValueType i = 0; i < lineLength; ++i, ++outputIt)
+      {
+        outputIt.Set(static_cast<OutputPixelType>(static_cast<ComputingPixelType>(sums[i])));
+      }
+      progress.Completed(lineLength);
+    }
+  }
+  else
+  {
+    (void)outputRegionForThread;
+    (void)direction;
+    itkExceptionStringMacro("Line by line computation requires scalar pixel types.");
+  }
+}
 } // end namespace itk
 
 #endif
@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkNeighborhoodOperatorImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkDerivativeOperator.h"
+#include "itkGaussianOperator.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkGTest.h"
+
+#include <random>
+
+namespace
+{
+using InputImageType = itk::Image<unsigned char, 3>;
+using OutputImageType = itk::Image<float, 3>;
+using FilterType = itk::NeighborhoodOperatorImageFilter<InputImageType, OutputImageType>;
+using OperatorType = FilterType::OutputNeighborhoodType;
+
+InputImageType::Pointer
+MakeRandomImage()
+{
+  auto                             image = InputImageType::New();
+  const InputImageType::RegionType region(itk::MakeIndex(-3, 2, 5), itk::MakeSize(31, 17, 9));
+  image->SetRegions(region);
+  image->Allocate();
+
+  std::mt19937                            generator(42);
+  std::uniform_int_distribution<unsigned> distribution(0, 255);
+  for (itk::ImageRegionIterator<InputImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<unsigned char>(distribution(generator)));
+  }
+  return image;
+}
+
+// The same operator, with an additional radius of 1 along another direction
+// filled with zeros, so the filter cannot use its line by line computation
+OperatorType
+PadOperator(const OperatorType & oper, unsigned int direction)
+{
+  auto radius = oper.GetRadius();
+  radius[(direction + 1) % 3] = 1;
+
+  OperatorType padded;
+  padded.SetRadius(radius);
+  for (unsigned int i = 0; i < padded.Size(); ++i)
+  {
+    padded[i] = 0;
+  }
+  for (unsigned int i = 0; i < oper.Size(); ++i)
+  {
+    padded[oper.GetOffset(i)] = oper[i];
+  }
+  return padded;
+}
+
+OutputImageType::Pointer
+Filter(const InputImageType *                        image,
+       const OperatorType &                          oper,
+       itk::ImageBoundaryCondition<InputImageType> * boundaryCondition,
+       const OutputImageType::RegionType &           requestedRegion)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetOperator(oper);
+  if (boundaryCondition)
+  {
+    filter->OverrideBoundaryCondition(boundaryCondition);
+  }
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+void
+ExpectSameOutput(const InputImageType *                        image,
+                 const OperatorType &                          oper,
+                 unsigned int                                  direction,
+                 itk::ImageBoundaryCondition<InputImageType> * boundaryCondition,
+                 const OutputImageType::RegionType &           requestedRegion)
+{
+  const auto lines = Filter(image, oper, boundaryCondition, requestedRegion);
+  const auto reference = Filter(image, PadOperator(oper, direction), boundaryCondition, requestedRegion);
+
+  itk::ImageRegionConstIterator<OutputImageType> lit(lines, requestedRegion);
+  itk::ImageRegionConstIterator<OutputImageType> rit(reference, requestedRegion);
+  for (; !lit.IsAtEnd(); ++lit, ++rit)
+  {
+    ASSERT_EQ(rit.Get(), lit.Get()) << "direction " << direction << " at " << lit.GetIndex();
+  }
+}
+
+} // namespace
+
+
+TEST(NeighborhoodOperatorImageFilter, LineOperatorsMatchNeighborhoodInnerProduct)
+{
+  const auto image = MakeRandomImage();
+  const auto largestRegion = image->GetLargestPossibleRegion();
+
+  // A requested region away from the borders along the direction 0 and 1,
+  // and touching the borders along the direction 2
+  OutputImageType::RegionType innerRegion = largestRegion;
+  innerRegion.ShrinkByRadius(itk::MakeSize(5, 3, 0));
+
+  itk::ConstantBoundaryCondition<InputImageType> constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(17);
+  itk::PeriodicBoundaryCondition<InputImageType> periodicBoundaryCondition;
+
+  for (unsigned int direction = 0; direction < 3; ++direction)
+  {
+    itk::GaussianOperator<float, 3> gaussian;
+    gaussian.SetDirection(direction);
+    gaussian.SetVariance(4.0);
+    gaussian.SetMaximumError(0.001);
+    gaussian.CreateDirectional();
+
+    itk::DerivativeOperator<float, 3> derivative;
+    derivative.SetDirection(direction);
+    derivative.SetOrder(1);
+    derivative.CreateDirectional();
+
+    for (const OperatorType & oper : { OperatorType(gaussian), OperatorType(derivative) })
+    {
+      ExpectSameOutput(image, oper, direction, nullptr, largestRegion);
+      ExpectSameOutput(image, oper, direction, &constantBoundaryCondition, largestRegion);
+      ExpectSameOutput(image, oper, direction, &periodicBoundaryCondition, largestRegion);
+      ExpectSameOutput(image, oper, direction, nullptr, innerRegion);
+      ExpectSameOutput(image, oper, direction, &periodicBoundaryCondition, innerRegion);
+    }
+  }
+}
@@ -21,12 +21,14 @@
 #include "itkFixedArray.h"
 #include "itkTransform.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkImageToImageFilter.h"
 #include "itkExtrapolateImageFunction.h"
 #include "itkLinearInterpolateImageFunction.h"
 #include "itkSize.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDataObjectDecorator.h"
+#include <vector>
 
 
 namespace itk
@@ -373,6 +375,30 @@ private:
   void
   InitializeTransform();
 
+  /** Same as LinearThreadedGenerateData(), but evaluates the pixels inside
+   * the buffer by kernel(continuousIndex), which interpolates without the
+   * virtual calls and bounds checks of the interpolator. */
+  template <typename TScanlineKernel>
+  void
+  ResampleScanlines(const OutputImageRegionType & outputRegionForThread, const TScanlineKernel & kernel);
+
+  /** The continuous input indices of the pixels of a scanline, and the
+   * buffers for interpolating them, which are reused for each scanline. */
+  struct ScanlineBuffers
+  {
+    std::vector<ContinuousInputIndexType> inputIndices;
+    std::vector<bool>                     isInside;
+    std::vector<ContinuousInputIndexType> insideIndices;
+    std::vector<InterpolatorOutputType>   values;
+  };
+
+  /** Sets the pixels of the scanline of outIt to the values at the input
+   * indices of the buffers. The interpolator is called once for all of the
+   * indices inside the buffer; the others are given the extrapolated value,
+   * or the default pixel value. */
+  void
+  InterpolateScanline(ImageScanlineIterator<TOutputImage> & outIt, ScanlineBuffers & buffers) const;
+
   SizeType                m_Size{};         // Size of the output image
   InterpolatorPointerType m_Interpolator{}; // Image function for
                                             // interpolation
@@ -26,9 +26,13 @@
 #include "itkSpecialCoordinatesImage.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkImageAlgorithm.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkBSplineInterpolateImageFunction.h"
 
 #include <algorithm>   // For max.
 #include <type_traits> // For is_same.
+#include <typeinfo>    // For typeid.
+#include <vector>
 #include "itkPrintHelper.h"
 
 namespace itk
@@ -379,44 +383,42 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   const bool isSpecialCoordinatesImage = (dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) != nullptr);
 
 
-  // Create an iterator that will walk the output region for this thread.
-
-  using OutputType = typename InterpolatorType::OutputType;
+  // The points of each scanline are transformed by a single call, and
+  // interpolated by a single call.
+  const SizeValueType                                  scanlineSize = outputRegionForThread.GetSize(0);
+  std::vector<typename TransformType::InputPointType>  transformInputPoints(scanlineSize);
+  std::vector<typename TransformType::OutputPointType> transformOutputPoints(scanlineSize);
+  ScanlineBuffers                                      buffers;
+  buffers.inputIndices.resize(scanlineSize);
+  buffers.isInside.resize(scanlineSize);
 
   // Walk the output region
-  for (ImageRegionIteratorWithIndex outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
+  for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
-    // Determine the index of the current output pixel
-
-    OutputPointType outputPoint; // Coordinates of current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
-
-    // Compute corresponding input pixel position
-    const InputPointType inputPoint = transformPtr->TransformPoint(outputPoint);
-
-    ContinuousInputIndexType inputIndex;
-    const bool               isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
-
-    OutputType value;
-    // Evaluate input at right position and copy to the output
-    if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
+    // Determine the coordinates of the output pixels of the scanline
+    IndexType index = outIt.ComputeIndex();
+    for (auto & transformInputPoint : transformInputPoints)
     {
-      value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-      outIt.Set(Self::CastPixelWithBoundsChecking(value));
+      OutputPointType outputPoint;
+      outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
+      transformInputPoint = outputPoint;
+      ++index[0];
     }
-    else
+
+    // Compute corresponding input pixel positions
+    transformPtr->TransformPoints(transformInputPoints.data(), transformOutputPoints.data(), scanlineSize);
+
+    for (SizeValueType i = 0; i < scanlineSize; ++i)
     {
-      if (m_Extrapolator.IsNull())
-      {
-        outIt.Set(m_DefaultPixelValue); // default background value
-      }
-      else
-      {
-        value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
-        outIt.Set(Self::CastPixelWithBoundsChecking(value));
-      }
+      const InputPointType       inputPoint = transformOutputPoints[i];
+      ContinuousInputIndexType & inputIndex = buffers.inputIndices[i];
+      const bool isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+      buffers.isInside[i] = m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput);
     }
-    progress.CompletedPixel();
+
+    // Evaluate input at right positions and copy to the output
+    this->InterpolateScanline(outIt, buffers);
+    progress.Completed(scanlineSize);
   }
 }
 
@@ -428,6 +430,49 @@ void
 ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
   LinearThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
 {
+  // The interpolators of ITK which are used most are called without virtual
+  // function calls, so that they can be inlined into the loop over the pixels.
+  if constexpr (std::is_same_v<InputImageType, Image<InputPixelType, InputImageDimension>> &&
+                std::is_arithmetic_v<InputPixelType> && !std::is_same_v<InputPixelType, bool>)
+  {
+    using NearestNeighborInterpolatorType =
+      NearestNeighborInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+    using BSplineInterpolatorType = BSplineInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+
+    const InterpolatorType & interpolatorReference = *m_Interpolator;
+    const std::type_info &   interpolatorType = typeid(interpolatorReference);
+
+    if (interpolatorType == typeid(NearestNeighborInterpolatorType))
+    {
+      const auto & interpolator = static_cast<const NearestNeighborInterpolatorType &>(*m_Interpolator);
+      this->ResampleScanlines(outputRegionForThread, [&interpolator](const ContinuousInputIndexType & index) {
+        return interpolator.NearestNeighborInterpolatorType::EvaluateAtContinuousIndex(index);
+      });
+      return;
+    }
+    if (interpolatorType == typeid(LinearInterpolatorType))
+    {
+      const auto & interpolator = static_cast<const LinearInterpolatorType &>(*m_Interpolator);
+      this->ResampleScanlines(outputRegionForThread, [&interpolator](const ContinuousInputIndexType & index) {
+        return interpolator.LinearInterpolatorType::EvaluateAtContinuousIndex(index);
+      });
+      return;
+    }
+    if (interpolatorType == typeid(BSplineInterpolatorType))
+    {
+      // The working space is allocated once, rather than for each pixel.
+      const auto &       interpolator = static_cast<const BSplineInterpolatorType &>(*m_Interpolator);
+      const unsigned int numberOfWeights = interpolator.GetSplineOrder() + 1;
+      vnl_matrix<long>   evaluateIndex(InputImageDimension, numberOfWeights);
+      vnl_matrix<double> weights(InputImageDimension, numberOfWeights);
+      this->ResampleScanlines(outputRegionForThread,
+                              [&interpolator, &evaluateIndex, &weights](const ContinuousInputIndexType & index) {
+                                return interpolator.EvaluateAtContinuousIndex(index, evaluateIndex, weights);
+                              });
+      return;
+    }
+  }
+
   OutputImageType *      outputPtr = this->GetOutput();
   const InputImageType * inputPtr = this->GetInput();
   const TransformType *  transformPtr = this->GetTransform();
@@ -439,9 +484,6 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   const auto firstIndexValueOfLargestPossibleRegion = largestPossibleRegion.GetIndex(0);
   const auto firstSizeValueOfLargestPossibleRegion = static_cast<double>(largestPossibleRegion.GetSize(0));
 
-  // Cache information from the superclass
-  const PixelType defaultValue = this->GetDefaultPixelValue();
-
   // As we walk across a scan line in the output image, we trace
   // an oriented/scaled/translated line in the input image. Each scan
   // line has a starting and ending point. Since all transforms
@@ -460,6 +502,12 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
   };
 
+  // The pixels of each scanline are interpolated by a single call.
+  const SizeValueType scanlineSize = outputRegionForThread.GetSize(0);
+  ScanlineBuffers     buffers;
+  buffers.inputIndices.resize(scanlineSize);
+  buffers.isInside.resize(scanlineSize);
+
   // Create an iterator that will walk the output region for this thread.
   for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
@@ -475,39 +523,138 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     index[0] += firstSizeValueOfLargestPossibleRegion;
     const auto vectorFromStartIndex = transformIndex(index) - startIndex;
 
-    IndexValueType scanlineIndex = computedIndex[0];
+    for (SizeValueType i = 0; i < scanlineSize; ++i)
+    {
+      const IndexValueType scanlineIndex = computedIndex[0] + static_cast<IndexValueType>(i);
 
+      // Perform linear interpolation from startIndex, along vectorFromStartIndex
+      const double alpha =
+        (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
-    while (!outIt.IsAtEndOfLine())
+      ContinuousInputIndexType & inputIndex = buffers.inputIndices[i];
+      inputIndex = startIndex;
+      for (unsigned int d = 0; d < InputImageDimension; ++d)
+      {
+        inputIndex[d] += alpha * vectorFromStartIndex[d];
+      }
+      buffers.isInside[i] = m_Interpolator->IsInsideBuffer(inputIndex);
+    }
+
+    // Evaluate input at right positions and copy to the output
+    this->InterpolateScanline(outIt, buffers);
+    progress.Completed(scanlineSize);
+  }
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  InterpolateScanline(ImageScanlineIterator<TOutputImage> & outIt, ScanlineBuffers & buffers) const
+{
+  const SizeValueType scanlineSize = buffers.inputIndices.size();
+
+  buffers.insideIndices.clear();
+  for (SizeValueType i = 0; i < scanlineSize; ++i)
+  {
+    if (buffers.isInside[i])
+    {
+      buffers.insideIndices.push_back(buffers.inputIndices[i]);
+    }
+  }
+  buffers.values.resize(buffers.insideIndices.size());
+  m_Interpolator->EvaluateAtContinuousIndices(
+    buffers.insideIndices.data(), buffers.values.data(), buffers.insideIndices.size());
+
+  auto value = buffers.values.cbegin();
+  for (SizeValueType i = 0; i < scanlineSize; ++i, ++outIt)
+  {
+    if (buffers.isInside[i])
     {
+      outIt.Set(Self::CastPixelWithBoundsChecking(*value));
+      ++value;
+    }
+    else if (m_Extrapolator.IsNull())
+    {
+      outIt.Set(m_DefaultPixelValue); // default background value
+    }
+    else
+    {
+      outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(buffers.inputIndices[i])));
+    }
+  }
+}
 
-      // Perform linear interpolation from startIndex, along vectorFromStartIndex
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+template <typename TScanlineKernel>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  ResampleScanlines(const OutputImageRegionType & outputRegionForThread, const TScanlineKernel & kernel)
+{
+  OutputImageType *      outputPtr = this->GetOutput();
+  const InputImageType * inputPtr = this->GetInput();
+  const TransformType *  transformPtr = this->GetTransform();
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  const OutputImageRegionType & largestPossibleRegion = outputPtr->GetLargestPossibleRegion();
+
+  const auto firstIndexValueOfLargestPossibleRegion = largestPossibleRegion.GetIndex(0);
+  const auto firstSizeValueOfLargestPossibleRegion = static_cast<double>(largestPossibleRegion.GetSize(0));
+
+  const PixelType defaultValue = this->GetDefaultPixelValue();
+
+  // Same test as ImageFunction::IsInsideBuffer(), without the virtual call
+  const ContinuousInputIndexType startContinuousIndex = m_Interpolator->GetStartContinuousIndex();
+  const ContinuousInputIndexType endContinuousIndex = m_Interpolator->GetEndContinuousIndex();
+
+  const auto transformIndex = [outputPtr, transformPtr, inputPtr](const IndexType & index) {
+    return inputPtr->template TransformPhysicalPointToContinuousIndex<TInterpolatorPrecisionType>(
+      transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
+  };
+
+  for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
+  {
+    // The scanline is mapped as in LinearThreadedGenerateData()
+    IndexType index = outIt.ComputeIndex();
+    const IndexValueType firstScanlineIndex = index[0];
+    index[0] = firstIndexValueOfLargestPossibleRegion;
+
+    const ContinuousInputIndexType startIndex = transformIndex(index);
+    index[0] += firstSizeValueOfLargestPossibleRegion;
+    const auto vectorFromStartIndex = transformIndex(index) - startIndex;
+
+    IndexValueType scanlineIndex = firstScanlineIndex;
+    while (!outIt.IsAtEndOfLine())
+    {
       const double alpha =
         (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
       ContinuousInputIndexType inputIndex(startIndex);
-      for (unsigned int i = 0; i < InputImageDimension; ++i)
+      bool                     isInside = true;
+      for (unsigned int d = 0; d < InputImageDimension; ++d)
       {
-        inputIndex[i] += alpha * vectorFromStartIndex[i];
+        inputIndex[d] += alpha * vectorFromStartIndex[d];
+        isInside &= (inputIndex[d] >= startContinuousIndex[d]) & (inputIndex[d] < endContinuousIndex[d]);
       }
 
-      // Evaluate input at right position and copy to the output
-      if (m_Interpolator->IsInsideBuffer(inputIndex))
+      if (isInside)
       {
-        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        outIt.Set(Self::CastPixelWithBoundsChecking(kernel(inputIndex)));
+      }
+      else if (m_Extrapolator.IsNull())
+      {
+        outIt.Set(defaultValue); // default background value
       }
       else
       {
-        if (m_Extrapolator.IsNull())
-        {
-          outIt.Set(defaultValue); // default background value
-        }
-        else
-        {
-          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
-        }
+        outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
       }
-
       ++outIt;
       ++scanlineIndex;
     }
@@ -20,11 +20,14 @@
 #include "itkResampleImageFilter.h"
 
 #include "itkAffineTransform.h"
+#include "itkBSplineInterpolateImageFunction.h"
 #include "itkCastImageFilter.h"
 #include "itkGaussianInterpolateImageFunction.h"
 #include "itkImage.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkNearestNeighborExtrapolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 #include "itkStreamingImageFilter.h"
 
 // Google Test header file:
@@ -117,6 +120,104 @@ Expect_ResampleImageFilter_thows_on_incomplete_configuration(const TPixel inputP
   EXPECT_EQ(TestThrowErrorOnEmptyResampleSpace(inputPixel, true), inputPixel);
 }
 
+
+// Derives from an interpolator without changing it, so that the filter
+// evaluates it by its virtual member functions, rather than by the inlined
+// calls for the interpolator itself.
+template <typename TInterpolator>
+class DerivedInterpolator : public TInterpolator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DerivedInterpolator);
+
+  using Self = DerivedInterpolator;
+  using Superclass = TInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(DerivedInterpolator);
+
+protected:
+  DerivedInterpolator() = default;
+  ~DerivedInterpolator() override = default;
+};
+
+
+// Tests that resampling with inlined interpolator calls produces the same pixel values
+// as resampling with the virtual member functions of the interpolator, for
+// an affine transform which maps part of the output outside the input.
+template <typename TInterpolator>
+void
+Expect_inlined_interpolator_matches_virtual_one(
+  const typename TInterpolator::InputImageType::Pointer & input,
+  const bool                                              useExtrapolator = false)
+{
+  using ImageType = typename TInterpolator::InputImageType;
+  constexpr unsigned int Dimension = ImageType::ImageDimension;
+
+  const auto transform = itk::AffineTransform<double, Dimension>::New();
+  transform->Scale(0.83);
+  transform->Rotate(0, 1, 0.3);
+  auto translation = itk::MakeFilled<typename itk::AffineTransform<double, Dimension>::OutputVectorType>(-1.7);
+  translation[0] = 2.3;
+  transform->Translate(translation);
+
+  const auto resample = [&input, &transform, useExtrapolator](typename TInterpolator::Pointer interpolator) {
+    const auto filter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+    filter->SetInput(input);
+    filter->SetTransform(transform);
+    filter->SetInterpolator(interpolator);
+    filter->SetSize(input->GetLargestPossibleRegion().GetSize() + itk::MakeFilled<itk::Size<Dimension>>(9));
+    filter->SetOutputStartIndex(itk::MakeFilled<itk::Index<Dimension>>(-4));
+    filter->SetDefaultPixelValue(7);
+    if (useExtrapolator)
+    {
+      filter->SetExtrapolator(itk::NearestNeighborExtrapolateImageFunction<ImageType, double>::New());
+    }
+    filter->Update();
+    return typename ImageType::Pointer(filter->GetOutput());
+  };
+
+  const auto expected = resample(DerivedInterpolator<TInterpolator>::New().GetPointer());
+  const auto actual = resample(TInterpolator::New());
+
+  unsigned int numberOfDefaultPixels = 0;
+  unsigned int numberOfMismatches = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(actual, actual->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    numberOfDefaultPixels += (it.Get() == 7);
+    if (it.Get() != expected->GetPixel(it.GetIndex()))
+    {
+      ++numberOfMismatches;
+      ADD_FAILURE() << "Pixel " << it.GetIndex() << " is " << +it.Get() << " instead of "
+                    << +expected->GetPixel(it.GetIndex());
+    }
+    if (numberOfMismatches > 10)
+    {
+      break;
+    }
+  }
+  EXPECT_EQ(numberOfDefaultPixels > 0, !useExtrapolator);
+}
+
+
+template <typename TImage>
+typename TImage::Pointer
+MakeRandomImage(const typename TImage::SizeType & size)
+{
+  std::mt19937                       generator(42);
+  std::uniform_int_distribution<int> distribution(30, 200);
+  const auto                         image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename TImage::PixelType>(distribution(generator)) / 3);
+  }
+  return image;
+}
+
 } // namespace
 
 // Compile time check of mixing transform and precision types
@@ -241,3 +342,26 @@ TEST(ResampleImageFilter, StreamingMatchesNonStreamedWithGaussianInterpolator)
   }
   EXPECT_EQ(itU.IsAtEnd(), itS.IsAtEnd());
 }
+
+
+TEST(ResampleImageFilter, InlinedInterpolatorsMatchVirtualOnes)
+{
+  using ShortImage2DType = itk::Image<short, 2>;
+  using FloatImage3DType = itk::Image<float, 3>;
+  using UCharImage2DType = itk::Image<unsigned char, 2>;
+
+  const auto shortImage = MakeRandomImage<ShortImage2DType>({ { 131, 67 } });
+  const auto floatImage = MakeRandomImage<FloatImage3DType>({ { 41, 23, 17 } });
+  const auto ucharImage = MakeRandomImage<UCharImage2DType>({ { 75, 33 } });
+
+  Expect_inlined_interpolator_matches_virtual_one<itk::NearestNeighborInterpolateImageFunction<ShortImage2DType>>(
+    shortImage);
+  Expect_inlined_interpolator_matches_virtual_one<itk::NearestNeighborInterpolateImageFunction<FloatImage3DType>>(
+    floatImage);
+  Expect_inlined_interpolator_matches_virtual_one<itk::LinearInterpolateImageFunction<ShortImage2DType>>(shortImage);
+  Expect_inlined_interpolator_matches_virtual_one<itk::LinearInterpolateImageFunction<FloatImage3DType>>(floatImage);
+  Expect_inlined_interpolator_matches_virtual_one<itk::LinearInterpolateImageFunction<FloatImage3DType>>(floatImage,
+                                                                                                  true);
+  Expect_inlined_interpolator_matches_virtual_one<itk::BSplineInterpolateImageFunction<UCharImage2DType>>(ucharImage);
+  Expect_inlined_interpolator_matches_virtual_one<itk::BSplineInterpolateImageFunction<FloatImage3DType>>(floatImage);
+}
@@ -20,10 +20,12 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkConstShapedNeighborhoodIterator.h"
+#include <algorithm>
 #include <atomic>
 #include <deque>
 #include <functional>
 #include <mutex>
+#include <numeric>
 #include <vector>
 
 namespace itk
@@ -35,6 +37,11 @@ namespace itk
  * This implementation was taken from the Insight Journal paper:
  * https://doi.org/10.54294/q6auw4
  *
+ * The equivalences between the labels of the runs are recorded in a
+ * lock-free union-find structure, so they can be found by several threads
+ * at once. The roots are always the smallest labels of their sets, so the
+ * labels do not depend on the order in which the equivalences are found.
+ *
  * \ingroup ITKImageLabel
  */
 template <typename TInputImage, typename TOutputImage>
@@ -130,7 +137,7 @@ protected:
 
   using LineMapType = std::vector<LineEncodingType>;
 
-  using UnionFindType = std::vector<InternalLabelType>;
+  using UnionFindType = std::vector<std::atomic<InternalLabelType>>;
   using ConsecutiveVectorType = std::vector<OutputPixelType>;
 
   SizeValueType
@@ -149,50 +156,120 @@ protected:
     return linearIndex;
   }
 
-  void
-  InitUnion(InternalLabelType numberOfLabels)
+  /** Number of blocks of at least 4096 elements of ParallelizeBlocks(). */
+  static SizeValueType
+  GetNumberOfBlocks(SizeValueType size)
   {
-    m_UnionFind = UnionFindType(numberOfLabels + 1);
+    return std::clamp<SizeValueType>(size / 4096, 1, 1024);
+  }
 
-    const auto        MapBegin = m_LineMap.begin();
-    const auto        MapEnd = m_LineMap.end();
-    InternalLabelType label = 1;
-    for (typename LineMapType::iterator LineIt = MapBegin; LineIt != MapEnd; ++LineIt)
+  /** Splits [0, size) into GetNumberOfBlocks(size) blocks, and calls
+   * blockFunction(block, begin, end) for each of them, in parallel. */
+  template <typename TBlockFunction>
+  void
+  ParallelizeBlocks(SizeValueType size, TBlockFunction && blockFunction) const
+  {
+    const SizeValueType numberOfBlocks = GetNumberOfBlocks(size);
+    const auto          processBlock = [size, numberOfBlocks, &blockFunction](SizeValueType block) {
+      blockFunction(block, size * block / numberOfBlocks, size * (block + 1) / numberOfBlocks);
+    };
+    if (numberOfBlocks == 1)
     {
-      for (auto cIt = LineIt->begin(); cIt != LineIt->end(); ++cIt)
-      {
-        cIt->label = label;
-        m_UnionFind[label] = label;
-        ++label;
-      }
+      processBlock(0);
+    }
+    else
+    {
+      m_EnclosingFilter->GetMultiThreader()->ParallelizeArray(0, numberOfBlocks, processBlock, nullptr);
     }
   }
 
+  void
+  InitUnion(InternalLabelType numberOfLabels)
+  {
+    m_UnionFind = UnionFindType(numberOfLabels + 1);
+    m_UnionFind[0].store(0, std::memory_order_relaxed);
+
+    // The runs are labelled in the order of the lines. The first label of
+    // each block of lines follows the runs of the previous blocks.
+    const SizeValueType            numberOfLines = m_LineMap.size();
+    std::vector<InternalLabelType> firstLabels(GetNumberOfBlocks(numberOfLines) + 1, 0);
+    firstLabels[0] = 1;
+    this->ParallelizeBlocks(
+      numberOfLines, [this, &firstLabels](SizeValueType block, SizeValueType begin, SizeValueType end) {
+        InternalLabelType numberOfRuns = 0;
+        for (SizeValueType line = begin; line < end; ++line)
+        {
+          numberOfRuns += m_LineMap[line].size();
+        }
+        firstLabels[block + 1] = numberOfRuns;
+      });
+    std::partial_sum(firstLabels.begin(), firstLabels.end(), firstLabels.begin());
+
+    this->ParallelizeBlocks(
+      numberOfLines, [this, &firstLabels](SizeValueType block, SizeValueType begin, SizeValueType end) {
+        InternalLabelType label = firstLabels[block];
+        for (SizeValueType line = begin; line < end; ++line)
+        {
+          for (auto & run : m_LineMap[line])
+          {
+            run.label = label;
+            m_UnionFind[label].store(label, std::memory_order_relaxed);
+            ++label;
+          }
+        }
+      });
+  }
+
+  /** Finds the root of the set of the label. The path to the root is halved
+   * along the way, with compare-and-swap operations which only replace a
+   * parent by one of its ancestors, so other threads may find and link
+   * labels at the same time. */
   InternalLabelType
   LookupSet(const InternalLabelType label)
   {
     InternalLabelType l = label;
-    while (l != m_UnionFind[l])
+    while (true)
     {
-      l = m_UnionFind[l]; // transitively sets equivalence
+      InternalLabelType parent = m_UnionFind[l].load(std::memory_order_relaxed);
+      if (parent == l)
+      {
+        return l;
+      }
+      const InternalLabelType grandParent = m_UnionFind[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        // On failure, parent is set to the new parent, set by another thread
+        m_UnionFind[l].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      }
+      l = parent;
     }
-    return l;
   }
 
+  /** Merges the sets of the two labels, by linking the larger root to the
+   * smaller one. This is retried when another thread links the larger root
+   * first. */
   void
   LinkLabels(const InternalLabelType label1, const InternalLabelType label2)
   {
-    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
-    const InternalLabelType           E1 = this->LookupSet(label1);
-    const InternalLabelType           E2 = this->LookupSet(label2);
-
-    if (E1 < E2)
+    InternalLabelType E1 = label1;
+    InternalLabelType E2 = label2;
+    while (true)
     {
-      m_UnionFind[E2] = E1;
-    }
-    else
-    {
-      m_UnionFind[E1] = E2;
+      E1 = this->LookupSet(E1);
+      E2 = this->LookupSet(E2);
+      if (E1 == E2)
+      {
+        return;
+      }
+      if (E1 < E2)
+      {
+        std::swap(E1, E2);
+      }
+      InternalLabelType expected = E1;
+      if (m_UnionFind[E1].compare_exchange_strong(expected, E2, std::memory_order_acq_rel))
+      {
+        return;
+      }
     }
   }
 
@@ -204,24 +281,39 @@ protected:
     m_Consecutive = ConsecutiveVectorType(N);
     m_Consecutive[0] = backgroundValue;
 
-    OutputPixelType consecutiveLabel = 0;
-    SizeValueType   count = 0;
-
-    for (size_t i = 1; i < N; ++i)
+    // The objects are numbered in the order of their roots, skipping the
+    // background value.
+    SizeValueType skippedLabel = NumericTraits<SizeValueType>::max();
+    if (!(backgroundValue < OutputPixelType{}) &&
+        static_cast<OutputPixelType>(static_cast<SizeValueType>(backgroundValue)) == backgroundValue)
     {
-      const auto label = static_cast<size_t>(m_UnionFind[i]);
-      if (label == i)
+      skippedLabel = static_cast<SizeValueType>(backgroundValue);
+    }
+    const auto isRoot = [this](size_t i) { return m_UnionFind[i].load(std::memory_order_relaxed) == i; };
+
+    std::vector<SizeValueType> firstObjects(GetNumberOfBlocks(N - 1) + 1, 0);
+    this->ParallelizeBlocks(N - 1, [&](SizeValueType block, SizeValueType begin, SizeValueType end) {
+      SizeValueType count = 0;
+      for (size_t i = begin + 1; i < end + 1; ++i)
       {
-        if (consecutiveLabel == backgroundValue)
+        count += isRoot(i);
+      }
+      firstObjects[block + 1] = count;
+    });
+    std::partial_sum(firstObjects.begin(), firstObjects.end(), firstObjects.begin());
+
+    this->ParallelizeBlocks(N - 1, [&](SizeValueType block, SizeValueType begin, SizeValueType end) {
+      SizeValueType object = firstObjects[block];
+      for (size_t i = begin + 1; i < end + 1; ++i)
+      {
+        if (isRoot(i))
         {
-          ++consecutiveLabel;
+          m_Consecutive[i] = static_cast<OutputPixelType>(object < skippedLabel ? object : object + 1);
+          ++object;
         }
-        m_Consecutive[label] = consecutiveLabel;
-        ++consecutiveLabel;
-        ++count;
       }
-    }
-    return count;
+    });
+    return firstObjects.back();
   }
 
   bool
@@ -129,6 +129,16 @@ public:
   itkSetMacro(InputForegroundValue, InputImagePixelType);
   itkGetConstMacro(InputForegroundValue, InputImagePixelType);
   /** @ITKEndGrouping */
+  /**
+   * Set/Get whether the principal moments and axes, the elongation, the
+   * flatness and the equivalent ellipsoid diameter should be computed or not.
+   * Default value is true.
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(ComputeMoments, bool);
+  itkGetConstReferenceMacro(ComputeMoments, bool);
+  itkBooleanMacro(ComputeMoments);
+  /** @ITKEndGrouping */
   /**
    * Set/Get whether the maximum Feret diameter should be computed or not.
    * Default value is false, because of the high computation time required.
@@ -181,6 +191,7 @@ private:
   bool                 m_FullyConnected{};
   OutputImagePixelType m_OutputBackgroundValue{};
   InputImagePixelType  m_InputForegroundValue{};
+  bool                 m_ComputeMoments{ true };
   bool                 m_ComputeFeretDiameter{};
   bool                 m_ComputePerimeter{};
   bool                 m_ComputeOrientedBoundingBox{};
@@ -75,6 +75,7 @@ BinaryImageToShapeLabelMapFilter<TInputImage, TOutputImage>::GenerateData()
   auto valuator = LabelObjectValuatorType::New();
   valuator->SetInput(labelizer->GetOutput());
   valuator->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  valuator->SetComputeMoments(m_ComputeMoments);
   valuator->SetComputePerimeter(m_ComputePerimeter);
   valuator->SetComputeFeretDiameter(m_ComputeFeretDiameter);
   valuator->SetComputeOrientedBoundingBox(m_ComputeOrientedBoundingBox);
@@ -94,6 +95,7 @@ BinaryImageToShapeLabelMapFilter<TInputImage, TOutputImage>::PrintSelf(std::ostr
   itkPrintSelfBooleanMacro(FullyConnected);
   print_helper::PrintNumericTrait(os, indent, "BackgroundValue", m_OutputBackgroundValue);
   print_helper::PrintNumericTrait(os, indent, "ForegroundValue", m_InputForegroundValue);
+  os << indent << "ComputeMoments: " << m_ComputeMoments << std::endl;
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
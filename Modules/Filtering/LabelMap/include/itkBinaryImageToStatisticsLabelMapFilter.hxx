@@ -81,6 +81,7 @@ BinaryImageToStatisticsLabelMapFilter<TInputImage, TFeatureImage, TOutputImage>:
   valuator->SetInput(labelizer->GetOutput());
   valuator->SetFeatureImage(this->GetFeatureImage());
   valuator->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  valuator->SetComputeMoments(m_ComputeMoments);
   valuator->SetComputePerimeter(m_ComputePerimeter);
   valuator->SetComputeFeretDiameter(m_ComputeFeretDiameter);
   valuator->SetComputeHistogram(m_ComputeHistogram);
@@ -102,6 +103,7 @@ BinaryImageToStatisticsLabelMapFilter<TInputImage, TFeatureImage, TOutputImage>:
   itkPrintSelfBooleanMacro(FullyConnected);
   print_helper::PrintNumericTrait(os, indent, "OutputBackgroundValue", m_OutputBackgroundValue);
   print_helper::PrintNumericTrait(os, indent, "InputForegroundValue", m_InputForegroundValue);
+  os << indent << "ComputeMoments: " << m_ComputeMoments << std::endl;
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeHistogram: " << m_ComputeHistogram << std::endl;
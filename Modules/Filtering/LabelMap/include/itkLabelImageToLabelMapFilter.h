@@ -71,6 +71,8 @@ public:
   using OutputImageRegionType = typename OutputImageType::RegionType;
   using OutputImagePixelType = typename OutputImageType::PixelType;
   using LabelObjectType = typename OutputImageType::LabelObjectType;
+  using LabelObjectPointer = typename LabelObjectType::Pointer;
+  using LabelType = typename LabelObjectType::LabelType;
   using LengthType = typename LabelObjectType::LengthType;
 
   /** ImageDimension constants */
@@ -125,9 +127,21 @@ protected:
   AfterThreadedGenerateData() override;
 
 private:
+  /** A run of pixels of the same label found by a work unit. */
+  struct RunType
+  {
+    IndexType  Index;
+    LengthType Length;
+    LabelType  Label;
+  };
+  using RunContainerType = std::vector<RunType>;
+
   OutputImagePixelType m_BackgroundValue{};
 
-  typename std::vector<OutputImagePointer> m_TemporaryImages{};
+  /** The runs found by each work unit, in the raster order of its region.
+   * They are grouped by label into the output label objects once all the
+   * work units are done, so that each object is created only once. */
+  std::vector<RunContainerType> m_WorkUnitRuns{};
 }; // end of class
 } // end namespace itk
 
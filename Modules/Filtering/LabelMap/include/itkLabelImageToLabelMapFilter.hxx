@@ -22,6 +22,8 @@
 #include "itkTotalProgressReporter.h"
 #include "itkImageLinearConstIteratorWithIndex.h"
 #include "itkPrintHelper.h"
+#include <algorithm>
+#include <unordered_map>
 
 namespace itk
 {
@@ -59,25 +61,12 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelImageToLabelMapFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
-  // init the temp images - one per thread
-  m_TemporaryImages.resize(this->GetNumberOfWorkUnits());
+  // set the minimum data needed to create the objects properly
+  this->GetOutput()->SetBackgroundValue(m_BackgroundValue);
 
-  for (ThreadIdType i = 0; i < this->GetNumberOfWorkUnits(); ++i)
-  {
-    if (i == 0)
-    {
-      // the first one is the output image
-      m_TemporaryImages[0] = this->GetOutput();
-    }
-    else
-    {
-      // the other must be created
-      m_TemporaryImages[i] = OutputImageType::New();
-    }
-
-    // set the minimum data needed to create the objects properly
-    m_TemporaryImages[i]->SetBackgroundValue(m_BackgroundValue);
-  }
+  // init the run tables - one per thread
+  m_WorkUnitRuns.clear();
+  m_WorkUnitRuns.resize(this->GetNumberOfWorkUnits());
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -88,6 +77,8 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
 {
   TotalProgressReporter progress(this, this->GetInput()->GetRequestedRegion().GetNumberOfPixels());
 
+  RunContainerType & runs = m_WorkUnitRuns[threadId];
+
   ImageLinearConstIteratorWithIndex it(this->GetInput(), regionForThread);
   it.SetDirection(0);
 
@@ -111,8 +102,12 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
           ++length;
           ++it;
         }
-        // create the run length object to go in the vector
-        m_TemporaryImages[threadId]->SetLine(idx, length, value);
+        // store the run, unless its label is the background of the output
+        const auto label = static_cast<LabelType>(value);
+        if (label != static_cast<LabelType>(m_BackgroundValue))
+        {
+          runs.push_back({ idx, length, label });
+        }
       }
       else
       {
@@ -130,34 +125,66 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData
 {
   OutputImageType * output = this->GetOutput();
 
-  // merge the lines from the temporary images in the output image
-  // don't use the first image - that's the output image
-  for (ThreadIdType i = 1; i < this->GetNumberOfWorkUnits(); ++i)
+  // gather the runs of all the threads in a single table sorted by label. The
+  // threads process consecutive slabs of the image, so a counting sort over
+  // the runs of the threads taken in order keeps each label in raster order.
+  std::unordered_map<LabelType, SizeValueType> labelIds;
+  std::vector<SizeValueType>                   runsPerLabel;
+  for (const RunContainerType & workUnitRuns : m_WorkUnitRuns)
   {
-    for (typename OutputImageType::Iterator it(m_TemporaryImages[i]); !it.IsAtEnd(); ++it)
+    for (const RunType & run : workUnitRuns)
     {
-      LabelObjectType * labelObject = it.GetLabelObject();
-      if (output->HasLabel(labelObject->GetLabel()))
-      {
-        // merge the lines in the output's object
-        LabelObjectType *                           lo = output->GetLabelObject(labelObject->GetLabel());
-        typename LabelObjectType::ConstLineIterator lit(labelObject);
-        while (!lit.IsAtEnd())
-        {
-          lo->AddLine(lit.GetLine());
-          ++lit;
-        }
-      }
-      else
+      const auto inserted = labelIds.try_emplace(run.Label, labelIds.size());
+      if (inserted.second)
       {
-        // simply take the object
-        output->AddLabelObject(labelObject);
+        runsPerLabel.push_back(0);
       }
+      ++runsPerLabel[inserted.first->second];
+    }
+  }
+
+  std::vector<std::pair<LabelType, SizeValueType>> sortedLabelIds(labelIds.begin(), labelIds.end());
+  std::sort(sortedLabelIds.begin(), sortedLabelIds.end());
+  std::vector<SizeValueType> firstRunOfLabel(runsPerLabel.size());
+  SizeValueType              numberOfRuns = 0;
+  for (const auto & labelId : sortedLabelIds)
+  {
+    firstRunOfLabel[labelId.second] = numberOfRuns;
+    numberOfRuns += runsPerLabel[labelId.second];
+  }
+
+  RunContainerType runs(numberOfRuns);
+  for (RunContainerType & workUnitRuns : m_WorkUnitRuns)
+  {
+    for (const RunType & run : workUnitRuns)
+    {
+      runs[firstRunOfLabel[labelIds[run.Label]]++] = run;
+    }
+    RunContainerType().swap(workUnitRuns);
+  }
+
+  // create each label object from its consecutive runs
+  auto first = runs.cbegin();
+  while (first != runs.cend())
+  {
+    auto last = first;
+    while (last != runs.cend() && last->Label == first->Label)
+    {
+      ++last;
+    }
+
+    const LabelObjectPointer labelObject = LabelObjectType::New();
+    labelObject->SetLabel(first->Label);
+    for (auto run = first; run != last; ++run)
+    {
+      labelObject->AddLine(run->Index, run->Length);
     }
+    output->AddLabelObject(labelObject);
+    first = last;
   }
 
-  // release the data in the temp images
-  m_TemporaryImages.clear();
+  // release the run tables
+  m_WorkUnitRuns.clear();
 }
 
 template <typename TInputImage, typename TOutputImage>
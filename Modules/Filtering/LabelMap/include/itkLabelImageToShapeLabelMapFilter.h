@@ -99,6 +99,16 @@ public:
   itkSetMacro(BackgroundValue, OutputImagePixelType);
   itkGetConstMacro(BackgroundValue, OutputImagePixelType);
   /** @ITKEndGrouping */
+  /**
+   * Set/Get whether the principal moments and axes, the elongation, the
+   * flatness and the equivalent ellipsoid diameter should be computed or not.
+   * Default value is true.
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(ComputeMoments, bool);
+  itkGetConstReferenceMacro(ComputeMoments, bool);
+  itkBooleanMacro(ComputeMoments);
+  /** @ITKEndGrouping */
   /**
    * Set/Get whether the maximum Feret diameter should be computed or not.
    * Default value is false, because of the high computation time required.
@@ -150,6 +160,7 @@ protected:
 
 private:
   OutputImagePixelType m_BackgroundValue{};
+  bool                 m_ComputeMoments{ true };
   bool                 m_ComputeFeretDiameter{};
   bool                 m_ComputePerimeter{};
   bool                 m_ComputeOrientedBoundingBox{};
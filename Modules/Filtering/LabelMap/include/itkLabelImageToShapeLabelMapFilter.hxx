@@ -72,6 +72,7 @@ LabelImageToShapeLabelMapFilter<TInputImage, TOutputImage>::GenerateData()
   auto valuator = LabelObjectValuatorType::New();
   valuator->SetInput(labelizer->GetOutput());
   valuator->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  valuator->SetComputeMoments(m_ComputeMoments);
   valuator->SetComputePerimeter(m_ComputePerimeter);
   valuator->SetComputeFeretDiameter(m_ComputeFeretDiameter);
   valuator->SetComputeOrientedBoundingBox(m_ComputeOrientedBoundingBox);
@@ -89,6 +90,7 @@ LabelImageToShapeLabelMapFilter<TInputImage, TOutputImage>::PrintSelf(std::ostre
   Superclass::PrintSelf(os, indent);
 
   print_helper::PrintNumericTrait(os, indent, "BackgroundValue", m_BackgroundValue);
+  os << indent << "ComputeMoments: " << m_ComputeMoments << std::endl;
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
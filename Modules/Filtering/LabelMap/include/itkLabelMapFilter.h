@@ -29,7 +29,9 @@
 #define itkLabelMapFilter_h
 
 #include "itkImageToImageFilter.h"
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -43,6 +45,10 @@ namespace itk
  * With that class, the developer doesn't need to take care of iterating over all the objects in
  * the image, or to manage by hand the threads.
  *
+ * The objects are handed out to the threads by cost: the objects that are large compared
+ * to the share of work of a thread are processed first, one at a time and largest first,
+ * and the remaining objects are handed out in small batches.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -134,7 +140,15 @@ protected:
   std::mutex m_LabelObjectContainerLock{};
 
 private:
-  typename InputImageType::Iterator m_LabelObjectIterator{};
+  /** The label objects to process, the large ones first. */
+  std::vector<LabelObjectType *> m_LabelObjects{};
+  SizeValueType                  m_NumberOfLargeLabelObjects{};
+  SizeValueType                  m_LabelObjectBatchSize{ 1 };
+
+  /** Positions of the next large object and of the next batch of small
+   * objects to hand out to a thread. */
+  std::atomic<SizeValueType> m_NextLargeLabelObject{};
+  std::atomic<SizeValueType> m_NextLabelObjectBatch{};
 };
 } // end namespace itk
 
@@ -27,6 +27,7 @@
  *=========================================================================*/
 #ifndef itkLabelMapFilter_hxx
 #define itkLabelMapFilter_hxx
+#include <algorithm>
 #include <mutex>
 #include "itkTotalProgressReporter.h"
 
@@ -68,13 +69,45 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
-  m_LabelObjectIterator = typename InputImageType::Iterator(this->GetLabelMap());
+  InputImageType * labelMap = this->GetLabelMap();
+
+  m_LabelObjects.clear();
+  m_LabelObjects.reserve(labelMap->GetNumberOfLabelObjects());
+  SizeValueType numberOfLines = 0;
+  for (typename InputImageType::Iterator it(labelMap); !it.IsAtEnd(); ++it)
+  {
+    m_LabelObjects.push_back(it.GetLabelObject());
+    numberOfLines += it.GetLabelObject()->GetNumberOfLines();
+  }
+
+  // The processing time of an object grows with its number of lines. Move the
+  // objects larger than a fraction of the share of a work unit to the front,
+  // largest first, so that a large object is never left for the end.
+  const SizeValueType numberOfWorkUnits = std::max<SizeValueType>(this->GetNumberOfWorkUnits(), 1);
+  const SizeValueType largeNumberOfLines = numberOfLines / (4 * numberOfWorkUnits) + 1;
+  const auto          firstSmallLabelObject =
+    std::stable_partition(m_LabelObjects.begin(), m_LabelObjects.end(), [largeNumberOfLines](LabelObjectType * lo) {
+      return lo->GetNumberOfLines() >= largeNumberOfLines;
+    });
+  std::sort(m_LabelObjects.begin(), firstSmallLabelObject, [](LabelObjectType * a, LabelObjectType * b) {
+    return a->GetNumberOfLines() > b->GetNumberOfLines();
+  });
+  m_NumberOfLargeLabelObjects = static_cast<SizeValueType>(firstSmallLabelObject - m_LabelObjects.begin());
+
+  // Hand out the small objects in batches, small enough to keep the work units
+  // balanced at the end
+  const SizeValueType numberOfSmallLabelObjects = m_LabelObjects.size() - m_NumberOfLargeLabelObjects;
+  m_LabelObjectBatchSize = std::clamp<SizeValueType>(numberOfSmallLabelObjects / (16 * numberOfWorkUnits), 1, 64);
+
+  m_NextLargeLabelObject = 0;
+  m_NextLabelObjectBatch = m_NumberOfLargeLabelObjects;
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
 {
+  m_LabelObjects.clear();
   this->UpdateProgress(1.0);
 }
 
@@ -82,37 +115,28 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(const OutputImageRegionType &)
 {
-  const auto            numberOfLabelObjects = this->GetLabelMap()->GetNumberOfLabelObjects();
+  const auto            numberOfLabelObjects = static_cast<SizeValueType>(m_LabelObjects.size());
   TotalProgressReporter progress(this, numberOfLabelObjects, numberOfLabelObjects);
-  while (true)
-  {
-    LabelObjectType * labelObject = nullptr;
-    // begin mutex lock
-    {
-      const std::lock_guard<std::mutex> lockGuard(m_LabelObjectContainerLock);
-
-      if (m_LabelObjectIterator.IsAtEnd())
-      {
-        // mutex lock holder deleted
-        return;
-      }
 
-      // get the label object
-      labelObject = m_LabelObjectIterator.GetLabelObject();
-
-      // increment the iterator now, so it will not be invalidated if the object
-      // is destroyed
-      ++m_LabelObjectIterator;
+  // The large objects, one at a time
+  for (SizeValueType i = m_NextLargeLabelObject++; i < m_NumberOfLargeLabelObjects; i = m_NextLargeLabelObject++)
+  {
+    this->ThreadedProcessLabelObject(m_LabelObjects[i]);
+    progress.CompletedPixel();
+  }
 
-      // unlock the mutex, so the other threads can get an object
+  // Then the small objects, by batches. The objects are taken from the vector
+  // rather than from the label map, so a thread may remove its object from
+  // the label map.
+  for (SizeValueType first = m_NextLabelObjectBatch.fetch_add(m_LabelObjectBatchSize); first < numberOfLabelObjects;
+       first = m_NextLabelObjectBatch.fetch_add(m_LabelObjectBatchSize))
+  {
+    const SizeValueType last = std::min(first + m_LabelObjectBatchSize, numberOfLabelObjects);
+    for (SizeValueType i = first; i < last; ++i)
+    {
+      this->ThreadedProcessLabelObject(m_LabelObjects[i]);
+      progress.CompletedPixel();
     }
-    // end mutex lock
-
-
-    // and run the user defined method for that object
-    this->ThreadedProcessLabelObject(labelObject);
-
-    progress.CompletedPixel();
   }
 }
 
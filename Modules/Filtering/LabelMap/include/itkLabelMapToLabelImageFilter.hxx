@@ -20,6 +20,7 @@
 
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -41,14 +42,15 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapToLabelImageFilter<TInputImage, TOutputImage>::ThreadedProcessLabelObject(LabelObjectType * labelObject)
 {
-  OutputImageType *                            output = this->GetOutput();
-  const typename LabelObjectType::LabelType &  label = labelObject->GetLabel();
-  typename LabelObjectType::ConstIndexIterator it(labelObject);
+  OutputImageType *          output = this->GetOutput();
+  const OutputImagePixelType label = static_cast<OutputImagePixelType>(labelObject->GetLabel());
+  OutputImagePixelType *     buffer = output->GetBufferPointer();
 
-  while (!it.IsAtEnd())
+  // the pixels of a line are contiguous in the output buffer
+  for (typename LabelObjectType::ConstLineIterator lit(labelObject); !lit.IsAtEnd(); ++lit)
   {
-    output->SetPixel(it.GetIndex(), label);
-    ++it;
+    const typename LabelObjectType::LineType & line = lit.GetLine();
+    std::fill_n(buffer + output->ComputeOffset(line.GetIndex()), line.GetLength(), label);
   }
 }
 
@@ -18,7 +18,7 @@
 #ifndef itkLabelObject_h
 #define itkLabelObject_h
 
-#include <deque>
+#include <vector>
 #include "itkLightObject.h"
 #include "itkLabelObjectLine.h"
 #include "itkWeakPointer.h"
@@ -34,7 +34,8 @@ namespace itk
  * It should be used associated with the LabelMap.
  *
  * LabelObject store mainly 2 things: the label of the object, and a set of lines
- * which are part of the object.
+ * which are part of the object. The lines are stored contiguously, so that an
+ * object with few lines costs a single small allocation.
  * No attribute is available in that class, so this class can be used as a base class
  * to implement a label object with attribute, or when no attribute is needed (see the
  * reconstruction filters for an example. If a simple attribute is needed,
@@ -270,7 +271,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
+    using LineContainerType = typename std::vector<LineType>;
     using InternalIteratorType = typename LineContainerType::const_iterator;
     InternalIteratorType m_Iterator;
     InternalIteratorType m_Begin;
@@ -360,7 +361,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
+    using LineContainerType = typename std::vector<LineType>;
     using InternalIteratorType = typename LineContainerType::const_iterator;
     void
     NextValidLine()
@@ -388,7 +389,7 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
-  using LineContainerType = typename std::deque<LineType>;
+  using LineContainerType = typename std::vector<LineType>;
 
   LineContainerType m_LineContainer{};
   LabelType         m_Label{};
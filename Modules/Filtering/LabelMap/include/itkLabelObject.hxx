@@ -267,6 +267,7 @@ LabelObject<TLabel, VImageDimension>::CopyLinesFrom(const TSourceLabelObject * s
   itkAssertOrThrowMacro((src != nullptr), "Null Pointer");
   // clear original lines and copy lines
   m_LineContainer.clear();
+  m_LineContainer.reserve(src->GetNumberOfLines());
   for (size_t i = 0; i < src->GetNumberOfLines(); ++i)
   {
     this->AddLine(src->GetLine(static_cast<SizeValueType>(i)));
@@ -306,26 +307,19 @@ LabelObject<TLabel, VImageDimension>::Optimize()
 {
   if (!m_LineContainer.empty())
   {
-    // first copy the lines in another container and clear the current one
-    LineContainerType lineContainer = m_LineContainer;
-    m_LineContainer.clear();
-
     // reorder the lines
     const typename Functor::LabelObjectLineComparator<LineType> comparator;
-    std::sort(lineContainer.begin(), lineContainer.end(), comparator);
+    std::sort(m_LineContainer.begin(), m_LineContainer.end(), comparator);
 
-    // then check the lines consistency
+    // then check the lines consistency, merging them in place
     // we'll proceed line index by line index
-    IndexType  currentIdx = lineContainer.begin()->GetIndex();
-    LengthType currentLength = lineContainer.begin()->GetLength();
-
-    auto it = lineContainer.begin();
-
-    while (it != lineContainer.end())
+    auto current = m_LineContainer.begin();
+    for (auto it = std::next(current); it != m_LineContainer.end(); ++it)
     {
-      const LineType & line = *it;
-      IndexType        idx = line.GetIndex();
-      const LengthType length = line.GetLength();
+      const IndexType  currentIdx = current->GetIndex();
+      const LengthType currentLength = current->GetLength();
+      const IndexType  idx = it->GetIndex();
+      const LengthType length = it->GetLength();
 
       // check the index to be sure that we are still in the same line idx
       bool sameIdx = true;
@@ -337,27 +331,23 @@ LabelObject<TLabel, VImageDimension>::Optimize()
         }
       }
 
-      // try to extend the current line idx, or create a new line
+      // try to extend the current line idx, or start a new line
       if (sameIdx && currentIdx[0] + (OffsetValueType)currentLength >= idx[0])
       {
         // we may expand the line
         const LengthType newLength = idx[0] + (OffsetValueType)length - currentIdx[0];
-        currentLength = std::max(newLength, currentLength);
+        current->SetLength(std::max(newLength, currentLength));
       }
       else
       {
-        // add the previous line to the new line container and use the new line
-        // index and size
-        this->AddLine(currentIdx, currentLength);
-        currentIdx = idx;
-        currentLength = length;
+        // keep the current line and use the new line index and size
+        ++current;
+        *current = *it;
       }
-
-      ++it;
     }
 
-    // complete the last line
-    this->AddLine(currentIdx, currentLength);
+    // drop the lines merged into the previous ones
+    m_LineContainer.erase(std::next(current), m_LineContainer.end());
   }
 }
 
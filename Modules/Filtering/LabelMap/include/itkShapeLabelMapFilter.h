@@ -30,15 +30,15 @@ namespace itk
  * ShapeLabelMapFilter can be used to set the attributes values of the
  * ShapeLabelObject in a LabelMap.
  *
- * ShapeLabelMapFilter takes an optional parameter, used only to
- * optimize the computation time and the memory usage when the
- * perimeter or the feret diameter is used: the exact copy of the
- * input LabelMap is stored in an Image.
- * It can be set with SetLabelImage(). It is cleared at the end of the
- * computation, so must be reset before running Update() again. It is
- * not part of the pipeline management design, to let the subclasses
- * of ShapeLabelMapFilter use the pipeline design to specify truly
- * required inputs.
+ * The attributes are computed directly from the run-length encoded
+ * lines of the objects, and the label objects are distributed to the
+ * work units by decreasing size (see LabelMapFilter), so a few large
+ * objects do not serialize the computation. The most expensive
+ * attributes can be disabled individually: ComputeMoments (principal
+ * moments and axes, elongation, flatness and equivalent ellipsoid
+ * diameter), ComputePerimeter, ComputeFeretDiameter and
+ * ComputeOrientedBoundingBox. The attributes which are not computed
+ * are left to their default value in the label objects.
  *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
@@ -95,9 +95,22 @@ public:
   itkConceptMacro(InputOStreamWritableCheck,
     (Concept::OStreamWritable<InputImagePixelType>));*/
 
+  /**
+   * Set/Get whether the principal moments and axes, the elongation, the
+   * flatness and the equivalent ellipsoid diameter should be computed or
+   * not. Default value is true. They are always computed when the oriented
+   * bounding box is, because it is aligned on the principal axes.
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(ComputeMoments, bool);
+  itkGetConstReferenceMacro(ComputeMoments, bool);
+  itkBooleanMacro(ComputeMoments);
+  /** @ITKEndGrouping */
   /**
    * Set/Get whether the maximum Feret diameter should be computed or not.
-   * Default value is false because of the high computation time required.
+   * Only the vertices of the convex hull of the object are compared, but the
+   * computation time is still quadratic in their number, so the default
+   * value is false.
    */
   /** @ITKStartGrouping */
   itkSetMacro(ComputeFeretDiameter, bool);
@@ -123,7 +136,8 @@ public:
   itkGetConstReferenceMacro(ComputeOrientedBoundingBox, bool);
   itkBooleanMacro(ComputeOrientedBoundingBox);
   /** @ITKEndGrouping */
-  /** Set the label image */
+  /** Set the label image. The label image is not required anymore to compute
+   * the attributes, so it is ignored. Kept for backward compatibility. */
   void
   SetLabelImage(const TLabelImage * input)
   {
@@ -137,9 +151,6 @@ protected:
   void
   ThreadedProcessLabelObject(LabelObjectType * labelObject) override;
 
-  void
-  BeforeThreadedGenerateData() override;
-
   void
   AfterThreadedGenerateData() override;
 
@@ -147,11 +158,17 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  bool                   m_ComputeMoments{ true };
   bool                   m_ComputeFeretDiameter{};
   bool                   m_ComputePerimeter{ true };
   bool                   m_ComputeOrientedBoundingBox{};
   LabelImageConstPointer m_LabelImage{};
 
+  void
+  ComputeMomentAttributes(LabelObjectType *                              labelObject,
+                          MatrixType                                     centralMoments,
+                          const typename LabelObjectType::CentroidType & physicalCentroid,
+                          double                                         equivalentRadius);
   void
   ComputeFeretDiameter(LabelObjectType * labelObject);
   void
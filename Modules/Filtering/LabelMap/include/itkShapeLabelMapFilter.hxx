@@ -29,35 +29,14 @@
 #include "itkSymmetricEigenDecomposition.h"
 #include "itkMath.h"
 #include "itkLexicographicCompare.h"
+#include <algorithm>
 #include <deque>
 #include "vnl/vnl_diag_matrix.h"
 #include <map>
+#include <vector>
 
 namespace itk
 {
-template <typename TImage, typename TLabelImage>
-void
-ShapeLabelMapFilter<TImage, TLabelImage>::BeforeThreadedGenerateData()
-{
-  Superclass::BeforeThreadedGenerateData();
-
-  // Generate the label image, if needed
-  if (m_ComputeFeretDiameter)
-  {
-    if (!m_LabelImage)
-    {
-      // generate an image of the labelized image
-      using LCI2IType = LabelMapToLabelImageFilter<TImage, LabelImageType>;
-      auto lci2i = LCI2IType::New();
-      lci2i->SetInput(this->GetOutput());
-      // Respect the number of threads of the filter
-      lci2i->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-      lci2i->Update();
-      m_LabelImage = lci2i->GetOutput();
-    }
-  }
-}
-
 template <typename TImage, typename TLabelImage>
 void
 ShapeLabelMapFilter<TImage, TLabelImage>::ThreadedProcessLabelObject(LabelObjectType * labelObject)
@@ -94,6 +73,7 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ThreadedProcessLabelObject(LabelObject
   SizeValueType                           nbOfPixelsOnBorder = 0;
   double                                  perimeterOnBorder = 0;
   MatrixType                              centralMoments{};
+  const bool computeMoments = m_ComputeMoments || m_ComputeOrientedBoundingBox;
 
   using LengthType = typename LabelObjectType::LengthType;
 
@@ -219,7 +199,11 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ThreadedProcessLabelObject(LabelObject
     // substituting for known summations over x. This is very similar to
     // equation 9 in the paper but with p_i dot p_j and NOT p_i dot p_i.
 
-    if (length <= 2)
+    if (!computeMoments)
+    {
+      // nothing to accumulate
+    }
+    else if (length <= 2)
     {
 
       // The following code is the basic implementation. The next
@@ -297,6 +281,49 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ThreadedProcessLabelObject(LabelObject
   typename LabelObjectType::CentroidType     physicalCentroid;
   output->TransformContinuousIndexToPhysicalPoint(centroid, physicalCentroid);
 
+  const double physicalSize = nbOfPixels * sizePerPixel;
+  const double equivalentRadius = GeometryUtilities::HyperSphereRadiusFromVolume(ImageDimension, physicalSize);
+  const double equivalentPerimeter = GeometryUtilities::HyperSpherePerimeter(ImageDimension, equivalentRadius);
+
+  // Set the values in the object
+  labelObject->SetNumberOfPixels(nbOfPixels);
+  labelObject->SetPhysicalSize(physicalSize);
+  labelObject->SetBoundingBox(boundingBox);
+  labelObject->SetCentroid(physicalCentroid);
+  labelObject->SetNumberOfPixelsOnBorder(nbOfPixelsOnBorder);
+  labelObject->SetPerimeterOnBorder(perimeterOnBorder);
+  labelObject->SetEquivalentSphericalRadius(equivalentRadius);
+  labelObject->SetEquivalentSphericalPerimeter(equivalentPerimeter);
+
+  if (computeMoments)
+  {
+    this->ComputeMomentAttributes(labelObject, centralMoments, physicalCentroid, equivalentRadius);
+  }
+
+  if (m_ComputeFeretDiameter)
+  {
+    this->ComputeFeretDiameter(labelObject);
+  }
+
+  if (m_ComputePerimeter)
+  {
+    this->ComputePerimeter(labelObject);
+  }
+
+  if (m_ComputeOrientedBoundingBox)
+  {
+    this->ComputeOrientedBoundingBox(labelObject);
+  }
+}
+
+template <typename TImage, typename TLabelImage>
+void
+ShapeLabelMapFilter<TImage, TLabelImage>::ComputeMomentAttributes(
+  LabelObjectType *                              labelObject,
+  MatrixType                                     centralMoments,
+  const typename LabelObjectType::CentroidType & physicalCentroid,
+  double                                         equivalentRadius)
+{
   // Center the second order moments
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
@@ -362,10 +389,6 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ThreadedProcessLabelObject(LabelObject
     }
   }
 
-  const double physicalSize = nbOfPixels * sizePerPixel;
-  const double equivalentRadius = GeometryUtilities::HyperSphereRadiusFromVolume(ImageDimension, physicalSize);
-  const double equivalentPerimeter = GeometryUtilities::HyperSpherePerimeter(ImageDimension, equivalentRadius);
-
   // Compute equivalent ellipsoid radius
   VectorType ellipsoidDiameter;
   double     edet = 1.0;
@@ -383,74 +406,109 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ThreadedProcessLabelObject(LabelObject
     }
   }
 
-  // Set the values in the object
-  labelObject->SetNumberOfPixels(nbOfPixels);
-  labelObject->SetPhysicalSize(physicalSize);
-  labelObject->SetBoundingBox(boundingBox);
-  labelObject->SetCentroid(physicalCentroid);
-  labelObject->SetNumberOfPixelsOnBorder(nbOfPixelsOnBorder);
-  labelObject->SetPerimeterOnBorder(perimeterOnBorder);
   labelObject->SetPrincipalMoments(principalMoments);
   labelObject->SetPrincipalAxes(principalAxes);
   labelObject->SetElongation(elongation);
-  labelObject->SetEquivalentSphericalRadius(equivalentRadius);
-  labelObject->SetEquivalentSphericalPerimeter(equivalentPerimeter);
   labelObject->SetEquivalentEllipsoidDiameter(ellipsoidDiameter);
   labelObject->SetFlatness(flatness);
-
-  if (m_ComputeFeretDiameter)
-  {
-    this->ComputeFeretDiameter(labelObject);
-  }
-
-  if (m_ComputePerimeter)
-  {
-    this->ComputePerimeter(labelObject);
-  }
-
-  if (m_ComputeOrientedBoundingBox)
-  {
-    this->ComputeOrientedBoundingBox(labelObject);
-  }
 }
 
 template <typename TImage, typename TLabelImage>
 void
 ShapeLabelMapFilter<TImage, TLabelImage>::ComputeFeretDiameter(LabelObjectType * labelObject)
 {
-  const LabelPixelType & label = labelObject->GetLabel();
-
-  using IndexListType = typename std::deque<IndexType>;
+  // The maximum distance between two pixels is reached between two vertices
+  // of the convex hull of the object. Those vertices are end points of the
+  // lines, and are also vertices of the convex hull of the end points lying
+  // in the same plane along the axes 0 and 1, so only those are kept.
+  using IndexListType = std::vector<IndexType>;
   IndexListType idxList;
+  idxList.reserve(2 * labelObject->GetNumberOfLines());
 
-  using NeighborIteratorType = typename itk::ConstNeighborhoodIterator<LabelImageType>;
-  auto                                      neighborHoodRadius = SizeType::Filled(1);
-  NeighborIteratorType                      it(neighborHoodRadius, m_LabelImage, m_LabelImage->GetBufferedRegion());
-  ConstantBoundaryCondition<LabelImageType> lcbc;
-  // Use label + 1 to have a label different of the current label on the border
-  lcbc.SetConstant(label + 1);
-  it.OverrideBoundaryCondition(&lcbc);
-  it.GoToBegin();
-
-  using NeighborIndexType = typename NeighborIteratorType::NeighborIndexType;
+  typename LabelObjectType::ConstLineIterator lit(labelObject);
+  while (!lit.IsAtEnd())
+  {
+    IndexType idx = lit.GetLine().GetIndex();
+    idxList.push_back(idx);
+    if (lit.GetLine().GetLength() > 1)
+    {
+      idx[0] += lit.GetLine().GetLength() - 1;
+      idxList.push_back(idx);
+    }
+    ++lit;
+  }
 
-  // Iterate over all the indexes
-  typename LabelObjectType::ConstIndexIterator iit(labelObject);
-  while (!iit.IsAtEnd())
+  if constexpr (ImageDimension > 1)
   {
-    // Move the iterator to the new location
-    it += iit.GetIndex() - it.GetIndex();
+    // Sort the end points by plane, then by row, then along the row
+    std::sort(idxList.begin(), idxList.end(), [](const IndexType & a, const IndexType & b) {
+      for (unsigned int i = ImageDimension; i > 0; --i)
+      {
+        if (a[i - 1] != b[i - 1])
+        {
+          return a[i - 1] < b[i - 1];
+        }
+      }
+      return false;
+    });
+
+    // Cross product of (a - o) and (b - o) in the plane of the axes 1 and 0
+    const auto cross = [](const IndexType & o, const IndexType & a, const IndexType & b) {
+      return (a[1] - o[1]) * (b[0] - o[0]) - (a[0] - o[0]) * (b[1] - o[1]);
+    };
+    const auto samePlane = [](const IndexType & a, const IndexType & b) {
+      for (unsigned int i = 2; i < ImageDimension; ++i)
+      {
+        if (a[i] != b[i])
+        {
+          return false;
+        }
+      }
+      return true;
+    };
 
-    // Push the pixel in the list if it is on the border of the object
-    for (NeighborIndexType i = 0; i < it.Size(); ++i)
+    // Andrew's monotone chain on each plane
+    IndexListType hull;
+    IndexListType chain;
+    for (auto planeBegin = idxList.begin(); planeBegin != idxList.end();)
     {
-      if (it.GetPixel(i) != label)
+      auto planeEnd = planeBegin;
+      while (planeEnd != idxList.end() && samePlane(*planeBegin, *planeEnd))
       {
-        idxList.push_back(iit.GetIndex());
-        break;
+        ++planeEnd;
+      }
+
+      if (planeEnd - planeBegin <= 2)
+      {
+        hull.insert(hull.end(), planeBegin, planeEnd);
+        planeBegin = planeEnd;
+        continue;
+      }
+
+      chain.clear();
+      for (auto pit = planeBegin; pit != planeEnd; ++pit)
+      {
+        while (chain.size() >= 2 && cross(chain[chain.size() - 2], chain.back(), *pit) <= 0)
+        {
+          chain.pop_back();
+        }
+        chain.push_back(*pit);
+      }
+      const size_t lowerSize = chain.size() + 1;
+      for (auto pit = planeEnd - 1; pit != planeBegin;)
+      {
+        --pit;
+        while (chain.size() >= lowerSize && cross(chain[chain.size() - 2], chain.back(), *pit) <= 0)
+        {
+          chain.pop_back();
+        }
+        chain.push_back(*pit);
       }
+      // The first point is repeated at the end of the chain
+      hull.insert(hull.end(), chain.begin(), chain.end() - 1);
+      planeBegin = planeEnd;
     }
-    ++iit;
+    idxList.swap(hull);
   }
 
   ImageType * output = this->GetOutput();
@@ -903,6 +961,7 @@ ShapeLabelMapFilter<TImage, TLabelImage>::PrintSelf(std::ostream & os, Indent in
 {
   Superclass::PrintSelf(os, indent);
 
+  os << indent << "ComputeMoments: " << m_ComputeMoments << std::endl;
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
@@ -29,6 +29,10 @@ namespace itk
  * StatisticsLabelMapFilter can be used to set the attributes values
  * of the StatisticsLabelObject in a LabelMap.
  *
+ * The weighted principal moments and axes, elongation and flatness are
+ * only computed when ComputeMoments is enabled, like their unweighted
+ * counterparts in ShapeLabelMapFilter.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -103,7 +103,7 @@ StatisticsLabelMapFilter<TImage, TFeatureImage>::ThreadedProcessLabelObject(Labe
   MatrixType            centralMoments{};
   MatrixType            principalAxes{};
   VectorType            principalMoments{};
-
+  const bool            computeMoments = this->GetComputeMoments();
 
   // iterate over all the indexes
   typename LabelObjectType::ConstIndexIterator it(labelObject);
@@ -139,12 +139,18 @@ StatisticsLabelMapFilter<TImage, TFeatureImage>::ThreadedProcessLabelObject(Labe
     for (unsigned int i = 0; i < ImageDimension; ++i)
     {
       centerOfGravity[i] += physicalPosition[i] * v;
-      centralMoments[i][i] += v * physicalPosition[i] * physicalPosition[i];
-      for (unsigned int j = i + 1; j < ImageDimension; ++j)
+    }
+    if (computeMoments)
+    {
+      for (unsigned int i = 0; i < ImageDimension; ++i)
       {
-        const double weight = v * physicalPosition[i] * physicalPosition[j];
-        centralMoments[i][j] += weight;
-        centralMoments[j][i] += weight;
+        centralMoments[i][i] += v * physicalPosition[i] * physicalPosition[i];
+        for (unsigned int j = i + 1; j < ImageDimension; ++j)
+        {
+          const double weight = v * physicalPosition[i] * physicalPosition[j];
+          centralMoments[i][j] += weight;
+          centralMoments[j][i] += weight;
+        }
       }
     }
     ++it;
@@ -213,63 +219,66 @@ StatisticsLabelMapFilter<TImage, TFeatureImage>::ThreadedProcessLabelObject(Labe
       }
     }
 
-    // Center the second order moments
-    for (unsigned int i = 0; i < ImageDimension; ++i)
+    if (computeMoments)
     {
-      for (unsigned int j = 0; j < ImageDimension; ++j)
+      // Center the second order moments
+      for (unsigned int i = 0; i < ImageDimension; ++i)
       {
-        centralMoments[i][j] -= centerOfGravity[i] * centerOfGravity[j];
+        for (unsigned int j = 0; j < ImageDimension; ++j)
+        {
+          centralMoments[i][j] -= centerOfGravity[i] * centerOfGravity[j];
+        }
       }
-    }
 
-    // the normalized second order central moment of a pixel
-    for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-      centralMoments[i][i] += output->GetSpacing()[i] * output->GetSpacing()[i] / 12.0;
-    }
+      // the normalized second order central moment of a pixel
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        centralMoments[i][i] += output->GetSpacing()[i] * output->GetSpacing()[i] / 12.0;
+      }
 
-    // Compute principal moments and axes
-    const itk::SymmetricEigenDecomposition<double> eigen{ centralMoments.GetVnlMatrix().as_matrix() };
-    vnl_diag_matrix<double>                        pm{ eigen.D };
-    for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-      //    principalMoments[i] = 4 * std::sqrt( pm(i,i) );
-      principalMoments[i] = std::max(pm(i), 0.0);
-    }
-    principalAxes = eigen.V.transpose();
+      // Compute principal moments and axes
+      const itk::SymmetricEigenDecomposition<double> eigen{ centralMoments.GetVnlMatrix().as_matrix() };
+      vnl_diag_matrix<double>                        pm{ eigen.D };
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        //    principalMoments[i] = 4 * std::sqrt( pm(i,i) );
+        principalMoments[i] = std::max(pm(i), 0.0);
+      }
+      principalAxes = eigen.V.transpose();
 
-    // Add a final reflection if needed for a proper rotation,
-    // by multiplying the last row by the determinant
-    const itk::RealEigenDecomposition<double> eigenrot{ principalAxes.GetVnlMatrix().as_matrix() };
-    const vnl_vector<std::complex<double>> &  eigenval = eigenrot.GetEigenvalues();
-    std::complex<double>                      det(1.0, 0.0);
+      // Add a final reflection if needed for a proper rotation,
+      // by multiplying the last row by the determinant
+      const itk::RealEigenDecomposition<double> eigenrot{ principalAxes.GetVnlMatrix().as_matrix() };
+      const vnl_vector<std::complex<double>> &  eigenval = eigenrot.GetEigenvalues();
+      std::complex<double>                      det(1.0, 0.0);
 
-    for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-      det *= eigenval(i);
-    }
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        det *= eigenval(i);
+      }
 
-    for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-      principalAxes[ImageDimension - 1][i] *= std::real(det);
-    }
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        principalAxes[ImageDimension - 1][i] *= std::real(det);
+      }
 
-    if constexpr (ImageDimension < 2)
-    {
-      elongation = 1;
-      flatness = 1;
-    }
-    else
-    {
-      if (Math::NotAlmostEquals(principalMoments[0], typename VectorType::ValueType{}))
+      if constexpr (ImageDimension < 2)
       {
-        const double flatnessRatio = principalMoments[1] / principalMoments[0];
-        flatness = (flatnessRatio > 0.0) ? std::sqrt(flatnessRatio) : 0.0;
+        elongation = 1;
+        flatness = 1;
       }
-      if (Math::NotAlmostEquals(principalMoments[ImageDimension - 2], typename VectorType::ValueType{}))
+      else
       {
-        const double elongationRatio = principalMoments[ImageDimension - 1] / principalMoments[ImageDimension - 2];
-        elongation = (elongationRatio > 0.0) ? std::sqrt(elongationRatio) : 0.0;
+        if (Math::NotAlmostEquals(principalMoments[0], typename VectorType::ValueType{}))
+        {
+          const double flatnessRatio = principalMoments[1] / principalMoments[0];
+          flatness = (flatnessRatio > 0.0) ? std::sqrt(flatnessRatio) : 0.0;
+        }
+        if (Math::NotAlmostEquals(principalMoments[ImageDimension - 2], typename VectorType::ValueType{}))
+        {
+          const double elongationRatio = principalMoments[ImageDimension - 1] / principalMoments[ImageDimension - 2];
+          elongation = (elongationRatio > 0.0) ? std::sqrt(elongationRatio) : 0.0;
+        }
       }
     }
   }
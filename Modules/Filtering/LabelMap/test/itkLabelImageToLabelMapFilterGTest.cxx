@@ -0,0 +1,107 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkLabelMapToLabelImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkGTest.h"
+
+namespace
+{
+using ImageType = itk::Image<unsigned int, 3>;
+using LabelMapType = itk::LabelMap<itk::LabelObject<unsigned int, 3>>;
+
+// Many small labels, each spread over several lines and slices, so that the
+// runs of a label are found by different work units.
+ImageType::Pointer
+MakeManyLabelsImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType{ ImageType::SizeType{ { 37, 23, 11 } } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & idx = it.GetIndex();
+    const unsigned int          label = (idx[0] / 3) + 13 * ((idx[1] + idx[2]) % 7);
+    it.Set((idx[0] + idx[1] + idx[2]) % 5 == 0 ? 0 : label + 1);
+  }
+  return image;
+}
+} // namespace
+
+TEST(LabelImageToLabelMapFilter, RoundTripWithManyLabelsAndWorkUnits)
+{
+  const ImageType::Pointer image = MakeManyLabelsImage();
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3, 8 })
+  {
+    auto toLabelMap = itk::LabelImageToLabelMapFilter<ImageType, LabelMapType>::New();
+    toLabelMap->SetInput(image);
+    toLabelMap->SetBackgroundValue(0);
+    toLabelMap->SetNumberOfWorkUnits(numberOfWorkUnits);
+    toLabelMap->Update();
+
+    const auto * labelMap = toLabelMap->GetOutput();
+    ASSERT_EQ(labelMap->GetNumberOfLabelObjects(), 13u * 7u);
+    itk::SizeValueType numberOfPixels = 0;
+    for (const auto & labelObject : labelMap->GetLabelObjects())
+    {
+      // the lines of an object are in raster order
+      for (itk::SizeValueType i = 1; i < labelObject->GetNumberOfLines(); ++i)
+      {
+        const ImageType::IndexType & previous = labelObject->GetLine(i - 1).GetIndex();
+        const ImageType::IndexType & current = labelObject->GetLine(i).GetIndex();
+        EXPECT_TRUE(std::lexicographical_compare(previous.rbegin(), previous.rend(), current.rbegin(), current.rend()));
+      }
+      numberOfPixels += labelObject->Size();
+    }
+
+    auto toLabelImage = itk::LabelMapToLabelImageFilter<LabelMapType, ImageType>::New();
+    toLabelImage->SetInput(labelMap);
+    toLabelImage->Update();
+
+    itk::SizeValueType numberOfForegroundPixels = 0;
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      ASSERT_EQ(toLabelImage->GetOutput()->GetPixel(it.GetIndex()), it.Get()) << it.GetIndex();
+      numberOfForegroundPixels += (it.Get() != 0);
+    }
+    EXPECT_EQ(numberOfPixels, numberOfForegroundPixels);
+  }
+}
+
+TEST(LabelObject, OptimizeSortsAndMergesLines)
+{
+  using LabelObjectType = itk::LabelObject<unsigned char, 2>;
+
+  auto labelObject = LabelObjectType::New();
+  labelObject->AddLine(itk::MakeIndex(6, 1), 2);
+  labelObject->AddLine(itk::MakeIndex(0, 2), 3);
+  labelObject->AddLine(itk::MakeIndex(2, 1), 3);
+  labelObject->AddLine(itk::MakeIndex(3, 1), 1);
+  labelObject->AddLine(itk::MakeIndex(5, 1), 1);
+  labelObject->AddLine(itk::MakeIndex(1, 2), 1);
+  labelObject->Optimize();
+
+  ASSERT_EQ(labelObject->GetNumberOfLines(), 2u);
+  EXPECT_EQ(labelObject->GetLine(0).GetIndex(), itk::MakeIndex(2, 1));
+  EXPECT_EQ(labelObject->GetLine(0).GetLength(), 6u);
+  EXPECT_EQ(labelObject->GetLine(1).GetIndex(), itk::MakeIndex(0, 2));
+  EXPECT_EQ(labelObject->GetLine(1).GetLength(), 3u);
+  EXPECT_EQ(labelObject->Size(), 9u);
+}
@@ -19,10 +19,14 @@
 #include "itkGTest.h"
 
 #include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
 #include "itkLabelImageToShapeLabelMapFilter.h"
 #include "itkTestingMacros.h"
 
 #include <cmath>
+#include <random>
+#include <vector>
 
 
 namespace Math = itk::Math;
@@ -107,6 +111,9 @@ protected:
       ITK_EXERCISE_BASIC_OBJECT_METHODS(l2s, LabelImageToShapeLabelMapFilter, ImageToImageFilter);
 
 
+      auto computeMoments = true;
+      ITK_TEST_SET_GET_BOOLEAN(l2s, ComputeMoments, computeMoments);
+
       auto computeFeretDiameter = true;
       ITK_TEST_SET_GET_BOOLEAN(l2s, ComputeFeretDiameter, computeFeretDiameter);
 
@@ -118,6 +125,81 @@ protected:
 
       return EXIT_SUCCESS;
     }
+
+    // Fill the image with random labels in [0, numberOfLabels), the first
+    // label being more frequent so the objects have holes and concavities
+    static void
+    FillRandomLabels(ImageType * image, unsigned int numberOfLabels, unsigned int seed)
+    {
+      std::mt19937                            generator(seed);
+      std::uniform_int_distribution<unsigned> distribution(0, 2 * numberOfLabels);
+      for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+      {
+        const unsigned value = distribution(generator);
+        it.Set(static_cast<PixelType>(value < numberOfLabels ? value : numberOfLabels - 1));
+      }
+    }
+
+    // The maximum distance between all the pairs of pixels of the label
+    static double
+    BruteForceFeretDiameter(const ImageType * image, PixelType label)
+    {
+      std::vector<typename ImageType::IndexType> indices;
+      for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd();
+           ++it)
+      {
+        if (it.Get() == label)
+        {
+          indices.push_back(it.GetIndex());
+        }
+      }
+
+      const auto & spacing = image->GetSpacing();
+      double       feretDiameter = 0;
+      for (size_t i = 0; i < indices.size(); ++i)
+      {
+        for (size_t j = i + 1; j < indices.size(); ++j)
+        {
+          double length = 0;
+          for (unsigned int d = 0; d < Dimension; ++d)
+          {
+            const itk::OffsetValueType indexDifference = indices[i][d] - indices[j][d];
+            length += Math::sqr(indexDifference * spacing[d]);
+          }
+          feretDiameter = std::max(feretDiameter, length);
+        }
+      }
+      return std::sqrt(feretDiameter);
+    }
+
+    static void
+    TestFeretDiameterAgainstBruteForce(unsigned int numberOfLabels, unsigned int seed)
+    {
+      auto image = CreateImage();
+      auto spacing = itk::MakeFilled<typename ImageType::SpacingType>(1.0);
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        spacing[d] += 0.3 * d;
+      }
+      image->SetSpacing(spacing);
+      FillRandomLabels(image, numberOfLabels, seed);
+
+      using L2SType = itk::LabelImageToShapeLabelMapFilter<ImageType>;
+      auto l2s = L2SType::New();
+      l2s->SetInput(image);
+      l2s->SetBackgroundValue(0);
+      l2s->ComputeFeretDiameterOn();
+      l2s->ComputePerimeterOff();
+      l2s->ComputeMomentsOff();
+      l2s->Update();
+
+      const ShapeLabelMapType * labelMap = l2s->GetOutput();
+      for (PixelType label = 1; label < numberOfLabels; ++label)
+      {
+        EXPECT_DOUBLE_EQ(BruteForceFeretDiameter(image, label), labelMap->GetLabelObject(label)->GetFeretDiameter())
+          << "label " << label;
+      }
+    }
   };
 };
 } // namespace
@@ -594,3 +676,46 @@ TEST_F(ShapeLabelMapFixture, 3D_DegenerateFlatObject_NumericallyStableEllipsoidD
   EXPECT_TRUE(std::isfinite(rawDeterminant)) << "Determinant of principal moments should be finite";
   EXPECT_GE(rawDeterminant, 0.0) << "Product of non-negative principal moments should be non-negative";
 }
+
+
+TEST_F(ShapeLabelMapFixture, FeretDiameterMatchesBruteForce)
+{
+  FixtureUtilities<2>::TestFeretDiameterAgainstBruteForce(2, 1);
+  FixtureUtilities<2>::TestFeretDiameterAgainstBruteForce(5, 2);
+  FixtureUtilities<3>::TestFeretDiameterAgainstBruteForce(4, 3);
+}
+
+TEST_F(ShapeLabelMapFixture, ComputeMomentsOff)
+{
+  using Utils = FixtureUtilities<3>;
+
+  auto image = Utils::CreateImage();
+  Utils::FillRandomLabels(image, 4, 4);
+
+  using L2SType = itk::LabelImageToShapeLabelMapFilter<Utils::ImageType>;
+  auto withMoments = L2SType::New();
+  withMoments->SetInput(image);
+  withMoments->SetBackgroundValue(0);
+  withMoments->Update();
+
+  auto withoutMoments = L2SType::New();
+  withoutMoments->SetInput(image);
+  withoutMoments->SetBackgroundValue(0);
+  withoutMoments->ComputeMomentsOff();
+  withoutMoments->Update();
+
+  for (Utils::PixelType label = 1; label < 4; ++label)
+  {
+    const Utils::LabelObjectType * expected = withMoments->GetOutput()->GetLabelObject(label);
+    const Utils::LabelObjectType * labelObject = withoutMoments->GetOutput()->GetLabelObject(label);
+
+    EXPECT_EQ(expected->GetNumberOfPixels(), labelObject->GetNumberOfPixels());
+    EXPECT_EQ(expected->GetBoundingBox(), labelObject->GetBoundingBox());
+    ITK_EXPECT_VECTOR_NEAR(expected->GetCentroid(), labelObject->GetCentroid(), 1e-10);
+    EXPECT_DOUBLE_EQ(expected->GetPerimeter(), labelObject->GetPerimeter());
+
+    EXPECT_GT(expected->GetPrincipalMoments()[2], 0.0);
+    EXPECT_EQ(0.0, labelObject->GetPrincipalMoments()[2]);
+    EXPECT_EQ(0.0, labelObject->GetElongation());
+  }
+}
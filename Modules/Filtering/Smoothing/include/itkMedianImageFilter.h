@@ -92,6 +92,14 @@ protected:
   MedianImageFilter();
   ~MedianImageFilter() override = default;
 
+  /** The only parameter of this filter, the radius, is printed by
+   * PrintSelf(). */
+  std::string
+  ComputeResultCacheKey() const override
+  {
+    return this->MakeResultCacheKeyFromPrintSelf();
+  }
+
   /** MedianImageFilter can be implemented as a multithreaded filter.
    * Therefore, this implementation provides a ThreadedGenerateData()
    * routine which is called for each processing thread. The output
@@ -151,6 +151,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** The key is made of the sigma and NormalizeAcrossScale, as PrintSelf()
+   * also prints the internal filters. */
+  std::string
+  ComputeResultCacheKey() const override;
+
   void
   GenerateData() override;
 
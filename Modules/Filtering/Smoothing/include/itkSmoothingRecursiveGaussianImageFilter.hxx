@@ -261,6 +261,16 @@ SmoothingRecursiveGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
 }
 
 
+template <typename TInputImage, typename TOutputImage>
+std::string
+SmoothingRecursiveGaussianImageFilter<TInputImage, TOutputImage>::ComputeResultCacheKey() const
+{
+  std::ostringstream parameters;
+  parameters.precision(std::numeric_limits<ScalarRealType>::max_digits10);
+  parameters << "Sigma: " << m_Sigma << "\nNormalizeAcrossScale: " << m_NormalizeAcrossScale;
+  return this->MakeResultCacheKey(parameters.str());
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 SmoothingRecursiveGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
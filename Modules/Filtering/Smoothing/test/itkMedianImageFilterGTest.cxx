@@ -21,6 +21,7 @@
 
 #include "itkImage.h"
 #include "itkImageBufferRange.h"
+#include "itkPipelineResultCache.h"
 
 #include <numeric> // For iota.
 #include <vector>
@@ -122,3 +123,36 @@ TEST(MedianImageFilter, ExpectedOutputPixelValuesForSequenceOfNaturalNumbers)
   Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numbers<itk::Image<int, 3>>(
     itk::Size<3>{ { 2, 2, 2 } }, { 3, 3, 3, 4, 5, 6, 6, 6 });
 }
+
+
+// Tests that the output of a median filter is reused by another median filter with the same radius, on an input with
+// the same content, when the result cache is used.
+TEST(MedianImageFilter, ReusesCachedOutput)
+{
+  using ImageType = itk::Image<int>;
+
+  const auto cache = itk::PipelineResultCache::GetInstance();
+  cache->Clear();
+
+  const auto median = [](unsigned int radius) {
+    const auto filter = itk::MedianImageFilter<ImageType, ImageType>::New();
+    filter->SetInput(CreateImageFilledWithSequenceOfNaturalNumbers<ImageType>(itk::Size<>{ { 5, 6 } }));
+    filter->SetRadius(radius);
+    filter->SetUseResultCache(true);
+    filter->Update();
+    return ImageType::Pointer(filter->GetOutput());
+  };
+
+  const auto first = median(1);
+  EXPECT_EQ(cache->GetNumberOfEntries(), 1u);
+  EXPECT_EQ(cache->GetNumberOfHits(), 0u);
+
+  const auto second = median(1);
+  EXPECT_EQ(cache->GetNumberOfHits(), 1u);
+  EXPECT_EQ(*second, *first);
+
+  median(2);
+  EXPECT_EQ(cache->GetNumberOfHits(), 1u);
+  EXPECT_EQ(cache->GetNumberOfEntries(), 2u);
+  cache->Clear();
+}
@@ -218,6 +218,13 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** All the parameters of this filter are printed by PrintSelf(). */
+  std::string
+  ComputeResultCacheKey() const override
+  {
+    return this->MakeResultCacheKeyFromPrintSelf();
+  }
+
   /** This method is used to set the state of the filter before
    * multi-threading. */
   void
@@ -140,6 +140,13 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** All the parameters of this filter are printed by PrintSelf(). */
+  std::string
+  ComputeResultCacheKey() const override
+  {
+    return this->MakeResultCacheKeyFromPrintSelf();
+  }
+
   /** ThresholdImageFilter can be implemented as a multithreaded filter.
    * Therefore, this implementation provides a DynamicThreadedGenerateData() routine
    * which is called for each processing thread. The output image data is
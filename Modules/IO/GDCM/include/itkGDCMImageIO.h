@@ -152,6 +152,13 @@ public:
   void
   Read(void * pointer) override;
 
+  /** GDCM keeps its state in each reader, so clones of this ImageIO can read files concurrently. */
+  bool
+  CanReadConcurrently() const override
+  {
+    return true;
+  }
+
   /** Set/Get the original component type of the image. This differs from
    * ComponentType which may change as a function of rescale slope and
    * intercept. */
@@ -269,6 +276,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the DICOM specific settings. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalReadImageInformation();
 
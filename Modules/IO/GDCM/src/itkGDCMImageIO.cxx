@@ -1492,6 +1492,23 @@ GDCMImageIO::InternalSetCompressor(const std::string & _compressor)
   }
 }
 
+LightObject::Pointer
+GDCMImageIO::InternalClone() const
+{
+  LightObject::Pointer lightObject = Superclass::InternalClone();
+
+  if (auto * const clone = dynamic_cast<Self *>(lightObject.GetPointer()))
+  {
+    clone->m_UIDPrefix = m_UIDPrefix;
+    clone->m_KeepOriginalUID = m_KeepOriginalUID;
+    clone->m_LoadPrivateTags = m_LoadPrivateTags;
+    clone->m_ReadYBRtoRGB = m_ReadYBRtoRGB;
+    clone->m_InternalComponentType = m_InternalComponentType;
+    return lightObject;
+  }
+  itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+}
+
 void
 GDCMImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -28,6 +28,7 @@
 #include "itkMetaDataObjectBase.h"
 #include "itkMetaDataDictionary.h"
 #include <memory> // For unique_ptr.
+#include <vector>
 
 // itk namespace first suppresses
 // kwstyle error for the H5 namespace below
@@ -80,6 +81,13 @@ namespace itk
  *                             in the MetaDataDictionary
  * re-arrangement.
  *
+ * The voxel data is stored in chunks of ChunkSize pixels, which are the
+ * units of compression and of reading: streamed reads of a region only
+ * read and decompress the chunks intersecting the region. With the default
+ * deflate compressor, optionally preceded by the shuffle filter, the chunks
+ * are compressed and decompressed in parallel. The "ZSTD" and "LZ4"
+ * compressors use the registered HDF5 filter plugins, when they are
+ * installed.
  *
  */
 
@@ -138,6 +146,32 @@ public:
   void
   Write(const void * buffer) override;
 
+  using ChunkSizeType = std::vector<SizeValueType>;
+
+  /** Set/Get the size of the chunks of the written voxel data, in pixels
+   * along each image dimension, fastest moving first. A missing or zero
+   * entry stands for the whole extent of the image along the dimension.
+   * The components of a pixel are always in the same chunk. The default,
+   * an empty size, stores each slice along the slowest moving dimension
+   * in a chunk.
+   *
+   * Images which are read region by region should use chunks about the
+   * size of the regions, e.g. {64, 64, 64, 1} for a 3D+t image read by
+   * 3D blocks. */
+  /** @ITKStartGrouping */
+  itkSetMacro(ChunkSize, ChunkSizeType);
+  itkGetConstReferenceMacro(ChunkSize, ChunkSizeType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether the bytes of the pixel components are shuffled before
+   * compression, storing the bytes of same significance together. It often
+   * improves the compression of multi-byte pixel types. Default is false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseShuffle, bool);
+  itkGetConstMacro(UseShuffle, bool);
+  itkBooleanMacro(UseShuffle);
+  /** @ITKEndGrouping */
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO() override;
@@ -148,6 +182,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Selects the HDF5 filter of the compressor: "" or "DEFLATE" (also
+   * "GZIP"), "ZSTD" or "LZ4". */
+  void
+  InternalSetCompressor(const std::string & _compressor) override;
+
 private:
   void
   WriteString(const std::string & path, const std::string & value);
@@ -204,6 +243,17 @@ private:
   void
   SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpace);
 
+  /** Read and write the chunks intersecting the IORegion directly, doing
+   * the decompression and compression in parallel. Return false, without
+   * accessing the voxel data, when the filters of the dataset or the
+   * IORegion do not allow it. */
+  /** @ITKStartGrouping */
+  bool
+  ReadChunks(void * buffer);
+  bool
+  WriteChunks(const void * buffer);
+  /** @ITKEndGrouping */
+
   /* A convenience function to ensure that the
    * state of the HDF5ImageIO object is returned
    * to a state similar to constructing a new
@@ -217,6 +267,9 @@ private:
   std::unique_ptr<H5::H5File>  m_H5File;
   std::unique_ptr<H5::DataSet> m_VoxelDataSet;
   bool                         m_ImageInformationWritten{ false };
+  ChunkSizeType                m_ChunkSize{};
+  bool                         m_UseShuffle{ false };
+  int                          m_CompressionFilter{ 1 }; // H5Z_FILTER_DEFLATE
 };
 } // end namespace itk
 
@@ -22,8 +22,11 @@
 #include "itksys/SystemTools.hxx"
 #include "itk_H5Cpp.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
+#include "itk_zlib.h"
 
 #include <algorithm>
+#include <atomic>
 #include <type_traits> // For is_signed_v.
 
 namespace itk
@@ -40,6 +43,7 @@ HDF5ImageIO::HDF5ImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+  this->Self::SetCompressor("");
   this->Self::SetMaximumCompressionLevel(9);
   this->Self::SetCompressionLevel(5);
   this->Self::UseCompressionOn();
@@ -50,9 +54,47 @@ HDF5ImageIO::~HDF5ImageIO() { this->ResetToInitialState(); }
 void
 HDF5ImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
+  using namespace print_helper;
+
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << m_H5File.get() << std::endl;
+  os << indent << "ChunkSize: " << m_ChunkSize << std::endl;
+  os << indent << "UseShuffle: " << (m_UseShuffle ? "On" : "Off") << std::endl;
+  os << indent << "CompressionFilter: " << m_CompressionFilter << std::endl;
+}
+
+namespace
+{
+// Identifiers of the filter plugins registered with the HDF Group
+constexpr H5Z_filter_t LZ4Filter = 32004;
+constexpr H5Z_filter_t ZstandardFilter = 32015;
+} // namespace
+
+void
+HDF5ImageIO::InternalSetCompressor(const std::string & _compressor)
+{
+  if (_compressor.empty() || _compressor == "DEFLATE" || _compressor == "GZIP")
+  {
+    m_CompressionFilter = H5Z_FILTER_DEFLATE;
+    return;
+  }
+
+  const H5Z_filter_t pluginFilter = _compressor == "ZSTD" ? ZstandardFilter : _compressor == "LZ4" ? LZ4Filter : -1;
+  if (pluginFilter >= 0)
+  {
+    // Loads the plugin if it is installed
+    if (H5Zfilter_avail(pluginFilter) > 0)
+    {
+      m_CompressionFilter = pluginFilter;
+      return;
+    }
+    itkWarningMacro("The HDF5 filter plugin of the compressor \"" << _compressor
+                                                                   << "\" is not available, setting to default.");
+    this->SetCompressor("");
+    return;
+  }
+  this->Superclass::InternalSetCompressor(_compressor);
 }
 
 //
@@ -1028,6 +1070,448 @@ HDF5ImageIO::SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpac
   imageSpace->selectHyperslab(H5S_SELECT_SET, HDFSize.get(), offset.get());
 }
 
+namespace
+{
+// The chunks of a dataset intersecting an IORegion, and the filters applied
+// to them when they can be applied outside of the HDF5 library: the optional
+// shuffle filter followed by the deflate filter.
+//
+// The dimensions are in ITK order: the components of the pixels first, then
+// the image dimensions, fastest moving first. HDF5 lists them in the reverse
+// order, without the components of the scalar images.
+class DeflatedChunks
+{
+public:
+  // Returns false when the dataset is not chunked or has other filters.
+  bool
+  Initialize(const H5::DataSet & dataSet, const ImageIORegion & region, unsigned int numberOfDimensions)
+  {
+    const H5::DSetCreatPropList plist = dataSet.getCreatePlist();
+    if (plist.getLayout() != H5D_CHUNKED)
+    {
+      return false;
+    }
+
+    const int numberOfFilters = plist.getNfilters();
+    for (int i = 0; i < numberOfFilters; ++i)
+    {
+      unsigned int flags = 0;
+      size_t       numberOfValues = 1;
+      unsigned int values[1] = { 0 };
+      unsigned int filterConfig = 0;
+      char         name[1];
+      const auto   filter = plist.getFilter(i, flags, numberOfValues, values, 0, name, filterConfig);
+      if (filter == H5Z_FILTER_SHUFFLE && i == 0)
+      {
+        m_ShuffleMask = 1u << i;
+      }
+      else if (filter == H5Z_FILTER_DEFLATE && i == numberOfFilters - 1)
+      {
+        m_DeflateMask = 1u << i;
+        m_CompressionLevel = numberOfValues > 0 ? static_cast<int>(values[0]) : Z_DEFAULT_COMPRESSION;
+      }
+      else
+      {
+        return false;
+      }
+    }
+    if (m_DeflateMask == 0)
+    {
+      return false;
+    }
+
+    const H5::DataSpace space = dataSet.getSpace();
+    const int           rank = space.getSimpleExtentNdims();
+    m_Scalar = rank == static_cast<int>(numberOfDimensions);
+    m_DataSize.resize(rank);
+    space.getSimpleExtentDims(m_DataSize.data());
+    m_ChunkSize.resize(rank);
+    plist.getChunk(rank, m_ChunkSize.data());
+    std::reverse(m_DataSize.begin(), m_DataSize.end());
+    std::reverse(m_ChunkSize.begin(), m_ChunkSize.end());
+    if (m_Scalar)
+    {
+      m_DataSize.insert(m_DataSize.begin(), 1);
+      m_ChunkSize.insert(m_ChunkSize.begin(), 1);
+    }
+    m_ComponentSize = dataSet.getDataType().getSize();
+
+    const size_t dimensions = m_DataSize.size();
+    m_RegionIndex.assign(dimensions, 0);
+    m_RegionSize.assign(dimensions, 1);
+    m_RegionSize[0] = m_DataSize[0];
+    for (unsigned int i = 0; i < std::min(region.GetImageDimension(), numberOfDimensions); ++i)
+    {
+      m_RegionIndex[i + 1] = region.GetIndex(i);
+      m_RegionSize[i + 1] = region.GetSize(i);
+    }
+
+    m_FirstChunk.resize(dimensions);
+    m_NumberOfChunksAlong.resize(dimensions);
+    m_NumberOfChunks = 1;
+    for (size_t d = 0; d < dimensions; ++d)
+    {
+      m_FirstChunk[d] = m_RegionIndex[d] / m_ChunkSize[d];
+      m_NumberOfChunksAlong[d] = (m_RegionIndex[d] + m_RegionSize[d] - 1) / m_ChunkSize[d] - m_FirstChunk[d] + 1;
+      m_NumberOfChunks *= m_NumberOfChunksAlong[d];
+    }
+    m_NumberOfChunkBytes = m_ComponentSize;
+    for (const hsize_t size : m_ChunkSize)
+    {
+      m_NumberOfChunkBytes *= size;
+    }
+    return true;
+  }
+
+  // Whether the region is only made of whole chunks, or of chunks cut by the
+  // upper border of the dataset.
+  bool
+  RegionCoversChunks() const
+  {
+    for (size_t d = 0; d < m_DataSize.size(); ++d)
+    {
+      const hsize_t regionEnd = m_RegionIndex[d] + m_RegionSize[d];
+      if (m_RegionIndex[d] % m_ChunkSize[d] != 0 || (regionEnd % m_ChunkSize[d] != 0 && regionEnd != m_DataSize[d]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  SizeValueType
+  GetNumberOfChunks() const
+  {
+    return m_NumberOfChunks;
+  }
+
+  size_t
+  GetNumberOfChunkBytes() const
+  {
+    return m_NumberOfChunkBytes;
+  }
+
+  int
+  GetCompressionLevel() const
+  {
+    return m_CompressionLevel;
+  }
+
+  // The index of the first pixel of a chunk, in ITK order.
+  std::vector<hsize_t>
+  GetChunkIndex(SizeValueType chunk) const
+  {
+    std::vector<hsize_t> index(m_DataSize.size());
+    for (size_t d = 0; d < index.size(); ++d)
+    {
+      index[d] = (m_FirstChunk[d] + chunk % m_NumberOfChunksAlong[d]) * m_ChunkSize[d];
+      chunk /= m_NumberOfChunksAlong[d];
+    }
+    return index;
+  }
+
+  // The offset of a chunk in the dataset, in HDF5 order.
+  std::vector<hsize_t>
+  GetChunkOffset(SizeValueType chunk) const
+  {
+    const std::vector<hsize_t> index = this->GetChunkIndex(chunk);
+    return std::vector<hsize_t>(index.rbegin(), index.rend() - (m_Scalar ? 1 : 0));
+  }
+
+  // Copies the pixels of the region in a chunk, or the reverse.
+  void
+  CopyToChunk(SizeValueType chunk, const unsigned char * regionBuffer, unsigned char * chunkBuffer) const
+  {
+    this->VisitRows(chunk, [=](size_t chunkOffset, size_t regionOffset, size_t length) {
+      std::copy_n(regionBuffer + regionOffset, length, chunkBuffer + chunkOffset);
+    });
+  }
+  void
+  CopyFromChunk(SizeValueType chunk, const unsigned char * chunkBuffer, unsigned char * regionBuffer) const
+  {
+    this->VisitRows(chunk, [=](size_t chunkOffset, size_t regionOffset, size_t length) {
+      std::copy_n(chunkBuffer + chunkOffset, length, regionBuffer + regionOffset);
+    });
+  }
+
+  // The shuffle filter stores the n-th bytes of all the components together.
+  bool
+  IsShuffled(uint32_t filterMask) const
+  {
+    return m_ShuffleMask != 0 && (filterMask & m_ShuffleMask) == 0;
+  }
+  bool
+  IsDeflated(uint32_t filterMask) const
+  {
+    return (filterMask & m_DeflateMask) == 0;
+  }
+  void
+  Shuffle(const unsigned char * input, unsigned char * output) const
+  {
+    const size_t numberOfComponents = m_NumberOfChunkBytes / m_ComponentSize;
+    for (size_t i = 0; i < numberOfComponents; ++i)
+    {
+      for (size_t byte = 0; byte < m_ComponentSize; ++byte)
+      {
+        output[byte * numberOfComponents + i] = input[i * m_ComponentSize + byte];
+      }
+    }
+  }
+  void
+  Unshuffle(const unsigned char * input, unsigned char * output) const
+  {
+    const size_t numberOfComponents = m_NumberOfChunkBytes / m_ComponentSize;
+    for (size_t i = 0; i < numberOfComponents; ++i)
+    {
+      for (size_t byte = 0; byte < m_ComponentSize; ++byte)
+      {
+        output[i * m_ComponentSize + byte] = input[byte * numberOfComponents + i];
+      }
+    }
+  }
+
+private:
+  // Calls visitor(chunkOffset, regionOffset, length) for the contiguous rows
+  // of bytes in the intersection of a chunk and of the region.
+  template <typename TVisitor>
+  void
+  VisitRows(SizeValueType chunk, TVisitor visitor) const
+  {
+    const size_t               dimensions = m_DataSize.size();
+    const std::vector<hsize_t> chunkIndex = this->GetChunkIndex(chunk);
+    std::vector<hsize_t>       begin(dimensions);
+    std::vector<hsize_t>       end(dimensions);
+    std::vector<size_t>        chunkStride(dimensions);
+    std::vector<size_t>        regionStride(dimensions);
+    for (size_t d = 0; d < dimensions; ++d)
+    {
+      begin[d] = std::max(chunkIndex[d], m_RegionIndex[d]);
+      end[d] = std::min(chunkIndex[d] + m_ChunkSize[d], m_RegionIndex[d] + m_RegionSize[d]);
+      chunkStride[d] = d == 0 ? m_ComponentSize : chunkStride[d - 1] * m_ChunkSize[d - 1];
+      regionStride[d] = d == 0 ? m_ComponentSize : regionStride[d - 1] * m_RegionSize[d - 1];
+    }
+
+    const size_t         length = (end[0] - begin[0]) * m_ComponentSize;
+    std::vector<hsize_t> position = begin;
+    for (;;)
+    {
+      size_t chunkOffset = 0;
+      size_t regionOffset = 0;
+      for (size_t i = 0; i < dimensions; ++i)
+      {
+        chunkOffset += (position[i] - chunkIndex[i]) * chunkStride[i];
+        regionOffset += (position[i] - m_RegionIndex[i]) * regionStride[i];
+      }
+      visitor(chunkOffset, regionOffset, length);
+
+      size_t d = 1;
+      for (; d < dimensions; ++d)
+      {
+        if (++position[d] < end[d])
+        {
+          break;
+        }
+        position[d] = begin[d];
+      }
+      if (d == dimensions)
+      {
+        return;
+      }
+    }
+  }
+
+  bool                 m_Scalar{ true };
+  std::vector<hsize_t> m_DataSize{};
+  std::vector<hsize_t> m_ChunkSize{};
+  std::vector<hsize_t> m_RegionIndex{};
+  std::vector<hsize_t> m_RegionSize{};
+  std::vector<hsize_t> m_FirstChunk{};
+  std::vector<hsize_t> m_NumberOfChunksAlong{};
+  SizeValueType        m_NumberOfChunks{ 0 };
+  size_t               m_ComponentSize{ 0 };
+  size_t               m_NumberOfChunkBytes{ 0 };
+  unsigned int         m_ShuffleMask{ 0 };
+  unsigned int         m_DeflateMask{ 0 };
+  int                  m_CompressionLevel{ Z_DEFAULT_COMPRESSION };
+};
+
+// The chunks are read and written in batches of a few chunks per thread,
+// which bounds the memory held by the compressed chunks.
+SizeValueType
+GetChunkBatchSize()
+{
+  return 4 * SizeValueType{ MultiThreaderBase::GetGlobalDefaultNumberOfThreads() };
+}
+} // namespace
+
+bool
+HDF5ImageIO::ReadChunks(void * buffer)
+{
+#if H5_VERSION_GE(1, 10, 5)
+  DeflatedChunks chunks;
+  if (!chunks.Initialize(*m_VoxelDataSet, this->GetIORegion(), this->GetNumberOfDimensions()))
+  {
+    return false;
+  }
+
+  // Chunks which were never written hold the fill value, leave them to the
+  // HDF5 library
+  const hid_t          dataSetId = m_VoxelDataSet->getId();
+  const SizeValueType  numberOfChunks = chunks.GetNumberOfChunks();
+  std::vector<hsize_t> storageSizes(numberOfChunks);
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    unsigned int filterMask = 0;
+    haddr_t      address = HADDR_UNDEF;
+    if (H5Dget_chunk_info_by_coord(
+          dataSetId, chunks.GetChunkOffset(chunk).data(), &filterMask, &address, &storageSizes[chunk]) < 0 ||
+        address == HADDR_UNDEF)
+    {
+      return false;
+    }
+  }
+
+  const SizeValueType             batchSize = GetChunkBatchSize();
+  std::vector<std::vector<Bytef>> storedChunks(std::min(batchSize, numberOfChunks));
+  std::vector<uint32_t>           filterMasks(storedChunks.size());
+  std::atomic<bool>               failed{ false };
+  for (SizeValueType first = 0; first < numberOfChunks; first += batchSize)
+  {
+    const SizeValueType last = std::min(first + batchSize, numberOfChunks);
+    for (SizeValueType chunk = first; chunk < last; ++chunk)
+    {
+      std::vector<Bytef> & storedChunk = storedChunks[chunk - first];
+      storedChunk.resize(storageSizes[chunk]);
+      if (H5Dread_chunk(dataSetId,
+                        H5P_DEFAULT,
+                        chunks.GetChunkOffset(chunk).data(),
+                        &filterMasks[chunk - first],
+                        storedChunk.data()) < 0)
+      {
+        itkExceptionMacro("Error reading a chunk of " << this->GetFileName());
+      }
+    }
+
+    MultiThreaderBase::New()->ParallelizeArray(
+      first,
+      last,
+      [&](SizeValueType chunk) {
+        const std::vector<Bytef> & storedChunk = storedChunks[chunk - first];
+        const uint32_t             filterMask = filterMasks[chunk - first];
+        const size_t               numberOfChunkBytes = chunks.GetNumberOfChunkBytes();
+        std::vector<Bytef>         chunkBuffer(numberOfChunkBytes);
+        if (chunks.IsDeflated(filterMask))
+        {
+          uLongf length = numberOfChunkBytes;
+          if (uncompress(chunkBuffer.data(), &length, storedChunk.data(), storedChunk.size()) != Z_OK ||
+              length != numberOfChunkBytes)
+          {
+            failed = true;
+            return;
+          }
+        }
+        else if (storedChunk.size() == numberOfChunkBytes)
+        {
+          chunkBuffer = storedChunk;
+        }
+        else
+        {
+          failed = true;
+          return;
+        }
+        if (chunks.IsShuffled(filterMask))
+        {
+          std::vector<Bytef> shuffled(numberOfChunkBytes);
+          std::swap(shuffled, chunkBuffer);
+          chunks.Unshuffle(shuffled.data(), chunkBuffer.data());
+        }
+        chunks.CopyFromChunk(chunk, chunkBuffer.data(), static_cast<Bytef *>(buffer));
+      },
+      nullptr);
+    if (failed)
+    {
+      itkExceptionMacro("Error decompressing a chunk of " << this->GetFileName());
+    }
+  }
+  return true;
+#else
+  (void)buffer;
+  return false;
+#endif
+}
+
+bool
+HDF5ImageIO::WriteChunks(const void * buffer)
+{
+#if H5_VERSION_GE(1, 10, 5)
+  DeflatedChunks chunks;
+  if (!chunks.Initialize(*m_VoxelDataSet, this->GetIORegion(), this->GetNumberOfDimensions()) ||
+      !chunks.RegionCoversChunks())
+  {
+    return false;
+  }
+
+  const hid_t                     dataSetId = m_VoxelDataSet->getId();
+  const SizeValueType             numberOfChunks = chunks.GetNumberOfChunks();
+  const SizeValueType             batchSize = GetChunkBatchSize();
+  const int                       compressionLevel = chunks.GetCompressionLevel();
+  std::vector<std::vector<Bytef>> storedChunks(std::min(batchSize, numberOfChunks));
+  std::atomic<bool>               failed{ false };
+  for (SizeValueType first = 0; first < numberOfChunks; first += batchSize)
+  {
+    const SizeValueType last = std::min(first + batchSize, numberOfChunks);
+    MultiThreaderBase::New()->ParallelizeArray(
+      first,
+      last,
+      [&](SizeValueType chunk) {
+        const size_t numberOfChunkBytes = chunks.GetNumberOfChunkBytes();
+        // The parts of the chunks outside of the dataset are not used
+        std::vector<Bytef> chunkBuffer(numberOfChunkBytes, 0);
+        chunks.CopyToChunk(chunk, static_cast<const Bytef *>(buffer), chunkBuffer.data());
+        if (chunks.IsShuffled(0))
+        {
+          std::vector<Bytef> unshuffled(numberOfChunkBytes);
+          std::swap(unshuffled, chunkBuffer);
+          chunks.Shuffle(unshuffled.data(), chunkBuffer.data());
+        }
+
+        std::vector<Bytef> & storedChunk = storedChunks[chunk - first];
+        uLongf               length = compressBound(numberOfChunkBytes);
+        storedChunk.resize(length);
+        if (compress2(storedChunk.data(), &length, chunkBuffer.data(), numberOfChunkBytes, compressionLevel) != Z_OK)
+        {
+          failed = true;
+          return;
+        }
+        storedChunk.resize(length);
+      },
+      nullptr);
+    if (failed)
+    {
+      itkExceptionMacro("Error compressing a chunk of " << this->GetFileName());
+    }
+
+    for (SizeValueType chunk = first; chunk < last; ++chunk)
+    {
+      const std::vector<Bytef> & storedChunk = storedChunks[chunk - first];
+      if (H5Dwrite_chunk(dataSetId,
+                         H5P_DEFAULT,
+                         0,
+                         chunks.GetChunkOffset(chunk).data(),
+                         storedChunk.size(),
+                         storedChunk.data()) < 0)
+      {
+        itkExceptionMacro("Error writing a chunk of " << this->GetFileName());
+      }
+    }
+  }
+  return true;
+#else
+  (void)buffer;
+  return false;
+#endif
+}
+
 void
 HDF5ImageIO::Read(void * buffer)
 {
@@ -1038,6 +1522,11 @@ HDF5ImageIO::Read(void * buffer)
   const H5::DataType voxelType = m_VoxelDataSet->getDataType();
   H5::DataSpace      imageSpace = m_VoxelDataSet->getSpace();
 
+  if (this->ReadChunks(buffer))
+  {
+    return;
+  }
+
   H5::DataSpace dspace;
   this->SetupStreaming(&imageSpace, &dspace);
   m_VoxelDataSet->read(buffer, voxelType, dspace, imageSpace);
@@ -1216,16 +1705,43 @@ HDF5ImageIO::WriteImageInformation()
     const H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
 
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
+    // by default, set the chunk size to be the N-1 dimension
     // region
     const H5::DSetCreatPropList plist;
 
     if (this->GetUseCompression())
     {
-      plist.setDeflate(this->GetCompressionLevel());
+      if (m_UseShuffle)
+      {
+        plist.setShuffle();
+      }
+      if (m_CompressionFilter == H5Z_FILTER_DEFLATE)
+      {
+        plist.setDeflate(this->GetCompressionLevel());
+      }
+      else if (m_CompressionFilter == ZstandardFilter)
+      {
+        const unsigned int compressionLevel = this->GetCompressionLevel();
+        plist.setFilter(m_CompressionFilter, H5Z_FLAG_OPTIONAL, 1, &compressionLevel);
+      }
+      else
+      {
+        plist.setFilter(m_CompressionFilter, H5Z_FLAG_OPTIONAL);
+      }
     }
 
-    dims[0] = 1;
+    const unsigned int imageDims = this->GetNumberOfDimensions();
+    if (m_ChunkSize.empty())
+    {
+      dims[0] = 1;
+    }
+    for (unsigned int i = 0; i < std::min<size_t>(imageDims, m_ChunkSize.size()); ++i)
+    {
+      if (m_ChunkSize[i] > 0)
+      {
+        dims[imageDims - i - 1] = std::min<hsize_t>(dims[imageDims - i - 1], m_ChunkSize[i]);
+      }
+    }
     plist.setChunk(numDims, dims.get());
     dims.reset();
 
@@ -1422,6 +1938,10 @@ void
 HDF5ImageIO::Write(const void * buffer)
 {
   this->WriteImageInformation();
+  if (this->WriteChunks(buffer))
+  {
+    return;
+  }
   try
   {
     const int numComponents = this->GetNumberOfComponents();
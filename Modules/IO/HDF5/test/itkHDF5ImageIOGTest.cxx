@@ -16,13 +16,21 @@
  *
  *=========================================================================*/
 #include "itkHDF5ImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileTileCache.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkMetaDataObject.h"
+#include "itkVectorImage.h"
 #include "itk_H5Cpp.h"
 #include "itkGTest.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 
 #define _STRING(s) #s
@@ -99,6 +107,134 @@ ReadImageInformationDescription(const std::string & path)
   }
   return {};
 }
+
+template <typename TImage>
+typename TImage::Pointer
+MakeRampImage(const typename TImage::SizeType & size, unsigned int numberOfComponents = 1)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->SetNumberOfComponentsPerPixel(numberOfComponents);
+  image->Allocate();
+  auto * const buffer = image->GetBufferPointer();
+  std::iota(buffer, buffer + image->GetBufferedRegion().GetNumberOfPixels() * numberOfComponents, 0);
+  return image;
+}
+
+template <typename TImage>
+void
+WriteImage(const TImage *      image,
+           itk::HDF5ImageIO *  io,
+           const std::string & path,
+           unsigned int        numberOfDivisions = 1,
+           bool                useCompression = true)
+{
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(image);
+  writer->SetImageIO(io);
+  writer->SetFileName(path);
+  writer->SetNumberOfStreamDivisions(numberOfDivisions);
+  writer->SetUseCompression(useCompression);
+  writer->Update();
+}
+
+// Reads the region of the file with streaming, and compares it with the image
+template <typename TImage>
+void
+ExpectRegionEqual(const TImage * expected, const std::string & path, const typename TImage::RegionType & region)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetImageIO(itk::HDF5ImageIO::New());
+  reader->SetFileName(path);
+  reader->UseStreamingOn();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+
+  const TImage * const image = reader->GetOutput();
+  ASSERT_EQ(region, image->GetBufferedRegion());
+  ASSERT_EQ(expected->GetNumberOfComponentsPerPixel(), image->GetNumberOfComponentsPerPixel());
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(expected->GetPixel(it.GetIndex()), it.Get()) << it.GetIndex();
+  }
+}
+
+std::vector<hsize_t>
+ReadChunkDimensions(const std::string & path)
+{
+  const H5::H5File            file(path, H5F_ACC_RDONLY);
+  const H5::DataSet           dataSet = file.openDataSet("/ITKImage/0/VoxelData");
+  const H5::DSetCreatPropList plist = dataSet.getCreatePlist();
+  std::vector<hsize_t>        dims(dataSet.getSpace().getSimpleExtentNdims());
+  plist.getChunk(static_cast<int>(dims.size()), dims.data());
+  return dims;
+}
+
+std::vector<H5Z_filter_t>
+ReadFilters(const std::string & path)
+{
+  const H5::H5File            file(path, H5F_ACC_RDONLY);
+  const H5::DSetCreatPropList plist = file.openDataSet("/ITKImage/0/VoxelData").getCreatePlist();
+  std::vector<H5Z_filter_t>   filters;
+  for (int i = 0; i < plist.getNfilters(); ++i)
+  {
+    unsigned int flags = 0;
+    size_t       numberOfValues = 0;
+    unsigned int filterConfig = 0;
+    char         name[1];
+    filters.push_back(plist.getFilter(i, flags, numberOfValues, nullptr, 0, name, filterConfig));
+  }
+  return filters;
+}
+
+// An HDF5ImageIO which records the largest number of its instances calling
+// the HDF5 library at the same time.
+class CallCountingHDF5ImageIO : public itk::HDF5ImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CallCountingHDF5ImageIO);
+
+  using Self = CallCountingHDF5ImageIO;
+  using Superclass = itk::HDF5ImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(CallCountingHDF5ImageIO);
+
+  static inline std::atomic<int> s_CallsInFlight{ 0 };
+  static inline std::atomic<int> s_MaximumCallsInFlight{ 0 };
+
+  void
+  ReadImageInformation() override
+  {
+    CountCall([this] { Superclass::ReadImageInformation(); });
+  }
+
+  void
+  Read(void * buffer) override
+  {
+    CountCall([this, buffer] { Superclass::Read(buffer); });
+  }
+
+protected:
+  CallCountingHDF5ImageIO() = default;
+
+private:
+  template <typename TCall>
+  static void
+  CountCall(const TCall & call)
+  {
+    const int callsInFlight = ++s_CallsInFlight;
+    int       maximumCallsInFlight = s_MaximumCallsInFlight;
+    while (callsInFlight > maximumCallsInFlight &&
+           !s_MaximumCallsInFlight.compare_exchange_weak(maximumCallsInFlight, callsInFlight))
+    {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    call();
+    --s_CallsInFlight;
+  }
+};
 } // namespace
 
 TEST(HDF5ImageIO, ReadImageInformationAcceptsConsistentGeometry)
@@ -180,3 +316,159 @@ TEST(HDF5ImageIO, WriteImageInformationCStringMetaDataRoundTrips)
   ASSERT_TRUE(itk::ExposeMetaData<std::string>(readIO->GetMetaDataDictionary(), "ConstCStringMeta", readConstValue));
   EXPECT_EQ(readConstValue, "const payload");
 }
+
+TEST(HDF5ImageIO, DefaultChunksAreSlices)
+{
+  using ImageType = itk::Image<short, 3>;
+  const std::string path = TestFilePath("default_chunks");
+  const auto        image = MakeRampImage<ImageType>(itk::MakeSize(21, 13, 5));
+  WriteImage(image.GetPointer(), itk::HDF5ImageIO::New(), path);
+
+  EXPECT_EQ(ReadChunkDimensions(path), std::vector<hsize_t>({ 1, 13, 21 }));
+  EXPECT_EQ(ReadFilters(path), std::vector<H5Z_filter_t>({ H5Z_FILTER_DEFLATE }));
+  ExpectRegionEqual(image.GetPointer(), path, image->GetLargestPossibleRegion());
+}
+
+TEST(HDF5ImageIO, ChunkedShuffledRoundTrip)
+{
+  using ImageType = itk::Image<unsigned int, 3>;
+  const std::string path = TestFilePath("shuffled_chunks");
+  const auto        image = MakeRampImage<ImageType>(itk::MakeSize(37, 29, 11));
+
+  auto io = itk::HDF5ImageIO::New();
+  io->SetChunkSize({ 16, 0, 4 });
+  io->UseShuffleOn();
+  WriteImage(image.GetPointer(), io, path);
+
+  // Zero stands for the whole extent, and the chunks are at most the image
+  EXPECT_EQ(ReadChunkDimensions(path), std::vector<hsize_t>({ 4, 29, 16 }));
+  EXPECT_EQ(ReadFilters(path), std::vector<H5Z_filter_t>({ H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE }));
+
+  ExpectRegionEqual(image.GetPointer(), path, image->GetLargestPossibleRegion());
+  ExpectRegionEqual(image.GetPointer(), path, ImageType::RegionType(itk::MakeIndex(5, 3, 2), itk::MakeSize(20, 7, 6)));
+  ExpectRegionEqual(
+    image.GetPointer(), path, ImageType::RegionType(itk::MakeIndex(36, 28, 10), itk::MakeSize(1, 1, 1)));
+
+  // The shuffled chunks are read as well by the HDF5 library
+  const H5::H5File          file(path, H5F_ACC_RDONLY);
+  const H5::DataSet         dataSet = file.openDataSet("/ITKImage/0/VoxelData");
+  std::vector<unsigned int> values(image->GetBufferedRegion().GetNumberOfPixels());
+  dataSet.read(values.data(), H5::PredType::NATIVE_UINT);
+  EXPECT_TRUE(std::equal(values.begin(), values.end(), image->GetBufferPointer()));
+}
+
+TEST(HDF5ImageIO, ChunkedVectorImageRoundTrip)
+{
+  using ImageType = itk::VectorImage<float, 2>;
+  const std::string path = TestFilePath("vector_chunks");
+  const auto        image = MakeRampImage<ImageType>(itk::MakeSize(45, 31), 3);
+
+  auto io = itk::HDF5ImageIO::New();
+  io->SetChunkSize({ 8, 8 });
+  io->UseShuffleOn();
+  WriteImage(image.GetPointer(), io, path);
+
+  EXPECT_EQ(ReadChunkDimensions(path), std::vector<hsize_t>({ 8, 8, 3 }));
+  ExpectRegionEqual(image.GetPointer(), path, image->GetLargestPossibleRegion());
+  ExpectRegionEqual(image.GetPointer(), path, ImageType::RegionType(itk::MakeIndex(7, 9), itk::MakeSize(30, 13)));
+}
+
+TEST(HDF5ImageIO, StreamedChunkedWrite)
+{
+  using ImageType = itk::Image<double, 3>;
+  const auto image = MakeRampImage<ImageType>(itk::MakeSize(19, 17, 12));
+
+  // Pieces of 3 slices cover whole chunks of 3 slices, and cut chunks of 5 slices
+  for (const itk::SizeValueType chunkDepth : { 3, 5 })
+  {
+    const std::string path = TestFilePath("streamed_chunks_" + std::to_string(chunkDepth));
+    auto              io = itk::HDF5ImageIO::New();
+    io->SetFileName(path);
+    io->SetNumberOfDimensions(3);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      io->SetDimensions(i, image->GetLargestPossibleRegion().GetSize(i));
+    }
+    io->SetPixelType(itk::IOPixelEnum::SCALAR);
+    io->SetComponentType(itk::IOComponentEnum::DOUBLE);
+    io->SetChunkSize({ 8, 8, chunkDepth });
+    io->UseCompressionOn();
+
+    for (itk::IndexValueType z = 0; z < 12; z += 3)
+    {
+      itk::ImageIORegion region(3);
+      region.SetIndex({ 0, 0, z });
+      region.SetSize({ 19, 17, 3 });
+      io->SetIORegion(region);
+      io->Write(image->GetBufferPointer() + image->ComputeOffset(itk::MakeIndex(0, 0, z)));
+    }
+    io = nullptr;
+
+    ExpectRegionEqual(image.GetPointer(), path, image->GetLargestPossibleRegion());
+    ExpectRegionEqual(image.GetPointer(), path, ImageType::RegionType(itk::MakeIndex(2, 3, 4), itk::MakeSize(9, 9, 6)));
+  }
+}
+
+TEST(HDF5ImageIO, UncompressedChunks)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  const std::string path = TestFilePath("uncompressed_chunks");
+  const auto        image = MakeRampImage<ImageType>(itk::MakeSize(15, 10));
+
+  auto io = itk::HDF5ImageIO::New();
+  io->SetChunkSize({ 4, 4 });
+  io->UseShuffleOn();
+  WriteImage(image.GetPointer(), io, path, 1, false);
+
+  EXPECT_EQ(ReadChunkDimensions(path), std::vector<hsize_t>({ 4, 4 }));
+  EXPECT_TRUE(ReadFilters(path).empty());
+  ExpectRegionEqual(image.GetPointer(), path, ImageType::RegionType(itk::MakeIndex(3, 2), itk::MakeSize(9, 7)));
+}
+
+TEST(HDF5ImageIO, Compressors)
+{
+  auto io = itk::HDF5ImageIO::New();
+  EXPECT_EQ(io->GetCompressor(), "");
+  io->SetCompressor("gzip");
+  EXPECT_EQ(io->GetCompressor(), "gzip");
+
+  // The plugins are usually not installed: the compressor is then reset to the default
+  io->SetCompressor("ZSTD");
+  EXPECT_TRUE(io->GetCompressor() == "ZSTD" || io->GetCompressor().empty());
+
+  using ImageType = itk::Image<unsigned short, 2>;
+  const std::string path = TestFilePath("compressor");
+  const auto        image = MakeRampImage<ImageType>(itk::MakeSize(30, 20));
+  io->SetChunkSize({ 10, 10 });
+  WriteImage(image.GetPointer(), io, path);
+  ExpectRegionEqual(image.GetPointer(), path, ImageType::RegionType(itk::MakeIndex(5, 5), itk::MakeSize(20, 10)));
+}
+
+TEST(HDF5ImageIO, TileCachePrefetchReadsOneTileAtATime)
+{
+  using ImageType = itk::Image<short, 3>;
+  const std::string path = TestFilePath("tile_cache");
+  const auto        image = MakeRampImage<ImageType>(itk::MakeSize(40, 30, 12));
+  WriteImage(image.GetPointer(), itk::HDF5ImageIO::New(), path);
+
+  // The HDF5 library is not thread safe
+  EXPECT_FALSE(itk::HDF5ImageIO::New()->CanReadConcurrently());
+
+  auto cache = itk::ImageFileTileCache<ImageType>::New();
+  cache->SetFileName(path);
+  cache->SetImageIO(CallCountingHDF5ImageIO::New());
+  cache->SetTileSize(itk::MakeSize(16, 16, 4));
+  cache->ReadImageInformation();
+  CallCountingHDF5ImageIO::s_MaximumCallsInFlight = 0;
+  cache->Prefetch(image->GetLargestPossibleRegion());
+  cache->WaitForPrefetch();
+
+  EXPECT_EQ(CallCountingHDF5ImageIO::s_MaximumCallsInFlight, 1);
+  EXPECT_EQ(cache->GetNumberOfTileReads(), 3u * 2u * 3u);
+
+  const ImageType::Pointer readImage = cache->ReadRegion(image->GetLargestPossibleRegion());
+  EXPECT_EQ(cache->GetNumberOfTileReads(), 3u * 2u * 3u);
+  EXPECT_TRUE(std::equal(image->GetBufferPointer(),
+                         image->GetBufferPointer() + image->GetBufferedRegion().GetNumberOfPixels(),
+                         readImage->GetBufferPointer()));
+}
@@ -23,6 +23,7 @@
 
 #include "itkImageIOBase.h"
 #include "itkImageSource.h"
+#include "itkMemoryMappedFile.h"
 #include "itkMacro.h"
 #include "itkImageRegion.h"
 #include "itkDefaultConvertPixelTraits.h"
@@ -121,6 +122,28 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
   /** @ITKEndGrouping */
+
+  /** Set/Get whether the pixel data should be memory mapped from the file,
+   * instead of being read into a newly allocated buffer. Mapping is only
+   * done when the ImageIO reports that the pixel data can be mapped (see
+   * ImageIOBase::CanMemoryMapPixelData), when the pixels need no conversion,
+   * and when the pixel data is suitably aligned in the file. The output then buffers its LargestPossibleRegion, while
+   * the pages of the file are only read when they are accessed, so that
+   * processing a small region of a large file is cheap. Otherwise the file
+   * is read as usual. Default is false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstReferenceMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+  /** @ITKEndGrouping */
+
+  /** Set/Get how the memory mapped pixels may be accessed. Default is
+   * CopyOnWrite, which lets filters modify the output (e.g. in place)
+   * without modifying the file. */
+  /** @ITKStartGrouping */
+  itkSetEnumMacro(MemoryMappingAccess, MemoryMappedFileEnums::Access);
+  itkGetEnumMacro(MemoryMappingAccess, MemoryMappedFileEnums::Access);
+  /** @ITKEndGrouping */
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -139,6 +162,11 @@ protected:
   void
   TestFileExistanceAndReadability();
 
+  /** Try to let the output refer to the memory mapped pixel data of the
+   * file. Returns false if the pixel data cannot be mapped. */
+  bool
+  MemoryMapOutput();
+
   /** Prepare the allocation of the output image during the first back
    * propagation of the pipeline. */
   void
@@ -163,6 +191,10 @@ protected:
 
   bool m_UseStreaming{};
 
+  bool m_UseMemoryMapping{ false };
+
+  MemoryMappedFileEnums::Access m_MemoryMappingAccess{ MemoryMappedFileEnums::Access::CopyOnWrite };
+
 private:
   std::string m_ExceptionMessage{};
 
@@ -24,6 +24,7 @@
 #include "itkPixelTraits.h"
 #include "itkVectorImage.h"
 #include "itkMetaDataObject.h"
+#include "itkMemoryMappedImageContainer.h"
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
@@ -49,6 +50,8 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  itkPrintSelfBooleanMacro(UseMemoryMapping);
+  os << indent << "MemoryMappingAccess: " << m_MemoryMappingAccess << std::endl;
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
@@ -360,6 +363,13 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
                 << "Allocating the buffer with the EnlargedRequestedRegion \n"
                 << output->GetRequestedRegion() << '\n');
 
+  // Let the output refer to the pixel data of the file, if possible
+  if (m_UseMemoryMapping && this->MemoryMapOutput())
+  {
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
   // allocated the output image to the size of the enlarge requested region
   this->AllocateOutputs();
 
@@ -441,6 +451,63 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MemoryMapOutput()
+{
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using ElementType = typename PixelContainerType::Element;
+  using MappedContainerType =
+    MemoryMappedImageContainer<typename PixelContainerType::ElementIdentifier, ElementType>;
+
+  const typename TOutputImage::Pointer output = this->GetOutput();
+  const ImageRegionType                largestRegion = output->GetLargestPossibleRegion();
+
+  // The pixels must not need any conversion, and the file must hold exactly
+  // the pixels of the largest possible region.
+  const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+  if (m_ImageIO->GetComponentType() != ioType ||
+      m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents() ||
+      static_cast<SizeValueType>(m_ImageIO->GetImageSizeInPixels()) != largestRegion.GetNumberOfPixels())
+  {
+    return false;
+  }
+  const auto numberOfBytes = static_cast<uint64_t>(m_ImageIO->GetImageSizeInBytes());
+  if (numberOfBytes == 0 || numberOfBytes % sizeof(ElementType) != 0)
+  {
+    return false;
+  }
+
+  m_ImageIO->SetFileName(this->GetFileName().c_str());
+  std::string           dataFileName;
+  ImageIOBase::SizeType dataOffset = 0;
+  if (!m_ImageIO->CanMemoryMapPixelData(dataFileName, dataOffset) || dataOffset < 0 ||
+      static_cast<uint64_t>(dataOffset) % alignof(ElementType) != 0)
+  {
+    itkDebugMacro("The pixel data of " << this->GetFileName() << " cannot be memory mapped");
+    return false;
+  }
+
+  std::shared_ptr<const MemoryMappedFile> mappedFile;
+  try
+  {
+    mappedFile =
+      std::make_shared<const MemoryMappedFile>(dataFileName, dataOffset, numberOfBytes, m_MemoryMappingAccess);
+  }
+  catch (const ExceptionObject & err)
+  {
+    // Let the ImageIO read the file, and report the error if it cannot either
+    itkDebugMacro("Memory mapping failed: " << err.GetDescription());
+    return false;
+  }
+
+  const auto container = MappedContainerType::New();
+  container->SetMemoryMappedFile(std::move(mappedFile), numberOfBytes / sizeof(ElementType));
+  output->SetBufferedRegion(largestRegion);
+  output->SetPixelContainer(container);
+  return true;
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(const void * inputData, size_t numberOfPixels)
@@ -0,0 +1,243 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageFileTileCache_h
+#define itkImageFileTileCache_h
+
+#include "itkImageFileReader.h"
+#include "itkLexicographicCompare.h"
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+/** \class ImageFileTileCache
+ * \brief Gives random access to an image file too large to be held in memory.
+ *
+ * The image is divided in tiles of TileSize pixels, aligned on the index of
+ * the largest possible region of the file. The tiles are read on demand
+ * with an ImageFileReader, and at most MaximumNumberOfTiles of them are kept
+ * in memory: when a new tile is needed, the least recently used one is
+ * released. The tiles covering a region which will be accessed soon can be
+ * read in the background with Prefetch().
+ *
+ * Only the requested tile is read when the ImageIO supports streamed
+ * reading (e.g. MetaImage, NRRD or VTK files without compression). Other
+ * ImageIOs read the whole file for each tile.
+ *
+ * GetTile(), GetPixel(), ReadRegion() and Prefetch() can be called
+ * concurrently from several threads. A tile requested by several threads
+ * at once is read only once. Different tiles are read concurrently only when
+ * the ImageIO can read concurrently (see ImageIOBase::CanReadConcurrently()),
+ * and one at a time otherwise, e.g. for HDF5 files.
+ *
+ * The pipeline already streams images larger than memory through filters
+ * which support it; this class is meant for the algorithms which access
+ * an image at arbitrary locations, or several times at the same locations.
+ *
+ * \sa ImageFileReader
+ * \sa StreamingImageFilter
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT ImageFileTileCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageFileTileCache);
+
+  /** Standard class type aliases. */
+  using Self = ImageFileTileCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageFileTileCache);
+
+  using ImageType = TImage;
+  using ImagePointer = typename ImageType::Pointer;
+  using ImageConstPointer = typename ImageType::ConstPointer;
+  using PixelType = typename ImageType::PixelType;
+  using IndexType = typename ImageType::IndexType;
+  using SizeType = typename ImageType::SizeType;
+  using RegionType = typename ImageType::RegionType;
+  using SpacingType = typename ImageType::SpacingType;
+  using PointType = typename ImageType::PointType;
+  using DirectionType = typename ImageType::DirectionType;
+  using ReaderType = ImageFileReader<ImageType>;
+
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  /** Set/Get the name of the file to read. */
+  /** @ITKStartGrouping */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the ImageIO used to read the file. It is cloned for each
+   * tile read. If not set, the ImageIO is created by the ImageIOFactory. */
+  /** @ITKStartGrouping */
+  itkSetObjectMacro(ImageIO, ImageIOBase);
+  itkGetModifiableObjectMacro(ImageIO, ImageIOBase);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the size of the tiles. Default is 64 pixels along the first
+   * two directions and 1 along the other ones, which suits the files stored
+   * slice by slice. */
+  /** @ITKStartGrouping */
+  itkSetMacro(TileSize, SizeType);
+  itkGetConstReferenceMacro(TileSize, SizeType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the maximum number of tiles kept in memory. Default is 64. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(MaximumNumberOfTiles, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(MaximumNumberOfTiles, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Read the image information from the file and release all the tiles.
+   * It is called automatically on the first access after a change of the
+   * parameters. */
+  void
+  ReadImageInformation();
+
+  /** The geometry of the image in the file. Returned by value, because the
+   * information may be read again by another thread. */
+  /** @ITKStartGrouping */
+  RegionType
+  GetLargestPossibleRegion();
+  SpacingType
+  GetSpacing();
+  PointType
+  GetOrigin();
+  DirectionType
+  GetDirection();
+  /** @ITKEndGrouping */
+
+  /** The index of the tile containing the pixel at the given index. */
+  IndexType
+  GetTileIndex(const IndexType & index);
+
+  /** The region of the image covered by a tile. The tiles on the upper
+   * border of the image may be smaller than TileSize. */
+  RegionType
+  GetTileRegion(const IndexType & tileIndex);
+
+  /** Returns the tile, read from the file if it is not in the cache. */
+  ImageConstPointer
+  GetTile(const IndexType & tileIndex);
+
+  /** Returns the value of a pixel of the file. */
+  PixelType
+  GetPixel(const IndexType & index);
+
+  /** Returns a new image holding the given region of the file, assembled from
+   * the tiles. */
+  ImagePointer
+  ReadRegion(const RegionType & region);
+
+  /** Reads in the background the tiles covering the given region, which are
+   * not in the cache. Reading errors are reported when the tiles are
+   * accessed. */
+  void
+  Prefetch(const RegionType & region);
+
+  /** Waits until the tiles requested by Prefetch() are read. */
+  void
+  WaitForPrefetch();
+
+  /** Releases all the tiles. */
+  void
+  Clear();
+
+  /** Number of tiles currently in the cache. */
+  SizeValueType
+  GetNumberOfCachedTiles() const;
+
+  /** Number of tile requests found in the cache, and read from the file. */
+  /** @ITKStartGrouping */
+  SizeValueType
+  GetNumberOfTileHits() const;
+  SizeValueType
+  GetNumberOfTileReads() const;
+  /** @ITKEndGrouping */
+
+protected:
+  ImageFileTileCache();
+  ~ImageFileTileCache() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Reads a tile from the file. Called without holding the lock, possibly
+   * from several threads at once. */
+  virtual ImageConstPointer
+  ReadTile(const RegionType & tileRegion) const;
+
+private:
+  using TileFutureType = std::shared_future<ImageConstPointer>;
+  using TileListType = std::list<IndexType>;
+
+  struct TileEntry
+  {
+    TileFutureType                  Tile;
+    typename TileListType::iterator LeastRecentlyUsedPosition;
+    SizeValueType                   ReadIdentifier;
+  };
+
+  using TileMapType = std::map<IndexType, TileEntry, Functor::LexicographicCompare>;
+
+  /** Reads the image information if the parameters were modified since the
+   * last time. The methods below must be called with the lock held. */
+  void
+  UpdateImageInformation();
+
+  IndexType
+  ComputeTileIndex(const IndexType & index) const;
+
+  RegionType
+  ComputeTileRegion(const IndexType & tileIndex) const;
+
+  std::string                    m_FileName{};
+  ImageIOBase::Pointer           m_ImageIO{};
+  SizeType                       m_TileSize{};
+  SizeValueType                  m_MaximumNumberOfTiles{ 64 };
+  ImagePointer                   m_ImageInformation{};
+  TimeStamp                      m_ImageInformationTime{};
+  TileMapType                    m_Tiles{};
+  TileListType                   m_LeastRecentlyUsedTiles{};
+  SizeValueType                  m_NumberOfTileHits{ 0 };
+  SizeValueType                  m_NumberOfTileReads{ 0 };
+  std::vector<std::future<void>> m_PrefetchResults{};
+  bool                           m_ReadConcurrently{ false };
+  mutable std::mutex             m_Mutex{};
+  std::mutex                     m_ReadMutex{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkImageFileTileCache.hxx"
+#endif
+
+#endif
@@ -0,0 +1,454 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageFileTileCache_hxx
+#define itkImageFileTileCache_hxx
+
+#include "itkImageAlgorithm.h"
+#include "itkIndexRange.h"
+#include "itkPrintHelper.h"
+#include "itkThreadPool.h"
+#include <algorithm>
+#include <chrono>
+
+namespace itk
+{
+template <typename TImage>
+ImageFileTileCache<TImage>::ImageFileTileCache()
+{
+  m_TileSize.Fill(1);
+  for (unsigned int i = 0; i < std::min(ImageDimension, 2u); ++i)
+  {
+    m_TileSize[i] = 64;
+  }
+}
+
+template <typename TImage>
+ImageFileTileCache<TImage>::~ImageFileTileCache()
+{
+  this->WaitForPrefetch();
+}
+
+template <typename TImage>
+void
+ImageFileTileCache<TImage>::ReadImageInformation()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_ImageInformation = nullptr;
+  this->UpdateImageInformation();
+}
+
+template <typename TImage>
+void
+ImageFileTileCache<TImage>::UpdateImageInformation()
+{
+  if (m_ImageInformation && m_ImageInformationTime > this->GetMTime())
+  {
+    return;
+  }
+
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro("FileName must be specified");
+  }
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    if (m_TileSize[i] == 0)
+    {
+      itkExceptionMacro("TileSize must be at least 1 in all the directions: " << m_TileSize);
+    }
+  }
+
+  auto reader = ReaderType::New();
+  reader->SetFileName(m_FileName);
+  if (m_ImageIO)
+  {
+    reader->SetImageIO(m_ImageIO);
+  }
+  reader->UpdateOutputInformation();
+  m_ReadConcurrently = reader->GetImageIO()->CanReadConcurrently();
+
+  auto imageInformation = ImageType::New();
+  imageInformation->CopyInformation(reader->GetOutput());
+  m_ImageInformation = imageInformation;
+  m_ImageInformationTime.Modified();
+
+  m_Tiles.clear();
+  m_LeastRecentlyUsedTiles.clear();
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::GetLargestPossibleRegion() -> RegionType
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->UpdateImageInformation();
+  return m_ImageInformation->GetLargestPossibleRegion();
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::GetSpacing() -> SpacingType
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->UpdateImageInformation();
+  return m_ImageInformation->GetSpacing();
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::GetOrigin() -> PointType
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->UpdateImageInformation();
+  return m_ImageInformation->GetOrigin();
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::GetDirection() -> DirectionType
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->UpdateImageInformation();
+  return m_ImageInformation->GetDirection();
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::ComputeTileIndex(const IndexType & index) const -> IndexType
+{
+  const IndexType & largestIndex = m_ImageInformation->GetLargestPossibleRegion().GetIndex();
+
+  IndexType tileIndex;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    // Round toward minus infinity, so the indices before the image are not in the first tile
+    const auto           tileSize = static_cast<IndexValueType>(m_TileSize[i]);
+    const IndexValueType offset = index[i] - largestIndex[i];
+    tileIndex[i] = offset / tileSize - (offset % tileSize < 0 ? 1 : 0);
+  }
+  return tileIndex;
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::ComputeTileRegion(const IndexType & tileIndex) const -> RegionType
+{
+  const RegionType & largestRegion = m_ImageInformation->GetLargestPossibleRegion();
+
+  RegionType tileRegion;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    tileRegion.SetIndex(i, largestRegion.GetIndex(i) + tileIndex[i] * static_cast<IndexValueType>(m_TileSize[i]));
+    tileRegion.SetSize(i, m_TileSize[i]);
+  }
+  if (!tileRegion.Crop(largestRegion))
+  {
+    itkExceptionMacro("Tile " << tileIndex << " is outside of the image " << largestRegion);
+  }
+  return tileRegion;
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::GetTileIndex(const IndexType & index) -> IndexType
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->UpdateImageInformation();
+  return this->ComputeTileIndex(index);
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::GetTileRegion(const IndexType & tileIndex) -> RegionType
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->UpdateImageInformation();
+  return this->ComputeTileRegion(tileIndex);
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::GetTile(const IndexType & tileIndex) -> ImageConstPointer
+{
+  std::promise<ImageConstPointer> promise;
+  TileFutureType                  tile;
+  RegionType                      tileRegion;
+  SizeValueType                   readIdentifier = 0;
+  bool                            readConcurrently = false;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+
+    this->UpdateImageInformation();
+    const auto it = m_Tiles.find(tileIndex);
+    if (it != m_Tiles.end())
+    {
+      // Most recently used tiles are at the front of the list
+      m_LeastRecentlyUsedTiles.splice(
+        m_LeastRecentlyUsedTiles.begin(), m_LeastRecentlyUsedTiles, it->second.LeastRecentlyUsedPosition);
+      ++m_NumberOfTileHits;
+      tile = it->second.Tile;
+    }
+    else
+    {
+      tileRegion = this->ComputeTileRegion(tileIndex);
+      tile = promise.get_future().share();
+      readIdentifier = ++m_NumberOfTileReads;
+      readConcurrently = m_ReadConcurrently;
+      m_LeastRecentlyUsedTiles.push_front(tileIndex);
+      m_Tiles.emplace(tileIndex, TileEntry{ tile, m_LeastRecentlyUsedTiles.begin(), readIdentifier });
+
+      // The tiles still used by a caller are kept alive by their smart pointer
+      while (m_Tiles.size() > m_MaximumNumberOfTiles)
+      {
+        m_Tiles.erase(m_LeastRecentlyUsedTiles.back());
+        m_LeastRecentlyUsedTiles.pop_back();
+      }
+    }
+  }
+
+  if (readIdentifier != 0)
+  {
+    // Read the tile without holding the lock, so other tiles can be accessed
+    // meanwhile. The other callers requesting this tile wait on the future.
+    try
+    {
+      // An ImageIO which cannot read concurrently may call a library which is
+      // not thread safe, like HDF5, so its tiles are read one at a time
+      std::unique_lock<std::mutex> readLock(m_ReadMutex, std::defer_lock);
+      if (!readConcurrently)
+      {
+        readLock.lock();
+      }
+      promise.set_value(this->ReadTile(tileRegion));
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+
+      // Do not keep the failure in the cache
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      const auto                        it = m_Tiles.find(tileIndex);
+      if (it != m_Tiles.end() && it->second.ReadIdentifier == readIdentifier)
+      {
+        m_LeastRecentlyUsedTiles.erase(it->second.LeastRecentlyUsedPosition);
+        m_Tiles.erase(it);
+      }
+    }
+  }
+
+  return tile.get();
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::ReadTile(const RegionType & tileRegion) const -> ImageConstPointer
+{
+  auto reader = ReaderType::New();
+  reader->SetFileName(m_FileName);
+  if (m_ImageIO)
+  {
+    // ImageIO objects hold the state of the file being read, so each reader
+    // needs its own, with the same reading settings
+    reader->SetImageIO(m_ImageIO->Clone());
+  }
+
+  ImageType * output = reader->GetOutput();
+  reader->UpdateOutputInformation();
+  output->SetRequestedRegion(tileRegion);
+  output->Update();
+
+  if (output->GetBufferedRegion() == tileRegion)
+  {
+    const ImagePointer tile = output;
+    tile->DisconnectPipeline();
+    return tile;
+  }
+
+  // The ImageIO read more than the tile: only keep the tile in memory
+  auto tile = ImageType::New();
+  tile->CopyInformation(output);
+  tile->SetBufferedRegion(tileRegion);
+  tile->SetRequestedRegion(tileRegion);
+  tile->Allocate();
+  ImageAlgorithm::Copy(output, tile.GetPointer(), tileRegion, tileRegion);
+  return tile;
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::GetPixel(const IndexType & index) -> PixelType
+{
+  return this->GetTile(this->GetTileIndex(index))->GetPixel(index);
+}
+
+template <typename TImage>
+auto
+ImageFileTileCache<TImage>::ReadRegion(const RegionType & region) -> ImagePointer
+{
+  auto image = ImageType::New();
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+
+    this->UpdateImageInformation();
+    if (!m_ImageInformation->GetLargestPossibleRegion().IsInside(region))
+    {
+      itkExceptionMacro("Region " << region << " is outside of the image "
+                                  << m_ImageInformation->GetLargestPossibleRegion());
+    }
+    image->CopyInformation(m_ImageInformation);
+  }
+  image->SetBufferedRegion(region);
+  image->SetRequestedRegion(region);
+  image->Allocate();
+
+  const IndexType firstTileIndex = this->GetTileIndex(region.GetIndex());
+  const IndexType lastTileIndex = this->GetTileIndex(region.GetUpperIndex());
+  RegionType      tileIndices;
+  tileIndices.SetIndex(firstTileIndex);
+  tileIndices.SetUpperIndex(lastTileIndex);
+
+  for (const IndexType & tileIndex : ImageRegionIndexRange<ImageDimension>(tileIndices))
+  {
+    const ImageConstPointer tile = this->GetTile(tileIndex);
+    RegionType              tileRegion = tile->GetBufferedRegion();
+    tileRegion.Crop(region);
+    ImageAlgorithm::Copy(tile.GetPointer(), image.GetPointer(), tileRegion, tileRegion);
+  }
+  return image;
+}
+
+template <typename TImage>
+void
+ImageFileTileCache<TImage>::Prefetch(const RegionType & region)
+{
+  RegionType tileIndices;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+
+    this->UpdateImageInformation();
+    RegionType croppedRegion = region;
+    if (!croppedRegion.Crop(m_ImageInformation->GetLargestPossibleRegion()))
+    {
+      return;
+    }
+    tileIndices.SetIndex(this->ComputeTileIndex(croppedRegion.GetIndex()));
+    tileIndices.SetUpperIndex(this->ComputeTileIndex(croppedRegion.GetUpperIndex()));
+
+    // Forget about the prefetches already done
+    m_PrefetchResults.erase(std::remove_if(m_PrefetchResults.begin(),
+                                           m_PrefetchResults.end(),
+                                           [](const std::future<void> & result) {
+                                             return result.wait_for(std::chrono::seconds(0)) ==
+                                                    std::future_status::ready;
+                                           }),
+                            m_PrefetchResults.end());
+  }
+
+  for (const IndexType & tileIndex : ImageRegionIndexRange<ImageDimension>(tileIndices))
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (m_Tiles.find(tileIndex) == m_Tiles.end())
+    {
+      m_PrefetchResults.push_back(ThreadPool::GetInstance()->AddWork([this, tileIndex] {
+        try
+        {
+          this->GetTile(tileIndex);
+        }
+        catch (...)
+        {
+          // Reported when the tile is accessed
+        }
+      }));
+    }
+  }
+}
+
+template <typename TImage>
+void
+ImageFileTileCache<TImage>::WaitForPrefetch()
+{
+  std::vector<std::future<void>> prefetchResults;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    prefetchResults.swap(m_PrefetchResults);
+  }
+  for (auto & result : prefetchResults)
+  {
+    result.wait();
+  }
+}
+
+template <typename TImage>
+void
+ImageFileTileCache<TImage>::Clear()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Tiles.clear();
+  m_LeastRecentlyUsedTiles.clear();
+}
+
+template <typename TImage>
+SizeValueType
+ImageFileTileCache<TImage>::GetNumberOfCachedTiles() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<SizeValueType>(m_Tiles.size());
+}
+
+template <typename TImage>
+SizeValueType
+ImageFileTileCache<TImage>::GetNumberOfTileHits() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfTileHits;
+}
+
+template <typename TImage>
+SizeValueType
+ImageFileTileCache<TImage>::GetNumberOfTileReads() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfTileReads;
+}
+
+template <typename TImage>
+void
+ImageFileTileCache<TImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << m_FileName << std::endl;
+  itkPrintSelfObjectMacro(ImageIO);
+  os << indent << "TileSize: " << m_TileSize << std::endl;
+  os << indent << "MaximumNumberOfTiles: " << m_MaximumNumberOfTiles << std::endl;
+  os << indent << "NumberOfCachedTiles: " << this->GetNumberOfCachedTiles() << std::endl;
+  os << indent << "NumberOfTileHits: " << this->GetNumberOfTileHits() << std::endl;
+  os << indent << "NumberOfTileReads: " << this->GetNumberOfTileReads() << std::endl;
+}
+} // end namespace itk
+
+#endif
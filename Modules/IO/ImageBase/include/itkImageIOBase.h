@@ -89,6 +89,9 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(ImageIOBase);
 
+  /** Create a clone of this ImageIO, see InternalClone(). */
+  itkCloneMacro(Self);
+
   /** Set/Get the name of the file to be read. */
   /** @ITKStartGrouping */
   itkSetStringMacro(FileName);
@@ -509,6 +512,18 @@ public:
     return false;
   }
 
+  /** Determine if clones of this ImageIO can read files concurrently, each
+   * one in its own thread. This requires the library which reads the files to
+   * be thread safe, and Clone() to copy all the reading settings (see
+   * InternalClone()). Readers which read concurrently otherwise read one
+   * file at a time with this ImageIO. Default is false.
+   * \sa ImageSeriesReader, ImageFileTileCache */
+  virtual bool
+  CanReadConcurrently() const
+  {
+    return false;
+  }
+
   /** Read the spacing and dimensions of the image.
    * Assumes SetFileName has been called with a valid file name. */
   virtual void
@@ -518,6 +533,20 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Determine if the pixel data of the file can be memory mapped, instead
+   * of being read by Read(). This requires the pixels of the whole image to
+   * be stored uncompressed and contiguously in a single file, in the native
+   * byte order, and in the same layout as in the pixel buffer of an image.
+   * If so, returns true, and sets the name of that file and the offset, in
+   * bytes, of the pixel data within it. Must be called after
+   * ReadImageInformation(). Default is false.
+   * \sa ImageFileReader::SetUseMemoryMapping */
+  virtual bool
+  CanMemoryMapPixelData(std::string & itkNotUsed(dataFileName), SizeType & itkNotUsed(dataOffset))
+  {
+    return false;
+  }
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -794,6 +823,14 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Creates another instance of the same class, with the same reading and
+   * writing settings (compression, streaming, palette, byte order and file
+   * type), but without the information about any particular file. Subclasses
+   * with settings of their own extend it, so that a clone reads a file the
+   * same way as the original. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual const ImageRegionSplitterBase *
   GetImageRegionSplitter() const;
 
@@ -35,6 +35,14 @@ namespace itk
  * the files, but the image data must have the same Size for all
  * dimensions.
  *
+ * The files are read concurrently by up to GetNumberOfWorkUnits() readers,
+ * each one straight into its part of the output buffer, when the ImageIO of
+ * every file can read concurrently (see ImageIOBase::CanReadConcurrently()).
+ * They are otherwise read one after another. The meta data dictionaries are
+ * nevertheless in the order of the files, and the error of the first file
+ * that cannot be read is reported. Set the number of work units to 1 to read
+ * the files one after another anyway.
+ *
  * \sa GDCMSeriesFileNames
  * \sa NumericSeriesFileNames
  * \ingroup IOFilters
@@ -135,7 +143,13 @@ public:
   /** Set/Get the ImageIO helper class. By default, the
    * ImageSeriesReader uses the factory mechanism of the
    * ImageFileReader to determine the file type. This method can be
-   * used to specify which IO to use. */
+   * used to specify which IO to use. When the files are read
+   * concurrently, each reader uses a clone of this ImageIO (see
+   * LightObject::Clone()), and this ImageIO reads the information of the
+   * last file afterwards. Only an ImageIO class which overrides
+   * ImageIOBase::CanReadConcurrently() reads concurrently, and it must then
+   * copy its own settings into its clones by extending
+   * ImageIOBase::InternalClone(). */
   /** @ITKStartGrouping */
   itkSetObjectMacro(ImageIO, ImageIOBase);
   itkGetModifiableObjectMacro(ImageIO, ImageIOBase);
@@ -23,9 +23,9 @@
 #include "itkArray.h"
 #include "itkVector.h"
 #include "itkMath.h"
-#include "itkProgressReporter.h"
 #include "itkMetaDataObject.h"
 #include <cstddef> // For ptrdiff_t.
+#include <exception>
 #include <iomanip>
 
 namespace itk
@@ -292,9 +292,6 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   output->SetBufferedRegion(requestedRegion);
   output->Allocate();
 
-  // progress reported on a per slice basis
-  ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
-
   // We utilize the modified time of the output information to
   // know when the meta array needs to be updated, when the output
   // information is updated so should the meta array.
@@ -304,139 +301,247 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
   typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
   const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
 
-  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
-  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
-  double                             maxSpacingDeviation = 0.0;
-  bool                               prevSliceIsValid = false;
-
-  m_InternalMetaDataDictionaries.reserve(static_cast<size_t>(numberOfFiles));
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->SetUpdateProgress(this->GetThreaderUpdateProgress());
 
-  for (int i = 0; i != numberOfFiles; ++i)
-  {
+  const auto getSliceStartIndex = [&requestedRegion, this](int i) {
+    IndexType sliceStartIndex = requestedRegion.GetIndex();
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
     {
       sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
     }
-
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
-
-    // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+    return sliceStartIndex;
+  };
+  const auto getFileName = [this, numberOfFiles](int i) -> const std::string & {
+    return m_FileNames[m_ReverseOrder ? numberOfFiles - i - 1 : i];
+  };
+
+  // Concurrent readers each use a clone of the ImageIO, because an ImageIO
+  // holds the information of the file it reads. The files are only read
+  // concurrently by ImageIO classes which declare that they can be, the
+  // others may call a library which is not thread safe. Without an ImageIO,
+  // the one of each file is therefore created beforehand by the factory.
+  bool readConcurrently = this->GetMultiThreader()->GetNumberOfWorkUnits() > 1 && numberOfFiles > 1;
+  std::vector<ImageIOBase::Pointer> fileImageIOs;
+  if (readConcurrently && m_ImageIO)
+  {
+    readConcurrently = m_ImageIO->CanReadConcurrently();
+  }
+  else if (readConcurrently)
+  {
+    fileImageIOs.resize(static_cast<size_t>(numberOfFiles));
+    for (int i = 0; i < numberOfFiles && readConcurrently; ++i)
     {
-      continue;
+      if (requestedRegion.IsInside(getSliceStartIndex(i)) || needToUpdateMetaDataDictionaryArray)
+      {
+        ImageIOBase::Pointer & fileImageIO = fileImageIOs[static_cast<size_t>(i)];
+        fileImageIO = ImageIOFactory::CreateImageIO(getFileName(i).c_str(), ImageIOFactory::IOFileModeEnum::ReadMode);
+        readConcurrently = fileImageIO && fileImageIO->CanReadConcurrently();
+      }
     }
+  }
+  if (!readConcurrently)
+  {
+    this->GetMultiThreader()->SetNumberOfWorkUnits(1);
+  }
 
-    // configure reader
+  const auto makeReader = [this, readConcurrently, &fileImageIOs, &getFileName](int i) {
     auto reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
-
-    TOutputImage * readerOutput = reader->GetOutput();
-
+    reader->SetFileName(getFileName(i).c_str());
     if (m_ImageIO)
     {
-      reader->SetImageIO(m_ImageIO);
+      if (readConcurrently)
+      {
+        reader->SetImageIO(m_ImageIO->Clone());
+      }
+      else
+      {
+        reader->SetImageIO(m_ImageIO);
+      }
+    }
+    else if (static_cast<size_t>(i) < fileImageIOs.size() && fileImageIOs[static_cast<size_t>(i)])
+    {
+      reader->SetImageIO(fileImageIOs[static_cast<size_t>(i)]);
     }
     reader->SetUseStreaming(m_UseStreaming);
-    readerOutput->SetRequestedRegion(sliceRegionToRequest);
+    return reader;
+  };
+
+  // What is read from each file. The slices are read concurrently, each one
+  // straight into its part of the output buffer. The origins and the meta
+  // data dictionaries are then processed in the order of the files.
+  struct SliceInformation
+  {
+    bool                             read{ false };
+    bool                             hasDictionary{ false };
+    typename TOutputImage::PointType origin{};
+    MetaDataDictionary               dictionary{};
+    std::exception_ptr               exception{};
+  };
+  std::vector<SliceInformation> slices(static_cast<size_t>(numberOfFiles));
+
+  const auto readSlice = [&, this](SizeValueType sliceNumber) {
+    const auto         i = static_cast<int>(sliceNumber);
+    SliceInformation & slice = slices[sliceNumber];
+    const IndexType    sliceStartIndex = getSliceStartIndex(i);
+    const bool         insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
 
-    // update the data or info
-    if (!insideRequestedRegion)
+    // check if we need this slice
+    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
     {
-      reader->UpdateOutputInformation();
+      return;
     }
-    else
-    {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
 
-      // propagate the requested region to determine what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
+    try
+    {
+      const auto     reader = makeReader(i);
+      TOutputImage * readerOutput = reader->GetOutput();
+      readerOutput->SetRequestedRegion(sliceRegionToRequest);
 
-      // check that the size of each slice is the same
-      if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+      // update the data or info
+      if (!insideRequestedRegion)
       {
-        itkExceptionMacro("Size mismatch! The size of  "
-                          << m_FileNames[iFileName].c_str() << " is "
-                          << readerOutput->GetLargestPossibleRegion().GetSize()
-                          << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+        reader->UpdateOutputInformation();
       }
+      else
+      {
+        // read the meta data information
+        readerOutput->UpdateOutputInformation();
 
-      // get the size of the region to be read
-      const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+        // propagate the requested region to determine what the region
+        // will actually be read
+        readerOutput->PropagateRequestedRegion();
 
-      if (readSize == sliceRegionToRequest.GetSize())
-      {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
+        // check that the size of each slice is the same
+        if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+        {
+          itkExceptionMacro("Size mismatch! The size of  "
+                            << reader->GetFileName() << " is " << readerOutput->GetLargestPossibleRegion().GetSize()
+                            << " and does not match the required size " << validSize << " from file "
+                            << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+        }
+
+        // get the size of the region to be read
+        const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
 
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+        if (readSize == sliceRegionToRequest.GetSize())
+        {
+          // if the buffer of the ImageReader is going to match that of
+          // ourselves, then set the ImageReader's buffer to a section
+          // of ours
 
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+          const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
 
+          using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+          const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
 
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
 
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool bufferDelete = false;
+          const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                          ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                          : 0;
 
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
+          const ptrdiff_t numberOfPixelComponentsUpToSlice =
+            numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+          const bool bufferDelete = false;
 
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
-        {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer,
-            static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
-            bufferDelete);
+          typename TOutputImage::InternalPixelType * outputSliceBuffer =
+            outputBuffer + numberOfPixelComponentsUpToSlice;
+
+          if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+          {
+            // if the input image type is a vector image then the number
+            // of components needs to be set for the size
+            readerOutput->GetPixelContainer()->SetImportPointer(
+              outputSliceBuffer,
+              static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
+              bufferDelete);
+          }
+          else
+          {
+            // otherwise the actual number of pixels needs to be passed
+            readerOutput->GetPixelContainer()->SetImportPointer(
+              outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+          }
+          readerOutput->UpdateOutputData();
         }
         else
         {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
-        }
-        readerOutput->UpdateOutputData();
-      }
-      else
-      {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
+          // the read region isn't going to match exactly what we need
+          // to update to buffer created by the reader, then copy
 
-        reader->Update();
+          reader->Update();
 
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
+          // output of buffer copy
+          ImageRegionType outRegion = requestedRegion;
+          outRegion.SetIndex(sliceStartIndex);
 
-        // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+          // set the moving dimension to a size of 1
+          if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+          {
+            outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+          }
+
+          ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
         }
 
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+        slice.origin = readerOutput->GetOrigin();
+      } // end !insideRequestedRegion
+
+      // Deep copy the MetaDataDictionary, which is needed when non uniform
+      // sampling turns out to be detected
+      if (reader->GetImageIO())
+      {
+        slice.dictionary = reader->GetImageIO()->GetMetaDataDictionary();
+        slice.hasDictionary = true;
       }
+      slice.read = true;
+    }
+    catch (...)
+    {
+      slice.exception = std::current_exception();
+    }
+  };
+
+  this->GetMultiThreader()->ParallelizeArray(0, static_cast<SizeValueType>(numberOfFiles), readSlice, this);
+
+  // Report the error of the first file that could not be read
+  for (const SliceInformation & slice : slices)
+  {
+    if (slice.exception)
+    {
+      std::rethrow_exception(slice.exception);
+    }
+  }
+
+  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
+  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
+  double                             maxSpacingDeviation = 0.0;
+  bool                               prevSliceIsValid = false;
 
+  m_InternalMetaDataDictionaries.reserve(static_cast<size_t>(numberOfFiles));
+
+  for (int i = 0; i != numberOfFiles; ++i)
+  {
+    SliceInformation & slice = slices[static_cast<size_t>(i)];
+    const bool         insideRequestedRegion = requestedRegion.IsInside(getSliceStartIndex(i));
+    bool               nonUniformSampling = false;
+    double             spacingDeviation = 0.0;
+
+    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+    {
+      continue;
+    }
+
+    if (insideRequestedRegion)
+    {
       // verify that slice spacing is the expected one
       // since we can be skipping some slices because they are outside of requested region
       // I am using additional variable
       if (prevSliceIsValid)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
+        const typename TOutputImage::PointType & sliceOrigin = slice.origin;
         using SpacingScalarType = typename TOutputImage::SpacingValueType;
         Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
         for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
@@ -463,27 +568,51 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
+        prevSliceOrigin = slice.origin;
         prevSliceIsValid = true;
       }
+    }
+    else if (!slice.read)
+    {
+      // Non uniform sampling was detected after the concurrent reading, so
+      // the information of the slices outside of the requested region is
+      // still to be read
+      const auto reader = makeReader(i);
+      reader->UpdateOutputInformation();
+      if (reader->GetImageIO())
+      {
+        slice.dictionary = reader->GetImageIO()->GetMetaDataDictionary();
+        slice.hasDictionary = true;
+      }
+    }
 
-      // report progress for read slices
-      progress.CompletedPixel();
-    } // end !insideRequestedRegion
-
-    // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+    // Move the MetaDataDictionary into the array
+    if (slice.hasDictionary && needToUpdateMetaDataDictionaryArray)
     {
-      MetaDataDictionary newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
       if (nonUniformSampling)
       {
         // slice-specific information
-        EncapsulateMetaData<double>(newDictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
+        EncapsulateMetaData<double>(slice.dictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
       }
-      m_InternalMetaDataDictionaries.push_back(std::move(newDictionary));
+      m_InternalMetaDataDictionaries.push_back(std::move(slice.dictionary));
     }
   } // end per slice loop
 
+  // Let the ImageIO describe the last file read, as when the files are read
+  // one after another with the ImageIO itself
+  if (readConcurrently && m_ImageIO)
+  {
+    for (int i = numberOfFiles - 1; i >= 0; --i)
+    {
+      if (slices[static_cast<size_t>(i)].read)
+      {
+        m_ImageIO->SetFileName(getFileName(i));
+        m_ImageIO->ReadImageInformation();
+        break;
+      }
+    }
+  }
+
   m_MetaDataDictionaryArray.clear();
   m_MetaDataDictionaryArray.reserve(m_InternalMetaDataDictionaries.size());
 
@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedFile_h
+#define itkMemoryMappedFile_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkMacro.h"
+#include "itkIntTypes.h"
+#include <string>
+
+namespace itk
+{
+/** \class MemoryMappedFileEnums
+ * \brief Contains all enum classes used by MemoryMappedFile class.
+ * \ingroup ITKIOImageBase
+ */
+class MemoryMappedFileEnums
+{
+public:
+  /**
+   * \ingroup ITKIOImageBase
+   * How the mapped memory may be accessed.
+   */
+  enum class Access : uint8_t
+  {
+    /** The memory may only be read. Writing to it is a segmentation fault. */
+    ReadOnly,
+    /** The memory may be written, but the changes are private to the
+     * process: the pages which are written are copied on first write,
+     * and the file itself is never modified. */
+    CopyOnWrite
+  };
+};
+// Define how to print enumeration
+extern ITKIOImageBase_EXPORT std::ostream &
+                             operator<<(std::ostream & out, const MemoryMappedFileEnums::Access value);
+
+/** \class MemoryMappedFile
+ * \brief Maps a range of bytes of a file into memory.
+ *
+ * The range is mapped when the object is constructed, and unmapped when
+ * it is destroyed. Pages are only read from the file when they are first
+ * accessed, so mapping a large file is cheap, and only the parts of it
+ * which are actually accessed become resident.
+ *
+ * \sa MemoryMappedImageContainer
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT MemoryMappedFile
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedFile);
+
+  using AccessEnum = MemoryMappedFileEnums::Access;
+
+  /** Maps numberOfBytes bytes of the file, starting at offset, which does
+   * not need to be a multiple of the page size. Throws an ExceptionObject if
+   * the file cannot be opened or mapped, or if it is too short. */
+  MemoryMappedFile(const std::string & fileName,
+                   uint64_t            offset,
+                   uint64_t            numberOfBytes,
+                   AccessEnum          access = AccessEnum::CopyOnWrite);
+
+  ~MemoryMappedFile();
+
+  /** Returns the address at which the byte at offset in the file is mapped. */
+  void *
+  GetData() const
+  {
+    return m_Data;
+  }
+
+  uint64_t
+  GetNumberOfBytes() const
+  {
+    return m_NumberOfBytes;
+  }
+
+  AccessEnum
+  GetAccess() const
+  {
+    return m_Access;
+  }
+
+private:
+  void *     m_Data{};
+  uint64_t   m_NumberOfBytes{};
+  AccessEnum m_Access{};
+
+  // The mapping itself starts at a page boundary, at or before m_Data.
+  void *   m_MappedAddress{};
+  uint64_t m_MappedLength{};
+};
+} // end namespace itk
+
+#endif // itkMemoryMappedFile_h
@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImageContainer_h
+#define itkMemoryMappedImageContainer_h
+
+#include "itkImportImageContainer.h"
+#include "itkMemoryMappedFile.h"
+#include <memory>
+
+namespace itk
+{
+/** \class MemoryMappedImageContainer
+ * \brief An ImportImageContainer whose elements are memory mapped from a file.
+ *
+ * The container keeps the MemoryMappedFile alive for as long as it refers
+ * to the mapped memory. When the container is reallocated, e.g. by a call
+ * to Reserve() with a larger size, the elements are copied into memory
+ * managed by the container itself, and the file is unmapped.
+ *
+ * Writing to the elements of a read-only mapping is a segmentation fault.
+ * Writing to the elements of a copy-on-write mapping is allowed, and never
+ * modifies the file.
+ *
+ * \sa ImageFileReader::SetUseMemoryMapping
+ * \ingroup ImageObjects
+ * \ingroup ITKIOImageBase
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT MemoryMappedImageContainer : public ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedImageContainer);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedImageContainer;
+  using Superclass = ImportImageContainer<TElementIdentifier, TElement>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using typename Superclass::ElementIdentifier;
+  using typename Superclass::Element;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedImageContainer);
+
+  /** Lets the container refer to the memory of the mapped file, which must
+   * hold at least numberOfElements elements, suitably aligned. */
+  void
+  SetMemoryMappedFile(std::shared_ptr<const MemoryMappedFile> mappedFile, ElementIdentifier numberOfElements)
+  {
+    if (mappedFile == nullptr || mappedFile->GetNumberOfBytes() < numberOfElements * sizeof(Element))
+    {
+      itkExceptionMacro("The mapped file is too small for " << numberOfElements << " elements");
+    }
+    this->Superclass::SetImportPointer(static_cast<Element *>(mappedFile->GetData()), numberOfElements, false);
+    m_MappedFile = std::move(mappedFile);
+  }
+
+  /** Returns the mapped file, or nullptr if the container does not refer to
+   * mapped memory (anymore). */
+  const MemoryMappedFile *
+  GetMemoryMappedFile() const
+  {
+    return m_MappedFile.get();
+  }
+
+protected:
+  MemoryMappedImageContainer() = default;
+  ~MemoryMappedImageContainer() override = default;
+
+  void
+  DeallocateManagedMemory() override
+  {
+    if (m_MappedFile != nullptr)
+    {
+      m_MappedFile.reset();
+      this->SetImportPointer(nullptr);
+      this->SetCapacity(0);
+      this->SetSize(0);
+    }
+    else
+    {
+      this->Superclass::DeallocateManagedMemory();
+    }
+  }
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "MemoryMappedFile: " << m_MappedFile.get() << std::endl;
+  }
+
+private:
+  std::shared_ptr<const MemoryMappedFile> m_MappedFile{};
+};
+} // end namespace itk
+
+#endif
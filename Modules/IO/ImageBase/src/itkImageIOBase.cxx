@@ -1105,6 +1105,27 @@ ImageIOBase::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion
   return streamableRegion;
 }
 
+LightObject::Pointer
+ImageIOBase::InternalClone() const
+{
+  LightObject::Pointer lightObject = Superclass::InternalClone();
+
+  if (auto * const clone = dynamic_cast<Self *>(lightObject.GetPointer()))
+  {
+    clone->SetUseCompression(m_UseCompression);
+    clone->SetCompressor(m_Compressor);
+    clone->SetCompressionLevel(m_CompressionLevel);
+    clone->SetUseStreamedReading(m_UseStreamedReading);
+    clone->SetUseStreamedWriting(m_UseStreamedWriting);
+    clone->SetExpandRGBPalette(m_ExpandRGBPalette);
+    clone->SetWritePalette(m_WritePalette);
+    clone->SetByteOrder(m_ByteOrder);
+    clone->SetFileType(m_FileType);
+    return lightObject;
+  }
+  itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+}
+
 /** Return the directions that this particular ImageIO would use by default
  *  in the case the recipient image dimension is smaller than the dimension
  *  of the image in file. */
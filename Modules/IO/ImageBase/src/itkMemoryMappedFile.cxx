@@ -0,0 +1,155 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMemoryMappedFile.h"
+
+#include <limits>
+
+#if defined(_WIN32)
+#  include "itksys/Encoding.hxx"
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+MemoryMappedFile::MemoryMappedFile(const std::string & fileName,
+                                   uint64_t            offset,
+                                   uint64_t            numberOfBytes,
+                                   AccessEnum          access)
+  : m_NumberOfBytes(numberOfBytes)
+  , m_Access(access)
+{
+  if (numberOfBytes == 0)
+  {
+    itkGenericExceptionMacro("Cannot map zero bytes of " << fileName);
+  }
+
+#if defined(_WIN32)
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const uint64_t mappedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+#else
+  const auto     pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  const uint64_t mappedOffset = offset - offset % pageSize;
+#endif
+  m_MappedLength = numberOfBytes + (offset - mappedOffset);
+  if (m_MappedLength < numberOfBytes || m_MappedLength > std::numeric_limits<size_t>::max())
+  {
+    itkGenericExceptionMacro("Cannot map " << numberOfBytes << " bytes of " << fileName
+                                           << ": too large for the address space");
+  }
+
+#if defined(_WIN32)
+  const HANDLE file = CreateFileW(itksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " for memory mapping");
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || static_cast<uint64_t>(fileSize.QuadPart) < offset + numberOfBytes)
+  {
+    CloseHandle(file);
+    itkGenericExceptionMacro("Cannot map " << numberOfBytes << " bytes at offset " << offset << " of " << fileName
+                                           << ": the file is too short");
+  }
+  const HANDLE fileMapping = CreateFileMappingW(
+    file, nullptr, (access == AccessEnum::ReadOnly) ? PAGE_READONLY : PAGE_WRITECOPY, 0, 0, nullptr);
+  // The mapping keeps the file open, and the view keeps the mapping alive.
+  CloseHandle(file);
+  if (fileMapping != nullptr)
+  {
+    m_MappedAddress = MapViewOfFile(fileMapping,
+                                    (access == AccessEnum::ReadOnly) ? FILE_MAP_READ : FILE_MAP_COPY,
+                                    static_cast<DWORD>(mappedOffset >> 32),
+                                    static_cast<DWORD>(mappedOffset & 0xFFFFFFFF),
+                                    static_cast<SIZE_T>(m_MappedLength));
+    CloseHandle(fileMapping);
+  }
+  if (m_MappedAddress == nullptr)
+  {
+    itkGenericExceptionMacro("Cannot memory map " << fileName);
+  }
+#else
+  const int file = open(fileName.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " for memory mapping");
+  }
+  struct stat fileStatus;
+  if (fstat(file, &fileStatus) != 0 || static_cast<uint64_t>(fileStatus.st_size) < offset + numberOfBytes)
+  {
+    close(file);
+    itkGenericExceptionMacro("Cannot map " << numberOfBytes << " bytes at offset " << offset << " of " << fileName
+                                           << ": the file is too short");
+  }
+  void * const address = mmap(nullptr,
+                              static_cast<size_t>(m_MappedLength),
+                              (access == AccessEnum::ReadOnly) ? PROT_READ : (PROT_READ | PROT_WRITE),
+                              (access == AccessEnum::ReadOnly) ? MAP_SHARED : MAP_PRIVATE,
+                              file,
+                              static_cast<off_t>(mappedOffset));
+  // The mapping keeps a reference to the file.
+  close(file);
+  if (address == MAP_FAILED)
+  {
+    itkGenericExceptionMacro("Cannot memory map " << fileName);
+  }
+  m_MappedAddress = address;
+#endif
+
+  m_Data = static_cast<char *>(m_MappedAddress) + (offset - mappedOffset);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if defined(_WIN32)
+  UnmapViewOfFile(m_MappedAddress);
+#else
+  munmap(m_MappedAddress, static_cast<size_t>(m_MappedLength));
+#endif
+}
+
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const MemoryMappedFileEnums::Access value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case MemoryMappedFileEnums::Access::ReadOnly:
+        return "itk::MemoryMappedFileEnums::Access::ReadOnly";
+      case MemoryMappedFileEnums::Access::CopyOnWrite:
+        return "itk::MemoryMappedFileEnums::Access::CopyOnWrite";
+      default:
+        return "INVALID VALUE FOR itk::MemoryMappedFileEnums::Access";
+    }
+  }();
+}
+} // end namespace itk
@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkIndexRange.h"
+#include "itkMemoryMappedImageContainer.h"
+#include "itkMetaImageIO.h"
+#include "itkGTest.h"
+#include <fstream>
+#include <numeric>
+
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using MappedContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, float>;
+
+template <typename TImage = ImageType>
+typename TImage::Pointer
+MakeRampImage()
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::RegionType(typename TImage::SizeType{ { 17, 13, 11 } }));
+  image->Allocate();
+  typename TImage::PixelType * const buffer = image->GetBufferPointer();
+  std::iota(buffer, buffer + image->GetBufferedRegion().GetNumberOfPixels(), typename TImage::PixelType{});
+  return image;
+}
+
+template <typename TImage>
+void
+WriteMetaImage(const TImage * image, const std::string & fileName)
+{
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(itk::MetaImageIO::New());
+  writer->Update();
+}
+
+template <typename TImage>
+typename itk::ImageFileReader<TImage>::Pointer
+MakeMappingReader(const std::string & fileName)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::MetaImageIO::New());
+  reader->UseMemoryMappingOn();
+  return reader;
+}
+
+template <typename TImage>
+void
+ExpectEqualPixels(const TImage * expected, const TImage * actual)
+{
+  ASSERT_EQ(expected->GetBufferedRegion(), actual->GetBufferedRegion());
+  const itk::SizeValueType numberOfPixels = expected->GetBufferedRegion().GetNumberOfPixels();
+  EXPECT_TRUE(std::equal(expected->GetBufferPointer(),
+                         expected->GetBufferPointer() + numberOfPixels,
+                         actual->GetBufferPointer()));
+}
+} // namespace
+
+
+TEST(ImageFileReaderMemoryMapping, IsOffByDefault)
+{
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  EXPECT_FALSE(reader->GetUseMemoryMapping());
+  EXPECT_EQ(reader->GetMemoryMappingAccess(), itk::MemoryMappedFileEnums::Access::CopyOnWrite);
+}
+
+
+// The data follows the header, at an offset which is only guaranteed to be
+// suitably aligned for single byte pixels.
+TEST(ImageFileReaderMemoryMapping, MapsLocalMetaImageData)
+{
+  using ByteImageType = itk::Image<unsigned char, 3>;
+  const std::string fileName = ::testing::TempDir() + "/itkImageFileReaderMemoryMappingLocal.mha";
+  const auto        image = MakeRampImage<ByteImageType>();
+  WriteMetaImage(image.GetPointer(), fileName);
+
+  const auto reader = MakeMappingReader<ByteImageType>(fileName);
+  reader->Update();
+  const ByteImageType * const output = reader->GetOutput();
+  const auto * const          container =
+    dynamic_cast<const itk::MemoryMappedImageContainer<itk::SizeValueType, unsigned char> *>(
+      output->GetPixelContainer());
+  ASSERT_NE(container, nullptr);
+  EXPECT_NE(container->GetMemoryMappedFile(), nullptr);
+  ExpectEqualPixels(image.GetPointer(), output);
+}
+
+
+TEST(ImageFileReaderMemoryMapping, MapsDetachedMetaImageData)
+{
+  const std::string fileName = ::testing::TempDir() + "/itkImageFileReaderMemoryMappingDetached.mhd";
+  const auto        image = MakeRampImage();
+  WriteMetaImage(image.GetPointer(), fileName);
+
+  const auto reader = MakeMappingReader<ImageType>(fileName);
+  reader->Update();
+  EXPECT_NE(dynamic_cast<const MappedContainerType *>(reader->GetOutput()->GetPixelContainer()), nullptr);
+  ExpectEqualPixels(image.GetPointer(), reader->GetOutput());
+}
+
+
+TEST(ImageFileReaderMemoryMapping, BuffersLargestRegionForRequestedRegion)
+{
+  const std::string fileName = ::testing::TempDir() + "/itkImageFileReaderMemoryMappingRegion.mhd";
+  const auto        image = MakeRampImage();
+  WriteMetaImage(image.GetPointer(), fileName);
+
+  const auto reader = MakeMappingReader<ImageType>(fileName);
+  reader->UpdateOutputInformation();
+  const ImageType::RegionType requestedRegion({ 2, 3, 4 }, { 5, 6, 1 });
+  reader->GetOutput()->SetRequestedRegion(requestedRegion);
+  reader->Update();
+
+  const ImageType * const output = reader->GetOutput();
+  EXPECT_NE(dynamic_cast<const MappedContainerType *>(output->GetPixelContainer()), nullptr);
+  EXPECT_EQ(output->GetBufferedRegion(), image->GetLargestPossibleRegion());
+  for (const auto & index : itk::ImageRegionIndexRange<3>(requestedRegion))
+  {
+    EXPECT_EQ(output->GetPixel(index), image->GetPixel(index));
+  }
+}
+
+
+TEST(ImageFileReaderMemoryMapping, CopyOnWriteDoesNotModifyFile)
+{
+  const std::string fileName = ::testing::TempDir() + "/itkImageFileReaderMemoryMappingCopyOnWrite.mhd";
+  const auto        image = MakeRampImage();
+  WriteMetaImage(image.GetPointer(), fileName);
+
+  {
+    const auto reader = MakeMappingReader<ImageType>(fileName);
+    reader->Update();
+    EXPECT_NE(dynamic_cast<const MappedContainerType *>(reader->GetOutput()->GetPixelContainer()), nullptr);
+    reader->GetOutput()->FillBuffer(-1.0f);
+    EXPECT_EQ(reader->GetOutput()->GetPixel({ { 1, 2, 3 } }), -1.0f);
+  }
+
+  const auto reader = MakeMappingReader<ImageType>(fileName);
+  reader->SetMemoryMappingAccess(itk::MemoryMappedFileEnums::Access::ReadOnly);
+  reader->Update();
+  ExpectEqualPixels(image.GetPointer(), reader->GetOutput());
+}
+
+
+TEST(ImageFileReaderMemoryMapping, ReadsWhenPixelsNeedConversion)
+{
+  const std::string fileName = ::testing::TempDir() + "/itkImageFileReaderMemoryMappingConversion.mha";
+  WriteMetaImage(MakeRampImage().GetPointer(), fileName);
+
+  using DoubleImageType = itk::Image<double, 3>;
+  const auto reader = MakeMappingReader<DoubleImageType>(fileName);
+  reader->Update();
+  const DoubleImageType * const output = reader->GetOutput();
+  using DoubleMappedContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, double>;
+  EXPECT_EQ(dynamic_cast<const DoubleMappedContainerType *>(output->GetPixelContainer()), nullptr);
+  EXPECT_EQ(output->GetPixel({ { 1, 0, 0 } }), 1.0);
+}
+
+
+TEST(ImageFileReaderMemoryMapping, ReadsCompressedData)
+{
+  const std::string fileName = ::testing::TempDir() + "/itkImageFileReaderMemoryMappingCompressed.mha";
+  const auto        image = MakeRampImage();
+  auto              writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(itk::MetaImageIO::New());
+  writer->UseCompressionOn();
+  writer->Update();
+
+  const auto reader = MakeMappingReader<ImageType>(fileName);
+  reader->Update();
+  EXPECT_EQ(dynamic_cast<const MappedContainerType *>(reader->GetOutput()->GetPixelContainer()), nullptr);
+  ExpectEqualPixels(image.GetPointer(), reader->GetOutput());
+}
+
+
+TEST(ImageFileReaderMemoryMapping, ContainerCopiesDataWhenGrowing)
+{
+  const std::string fileName = ::testing::TempDir() + "/itkImageFileReaderMemoryMappingGrow.raw";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    const float   values[] = { 1.0f, 2.0f, 3.0f };
+    file.write(reinterpret_cast<const char *>(values), sizeof(values));
+  }
+
+  const auto container = MappedContainerType::New();
+  container->SetMemoryMappedFile(std::make_shared<const itk::MemoryMappedFile>(fileName, 4, 8), 2);
+  EXPECT_EQ((*container)[0], 2.0f);
+  EXPECT_EQ((*container)[1], 3.0f);
+
+  container->Reserve(10);
+  EXPECT_EQ(container->GetMemoryMappedFile(), nullptr);
+  EXPECT_EQ((*container)[1], 3.0f);
+  EXPECT_TRUE(container->GetContainerManageMemory());
+
+  EXPECT_THROW(itk::MemoryMappedFile(fileName, 4, 100), itk::ExceptionObject);
+}
@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileTileCache.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkMultiThreaderBase.h"
+#include "itkGTest.h"
+#include <atomic>
+#include <numeric>
+
+
+namespace
+{
+using ImageType = itk::Image<unsigned short, 3>;
+using CacheType = itk::ImageFileTileCache<ImageType>;
+
+ImageType::Pointer
+MakeRampImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(itk::MakeSize(50, 37, 7));
+  image->SetSpacing(itk::MakeVector(0.5, 0.75, 2.0));
+  image->SetOrigin(itk::MakePoint(-2.5, 2.25, 1.0));
+  image->Allocate();
+  ImageType::PixelType * const buffer = image->GetBufferPointer();
+  std::iota(buffer, buffer + image->GetBufferedRegion().GetNumberOfPixels(), ImageType::PixelType{});
+  return image;
+}
+
+std::string
+WriteRampImage(const char * name)
+{
+  const std::string fileName = ::testing::TempDir() + "/" + name;
+  auto              writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(MakeRampImage());
+  writer->SetFileName(fileName);
+  writer->SetImageIO(itk::MetaImageIO::New());
+  writer->Update();
+  return fileName;
+}
+
+CacheType::Pointer
+MakeCache(const std::string & fileName)
+{
+  auto cache = CacheType::New();
+  cache->SetFileName(fileName);
+  cache->SetImageIO(itk::MetaImageIO::New());
+  cache->SetTileSize(itk::MakeSize(16, 16, 1));
+  cache->SetMaximumNumberOfTiles(4);
+  return cache;
+}
+} // namespace
+
+
+TEST(ImageFileTileCache, ReadsImageInformation)
+{
+  const auto expected = MakeRampImage();
+  const auto cache = MakeCache(WriteRampImage("itkImageFileTileCacheInformation.mha"));
+
+  EXPECT_EQ(expected->GetLargestPossibleRegion(), cache->GetLargestPossibleRegion());
+  EXPECT_EQ(expected->GetSpacing(), cache->GetSpacing());
+  EXPECT_EQ(expected->GetOrigin(), cache->GetOrigin());
+  EXPECT_EQ(expected->GetDirection(), cache->GetDirection());
+  EXPECT_EQ(0u, cache->GetNumberOfCachedTiles());
+}
+
+TEST(ImageFileTileCache, TilesAreAlignedOnTheImage)
+{
+  const auto cache = MakeCache(WriteRampImage("itkImageFileTileCacheTiles.mha"));
+
+  EXPECT_EQ(itk::MakeIndex(0, 0, 0), cache->GetTileIndex(itk::MakeIndex(0, 0, 0)));
+  EXPECT_EQ(itk::MakeIndex(1, 2, 6), cache->GetTileIndex(itk::MakeIndex(16, 32, 6)));
+  EXPECT_EQ(itk::MakeIndex(-1, -1, 0), cache->GetTileIndex(itk::MakeIndex(-1, -1, 0)));
+
+  // The last tiles are cropped by the image
+  EXPECT_EQ(ImageType::RegionType(itk::MakeIndex(48, 32, 6), itk::MakeSize(2, 5, 1)),
+            cache->GetTileRegion(itk::MakeIndex(3, 2, 6)));
+
+  EXPECT_THROW(cache->GetTile(itk::MakeIndex(4, 0, 0)), itk::ExceptionObject);
+  EXPECT_THROW(cache->GetTile(itk::MakeIndex(0, -1, 0)), itk::ExceptionObject);
+}
+
+TEST(ImageFileTileCache, ReadsPixelsAndRegions)
+{
+  const auto expected = MakeRampImage();
+  const auto cache = MakeCache(WriteRampImage("itkImageFileTileCacheRegions.mha"));
+
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    ASSERT_EQ(it.Get(), cache->GetPixel(it.GetIndex())) << it.GetIndex();
+  }
+  EXPECT_LE(cache->GetNumberOfCachedTiles(), 4u);
+
+  const ImageType::RegionType region(itk::MakeIndex(7, 10, 2), itk::MakeSize(30, 20, 3));
+  const auto                  image = cache->ReadRegion(region);
+  EXPECT_EQ(region, image->GetBufferedRegion());
+  EXPECT_EQ(expected->GetSpacing(), image->GetSpacing());
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(expected->GetPixel(it.GetIndex()), it.Get()) << it.GetIndex();
+  }
+
+  EXPECT_THROW(cache->ReadRegion(ImageType::RegionType(itk::MakeIndex(40, 30, 0), itk::MakeSize(10, 10, 1))),
+               itk::ExceptionObject);
+}
+
+TEST(ImageFileTileCache, ReleasesLeastRecentlyUsedTiles)
+{
+  const auto cache = MakeCache(WriteRampImage("itkImageFileTileCacheLeastRecentlyUsed.mha"));
+
+  const auto first = cache->GetTile(itk::MakeIndex(0, 0, 0));
+  EXPECT_EQ(ImageType::RegionType(itk::MakeIndex(0, 0, 0), itk::MakeSize(16, 16, 1)), first->GetBufferedRegion());
+  EXPECT_EQ(first, cache->GetTile(itk::MakeIndex(0, 0, 0)));
+  EXPECT_EQ(1u, cache->GetNumberOfTileReads());
+  EXPECT_EQ(1u, cache->GetNumberOfTileHits());
+
+  for (itk::IndexValueType z = 1; z < 4; ++z)
+  {
+    cache->GetTile(itk::MakeIndex(0, 0, z));
+  }
+  // Use the first tile again, so the tile (0, 0, 1) is the least recently used one
+  cache->GetTile(itk::MakeIndex(0, 0, 0));
+  cache->GetTile(itk::MakeIndex(0, 0, 4));
+  EXPECT_EQ(4u, cache->GetNumberOfCachedTiles());
+  EXPECT_EQ(5u, cache->GetNumberOfTileReads());
+
+  cache->GetTile(itk::MakeIndex(0, 0, 0));
+  EXPECT_EQ(5u, cache->GetNumberOfTileReads());
+  cache->GetTile(itk::MakeIndex(0, 0, 1));
+  EXPECT_EQ(6u, cache->GetNumberOfTileReads());
+
+  // A released tile is still valid for its users
+  EXPECT_EQ(0u, first->GetPixel(itk::MakeIndex(0, 0, 0)));
+
+  cache->Clear();
+  EXPECT_EQ(0u, cache->GetNumberOfCachedTiles());
+}
+
+TEST(ImageFileTileCache, Prefetch)
+{
+  const auto cache = MakeCache(WriteRampImage("itkImageFileTileCachePrefetch.mha"));
+  cache->SetMaximumNumberOfTiles(100);
+
+  const ImageType::RegionType region(itk::MakeIndex(0, 10, 1), itk::MakeSize(20, 10, 2));
+  cache->Prefetch(region);
+  cache->WaitForPrefetch();
+
+  // Tiles (0..1, 0..1, 1..2)
+  EXPECT_EQ(8u, cache->GetNumberOfCachedTiles());
+  EXPECT_EQ(8u, cache->GetNumberOfTileReads());
+
+  cache->ReadRegion(region);
+  EXPECT_EQ(8u, cache->GetNumberOfTileReads());
+  EXPECT_EQ(8u, cache->GetNumberOfTileHits());
+
+  // Nothing to do outside of the image
+  cache->Prefetch(ImageType::RegionType(itk::MakeIndex(100, 0, 0), itk::MakeSize(10, 10, 1)));
+  cache->WaitForPrefetch();
+  EXPECT_EQ(8u, cache->GetNumberOfCachedTiles());
+}
+
+TEST(ImageFileTileCache, ConcurrentAccess)
+{
+  const auto expected = MakeRampImage();
+  const auto cache = MakeCache(WriteRampImage("itkImageFileTileCacheConcurrent.mha"));
+  cache->SetMaximumNumberOfTiles(3);
+
+  const ImageType::RegionType & region = expected->GetBufferedRegion();
+  std::atomic<unsigned int>     numberOfErrors{ 0 };
+  itk::MultiThreaderBase::New()->ParallelizeImageRegion<3>(
+    region,
+    [&](const ImageType::RegionType & threadRegion) {
+      for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, threadRegion); !it.IsAtEnd(); ++it)
+      {
+        if (cache->GetPixel(it.GetIndex()) != it.Get())
+        {
+          ++numberOfErrors;
+        }
+      }
+    },
+    nullptr);
+  EXPECT_EQ(0u, numberOfErrors);
+}
+
+TEST(ImageFileTileCache, ReportsMissingFile)
+{
+  auto cache = CacheType::New();
+  EXPECT_THROW(cache->GetLargestPossibleRegion(), itk::ExceptionObject);
+
+  cache->SetFileName(::testing::TempDir() + "/itkImageFileTileCacheMissing.mha");
+  EXPECT_THROW(cache->GetPixel(itk::MakeIndex(0, 0, 0)), itk::ExceptionObject);
+}
@@ -0,0 +1,310 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImageFileWriter.h"
+#include "itkImageSeriesReader.h"
+#include "itkMetaDataObject.h"
+#include "itkMetaImageIO.h"
+#include "itkMetaImageIOFactory.h"
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+using ReaderType = itk::ImageSeriesReader<ImageType>;
+
+constexpr unsigned int numberOfSlices = 23;
+
+// Writes single slice volumes with distinct pixel values and a "SliceNumber"
+// entry in their meta data. The slices are 1 apart, but a slice may be left
+// out, to make the sampling non uniform.
+std::vector<std::string>
+WriteSlices(const std::string & prefix, int missingSlice = -1)
+{
+  std::vector<std::string> fileNames;
+  for (unsigned int sliceNumber = 0; sliceNumber < numberOfSlices; ++sliceNumber)
+  {
+    if (static_cast<int>(sliceNumber) == missingSlice)
+    {
+      continue;
+    }
+    auto slice = ImageType::New();
+    slice->SetRegions(ImageType::RegionType(ImageType::SizeType{ { 19, 7, 1 } }));
+    slice->SetOrigin(ImageType::PointType{ { 0.0, 0.0, static_cast<double>(sliceNumber) } });
+    slice->Allocate();
+    std::iota(slice->GetBufferPointer(),
+              slice->GetBufferPointer() + slice->GetBufferedRegion().GetNumberOfPixels(),
+              static_cast<short>(1000 * sliceNumber));
+    itk::EncapsulateMetaData<std::string>(slice->GetMetaDataDictionary(), "SliceNumber", std::to_string(sliceNumber));
+
+    fileNames.push_back(::testing::TempDir() + "/" + prefix + std::to_string(sliceNumber) + ".mha");
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(slice);
+    writer->SetFileName(fileNames.back());
+    writer->SetImageIO(itk::MetaImageIO::New());
+    writer->Update();
+  }
+  return fileNames;
+}
+
+ReaderType::Pointer
+MakeReader(const std::vector<std::string> & fileNames, itk::ThreadIdType numberOfWorkUnits)
+{
+  auto reader = ReaderType::New();
+  reader->SetFileNames(fileNames);
+  reader->SetImageIO(itk::MetaImageIO::New());
+  reader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  return reader;
+}
+
+std::vector<std::string>
+GetSliceNumbers(const ReaderType * reader)
+{
+  std::vector<std::string> sliceNumbers;
+  for (const itk::MetaDataDictionary * dictionary : *reader->GetMetaDataDictionaryArray())
+  {
+    std::string sliceNumber;
+    itk::ExposeMetaData<std::string>(*dictionary, "SliceNumber", sliceNumber);
+    sliceNumbers.push_back(sliceNumber);
+  }
+  return sliceNumbers;
+}
+
+// A MetaImageIO which does not declare that it can read concurrently, as an
+// ImageIO calling a library which is not thread safe, and which records the
+// largest number of files read at the same time.
+class SerialMetaImageIO : public itk::MetaImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SerialMetaImageIO);
+
+  using Self = SerialMetaImageIO;
+  using Superclass = itk::MetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(SerialMetaImageIO);
+
+  static inline std::atomic<int> s_ReadsInFlight{ 0 };
+  static inline std::atomic<int> s_MaximumReadsInFlight{ 0 };
+
+  bool
+  CanReadConcurrently() const override
+  {
+    return false;
+  }
+
+  void
+  Read(void * buffer) override
+  {
+    const int readsInFlight = ++s_ReadsInFlight;
+    int       maximumReadsInFlight = s_MaximumReadsInFlight;
+    while (readsInFlight > maximumReadsInFlight &&
+           !s_MaximumReadsInFlight.compare_exchange_weak(maximumReadsInFlight, readsInFlight))
+    {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    Superclass::Read(buffer);
+    --s_ReadsInFlight;
+  }
+
+protected:
+  SerialMetaImageIO() = default;
+};
+
+void
+ExpectEqualPixels(const ImageType * expected, const ImageType * actual)
+{
+  ASSERT_EQ(expected->GetBufferedRegion(), actual->GetBufferedRegion());
+  EXPECT_TRUE(std::equal(expected->GetBufferPointer(),
+                         expected->GetBufferPointer() + expected->GetBufferedRegion().GetNumberOfPixels(),
+                         actual->GetBufferPointer()));
+}
+} // namespace
+
+
+TEST(ImageSeriesReaderConcurrency, ReadsSameAsSequentially)
+{
+  const std::vector<std::string> fileNames = WriteSlices("itkImageSeriesReaderConcurrency");
+
+  const auto sequentialReader = MakeReader(fileNames, 1);
+  sequentialReader->Update();
+  const auto concurrentReader = MakeReader(fileNames, 4);
+  concurrentReader->Update();
+
+  ExpectEqualPixels(sequentialReader->GetOutput(), concurrentReader->GetOutput());
+  EXPECT_EQ(concurrentReader->GetOutput()->GetPixel({ { 3, 2, 17 } }), 17000 + 2 * 19 + 3);
+
+  // The dictionaries are in the order of the files
+  const std::vector<std::string> sliceNumbers = GetSliceNumbers(concurrentReader);
+  ASSERT_EQ(sliceNumbers.size(), numberOfSlices);
+  for (unsigned int i = 0; i < numberOfSlices; ++i)
+  {
+    EXPECT_EQ(sliceNumbers[i], std::to_string(i));
+  }
+  EXPECT_EQ(GetSliceNumbers(sequentialReader), sliceNumbers);
+
+  // As when reading sequentially, the ImageIO describes the last file
+  EXPECT_EQ(concurrentReader->GetImageIO()->GetFileName(), fileNames.back());
+
+  const auto reverseReader = MakeReader(fileNames, 4);
+  reverseReader->ReverseOrderOn();
+  reverseReader->Update();
+  EXPECT_EQ(reverseReader->GetOutput()->GetPixel({ { 0, 0, 0 } }), static_cast<short>(1000 * (numberOfSlices - 1)));
+  EXPECT_EQ(GetSliceNumbers(reverseReader).front(), std::to_string(numberOfSlices - 1));
+}
+
+
+TEST(ImageSeriesReaderConcurrency, ReadsWithTheImageIOsOfTheFactory)
+{
+  itk::MetaImageIOFactory::RegisterOneFactory();
+  const std::vector<std::string> fileNames = WriteSlices("itkImageSeriesReaderConcurrencyFactory");
+
+  const auto sequentialReader = MakeReader(fileNames, 1);
+  sequentialReader->Update();
+  const auto concurrentReader = MakeReader(fileNames, 4);
+  concurrentReader->SetImageIO(nullptr);
+  concurrentReader->Update();
+
+  ExpectEqualPixels(sequentialReader->GetOutput(), concurrentReader->GetOutput());
+  EXPECT_EQ(GetSliceNumbers(concurrentReader), GetSliceNumbers(sequentialReader));
+}
+
+
+TEST(ImageSeriesReaderConcurrency, ReadsOneAfterAnotherWithoutConcurrentImageIO)
+{
+  const std::vector<std::string> fileNames = WriteSlices("itkImageSeriesReaderConcurrencySerial");
+
+  EXPECT_FALSE(itk::ImageIOBase::Pointer(SerialMetaImageIO::New())->CanReadConcurrently());
+  EXPECT_TRUE(itk::ImageIOBase::Pointer(itk::MetaImageIO::New())->CanReadConcurrently());
+
+  const auto sequentialReader = MakeReader(fileNames, 1);
+  sequentialReader->Update();
+  const auto reader = MakeReader(fileNames, 4);
+  const auto imageIO = SerialMetaImageIO::New();
+  reader->SetImageIO(imageIO);
+  SerialMetaImageIO::s_MaximumReadsInFlight = 0;
+  reader->Update();
+
+  EXPECT_EQ(SerialMetaImageIO::s_MaximumReadsInFlight, 1);
+  ExpectEqualPixels(sequentialReader->GetOutput(), reader->GetOutput());
+  EXPECT_EQ(GetSliceNumbers(reader), GetSliceNumbers(sequentialReader));
+  EXPECT_EQ(reader->GetImageIO(), imageIO.GetPointer());
+  EXPECT_EQ(imageIO->GetFileName(), fileNames.back());
+}
+
+
+TEST(ImageSeriesReaderConcurrency, ReadsRequestedSlices)
+{
+  const std::vector<std::string> fileNames = WriteSlices("itkImageSeriesReaderConcurrencyRegion");
+
+  const auto reader = MakeReader(fileNames, 3);
+  reader->UpdateOutputInformation();
+  const ImageType::RegionType requestedRegion({ 0, 0, 5 }, { 19, 7, 9 });
+  reader->GetOutput()->SetRequestedRegion(requestedRegion);
+  reader->Update();
+
+  EXPECT_EQ(reader->GetOutput()->GetBufferedRegion(), requestedRegion);
+  EXPECT_EQ(reader->GetOutput()->GetPixel({ { 1, 0, 5 } }), 5001);
+  EXPECT_EQ(reader->GetOutput()->GetPixel({ { 0, 1, 13 } }), 13019);
+  EXPECT_EQ(GetSliceNumbers(reader).size(), numberOfSlices);
+}
+
+
+TEST(ImageSeriesReaderConcurrency, DetectsNonUniformSampling)
+{
+  const std::vector<std::string> fileNames = WriteSlices("itkImageSeriesReaderConcurrencyNonUniform", 11);
+
+  const auto sequentialReader = MakeReader(fileNames, 1);
+  sequentialReader->Update();
+  const auto concurrentReader = MakeReader(fileNames, 4);
+  concurrentReader->Update();
+
+  double deviation = 0.0;
+  EXPECT_TRUE(itk::ExposeMetaData<double>(
+    concurrentReader->GetOutput()->GetMetaDataDictionary(), "ITK_non_uniform_sampling_deviation", deviation));
+  EXPECT_GT(deviation, 0.9);
+
+  // The deviations are recorded for the same slices as when reading sequentially
+  const auto & sequentialDictionaries = *sequentialReader->GetMetaDataDictionaryArray();
+  const auto & concurrentDictionaries = *concurrentReader->GetMetaDataDictionaryArray();
+  ASSERT_EQ(concurrentDictionaries.size(), numberOfSlices - 1);
+  ASSERT_EQ(sequentialDictionaries.size(), concurrentDictionaries.size());
+  for (size_t i = 0; i < concurrentDictionaries.size(); ++i)
+  {
+    double sequentialDeviation = -1.0;
+    double concurrentDeviation = -1.0;
+    itk::ExposeMetaData<double>(*sequentialDictionaries[i], "ITK_non_uniform_sampling_deviation", sequentialDeviation);
+    itk::ExposeMetaData<double>(*concurrentDictionaries[i], "ITK_non_uniform_sampling_deviation", concurrentDeviation);
+    EXPECT_EQ(sequentialDeviation, concurrentDeviation) << "slice " << i;
+  }
+  EXPECT_EQ(GetSliceNumbers(concurrentReader), GetSliceNumbers(sequentialReader));
+  ExpectEqualPixels(sequentialReader->GetOutput(), concurrentReader->GetOutput());
+}
+
+
+TEST(ImageSeriesReaderConcurrency, ReportsErrorOfFirstUnreadableFile)
+{
+  std::vector<std::string> fileNames = WriteSlices("itkImageSeriesReaderConcurrencyError");
+  const std::string        firstMissingFile = ::testing::TempDir() + "/itkImageSeriesReaderConcurrencyMissing6.mha";
+  fileNames[6] = firstMissingFile;
+  fileNames[20] = ::testing::TempDir() + "/itkImageSeriesReaderConcurrencyMissing20.mha";
+
+  const auto reader = MakeReader(fileNames, 4);
+  reader->UpdateOutputInformation();
+  try
+  {
+    reader->Update();
+    FAIL() << "No exception thrown";
+  }
+  catch (const itk::ExceptionObject & exception)
+  {
+    EXPECT_NE(std::string(exception.what()).find(firstMissingFile), std::string::npos) << exception.what();
+  }
+}
+
+
+TEST(ImageSeriesReaderConcurrency, CloneKeepsImageIOSettings)
+{
+  auto io = itk::MetaImageIO::New();
+  io->SetUseCompression(true);
+  io->SetCompressionLevel(7);
+  io->SetUseStreamedReading(true);
+  io->SetExpandRGBPalette(false);
+  io->SetSubSamplingFactor(2);
+  io->SetCompressedDataChunkSize(12345);
+  io->SetFileName("notCloned.mha");
+
+  const itk::ImageIOBase::Pointer clone = io->Clone();
+  EXPECT_NE(clone.GetPointer(), io.GetPointer());
+  EXPECT_TRUE(clone->GetUseCompression());
+  EXPECT_EQ(clone->GetCompressionLevel(), 7);
+  EXPECT_TRUE(clone->GetUseStreamedReading());
+  EXPECT_FALSE(clone->GetExpandRGBPalette());
+  EXPECT_EQ(clone->GetFileName(), std::string());
+
+  // The MetaImageIO specific settings
+  const auto * const metaClone = dynamic_cast<const itk::MetaImageIO *>(clone.GetPointer());
+  ASSERT_NE(metaClone, nullptr);
+  EXPECT_EQ(metaClone->GetSubSamplingFactor(), 2u);
+  EXPECT_EQ(metaClone->GetCompressedDataChunkSize(), 12345u);
+}
@@ -92,6 +92,14 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The IJG library keeps its state in each decompression object, so clones
+   * of this ImageIO can read files concurrently. */
+  bool
+  CanReadConcurrently() const override
+  {
+    return true;
+  }
+
   /** Reads 3D data from multiple files assuming one slice per file. */
   virtual void
   ReadVolume(void * buffer);
@@ -119,6 +127,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the progressive and CMYK to RGB settings. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   WriteSlice(const std::string & fileName, const void * const buffer);
 
@@ -317,6 +317,20 @@ JPEGImageIO::JPEGImageIO()
 
 JPEGImageIO::~JPEGImageIO() = default;
 
+LightObject::Pointer
+JPEGImageIO::InternalClone() const
+{
+  LightObject::Pointer lightObject = Superclass::InternalClone();
+
+  if (auto * const clone = dynamic_cast<Self *>(lightObject.GetPointer()))
+  {
+    clone->m_Progressive = m_Progressive;
+    clone->m_CMYKtoRGB = m_CMYKtoRGB;
+    return lightObject;
+  }
+  itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+}
+
 void
 JPEGImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
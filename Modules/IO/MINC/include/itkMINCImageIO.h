@@ -137,6 +137,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the RAS to LPS conversion setting. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   WriteSlice(std::string & fileName, const void * buffer);
 
@@ -271,6 +271,19 @@ MINCImageIO::MINCImageIO()
 
 MINCImageIO::~MINCImageIO() { this->CloseVolume(); }
 
+LightObject::Pointer
+MINCImageIO::InternalClone() const
+{
+  LightObject::Pointer lightObject = Superclass::InternalClone();
+
+  if (auto * const clone = dynamic_cast<Self *>(lightObject.GetPointer()))
+  {
+    clone->m_RAStoLPS = m_RAStoLPS;
+    return lightObject;
+  }
+  itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+}
+
 void
 MINCImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
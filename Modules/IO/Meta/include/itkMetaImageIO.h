@@ -21,6 +21,7 @@
 
 
 #include <fstream>
+#include <vector>
 #include "itkImageIOBase.h"
 #include "itkNumberToString.h"
 #include "itkSingletonMacro.h"
@@ -68,6 +69,13 @@ public:
     return true;
   }
 
+  /** MetaIO keeps its state in each MetaImage, so clones of this ImageIO can read files concurrently. */
+  bool
+  CanReadConcurrently() const override
+  {
+    return true;
+  }
+
   /*-------- This part of the interfaces deals with reading data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -83,6 +91,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixel data can be mapped if it is binary, uncompressed, in native
+   * byte order, not subsampled, and stored in a single file: either locally,
+   * after the header, or in a single data file. */
+  bool
+  CanMemoryMapPixelData(std::string & dataFileName, SizeType & dataOffset) override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -135,12 +149,13 @@ public:
                            const ImageIORegion & largestPossibleRegion) override;
 
   /** Determine if the ImageIO can stream reading from this
-   *  file. Only time cannot stream read/write is if compression is used.
+   *  file. Compressed data can only be streamed if it is compressed in
+   *  chunks, see SetCompressedDataChunkSize().
    *  CanRead must be called prior to this function. */
   bool
   CanStreamRead() override
   {
-    if (m_MetaImage.CompressedData())
+    if (m_MetaImage.CompressedData() && m_CompressedDataChunkOffsets.empty())
     {
       return false;
     }
@@ -162,6 +177,19 @@ public:
     return true;
   }
 
+  /** The number of bytes of pixel data which are compressed independently of
+   *  each other when writing compressed data. The chunks still form a single
+   *  zlib stream, which any MetaImage reader can decompress, while their
+   *  compressed sizes are listed in the header: the chunks are then compressed
+   *  and decompressed in parallel, and reading a region only decompresses the
+   *  chunks which overlap it. The chunk size is increased if needed to keep
+   *  the header small. Zero compresses the data as a single chunk, as older
+   *  versions did. The default is 4 MiB. */
+  /** @ITKStartGrouping */
+  itkSetMacro(CompressedDataChunkSize, SizeValueType);
+  itkGetConstMacro(CompressedDataChunkSize, SizeValueType);
+  /** @ITKEndGrouping */
+
   /** Determining the subsampling factor in case
    *  we want a coarse version of the image/
    * \warning this is only used when streaming is on. */
@@ -191,6 +219,11 @@ protected:
   ~MetaImageIO() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Also copies the sub-sampling factor, the double precision and the
+   * compressed data chunk size. */
+  LightObject::Pointer
+  InternalClone() const override;
   template <unsigned int VNRows, unsigned int VNColumns = VNRows>
   bool
   WriteMatrixInMetaData(std::ostringstream &       strs,
@@ -201,10 +234,55 @@ private:
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(unsigned int, DefaultDoublePrecision);
 
-  MetaImage m_MetaImage{};
+  /** Returns the single file which holds the data, and the offset of the
+   * data in that file, or false if the data is split over multiple files. */
+  bool
+  GetElementDataFile(std::string & dataFileName, SizeType & dataOffset, SizeType numberOfDataBytes);
+
+  /** Compresses the data in chunks, in parallel, and writes the file.
+   * Returns false if the data cannot be written in chunks. */
+  bool
+  WriteCompressedDataChunks(const void * buffer);
+
+  /** Decompresses the chunks which overlap m_IORegion, in parallel.
+   * Returns false if the data cannot be read from its chunks. */
+  bool
+  ReadCompressedDataChunks(void * buffer);
+
+  /** A MetaImage which can also write element data that MetaImageIO has
+   * compressed itself, and remove the fields it added to the header. */
+  class CompressedDataMetaImage : public MetaImage
+  {
+  public:
+    /** Writes the header, and the specified zlib stream as the element
+     * data, without compressing the element data of the image. */
+    bool
+    WriteCompressedElementData(const char * fileName, const void * compressedData, std::streamoff compressedDataSize);
+
+    /** Removes a field added by AddUserField(). */
+    void
+    RemoveUserField(const char * fieldName);
+
+  protected:
+    void
+    M_SetupWriteFields() override;
+
+  private:
+    // The size of the zlib stream being written, or 0.
+    std::streamoff m_CompressedElementDataSize{};
+  };
+
+  CompressedDataMetaImage m_MetaImage{};
 
   unsigned int m_SubSamplingFactor{};
 
+  SizeValueType m_CompressedDataChunkSize{ 4 * 1024 * 1024 };
+
+  // The chunk size and the offsets of the compressed chunks within the
+  // compressed data of the file being read, if it is compressed in chunks.
+  SizeValueType              m_ReadCompressedDataChunkSize{};
+  std::vector<SizeValueType> m_CompressedDataChunkOffsets{};
+
   static unsigned int * m_DefaultDoublePrecision;
 };
 
@@ -24,9 +24,17 @@
 #include "itkNumberToString.h"
 #include "itkSingleton.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
 #include "metaImageUtils.h"
+#include "itk_zlib.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <numeric>
 #include <set>
+#include <sstream>
 
 
 namespace itk
@@ -35,6 +43,25 @@ namespace itk
 // better accuracy when writing out floating point number in MetaImage header.
 itkGetGlobalValueMacro(MetaImageIO, unsigned int, DefaultDoublePrecision, 17);
 
+namespace
+{
+// The header fields which describe data compressed in chunks: the number of
+// uncompressed bytes per chunk, and the number of compressed bytes of each
+// chunk. The compressed data is a single zlib stream, made of a two byte
+// zlib header, the chunks, each deflated independently of the others and
+// ending at a byte boundary, and the four byte Adler-32 checksum of the data.
+const std::string compressedDataChunkSizeKey = "CompressedDataChunkSize";
+const std::string compressedDataChunksKey = "CompressedDataChunks";
+
+constexpr SizeValueType zlibHeaderSize = 2;
+constexpr SizeValueType zlibTrailerSize = 4;
+
+// Keeps the list of chunks in the header well below the maximum length of a
+// MetaIO field value, and each chunk within the range of a zlib buffer.
+constexpr SizeValueType maximumNumberOfCompressedDataChunks = 2048;
+constexpr SizeValueType maximumCompressedDataChunkSize = SizeValueType{ 1 } << 30;
+} // namespace
+
 unsigned int * MetaImageIO::m_DefaultDoublePrecision;
 
 MetaImageIO::MetaImageIO()
@@ -66,12 +93,28 @@ MetaImageIO::MetaImageIO()
 
 MetaImageIO::~MetaImageIO() = default;
 
+LightObject::Pointer
+MetaImageIO::InternalClone() const
+{
+  LightObject::Pointer lightObject = Superclass::InternalClone();
+
+  if (auto * const clone = dynamic_cast<Self *>(lightObject.GetPointer()))
+  {
+    clone->SetDoublePrecision(m_MetaImage.GetDoublePrecision());
+    clone->m_SubSamplingFactor = m_SubSamplingFactor;
+    clone->m_CompressedDataChunkSize = m_CompressedDataChunkSize;
+    return lightObject;
+  }
+  itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+}
+
 void
 MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   m_MetaImage.PrintInfo();
   os << indent << "SubSamplingFactor: " << m_SubSamplingFactor << '\n';
+  os << indent << "CompressedDataChunkSize: " << m_CompressedDataChunkSize << '\n';
 }
 
 void
@@ -278,12 +321,59 @@ MetaImageIO::ReadImageInformation()
   //
   // save the metadatadictionary in the MetaImage header.
   // NOTE: The MetaIO library only supports typeless strings as metadata
-  const int dictFields = m_MetaImage.GetNumberOfAdditionalReadFields();
+  // The description of the compressed data chunks only applies to this file.
+  std::string compressedDataChunkSize;
+  std::string compressedDataChunks;
+  const int   dictFields = m_MetaImage.GetNumberOfAdditionalReadFields();
   for (int f = 0; f < dictFields; ++f)
   {
     const std::string key(m_MetaImage.GetAdditionalReadFieldName(f));
     const std::string value(m_MetaImage.GetAdditionalReadFieldValue(f));
-    EncapsulateMetaData<std::string>(thisMetaDict, key, value);
+    if (key == compressedDataChunkSizeKey)
+    {
+      compressedDataChunkSize = value;
+    }
+    else if (key == compressedDataChunksKey)
+    {
+      compressedDataChunks = value;
+    }
+    else
+    {
+      EncapsulateMetaData<std::string>(thisMetaDict, key, value);
+    }
+  }
+
+  m_ReadCompressedDataChunkSize = 0;
+  m_CompressedDataChunkOffsets.clear();
+  if (m_MetaImage.BinaryData() && m_MetaImage.CompressedData() && !compressedDataChunkSize.empty())
+  {
+    std::istringstream chunkSizeStream(compressedDataChunkSize);
+    std::istringstream chunksStream(compressedDataChunks);
+    SizeValueType      chunkSize = 0;
+    chunkSizeStream >> chunkSize;
+    m_CompressedDataChunkOffsets.push_back(zlibHeaderSize);
+    for (SizeValueType compressedChunkSize = 0; chunksStream >> compressedChunkSize;)
+    {
+      m_CompressedDataChunkOffsets.push_back(m_CompressedDataChunkOffsets.back() + compressedChunkSize);
+    }
+
+    // Without a consistent description, the data is read as a single stream.
+    int elementSize = 0;
+    MET_SizeOfType(m_MetaImage.ElementType(), &elementSize);
+    auto numberOfDataBytes = static_cast<SizeValueType>(m_MetaImage.ElementNumberOfChannels()) * elementSize;
+    for (int i = 0; i < m_MetaImage.NDims(); ++i)
+    {
+      numberOfDataBytes *= m_MetaImage.DimSize(i);
+    }
+    if (chunkSize > 0 && chunkSize <= maximumCompressedDataChunkSize && chunksStream.eof() &&
+        m_CompressedDataChunkOffsets.size() - 1 == (numberOfDataBytes + chunkSize - 1) / chunkSize)
+    {
+      m_ReadCompressedDataChunkSize = chunkSize;
+    }
+    else
+    {
+      m_CompressedDataChunkOffsets.clear();
+    }
   }
 
   //
@@ -320,7 +410,11 @@ MetaImageIO::Read(void * buffer)
     largestRegion.SetSize(i, this->GetDimensions(i));
   }
 
-  if (largestRegion != m_IORegion)
+  if (!m_CompressedDataChunkOffsets.empty() && m_SubSamplingFactor == 1 && this->ReadCompressedDataChunks(buffer))
+  {
+    // Only the chunks which overlap the region have been decompressed
+  }
+  else if (largestRegion != m_IORegion)
   {
     const auto indexMin = make_unique_for_overwrite<int[]>(nDims);
     const auto indexMax = make_unique_for_overwrite<int[]>(nDims);
@@ -360,6 +454,461 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+namespace
+{
+// Returns the offset of the data which follows the header of a file with
+// "ElementDataFile = LOCAL". The header ends with the ElementDataFile line.
+ImageIOBase::SizeType
+GetLocalElementDataOffset(const std::string & fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  std::string   line;
+  while (std::getline(file, line))
+  {
+    const std::string::size_type keyBegin = line.find_first_not_of(" \t");
+    if (keyBegin != std::string::npos && line.compare(keyBegin, 15, "ElementDataFile") == 0)
+    {
+      return static_cast<ImageIOBase::SizeType>(file.tellg());
+    }
+  }
+  return -1;
+}
+} // namespace
+
+bool
+MetaImageIO::CanMemoryMapPixelData(std::string & dataFileName, SizeType & dataOffset)
+{
+  int elementSize = 0;
+  MET_SizeOfType(m_MetaImage.ElementType(), &elementSize);
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() || m_SubSamplingFactor != 1 ||
+      static_cast<unsigned int>(elementSize) != this->GetComponentSize() ||
+      (elementSize > 1 && m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB()))
+  {
+    return false;
+  }
+
+  return this->GetElementDataFile(dataFileName, dataOffset, this->GetImageSizeInBytes());
+}
+
+bool
+MetaImageIO::GetElementDataFile(std::string & dataFileName, SizeType & dataOffset, SizeType numberOfDataBytes)
+{
+  const std::string elementDataFileName = m_MetaImage.ElementDataFileName();
+  if (elementDataFileName == "LOCAL" || elementDataFileName == "Local" || elementDataFileName == "local")
+  {
+    dataFileName = m_FileName;
+  }
+  else if (elementDataFileName.empty() || elementDataFileName.compare(0, 4, "LIST") == 0 ||
+           elementDataFileName.find('%') != std::string::npos)
+  {
+    // The data is split over multiple files
+    return false;
+  }
+  else if (itksys::SystemTools::FileIsFullPath(elementDataFileName))
+  {
+    dataFileName = elementDataFileName;
+  }
+  else
+  {
+    // A relative data file name is relative to the header file
+    const std::string path = itksys::SystemTools::GetFilenamePath(m_FileName);
+    dataFileName = path.empty() ? elementDataFileName : path + '/' + elementDataFileName;
+  }
+
+  if (m_MetaImage.HeaderSize() > 0)
+  {
+    dataOffset = m_MetaImage.HeaderSize();
+  }
+  else if (m_MetaImage.HeaderSize() == -1)
+  {
+    // The data is at the end of the file
+    dataOffset = static_cast<SizeType>(itksys::SystemTools::FileLength(dataFileName)) - numberOfDataBytes;
+  }
+  else
+  {
+    dataOffset = (dataFileName == m_FileName) ? GetLocalElementDataOffset(m_FileName) : 0;
+  }
+  return dataOffset >= 0;
+}
+
+bool
+MetaImageIO::WriteCompressedDataChunks(const void * buffer)
+{
+  const SizeValueType numberOfDataBytes = this->GetImageSizeInBytes();
+  if (m_CompressedDataChunkSize == 0 || numberOfDataBytes == 0 || !m_MetaImage.BinaryData() ||
+      std::string(m_MetaImage.ElementDataFileName()).find('%') != std::string::npos)
+  {
+    return false;
+  }
+  const SizeValueType chunkSize =
+    std::max(m_CompressedDataChunkSize,
+             (numberOfDataBytes + maximumNumberOfCompressedDataChunks - 1) / maximumNumberOfCompressedDataChunks);
+  if (chunkSize > maximumCompressedDataChunkSize)
+  {
+    return false;
+  }
+  const SizeValueType numberOfChunks = (numberOfDataBytes + chunkSize - 1) / chunkSize;
+  const auto          getChunkLength = [numberOfDataBytes, chunkSize](SizeValueType chunk) {
+    return static_cast<uInt>(std::min(chunkSize, numberOfDataBytes - chunk * chunkSize));
+  };
+
+  std::vector<std::vector<Bytef>> compressedChunks(numberOfChunks);
+  std::vector<uLong>              checksums(numberOfChunks);
+  std::atomic<bool>               failed{ false };
+  const int                       compressionLevel = this->GetCompressionLevel();
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      const Bytef * const chunkData = static_cast<const Bytef *>(buffer) + chunk * chunkSize;
+      const uInt          chunkLength = getChunkLength(chunk);
+      checksums[chunk] = adler32(adler32(0, nullptr, 0), chunkData, chunkLength);
+
+      z_stream stream{};
+      if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        failed = true;
+        return;
+      }
+      std::vector<Bytef> & compressedChunk = compressedChunks[chunk];
+      // The margin covers the empty stored block which ends a sync flush.
+      compressedChunk.resize(deflateBound(&stream, chunkLength) + 16);
+      stream.next_in = const_cast<Bytef *>(chunkData);
+      stream.avail_in = chunkLength;
+      stream.next_out = compressedChunk.data();
+      stream.avail_out = static_cast<uInt>(compressedChunk.size());
+      // A sync flush ends the chunk at a byte boundary, without ending the stream.
+      const bool isLastChunk = chunk + 1 == numberOfChunks;
+      const int  result = deflate(&stream, isLastChunk ? Z_FINISH : Z_SYNC_FLUSH);
+      if (result != (isLastChunk ? Z_STREAM_END : Z_OK) || stream.avail_in != 0 || stream.avail_out == 0)
+      {
+        failed = true;
+      }
+      compressedChunk.resize(compressedChunk.size() - stream.avail_out);
+      deflateEnd(&stream);
+    },
+    nullptr);
+  if (failed)
+  {
+    return false;
+  }
+
+  // The zlib header, as written by deflate() for the same compression level.
+  const unsigned int levelFlags =
+    (compressionLevel < 2) ? 0 : (compressionLevel < 6) ? 1 : (compressionLevel == 6) ? 2 : 3;
+  unsigned int header = (0x78u << 8) | (levelFlags << 6);
+  header += 31 - header % 31;
+
+  SizeValueType compressedDataSize = zlibHeaderSize + zlibTrailerSize;
+  for (const auto & compressedChunk : compressedChunks)
+  {
+    compressedDataSize += compressedChunk.size();
+  }
+  std::vector<Bytef> compressedData;
+  compressedData.reserve(compressedDataSize);
+  compressedData.push_back(static_cast<Bytef>(header >> 8));
+  compressedData.push_back(static_cast<Bytef>(header & 0xFF));
+
+  std::ostringstream chunksField;
+  uLong              checksum = adler32(0, nullptr, 0);
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    compressedData.insert(compressedData.end(), compressedChunks[chunk].cbegin(), compressedChunks[chunk].cend());
+    chunksField << (chunk > 0 ? " " : "") << compressedChunks[chunk].size();
+    std::vector<Bytef>().swap(compressedChunks[chunk]);
+    checksum = adler32_combine(checksum, checksums[chunk], static_cast<z_off_t>(getChunkLength(chunk)));
+  }
+  for (int shift = 24; shift >= 0; shift -= 8)
+  {
+    compressedData.push_back(static_cast<Bytef>((checksum >> shift) & 0xFF));
+  }
+
+  const std::string chunkSizeField = std::to_string(chunkSize);
+  const std::string chunksFieldValue = chunksField.str();
+  m_MetaImage.AddUserField(compressedDataChunkSizeKey.c_str(),
+                           MET_STRING,
+                           static_cast<int>(chunkSizeField.size()),
+                           chunkSizeField.c_str(),
+                           true,
+                           -1);
+  m_MetaImage.AddUserField(compressedDataChunksKey.c_str(),
+                           MET_STRING,
+                           static_cast<int>(chunksFieldValue.size()),
+                           chunksFieldValue.c_str(),
+                           true,
+                           -1);
+
+  if (!m_MetaImage.WriteCompressedElementData(
+        m_FileName.c_str(), compressedData.data(), static_cast<std::streamoff>(compressedData.size())))
+  {
+    itkExceptionMacro("File cannot be written: " << this->GetFileName() << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  return true;
+}
+
+bool
+MetaImageIO::CompressedDataMetaImage::WriteCompressedElementData(const char *   fileName,
+                                                                 const void *   compressedData,
+                                                                 std::streamoff compressedDataSize)
+{
+  // MetaImage::Write() compresses the element data of compressed images, so
+  // it writes the header as for uncompressed data, and M_SetupWriteFields()
+  // describes the compressed data. The data file is named as Write() names
+  // the files of compressed data.
+  FileName(fileName);
+  const bool defaultDataFileName = std::string(ElementDataFileName()).empty();
+  if (defaultDataFileName)
+  {
+    int suffixPosition = 0;
+    MET_GetFileSuffixPtr(m_FileName, &suffixPosition);
+    if (m_FileName.compare(suffixPosition, std::string::npos, "mha") == 0)
+    {
+      ElementDataFileName("LOCAL");
+    }
+    else
+    {
+      MET_SetFileSuffix(m_FileName, "mhd");
+      std::string dataFileName = m_FileName;
+      MET_SetFileSuffix(dataFileName, "zraw");
+      ElementDataFileName(dataFileName.c_str());
+    }
+  }
+
+  m_CompressedData = false;
+  m_CompressedElementDataSize = compressedDataSize;
+  bool written = Write(nullptr, nullptr, false);
+  m_CompressedData = true;
+  m_CompressedElementDataSize = 0;
+
+  if (written)
+  {
+    // The local data follows the header, other data is written to its own file
+    METAIO_STREAM::ofstream headerStream(m_FileName.c_str(), std::ios::binary | std::ios::out | std::ios::app);
+    written = headerStream.is_open() && M_WriteElements(&headerStream, compressedData, compressedDataSize);
+  }
+  if (defaultDataFileName)
+  {
+    ElementDataFileName("");
+  }
+  return written;
+}
+
+void
+MetaImageIO::CompressedDataMetaImage::RemoveUserField(const char * fieldName)
+{
+  std::set<MET_FieldRecordType *> removedFields;
+  for (FieldsContainerType * const fields : { &m_UserDefinedWriteFields, &m_UserDefinedReadFields })
+  {
+    const auto removed =
+      std::stable_partition(fields->begin(), fields->end(), [fieldName](const MET_FieldRecordType * field) {
+        return std::strcmp(field->name, fieldName) != 0;
+      });
+    removedFields.insert(removed, fields->end());
+    fields->erase(removed, fields->end());
+  }
+  const auto isRemoved = [&removedFields](MET_FieldRecordType * field) { return removedFields.count(field) > 0; };
+  m_Fields.erase(std::remove_if(m_Fields.begin(), m_Fields.end(), isRemoved), m_Fields.end());
+  for (MET_FieldRecordType * const field : removedFields)
+  {
+    delete field;
+  }
+}
+
+void
+MetaImageIO::CompressedDataMetaImage::M_SetupWriteFields()
+{
+  if (m_CompressedElementDataSize > 0)
+  {
+    m_CompressedData = true;
+    m_CompressedDataSize = m_CompressedElementDataSize;
+    MetaImage::M_SetupWriteFields();
+    m_CompressedData = false;
+    m_CompressedDataSize = 0;
+  }
+  else
+  {
+    MetaImage::M_SetupWriteFields();
+  }
+}
+
+bool
+MetaImageIO::ReadCompressedDataChunks(void * buffer)
+{
+  const SizeValueType                chunkSize = m_ReadCompressedDataChunkSize;
+  const std::vector<SizeValueType> & chunkOffsets = m_CompressedDataChunkOffsets;
+  const SizeValueType                numberOfChunks = chunkOffsets.size() - 1;
+  const SizeValueType                compressedDataSize = chunkOffsets.back() + zlibTrailerSize;
+
+  std::string dataFileName;
+  SizeType    dataOffset = 0;
+  if (!this->GetElementDataFile(dataFileName, dataOffset, compressedDataSize) ||
+      static_cast<SizeValueType>(itksys::SystemTools::FileLength(dataFileName)) <
+        static_cast<SizeValueType>(dataOffset) + compressedDataSize)
+  {
+    return false;
+  }
+
+  const unsigned int nDims = this->GetNumberOfDimensions();
+  ImageIORegion      largestRegion(nDims);
+  for (unsigned int i = 0; i < nDims; ++i)
+  {
+    largestRegion.SetIndex(i, 0);
+    largestRegion.SetSize(i, this->GetDimensions(i));
+  }
+  const bool          readAll = largestRegion == m_IORegion;
+  const ImageIORegion region = readAll ? largestRegion : m_IORegion;
+
+  const SizeValueType pixelSize = this->GetPixelSize();
+  const SizeValueType numberOfDataBytes = this->GetImageSizeInBytes();
+  const SizeValueType rowSize = region.GetSize(0) * pixelSize;
+
+  // Calls rowFunction with the offset, in the data, of each row of the region.
+  const auto forEachRow = [&region, nDims, pixelSize, this](const auto & rowFunction) {
+    std::vector<SizeValueType> index(nDims, 0);
+    const SizeValueType numberOfRows = region.GetNumberOfPixels() / std::max<SizeValueType>(region.GetSize(0), 1);
+    for (SizeValueType row = 0; row < numberOfRows; ++row)
+    {
+      SizeValueType offset = 0;
+      for (unsigned int i = nDims; i > 0; --i)
+      {
+        offset =
+          offset * this->GetDimensions(i - 1) + static_cast<SizeValueType>(region.GetIndex(i - 1)) + index[i - 1];
+      }
+      rowFunction(offset * pixelSize);
+      for (unsigned int i = 1; i < nDims && ++index[i] == region.GetSize(i); ++i)
+      {
+        index[i] = 0;
+      }
+    }
+  };
+
+  // The chunks which overlap the region, in increasing order.
+  std::vector<SizeValueType> chunks;
+  if (readAll)
+  {
+    chunks.resize(numberOfChunks);
+    std::iota(chunks.begin(), chunks.end(), SizeValueType{ 0 });
+  }
+  else
+  {
+    forEachRow([&chunks, chunkSize, rowSize](SizeValueType rowOffset) {
+      for (SizeValueType chunk = rowOffset / chunkSize; chunk <= (rowOffset + rowSize - 1) / chunkSize; ++chunk)
+      {
+        if (chunks.empty() || chunks.back() < chunk)
+        {
+          chunks.push_back(chunk);
+        }
+      }
+    });
+  }
+
+  std::ifstream file(dataFileName, std::ios::binary);
+  std::vector<SizeValueType> compressedChunkOffsets(chunks.size() + 1, 0);
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    compressedChunkOffsets[i + 1] =
+      compressedChunkOffsets[i] + chunkOffsets[chunks[i] + 1] - chunkOffsets[chunks[i]];
+  }
+  const auto compressedChunks = make_unique_for_overwrite<char[]>(compressedChunkOffsets.back() + zlibTrailerSize);
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    file.seekg(static_cast<std::streamoff>(static_cast<SizeValueType>(dataOffset) + chunkOffsets[chunks[i]]));
+    file.read(compressedChunks.get() + compressedChunkOffsets[i],
+              static_cast<std::streamsize>(compressedChunkOffsets[i + 1] - compressedChunkOffsets[i]));
+  }
+  if (readAll)
+  {
+    file.read(compressedChunks.get() + compressedChunkOffsets.back(), zlibTrailerSize);
+  }
+  if (!file)
+  {
+    itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  // When reading a region, the chunks are decompressed into a separate buffer.
+  const auto chunkBuffer = make_unique_for_overwrite<char[]>(readAll ? 0 : chunks.size() * chunkSize);
+  const auto getChunkData = [&](size_t i) {
+    return readAll ? static_cast<char *>(buffer) + chunks[i] * chunkSize : chunkBuffer.get() + i * chunkSize;
+  };
+
+  std::vector<uLong> checksums(chunks.size());
+  std::atomic<bool>  failed{ false };
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    chunks.size(),
+    [&](SizeValueType i) {
+      const auto chunkLength = static_cast<uInt>(std::min(chunkSize, numberOfDataBytes - chunks[i] * chunkSize));
+      auto *     chunkData = reinterpret_cast<Bytef *>(getChunkData(i));
+
+      z_stream stream{};
+      if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+      {
+        failed = true;
+        return;
+      }
+      stream.next_in = reinterpret_cast<Bytef *>(compressedChunks.get() + compressedChunkOffsets[i]);
+      stream.avail_in = static_cast<uInt>(compressedChunkOffsets[i + 1] - compressedChunkOffsets[i]);
+      stream.next_out = chunkData;
+      stream.avail_out = chunkLength;
+      const int result = inflate(&stream, Z_SYNC_FLUSH);
+      if ((result != Z_OK && result != Z_STREAM_END) || stream.avail_out != 0)
+      {
+        failed = true;
+      }
+      inflateEnd(&stream);
+      if (readAll)
+      {
+        checksums[i] = adler32(adler32(0, nullptr, 0), chunkData, chunkLength);
+      }
+    },
+    nullptr);
+
+  if (readAll && !failed)
+  {
+    uLong checksum = adler32(0, nullptr, 0);
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+      checksum = adler32_combine(
+        checksum, checksums[i], static_cast<z_off_t>(std::min(chunkSize, numberOfDataBytes - chunks[i] * chunkSize)));
+    }
+    const auto * const trailer =
+      reinterpret_cast<const unsigned char *>(compressedChunks.get() + compressedChunkOffsets.back());
+    const uLong expectedChecksum =
+      (uLong{ trailer[0] } << 24) | (uLong{ trailer[1] } << 16) | (uLong{ trailer[2] } << 8) | uLong{ trailer[3] };
+    failed = checksum != expectedChecksum;
+  }
+  if (failed)
+  {
+    itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
+                                              << "Reason: the compressed data is corrupt");
+  }
+
+  if (!readAll)
+  {
+    char * output = static_cast<char *>(buffer);
+    forEachRow([&](SizeValueType rowOffset) {
+      for (SizeValueType remaining = rowSize; remaining > 0;)
+      {
+        const SizeValueType chunk = rowOffset / chunkSize;
+        const auto          i =
+          static_cast<size_t>(std::lower_bound(chunks.cbegin(), chunks.cend(), chunk) - chunks.cbegin());
+        const SizeValueType offsetInChunk = rowOffset - chunk * chunkSize;
+        const SizeValueType count = std::min(remaining, chunkSize - offsetInChunk);
+        std::copy_n(getChunkData(i) + offsetInChunk, count, output);
+        output += count;
+        rowOffset += count;
+        remaining -= count;
+      }
+    });
+  }
+
+  m_MetaImage.ElementData(buffer, false);
+  m_MetaImage.ElementByteOrderFix(region.GetNumberOfPixels());
+  return true;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
@@ -418,7 +967,8 @@ MetaImageIO::WriteImageInformation()
   const std::vector<std::string> keys = metaDict.GetKeys();
   for (auto & key : keys)
   {
-    if (key == ITK_ExperimentDate || key == ITK_VoxelUnits)
+    if (key == ITK_ExperimentDate || key == ITK_VoxelUnits || key == compressedDataChunkSizeKey ||
+        key == compressedDataChunksKey)
     {
       continue;
     }
@@ -539,6 +1089,11 @@ MetaImageIO::WriteImageInformation()
 void
 MetaImageIO::Write(const void * buffer)
 {
+  // The description of the chunks of a previous Write() must not be written
+  // again, with other data.
+  m_MetaImage.RemoveUserField(compressedDataChunkSizeKey.c_str());
+  m_MetaImage.RemoveUserField(compressedDataChunksKey.c_str());
+
   const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
 
   bool binaryData = true;
@@ -749,6 +1304,10 @@ MetaImageIO::Write(const void * buffer)
                                                        << "Reason: " << itksys::SystemTools::GetLastSystemError());
     }
   }
+  else if (m_UseCompression && this->WriteCompressedDataChunks(buffer))
+  {
+    // The data has been compressed in chunks, in parallel
+  }
   else
   {
     if (!m_MetaImage.Write(m_FileName.c_str()))
@@ -0,0 +1,176 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+
+// Writes and reads images whose data is compressed in chunks
+
+namespace
+{
+using PixelType = short;
+using ImageType = itk::Image<PixelType, 3>;
+
+ImageType::Pointer
+MakeImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(ImageType::SizeType{ { 67, 53, 41 } }));
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<PixelType>((index[0] * 7 + index[1] * 3) % 101 - 50 + index[2]));
+  }
+  return image;
+}
+
+void
+WriteCompressedImage(const ImageType *  image,
+                     const std::string & fileName,
+                     itk::SizeValueType  chunkSize,
+                     itk::MetaImageIO *  io = nullptr)
+{
+  const itk::MetaImageIO::Pointer metaImageIO = (io != nullptr) ? io : itk::MetaImageIO::New().GetPointer();
+  metaImageIO->SetCompressedDataChunkSize(chunkSize);
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(metaImageIO);
+  writer->UseCompressionOn();
+  writer->Update();
+}
+
+ImageType::Pointer
+ReadMetaImage(const std::string & fileName, const ImageType::RegionType * requestedRegion = nullptr)
+{
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::MetaImageIO::New());
+  reader->UpdateOutputInformation();
+  if (requestedRegion != nullptr)
+  {
+    reader->GetOutput()->SetRequestedRegion(*requestedRegion);
+  }
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool
+HasEqualPixels(const ImageType * expected, const ImageType * actual, const ImageType::RegionType & region)
+{
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(actual, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expected->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get() << " instead of "
+                << expected->GetPixel(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string
+ReadFile(const std::string & fileName)
+{
+  std::ifstream      file(fileName, std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+} // namespace
+
+int
+itkMetaImageIOCompressedDataChunksTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " testDataDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+  const auto        image = MakeImage();
+
+  auto metaImageIO = itk::MetaImageIO::New();
+  ITK_TEST_EXPECT_EQUAL(metaImageIO->GetCompressedDataChunkSize(), 4 * 1024 * 1024);
+
+  for (const std::string & fileName :
+       { directory + "/CompressedDataChunks.mha", directory + "/CompressedDataChunks.mhd" })
+  {
+    std::cout << "Write and read " << fileName << std::endl;
+    WriteCompressedImage(image, fileName, 16 * 1024);
+    const std::string header = ReadFile(fileName);
+    ITK_TEST_EXPECT_TRUE(header.find("CompressedDataChunkSize = 16384") != std::string::npos);
+    ITK_TEST_EXPECT_TRUE(header.find("CompressedDataChunks = ") != std::string::npos);
+
+    const auto output = ReadMetaImage(fileName);
+    ITK_TEST_EXPECT_TRUE(HasEqualPixels(image, output, image->GetLargestPossibleRegion()));
+    ITK_TEST_EXPECT_TRUE(!output->GetMetaDataDictionary().HasKey("CompressedDataChunks"));
+
+    // A region is read from the chunks which overlap it
+    const ImageType::RegionType region({ 3, 50, 7 }, { 60, 3, 20 });
+    const auto                  regionOutput = ReadMetaImage(fileName, &region);
+    ITK_TEST_EXPECT_EQUAL(regionOutput->GetBufferedRegion(), region);
+    ITK_TEST_EXPECT_TRUE(HasEqualPixels(image, regionOutput, region));
+
+    // The data is a regular zlib stream, which MetaIO reads as usual
+    MetaImage metaImage;
+    ITK_TEST_EXPECT_TRUE(metaImage.Read(fileName.c_str()));
+    metaImage.ElementByteOrderFix();
+    ITK_TEST_EXPECT_TRUE(std::equal(image->GetBufferPointer(),
+                                    image->GetBufferPointer() + image->GetLargestPossibleRegion().GetNumberOfPixels(),
+                                    static_cast<const PixelType *>(metaImage.ElementData())));
+  }
+
+  std::cout << "Write and read without chunks" << std::endl;
+  const std::string singleStreamFileName = directory + "/CompressedDataSingleStream.mha";
+  WriteCompressedImage(ReadMetaImage(directory + "/CompressedDataChunks.mha"), singleStreamFileName, 0);
+  ITK_TEST_EXPECT_TRUE(ReadFile(singleStreamFileName).find("CompressedDataChunk") == std::string::npos);
+  ITK_TEST_EXPECT_TRUE(HasEqualPixels(image, ReadMetaImage(singleStreamFileName), image->GetLargestPossibleRegion()));
+
+  std::cout << "Write with and then without chunks, by the same ImageIO" << std::endl;
+  const auto reusedMetaImageIO = itk::MetaImageIO::New();
+  WriteCompressedImage(image, directory + "/CompressedDataChunksReusedIO.mha", 16 * 1024, reusedMetaImageIO);
+  WriteCompressedImage(image, singleStreamFileName, 0, reusedMetaImageIO);
+  ITK_TEST_EXPECT_TRUE(ReadFile(singleStreamFileName).find("CompressedDataChunk") == std::string::npos);
+  ITK_TEST_EXPECT_TRUE(HasEqualPixels(image, ReadMetaImage(singleStreamFileName), image->GetLargestPossibleRegion()));
+
+  std::cout << "Read corrupt data" << std::endl;
+  const std::string corruptFileName = directory + "/CompressedDataChunksCorrupt.mha";
+  {
+    std::string contents = ReadFile(directory + "/CompressedDataChunks.mha");
+    contents.back() = static_cast<char>(contents.back() ^ 0x5A);
+    std::ofstream(corruptFileName, std::ios::binary) << contents;
+  }
+  ITK_TRY_EXPECT_EXCEPTION(ReadMetaImage(corruptFileName));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
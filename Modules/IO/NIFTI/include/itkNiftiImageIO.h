@@ -159,6 +159,19 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The NIfTI library keeps its state in each nifti_image, so clones of this ImageIO can read files concurrently. */
+  bool
+  CanReadConcurrently() const override
+  {
+    return true;
+  }
+
+  /** The pixel data can be mapped if it is uncompressed, in native byte
+   * order, needs no rescaling or conversion, and if each pixel is stored
+   * as a single NIfTI element (i.e. scalar, complex, RGB or RGBA). */
+  bool
+  CanMemoryMapPixelData(std::string & dataFileName, SizeType & dataOffset) override;
+
   //-------- This part of the interfaces deals with writing data. -----
 
   /** Determine if the file can be written with this ImageIO implementation.
@@ -182,6 +195,31 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Single file compressed NIfTI (.nii.gz) files of scalar, complex, RGB
+   * or RGBA pixels can be written in pieces, in file order: each piece is
+   * compressed and appended to the file, so the whole image is never held
+   * in memory. Requires a non-zero CompressedDataChunkSize. */
+  bool
+  CanStreamWrite() override;
+
+  /** Compressed files are written one piece after the other, so pasting
+   * a region into an existing compressed file is not supported. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  /** Set/Get the number of uncompressed bytes of the chunks deflated in
+   * parallel when writing single file compressed NIfTI (.nii.gz) files of
+   * scalar, complex, RGB or RGBA pixels. Each chunk ends at a byte
+   * boundary, so the chunks form a single gzip stream, readable by any
+   * gzip reader. Zero compresses the file with the nifti library, on a
+   * single thread, as older versions did. The default is 4 MiB. */
+  /** @ITKStartGrouping */
+  itkSetMacro(CompressedDataChunkSize, SizeValueType);
+  itkGetConstMacro(CompressedDataChunkSize, SizeValueType);
+  /** @ITKEndGrouping */
+
   /** Calculate the region of the image that can be efficiently read
    *  in response to a given requested region. */
   ImageIORegion
@@ -256,6 +294,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the NIfTI specific settings. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual bool
   GetUseLegacyModeForTwoFileWriting() const
   {
@@ -268,6 +310,11 @@ private:
 
   std::unique_ptr<NiftiImageProxy> m_Holder;
 
+  // The compressed file which is written in pieces.
+  class GzipStreamWriter;
+
+  std::unique_ptr<GzipStreamWriter> m_GzipStreamWriter;
+
   // Try to use the Q and S form codes from MetaDataDictionary if they are specified
   // there, otherwise default to the backwards compatible values from earlier
   // versions of ITK. The qform guess would probably been better to have
@@ -292,6 +339,15 @@ private:
   void
   SetImageIOMetadataFromNIfTI();
 
+  // Whether Write() deflates the data in parallel chunks, with GzipStreamWriter.
+  bool
+  CanWriteCompressedDataChunks();
+
+  // Compresses the data of the IO region and appends it to the file, after the
+  // header for the first region.
+  void
+  WriteCompressedDataChunks(const void * buffer);
+
   double m_RescaleSlope{ 1.0 };
   double m_RescaleIntercept{ 0.0 };
 
@@ -307,6 +363,8 @@ private:
 
   bool m_SFORM_Permissive{ false };
   bool m_SFORM_Corrected{ false };
+
+  SizeValueType m_CompressedDataChunkSize{ SizeValueType{ 4 } << 20 };
 };
 
 
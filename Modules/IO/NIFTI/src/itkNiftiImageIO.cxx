@@ -25,9 +25,15 @@
 #include <nifti1_io.h>
 #include "itkNiftiImageIOConfigurePrivate.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
 #include "itkStringConvert.h"
 #include "itksys/SystemTools.hxx"
 #include "itksys/SystemInformation.hxx"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 
 namespace itk
 {
@@ -170,6 +176,145 @@ public:
 };
 
 
+// Writes a gzip file whose data is given in pieces, one after the other. The
+// data is split into chunks which are deflated in parallel, independently of
+// each other. Each chunk ends at a byte boundary with a sync flush, and the
+// last one ends the deflate stream, so the chunks form a single gzip member,
+// as pigz writes them. The CRC-32 of the chunks are combined for the trailer.
+class NiftiImageIO::GzipStreamWriter
+{
+public:
+  GzipStreamWriter(const std::string & fileName, SizeValueType numberOfBytes, SizeValueType chunkSize)
+    : m_File(fileName, std::ios::out | std::ios::binary | std::ios::trunc)
+    , m_NumberOfBytes(numberOfBytes)
+    , m_ChunkSize(std::clamp<SizeValueType>(chunkSize, 1, maximumChunkSize))
+  {
+    // The gzip header: magic number, deflate method, no flags, no time, unknown OS
+    static constexpr unsigned char header[10] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+    m_File.write(reinterpret_cast<const char *>(header), sizeof(header));
+  }
+
+  // Compresses the data, and appends it to the file. Returns false on failure.
+  bool
+  Write(const void * data, SizeValueType numberOfBytes)
+  {
+    if (!m_File || numberOfBytes > m_NumberOfBytes - m_NumberOfWrittenBytes)
+    {
+      return false;
+    }
+    const SizeValueType numberOfChunks = (numberOfBytes + m_ChunkSize - 1) / m_ChunkSize;
+    const bool          endsStream = m_NumberOfWrittenBytes + numberOfBytes == m_NumberOfBytes;
+    const auto          getChunkLength = [this, numberOfBytes](SizeValueType chunk) {
+      return static_cast<uInt>(std::min(m_ChunkSize, numberOfBytes - chunk * m_ChunkSize));
+    };
+
+    // The chunks are compressed in batches, which bounds the memory used for
+    // the compressed chunks.
+    const MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+    const SizeValueType              batchSize = 2 * SizeValueType{ threader->GetMaximumNumberOfThreads() };
+    std::vector<std::vector<Bytef>>  compressedChunks(std::min(batchSize, numberOfChunks));
+    std::vector<uLong>               checksums(compressedChunks.size());
+    for (SizeValueType firstChunk = 0; firstChunk < numberOfChunks; firstChunk += batchSize)
+    {
+      const SizeValueType endChunk = std::min(firstChunk + batchSize, numberOfChunks);
+      std::atomic<bool>   failed{ false };
+      threader->ParallelizeArray(
+        firstChunk,
+        endChunk,
+        [&](SizeValueType chunk) {
+          const Bytef * const  chunkData = static_cast<const Bytef *>(data) + chunk * m_ChunkSize;
+          const uInt           chunkLength = getChunkLength(chunk);
+          std::vector<Bytef> & compressedChunk = compressedChunks[chunk - firstChunk];
+          checksums[chunk - firstChunk] = crc32(crc32(0, nullptr, 0), chunkData, chunkLength);
+          if (!CompressChunk(chunkData, chunkLength, endsStream && chunk + 1 == numberOfChunks, compressedChunk))
+          {
+            failed = true;
+          }
+        },
+        nullptr);
+      if (failed)
+      {
+        return false;
+      }
+      for (SizeValueType chunk = firstChunk; chunk < endChunk; ++chunk)
+      {
+        const std::vector<Bytef> & compressedChunk = compressedChunks[chunk - firstChunk];
+        m_File.write(reinterpret_cast<const char *>(compressedChunk.data()),
+                     static_cast<std::streamsize>(compressedChunk.size()));
+        m_Checksum =
+          crc32_combine(m_Checksum, checksums[chunk - firstChunk], static_cast<z_off_t>(getChunkLength(chunk)));
+      }
+    }
+    m_NumberOfWrittenBytes += numberOfBytes;
+
+    if (endsStream)
+    {
+      // The gzip trailer: the CRC-32 and the size modulo 2^32 of the data, in little endian order
+      unsigned char trailer[8];
+      for (unsigned int i = 0; i < 4; ++i)
+      {
+        trailer[i] = static_cast<unsigned char>((m_Checksum >> (8 * i)) & 0xFF);
+        trailer[4 + i] = static_cast<unsigned char>((m_NumberOfBytes >> (8 * i)) & 0xFF);
+      }
+      m_File.write(reinterpret_cast<const char *>(trailer), sizeof(trailer));
+      m_File.close();
+    }
+    return !m_File.fail();
+  }
+
+  SizeValueType
+  GetNumberOfWrittenBytes() const
+  {
+    return m_NumberOfWrittenBytes;
+  }
+
+  // The number of bytes before the pixel data.
+  void
+  SetDataOffset(SizeValueType dataOffset)
+  {
+    m_DataOffset = dataOffset;
+  }
+  SizeValueType
+  GetDataOffset() const
+  {
+    return m_DataOffset;
+  }
+
+private:
+  // Keeps each chunk within the range of a zlib buffer.
+  static constexpr SizeValueType maximumChunkSize = SizeValueType{ 1 } << 30;
+
+  static bool
+  CompressChunk(const Bytef * chunkData, uInt chunkLength, bool endsStream, std::vector<Bytef> & compressedChunk)
+  {
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      return false;
+    }
+    // The margin covers the empty stored block which ends a sync flush.
+    compressedChunk.resize(deflateBound(&stream, chunkLength) + 16);
+    stream.next_in = const_cast<Bytef *>(chunkData);
+    stream.avail_in = chunkLength;
+    stream.next_out = compressedChunk.data();
+    stream.avail_out = static_cast<uInt>(compressedChunk.size());
+    const int  result = deflate(&stream, endsStream ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool succeeded =
+      result == (endsStream ? Z_STREAM_END : Z_OK) && stream.avail_in == 0 && stream.avail_out > 0;
+    compressedChunk.resize(compressedChunk.size() - stream.avail_out);
+    deflateEnd(&stream);
+    return succeeded;
+  }
+
+  std::ofstream       m_File;
+  const SizeValueType m_NumberOfBytes;
+  const SizeValueType m_ChunkSize;
+  SizeValueType       m_NumberOfWrittenBytes{ 0 };
+  SizeValueType       m_DataOffset{ 0 };
+  uLong               m_Checksum{ crc32(0, nullptr, 0) };
+};
+
+
 NiftiImageIO::NiftiImageIO()
   : m_Holder{ std::make_unique<NiftiImageProxy>() }
   , m_LegacyAnalyze75Mode{ ITK_NIFTI_IO_ANALYZE_FLAVOR_DEFAULT }
@@ -198,6 +343,26 @@ NiftiImageIO::NiftiImageIO()
 
 NiftiImageIO::~NiftiImageIO() = default;
 
+LightObject::Pointer
+NiftiImageIO::InternalClone() const
+{
+  LightObject::Pointer lightObject = Superclass::InternalClone();
+
+  if (auto * const clone = dynamic_cast<Self *>(lightObject.GetPointer()))
+  {
+    clone->m_RescaleSlope = m_RescaleSlope;
+    clone->m_RescaleIntercept = m_RescaleIntercept;
+    clone->m_ConvertRASVectors = m_ConvertRASVectors;
+    clone->m_ConvertRASDisplacementVectors = m_ConvertRASDisplacementVectors;
+    clone->m_LegacyAnalyze75Mode = m_LegacyAnalyze75Mode;
+    clone->m_ZeroNonFinitePixels = m_ZeroNonFinitePixels;
+    clone->m_SFORM_Permissive = m_SFORM_Permissive;
+    clone->m_CompressedDataChunkSize = m_CompressedDataChunkSize;
+    return lightObject;
+  }
+  itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+}
+
 void
 NiftiImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -213,6 +378,7 @@ NiftiImageIO::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "OnDiskComponentType: " << m_OnDiskComponentType << std::endl;
   os << indent << "LegacyAnalyze75Mode: " << m_LegacyAnalyze75Mode << std::endl;
   os << indent << "SFORM permissive: " << (m_SFORM_Permissive ? "On" : "Off") << std::endl;
+  os << indent << "CompressedDataChunkSize: " << m_CompressedDataChunkSize << std::endl;
 }
 
 bool
@@ -615,6 +781,36 @@ NiftiImageIO::Read(void * buffer)
   }
 }
 
+bool
+NiftiImageIO::CanMemoryMapPixelData(std::string & dataFileName, SizeType & dataOffset)
+{
+  // ReadImageInformation() releases the header, so read it again, as Read() does.
+  m_Holder->ptr.reset(nifti_image_read(this->GetFileName(), false));
+  const nifti_image * const header = m_Holder->ptr.get();
+  if (header == nullptr || header->iname == nullptr || header->iname_offset < 0 ||
+      nifti_is_gzfile(header->iname) != 0)
+  {
+    return false;
+  }
+
+  // Read() copies vector pixels component by component, and rescales,
+  // converts, or zeroes pixels as configured.
+  const bool packedPixel = this->GetNumberOfComponents() == 1 || this->GetPixelType() == IOPixelEnum::COMPLEX ||
+                           this->GetPixelType() == IOPixelEnum::RGB || this->GetPixelType() == IOPixelEnum::RGBA;
+  const bool floatingPoint =
+    this->m_ComponentType == IOComponentEnum::FLOAT || this->m_ComponentType == IOComponentEnum::DOUBLE;
+  if (!packedPixel || this->MustRescale() || this->m_ConvertRAS || (m_ZeroNonFinitePixels && floatingPoint) ||
+      (header->swapsize > 1 && header->byteorder != nifti_short_order()) ||
+      static_cast<SizeType>(header->nvox) * header->nbyper != this->GetImageSizeInBytes())
+  {
+    return false;
+  }
+
+  dataFileName = header->iname;
+  dataOffset = header->iname_offset;
+  return true;
+}
+
 NiftiImageIOEnums::NiftiFileEnum
 NiftiImageIO::DetermineFileType(const char * FileNameToRead)
 {
@@ -2119,9 +2315,128 @@ NiftiImageIO::SetNIfTIOrientationFromImageIO(unsigned short origdims, unsigned s
   m_Holder->ptr->sform_code = NIFTI_XFORM_SCANNER_ANAT;
 }
 
+bool
+NiftiImageIO::CanStreamWrite()
+{
+  return this->CanWriteCompressedDataChunks();
+}
+
+unsigned int
+NiftiImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                                const ImageIORegion & pasteRegion,
+                                                const ImageIORegion & largestPossibleRegion)
+{
+  if (this->CanStreamWrite() && pasteRegion != largestPossibleRegion)
+  {
+    itkExceptionMacro("Pasting is not supported for compressed files! Can't write:" << this->GetFileName());
+  }
+  return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+}
+
+bool
+NiftiImageIO::CanWriteCompressedDataChunks()
+{
+  // Only the pixels stored as a single NIfTI element are written as they are in memory.
+  const unsigned int numComponents = this->GetNumberOfComponents();
+  const bool         packedPixel = numComponents == 1 ||
+                           (numComponents == 2 && this->GetPixelType() == IOPixelEnum::COMPLEX) ||
+                           (numComponents == 3 && this->GetPixelType() == IOPixelEnum::RGB) ||
+                           (numComponents == 4 && this->GetPixelType() == IOPixelEnum::RGBA);
+  const char * const extension = nifti_find_file_extension(this->GetFileName());
+  return m_CompressedDataChunkSize > 0 && packedPixel && extension != nullptr &&
+         itksys::SystemTools::LowerCase(extension) == ".nii.gz" && !this->GetUseLegacyModeForTwoFileWriting() &&
+         this->GetImageSizeInBytes() > 0;
+}
+
+void
+NiftiImageIO::WriteCompressedDataChunks(const void * buffer)
+{
+  // The pieces of the image are written one after the other, in file order.
+  // The data of each piece must therefore be contiguous in the file.
+  const ImageIORegion & region = this->GetIORegion();
+  const unsigned int    nDims = this->GetNumberOfDimensions();
+  SizeValueType         pieceOffset = 0;
+  SizeValueType         stride = 1;
+  bool                  contiguous = true;
+  bool                  partial = false;
+  for (unsigned int d = 0; d < nDims; ++d)
+  {
+    const SizeValueType size = d < region.GetImageDimension() ? region.GetSize(d) : 1;
+    const IndexValueType index = d < region.GetImageDimension() ? region.GetIndex(d) : 0;
+    contiguous = contiguous && !(partial && size > 1);
+    partial = partial || size != this->GetDimensions(d);
+    pieceOffset += static_cast<SizeValueType>(index) * stride;
+    stride *= this->GetDimensions(d);
+  }
+  const SizeValueType pixelSize = this->GetPixelSize();
+  pieceOffset *= pixelSize;
+  const SizeValueType pieceSize = region.GetNumberOfPixels() * pixelSize;
+  if (!contiguous)
+  {
+    itkExceptionMacro("The region " << region << " is not contiguous in the file, so it cannot be compressed: "
+                                    << this->GetFileName());
+  }
+
+  if (pieceOffset == 0)
+  {
+    this->WriteImageInformation();
+    nifti_image * const header = m_Holder->ptr.get();
+    nifti_set_iname_offset(header);
+
+    // The header, and the extensions as nifti_write_extensions() writes them,
+    // followed by zeros up to the offset of the data.
+    std::vector<char>    headerBytes(std::max<size_t>(header->iname_offset, sizeof(nifti_1_header) + 4));
+    const nifti_1_header nhdr = nifti_convert_nim2nhdr(header);
+    std::memcpy(headerBytes.data(), &nhdr, sizeof(nhdr));
+    size_t position = sizeof(nhdr);
+    headerBytes[position] = header->num_ext > 0 ? 1 : 0;
+    position += 4;
+    for (int e = 0; e < header->num_ext; ++e)
+    {
+      const nifti1_extension & extension = header->ext_list[e];
+      headerBytes.resize(std::max(headerBytes.size(), position + extension.esize));
+      std::memcpy(&headerBytes[position], &extension.esize, sizeof(int));
+      std::memcpy(&headerBytes[position + sizeof(int)], &extension.ecode, sizeof(int));
+      std::memcpy(&headerBytes[position + 2 * sizeof(int)], extension.edata, extension.esize - 2 * sizeof(int));
+      position += extension.esize;
+    }
+
+    m_GzipStreamWriter = std::make_unique<GzipStreamWriter>(
+      this->GetFileName(), headerBytes.size() + this->GetImageSizeInBytes(), m_CompressedDataChunkSize);
+    if (!m_GzipStreamWriter->Write(headerBytes.data(), headerBytes.size()))
+    {
+      m_GzipStreamWriter.reset();
+      itkExceptionMacro("ERROR: failed to write the header of: " << this->GetFileName());
+    }
+    m_GzipStreamWriter->SetDataOffset(headerBytes.size());
+  }
+  else if (m_GzipStreamWriter == nullptr ||
+           m_GzipStreamWriter->GetNumberOfWrittenBytes() != m_GzipStreamWriter->GetDataOffset() + pieceOffset)
+  {
+    m_GzipStreamWriter.reset();
+    itkExceptionMacro("The pieces of a compressed file must be written in file order: " << this->GetFileName());
+  }
+
+  const bool written = m_GzipStreamWriter->Write(buffer, pieceSize);
+  if (!written || pieceOffset + pieceSize == static_cast<SizeValueType>(this->GetImageSizeInBytes()))
+  {
+    m_GzipStreamWriter.reset();
+  }
+  if (!written)
+  {
+    itkExceptionMacro("ERROR: failed to write compressed data to: " << this->GetFileName());
+  }
+}
+
 void
 NiftiImageIO::Write(const void * buffer)
 {
+  if (this->CanWriteCompressedDataChunks())
+  {
+    this->WriteCompressedDataChunks(buffer);
+    return;
+  }
+
   // Write the image Information before writing data
   this->WriteImageInformation();
   const unsigned int numComponents = this->GetNumberOfComponents();
@@ -22,6 +22,7 @@
 #include "itkNiftiImageIO.h"
 #include "itkVectorImage.h"
 #include "itkImageRegionIterator.h"
+#include "itkMemoryMappedImageContainer.h"
 
 #include <array>
 #include <cmath>
@@ -314,3 +315,137 @@ TEST(NiftiImageIO, ZeroNonFinitePixelsOverwritesNonFiniteValues)
     EXPECT_EQ(it.Get(), 0.0f) << "opting in should overwrite every non-finite value";
   }
 }
+
+TEST(NiftiImageIO, MemoryMapsUncompressedPixelData)
+{
+  using ImageType = itk::Image<float, 3>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(itk::Size<3>{ { 7, 5, 3 } }));
+  image->Allocate();
+  {
+    itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion());
+    for (float value = 0.0f; !it.IsAtEnd(); ++it, ++value)
+    {
+      it.Set(value);
+    }
+  }
+
+  for (const std::string fileName : { "MemoryMapped.nii", "MemoryMapped.nii.gz" })
+  {
+    const std::string path = OutputPath(fileName);
+    auto              writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(itk::NiftiImageIO::New());
+    writer->SetInput(image);
+    writer->SetFileName(path);
+    ASSERT_NO_THROW(writer->Update());
+
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(itk::NiftiImageIO::New());
+    reader->SetFileName(path);
+    reader->UseMemoryMappingOn();
+    ASSERT_NO_THROW(reader->Update());
+
+    // Compressed data cannot be mapped, and is read as usual.
+    const ImageType * const output = reader->GetOutput();
+    const bool              isMapped =
+      dynamic_cast<const itk::MemoryMappedImageContainer<itk::SizeValueType, float> *>(output->GetPixelContainer()) !=
+      nullptr;
+    EXPECT_EQ(isMapped, fileName == "MemoryMapped.nii") << fileName;
+    itk::ImageRegionConstIterator<ImageType> expected(image, image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> it(output, output->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it, ++expected)
+    {
+      EXPECT_EQ(it.Get(), expected.Get());
+    }
+  }
+}
+
+TEST(NiftiImageIO, StreamsCompressedDataChunks)
+{
+  using ImageType = itk::Image<short, 3>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(itk::Size<3>{ { 31, 17, 13 } }));
+  image->Allocate();
+  {
+    itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion());
+    for (short value = 0; !it.IsAtEnd(); ++it, ++value)
+    {
+      it.Set(value);
+    }
+  }
+
+  // Streamed, in pieces of several chunks, and in a single piece of a single chunk
+  for (const unsigned int numberOfStreamDivisions : { 5u, 1u })
+  {
+    const std::string path = OutputPath("StreamedCompressed" + std::to_string(numberOfStreamDivisions) + ".nii.gz");
+    auto              io = itk::NiftiImageIO::New();
+    EXPECT_EQ(io->GetCompressedDataChunkSize(), itk::SizeValueType{ 4 } << 20);
+    io->SetCompressedDataChunkSize(numberOfStreamDivisions > 1 ? 1000 : 0);
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(io);
+    writer->SetInput(image);
+    writer->SetFileName(path);
+    writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+    ASSERT_NO_THROW(writer->Update());
+    EXPECT_EQ(io->CanStreamWrite(), numberOfStreamDivisions > 1);
+
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(itk::NiftiImageIO::New());
+    reader->SetFileName(path);
+    ASSERT_NO_THROW(reader->Update());
+    const ImageType * const output = reader->GetOutput();
+    EXPECT_EQ(output->GetLargestPossibleRegion(), image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> expected(image, image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> it(output, output->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it, ++expected)
+    {
+      ASSERT_EQ(it.Get(), expected.Get()) << numberOfStreamDivisions << " stream divisions, at " << it.GetIndex();
+    }
+  }
+}
+
+TEST(NiftiImageIO, CompressedDataChunksCannotBePasted)
+{
+  using ImageType = itk::Image<float, 3>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(itk::Size<3>{ { 8, 8, 8 } }));
+  image->AllocateInitialized();
+
+  itk::ImageIORegion pasteRegion(3);
+  pasteRegion.SetSize(0, 8);
+  pasteRegion.SetSize(1, 8);
+  pasteRegion.SetSize(2, 4);
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetImageIO(itk::NiftiImageIO::New());
+  writer->SetInput(image);
+  writer->SetFileName(OutputPath("PastedCompressed.nii.gz"));
+  writer->SetIORegion(pasteRegion);
+  EXPECT_THROW(writer->Update(), itk::ExceptionObject);
+}
+
+TEST(NiftiImageIO, CloneKeepsNiftiSettings)
+{
+  using FlavorType = itk::NiftiImageIOEnums::Analyze75Flavor;
+
+  auto             io = itk::NiftiImageIO::New();
+  const FlavorType flavor =
+    (io->GetLegacyAnalyze75Mode() == FlavorType::AnalyzeFSL) ? FlavorType::AnalyzeITK4 : FlavorType::AnalyzeFSL;
+  io->SetLegacyAnalyze75Mode(flavor);
+  io->SetSFORM_Permissive(!io->GetSFORM_Permissive());
+  io->SetConvertRASVectors(true);
+  io->SetConvertRASDisplacementVectors(false);
+  io->SetZeroNonFinitePixels(true);
+  io->SetCompressedDataChunkSize(12345);
+
+  const itk::ImageIOBase::Pointer clone = io->Clone();
+  const auto * const              niftiClone = dynamic_cast<const itk::NiftiImageIO *>(clone.GetPointer());
+  ASSERT_NE(niftiClone, nullptr);
+  EXPECT_NE(niftiClone, io.GetPointer());
+  EXPECT_EQ(niftiClone->GetLegacyAnalyze75Mode(), flavor);
+  EXPECT_EQ(niftiClone->GetSFORM_Permissive(), io->GetSFORM_Permissive());
+  EXPECT_TRUE(niftiClone->GetConvertRASVectors());
+  EXPECT_FALSE(niftiClone->GetConvertRASDisplacementVectors());
+  EXPECT_TRUE(niftiClone->GetZeroNonFinitePixels());
+  EXPECT_EQ(niftiClone->GetCompressedDataChunkSize(), 12345u);
+}
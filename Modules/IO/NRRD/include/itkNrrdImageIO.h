@@ -125,6 +125,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixel data can be mapped if it is raw encoded, in native byte
+   * order, stored in a single file, and does not need to be permuted. */
+  bool
+  CanMemoryMapPixelData(std::string & dataFileName, SizeType & dataOffset) override;
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
@@ -212,6 +217,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the axes reordering. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalSetCompressor(const std::string & _compressor) override;
 
@@ -25,6 +25,7 @@
 #include "itkNumberToString.h"
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <sstream>
 #include <type_traits>
@@ -369,6 +370,19 @@ NrrdImageIO::NrrdImageIO()
 
 NrrdImageIO::~NrrdImageIO() = default;
 
+LightObject::Pointer
+NrrdImageIO::InternalClone() const
+{
+  LightObject::Pointer lightObject = Superclass::InternalClone();
+
+  if (auto * const clone = dynamic_cast<Self *>(lightObject.GetPointer()))
+  {
+    clone->m_AxesReorder = m_AxesReorder;
+    return lightObject;
+  }
+  itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+}
+
 bool
 NrrdImageIO::SupportsDimension(unsigned long dim)
 {
@@ -1221,6 +1235,86 @@ NrrdImageIO::Read(void * buffer)
   }
 }
 
+bool
+NrrdImageIO::CanMemoryMapPixelData(std::string & dataFileName, SizeType & dataOffset)
+{
+  if (this->GetPixelType() == IOPixelEnum::SYMMETRICSECONDRANKTENSOR)
+  {
+    // The tensors may be stored with a mask component, which Read() crops
+    return false;
+  }
+
+  const std::unique_ptr<Nrrd, decltype(&nrrdNix)>               nrrdGuard(nrrdNew(), nrrdNix);
+  const std::unique_ptr<NrrdIoState, decltype(&nrrdIoStateNix)> nioGuard(nrrdIoStateNew(), nrrdIoStateNix);
+  Nrrd * const                                                  nrrd = nrrdGuard.get();
+  NrrdIoState * const                                           nio = nioGuard.get();
+
+  // Read just the header, but let nrrdLoad skip to the start of the data
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+
+  // nrrd causes exceptions on purpose, so mask them
+  bool saveFPEState(false);
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    saveFPEState = FloatingPointExceptions::GetEnabled();
+    FloatingPointExceptions::Disable();
+  }
+  const bool loaded = (nrrdLoad(nrrd, this->GetFileName(), nio) == 0);
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    FloatingPointExceptions::SetEnabled(saveFPEState);
+  }
+  if (!loaded)
+  {
+    free(biffGetDone(NRRD));
+    return false;
+  }
+
+  // The data file is only kept open if there is a single one
+  long dataPosition = -1;
+  if (nio->dataFile != nullptr)
+  {
+    dataPosition = ftell(nio->dataFile);
+    nio->dataFile = airFclose(nio->dataFile);
+  }
+
+  int                       pixelAxisIndex{ -1 };
+  std::vector<unsigned int> imageAxes_nrrd;
+  unsigned int              numberOfDomainAxes{ 0 };
+  bool                      needPermutation{ false };
+  GetAxisOrderForFileReading(
+    nrrd, imageAxes_nrrd, pixelAxisIndex, numberOfDomainAxes, needPermutation, this->GetAxesReorder());
+
+  if (dataPosition < 0 || nio->format != nrrdFormatNRRD || nio->encoding != nrrdEncodingRaw || needPermutation ||
+      nio->dataFSkip != nullptr || (nrrdElementSize(nrrd) > 1 && nio->endian != airMyEndian()) ||
+      nrrdElementSize(nrrd) != this->GetComponentSize())
+  {
+    return false;
+  }
+
+  if (nio->dataFNArr->len == 0)
+  {
+    // The data is attached to the header
+    dataFileName = this->GetFileName();
+  }
+  else
+  {
+    dataFileName = nio->dataFN[0];
+    if (dataFileName == "-")
+    {
+      return false;
+    }
+    if (dataFileName[0] != '/' && (dataFileName.size() < 2 || dataFileName[1] != ':'))
+    {
+      // A relative data file name is relative to the header file
+      dataFileName = std::string(nio->path != nullptr ? nio->path : ".") + '/' + dataFileName;
+    }
+  }
+  dataOffset = dataPosition;
+  return true;
+}
+
 bool
 NrrdImageIO::CanWriteFile(const char * name)
 {
@@ -19,6 +19,7 @@
 #include "itkNrrdImageIO.h"
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
+#include "itkMemoryMappedImageContainer.h"
 #include "itkMetaDataObject.h"
 #include "itkGTest.h"
 #include <fstream>
@@ -165,3 +166,86 @@ TEST(NrrdImageIO, PerAxisPrefixedCustomKeySurvivesRoundTrip)
   std::string value;
   EXPECT_TRUE(itk::ExposeMetaData(restored->GetMetaDataDictionary(), "NRRD_kinds[0]_vendor", value));
 }
+
+// Raw data in a detached file, after a byte skip, is memory mapped by the reader.
+TEST(NrrdImageIO, MemoryMapsRawDetachedData)
+{
+  const std::string dir = ::testing::TempDir();
+  const std::string header = WriteFile(dir + "/mmap.nhdr",
+                                       "NRRD0004\n"
+                                       "type: uchar\n"
+                                       "dimension: 3\n"
+                                       "sizes: 4 3 2\n"
+                                       "encoding: raw\n"
+                                       "byte skip: 3\n"
+                                       "data file: mmap.raw\n");
+  std::string content = "abc";
+  for (char value = 0; value < 24; ++value)
+  {
+    content += value;
+  }
+  WriteFile(dir + "/mmap.raw", content);
+
+  auto io = itk::NrrdImageIO::New();
+  io->SetFileName(header);
+  io->ReadImageInformation();
+  std::string                dataFileName;
+  itk::ImageIOBase::SizeType dataOffset = 0;
+  ASSERT_TRUE(io->CanMemoryMapPixelData(dataFileName, dataOffset));
+  EXPECT_EQ(dataFileName, dir + "/mmap.raw");
+  EXPECT_EQ(dataOffset, 3);
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(header);
+  reader->SetImageIO(io);
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  using MappedContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, unsigned char>;
+  const ImageType * const output = reader->GetOutput();
+  EXPECT_NE(dynamic_cast<const MappedContainerType *>(output->GetPixelContainer()), nullptr);
+  EXPECT_EQ(output->GetPixel({ { 3, 2, 1 } }), 23);
+}
+
+// Compressed data cannot be memory mapped, so the reader falls back to reading it.
+TEST(NrrdImageIO, ReadsCompressedDataWhenMemoryMapping)
+{
+  const std::string dir = ::testing::TempDir();
+  auto              image = ImageType::New();
+  image->SetRegions(ImageType::RegionType{ ImageType::IndexType{}, ImageType::SizeType::Filled(3) });
+  image->Allocate();
+  image->FillBuffer(7);
+
+  const std::string file = dir + "/mmap-compressed.nrrd";
+  auto              writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetFileName(file);
+  writer->SetInput(image);
+  writer->SetImageIO(itk::NrrdImageIO::New());
+  writer->UseCompressionOn();
+  writer->Update();
+
+  auto io = itk::NrrdImageIO::New();
+  io->SetFileName(file);
+  io->ReadImageInformation();
+  std::string                dataFileName;
+  itk::ImageIOBase::SizeType dataOffset = 0;
+  EXPECT_FALSE(io->CanMemoryMapPixelData(dataFileName, dataOffset));
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(file);
+  reader->SetImageIO(io);
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  EXPECT_EQ(reader->GetOutput()->GetPixel({ { 2, 2, 2 } }), 7);
+}
+
+TEST(NrrdImageIO, CloneKeepsAxesReorder)
+{
+  auto io = itk::NrrdImageIO::New();
+  io->SetAxesReorderToUseScalarPixel();
+
+  const itk::ImageIOBase::Pointer clone = io->Clone();
+  const auto * const              nrrdClone = dynamic_cast<const itk::NrrdImageIO *>(clone.GetPointer());
+  ASSERT_NE(nrrdClone, nullptr);
+  EXPECT_NE(nrrdClone, io.GetPointer());
+  EXPECT_EQ(nrrdClone->GetAxesReorder(), itk::AxesReorderEnum::UseScalarPixel);
+}
@@ -122,6 +122,13 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Each read uses its own stream, so clones of this ImageIO can read files concurrently. */
+  bool
+  CanReadConcurrently() const override
+  {
+    return true;
+  }
+
   /** Set/Get the Data mask. */
   /** @ITKStartGrouping */
   itkGetConstReferenceMacro(ImageMask, unsigned short);
@@ -164,6 +171,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also copies the header and the image geometry, which are not read
+   * from the file but set by the user. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   // void ComputeInternalFileName(unsigned long slice);
 
 private:
@@ -75,6 +75,29 @@ RawImageIO<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent)
   os << indent << "FileDimensionality: " << m_FileDimensionality << std::endl;
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+LightObject::Pointer
+RawImageIO<TPixel, VImageDimension>::InternalClone() const
+{
+  LightObject::Pointer lightObject = Superclass::InternalClone();
+
+  if (auto * const clone = dynamic_cast<Self *>(lightObject.GetPointer()))
+  {
+    clone->SetNumberOfComponents(this->GetNumberOfComponents());
+    clone->SetNumberOfDimensions(this->GetNumberOfDimensions());
+    clone->m_Dimensions = this->m_Dimensions;
+    clone->m_Spacing = this->m_Spacing;
+    clone->m_Origin = this->m_Origin;
+    clone->m_Direction = this->m_Direction;
+    clone->m_FileDimensionality = m_FileDimensionality;
+    clone->m_ManualHeaderSize = m_ManualHeaderSize;
+    clone->m_HeaderSize = m_HeaderSize;
+    clone->m_ImageMask = m_ImageMask;
+    return lightObject;
+  }
+  itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 SizeValueType
 RawImageIO<TPixel, VImageDimension>::GetHeaderSize()
@@ -191,6 +191,14 @@ protected:
     return ProcessVirtualPoint_impl(IdentityHelper<TDomainPartitioner>(), virtualIndex, virtualPoint, threadId);
   }
 
+  /** The metric is evaluated over a neighborhood of each point, so the
+   * fixed image sample cache does not apply. */
+  bool
+  SupportsFixedImageSampleCache() const override
+  {
+    return false;
+  }
+
   /* specific overloading for sparse CC metric */
   bool
   ProcessVirtualPoint_impl(IdentityHelper<ThreadedIndexedContainerPartitioner> itkNotUsed(self),
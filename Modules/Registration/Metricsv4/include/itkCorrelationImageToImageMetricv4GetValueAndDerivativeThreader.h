@@ -104,6 +104,14 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId) override;
 
+  /** Processing is done in \c ProcessVirtualPoint, which does not use
+   * the fixed image sample cache. */
+  bool
+  SupportsFixedImageSampleCache() const override
+  {
+    return false;
+  }
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -103,6 +103,13 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId) override;
 
+  /** Processing is done in \c ProcessVirtualPoint, which does not use
+   * the fixed image sample cache. */
+  bool
+  SupportsFixedImageSampleCache() const override
+  {
+    return false;
+  }
 
   /**
    * Not using. All processing is done in ProcessVirtualPoint.
@@ -100,13 +100,9 @@ namespace itk
  * SetFixedSampledPointSet is called or SetVirtualSampledPointSet
  * along with SetUseVirtualSampledPointSet.
  * \note If the point set is sparse, the option SetUse[Fixed|Moving]ImageGradientFilter
- * typically should be disabled to avoid excessive computation. However,
- * the gradient values of the fixed image are not cached
- * when using a point set (there are plans for this in the future), so
- * depending on the number of iterations (when used during optimization)
- * and the level of sparsity, it may be more efficient to
- * use a gradient image filter for it because it will only be
- * calculated once.
+ * typically should be disabled to avoid excessive computation. The fixed
+ * image values and gradients at the sample points can then be computed once
+ * and reused across iterations by enabling UseFixedImageSampleCache.
  *
  * Vector Images
  *
@@ -525,6 +521,31 @@ public:
   itkGetConstReferenceMacro(UseMovingImageGradientFilter, bool);
   itkBooleanMacro(UseMovingImageGradientFilter);
   /** @ITKEndGrouping */
+  /** Set/Get caching of the fixed-image side of each sample across evaluations.
+   * When enabled, the virtual point, mapped fixed point, fixed pixel value and
+   * fixed image gradient of each virtual domain sample are computed on the first
+   * evaluation and reused by later evaluations, so that each iteration of an
+   * optimization only evaluates the moving image. The cache is discarded by
+   * Initialize() and whenever the metric, the fixed image, the fixed transform,
+   * the fixed interpolator or the fixed image mask has been modified since it
+   * was filled. Changes to the sub-transforms of a composite fixed transform are
+   * not detected; call Initialize() after modifying them. Requires roughly
+   * 100 bytes per virtual domain sample. Metrics that evaluate a neighborhood
+   * around each sample ignore this option. False by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseFixedImageSampleCache, bool);
+  itkGetConstReferenceMacro(UseFixedImageSampleCache, bool);
+  itkBooleanMacro(UseFixedImageSampleCache);
+  /** @ITKEndGrouping */
+
+  /** Get the time at which the fixed image sample cache was last reset, to
+   * be filled again by the next evaluation. It is unchanged as long as the
+   * evaluations reuse the cached samples. */
+  ModifiedTimeType
+  GetFixedImageSampleCacheMTime() const
+  {
+    return this->m_FixedImageSamplesTime.GetMTime();
+  }
   /** Get number of work units to used in the most recent
    * evaluation.  Only valid after GetValueAndDerivative() or
    * GetValue() has been called. */
@@ -680,6 +701,20 @@ protected:
                                                                  Self>;
   friend class ImageToImageMetricv4GetValueAndDerivativeThreader<ThreadedIndexedContainerPartitioner, Self>;
 
+  /** Fixed-image side of a virtual domain sample, stored by the fixed image
+   * sample cache. \c IsEvaluated is set once the remaining members are filled,
+   * and \c IsValid holds the result of TransformAndEvaluateFixedPoint. */
+  struct FixedImageSampleType
+  {
+    VirtualIndexType       VirtualIndex{};
+    VirtualPointType       VirtualPoint{};
+    FixedImagePointType    MappedFixedPoint{};
+    FixedImagePixelType    MappedFixedPixelValue{};
+    FixedImageGradientType MappedFixedImageGradient{};
+    bool                   IsEvaluated{ false };
+    bool                   IsValid{ false };
+  };
+
   /* A DenseGetValueAndDerivativeThreader
    * Derived classes must define this class and assign it in their constructor
    * if threaded processing in GetValueAndDerivative is performed. */
@@ -698,6 +733,13 @@ protected:
   virtual void
   InitializeForIteration() const;
 
+  /** Make the fixed image sample cache ready for an evaluation. Returns false
+   * and releases the cache if UseFixedImageSampleCache is off. Otherwise the
+   * cache is sized to GetNumberOfDomainPoints() and its entries are reset if
+   * any fixed-side input has been modified since it was filled. */
+  bool
+  PrepareFixedImageSampleCache() const;
+
   /**
    * Transform a point from VirtualImage domain to FixedImage domain and evaluate.
    * This function also checks if mapped point is within the mask if
@@ -815,6 +857,14 @@ protected:
   FixedSampledPointSet */
   bool m_UseVirtualSampledPointSet{};
 
+  /** Fixed image sample cache, indexed by virtual domain sample, and the
+   * time at which it was last reset. */
+  mutable std::vector<FixedImageSampleType> m_FixedImageSamples{};
+  mutable TimeStamp                         m_FixedImageSamplesTime{};
+
+  /** Flag to cache the fixed-image side of each sample across evaluations. */
+  bool m_UseFixedImageSampleCache{ false };
+
   ImageToImageMetricv4();
   ~ImageToImageMetricv4() override = default;
 
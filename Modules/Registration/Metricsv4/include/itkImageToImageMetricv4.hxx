@@ -128,6 +128,9 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
     this->MapFixedSampledPointSetToVirtual();
   }
 
+  /* Samples cached for a previous level or set of inputs are stale. */
+  this->m_FixedImageSamples.clear();
+
   /* Initialize interpolators. */
   itkDebugMacro("Initialize Interpolators");
   this->m_FixedInterpolator->SetInputImage(this->m_FixedImage);
@@ -280,6 +283,44 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   }
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+bool
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  PrepareFixedImageSampleCache() const
+{
+  if (!this->m_UseFixedImageSampleCache)
+  {
+    std::vector<FixedImageSampleType>().swap(this->m_FixedImageSamples);
+    return false;
+  }
+
+  /* The fixed side of a sample depends on these inputs only. */
+  ModifiedTimeType inputsMTime = std::max(this->GetMTime(), this->m_FixedImage->GetMTime());
+  inputsMTime = std::max(inputsMTime, this->m_FixedTransform->GetMTime());
+  inputsMTime = std::max(inputsMTime, this->m_FixedInterpolator->GetMTime());
+  if (this->m_FixedImageMask)
+  {
+    inputsMTime = std::max(inputsMTime, this->m_FixedImageMask->GetMTime());
+  }
+  if (this->m_UseSampledPointSet)
+  {
+    inputsMTime = std::max(inputsMTime, this->m_VirtualSampledPointSet->GetMTime());
+  }
+
+  const SizeValueType numberOfSamples = this->GetNumberOfDomainPoints();
+  if (this->m_FixedImageSamples.size() != numberOfSamples || inputsMTime > this->m_FixedImageSamplesTime.GetMTime())
+  {
+    itkDebugMacro("Resetting the fixed image sample cache");
+    this->m_FixedImageSamples.assign(numberOfSamples, FixedImageSampleType{});
+    this->m_FixedImageSamplesTime.Modified();
+  }
+  return true;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -648,6 +689,7 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
      << indent << "GetUseMovingImageGradientFilter: " << this->GetUseMovingImageGradientFilter() << std::endl
      << indent << "UseFloatingPointCorrection: " << this->GetUseFloatingPointCorrection() << std::endl
      << indent << "FloatingPointCorrectionResolution: " << this->GetFloatingPointCorrectionResolution() << std::endl;
+  itkPrintSelfBooleanMacro(UseFixedImageSampleCache);
 
   itkPrintSelfObjectMacro(FixedImage);
   itkPrintSelfObjectMacro(MovingImage);
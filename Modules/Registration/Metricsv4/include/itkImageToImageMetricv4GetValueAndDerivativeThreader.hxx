@@ -30,7 +30,34 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<
   TImageToImageMetricv4>::ThreadedExecution(const DomainType & imageSubRegion, const ThreadIdType threadId)
 {
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
-  VirtualPointType                              virtualPoint;
+  if (this->m_UseFixedImageSampleCache)
+  {
+    /* The cache holds one entry per pixel of the virtual region, in the
+     * order of its linear offset. */
+    const typename VirtualImageType::RegionType virtualRegion = this->m_Associate->GetVirtualRegion();
+    for (ImageRegionConstIteratorWithIndex it(virtualImage, imageSubRegion); !it.IsAtEnd(); ++it)
+    {
+      const VirtualIndexType & virtualIndex = it.GetIndex();
+      SizeValueType            offset = 0;
+      SizeValueType            stride = 1;
+      for (unsigned int d = 0; d < TImageToImageMetricv4::VirtualImageDimension; ++d)
+      {
+        offset += static_cast<SizeValueType>(virtualIndex[d] - virtualRegion.GetIndex(d)) * stride;
+        stride *= virtualRegion.GetSize(d);
+      }
+      auto & fixedImageSample = this->m_Associate->m_FixedImageSamples[offset];
+      if (!fixedImageSample.IsEvaluated)
+      {
+        fixedImageSample.VirtualIndex = virtualIndex;
+        virtualImage->TransformIndexToPhysicalPoint(virtualIndex, fixedImageSample.VirtualPoint);
+      }
+      this->ProcessCachedVirtualPoint(fixedImageSample, threadId);
+    }
+    this->m_Associate->FinalizeThread(threadId);
+    return;
+  }
+
+  VirtualPointType virtualPoint;
   for (ImageRegionConstIteratorWithIndex it(virtualImage, imageSubRegion); !it.IsAtEnd(); ++it)
   {
     const VirtualIndexType & virtualIndex = it.GetIndex();
@@ -52,6 +79,22 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<ThreadedIndexedContainerPartit
   const ElementIdentifierType                   begin = indexSubRange[0];
   const ElementIdentifierType                   end = indexSubRange[1];
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
+  if (this->m_UseFixedImageSampleCache)
+  {
+    for (ElementIdentifierType i = begin; i <= end; ++i)
+    {
+      auto & fixedImageSample = this->m_Associate->m_FixedImageSamples[i];
+      if (!fixedImageSample.IsEvaluated)
+      {
+        fixedImageSample.VirtualPoint = virtualSampledPointSet->GetPoint(i);
+        fixedImageSample.VirtualIndex = virtualImage->TransformPhysicalPointToIndex(fixedImageSample.VirtualPoint);
+      }
+      this->ProcessCachedVirtualPoint(fixedImageSample, threadId);
+    }
+    this->m_Associate->FinalizeThread(threadId);
+    return;
+  }
+
   for (ElementIdentifierType i = begin; i <= end; ++i)
   {
     const VirtualPointType & virtualPoint = virtualSampledPointSet->GetPoint(i);
@@ -88,6 +88,8 @@ public:
   using InternalComputationValueType = typename ImageToImageMetricv4Type::InternalComputationValueType;
   using NumberOfParametersType = typename ImageToImageMetricv4Type::NumberOfParametersType;
 
+  using FixedImageSampleType = typename ImageToImageMetricv4Type::FixedImageSampleType;
+
   using CompensatedDerivativeValueType = CompensatedSummation<DerivativeValueType>;
   using CompensatedDerivativeType = std::vector<CompensatedDerivativeValueType>;
 
@@ -99,7 +101,9 @@ protected:
   ImageToImageMetricv4GetValueAndDerivativeThreaderBase();
   ~ImageToImageMetricv4GetValueAndDerivativeThreaderBase() override = default;
 
-  /** Resize and initialize per thread objects. */
+  /** Resize and initialize per thread objects. The per thread objects are
+   * kept between executions and only reallocated when the number of work
+   * units changes. */
   void
   BeforeThreadedExecution() override;
 
@@ -122,6 +126,43 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId);
 
+  /** Same as \c ProcessVirtualPoint, but takes the fixed-image side of the
+   * point from \c fixedImageSample, an entry of the metric's fixed image
+   * sample cache, which is evaluated first if it has not been already. Only
+   * called when \c m_UseFixedImageSampleCache is true. */
+  bool
+  ProcessCachedVirtualPoint(FixedImageSampleType & fixedImageSample, const ThreadIdType threadId);
+
+  /** Whether the threader evaluates each virtual point only through \c
+   * ProcessPoint, so that the fixed-image side of the points can be cached
+   * across executions. Threaders that override \c ProcessVirtualPoint or
+   * sample a neighborhood of each point return false. */
+  virtual bool
+  SupportsFixedImageSampleCache() const
+  {
+    return true;
+  }
+
+  /** Map \c virtualPoint to the fixed image and evaluate the fixed image
+   * value and, if \c computeGradient is true, its gradient there. Returns
+   * false if the point is outside the fixed image or mask. */
+  bool
+  EvaluateFixedImageSample(const VirtualPointType & virtualPoint,
+                           FixedImagePointType &    mappedFixedPoint,
+                           FixedImagePixelType &    mappedFixedPixelValue,
+                           FixedImageGradientType & mappedFixedImageGradient,
+                           bool                     computeGradient) const;
+
+  /** Evaluate the moving side of a virtual point whose fixed side is valid,
+   * call \c ProcessPoint and accumulate its results for \c threadId. */
+  bool
+  ProcessVirtualPointWithFixedImageSample(const VirtualIndexType &       virtualIndex,
+                                          const VirtualPointType &       virtualPoint,
+                                          const FixedImagePointType &    mappedFixedPoint,
+                                          const FixedImagePixelType &    mappedFixedPixelValue,
+                                          const FixedImageGradientType & mappedFixedImageGradient,
+                                          const ThreadIdType             threadId);
+
   /** Method to calculate the metric value and derivative
    * given a point, value and image derivative for both fixed and moving
    * spaces. The provided values have been calculated from \c virtualPoint,
@@ -195,6 +236,11 @@ protected:
                     PaddedGetValueAndDerivativePerThreadStruct,
                     AlignedGetValueAndDerivativePerThreadStruct);
   std::unique_ptr<AlignedGetValueAndDerivativePerThreadStruct[]> m_GetValueAndDerivativePerThreadVariables;
+  ThreadIdType                                                   m_NumberOfGetValueAndDerivativePerThreadVariables{};
+
+  /** Whether the current execution reads and fills the metric's fixed image
+   * sample cache. Set in \c BeforeThreadedExecution. */
+  bool m_UseFixedImageSampleCache{ false };
 
   /** Cached values to avoid call overhead.
    *  These will only be set once threading has been started. */
@@ -44,10 +44,19 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   this->m_CachedNumberOfParameters = this->m_Associate->GetNumberOfParameters();
   this->m_CachedNumberOfLocalParameters = this->m_Associate->GetNumberOfLocalParameters();
 
-  /* Per-thread results */
+  /* Per-thread results. These are kept from one execution to the next, so
+   * that the containers below are only resized when their size changes. */
   const ThreadIdType numWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
-  this->m_GetValueAndDerivativePerThreadVariables =
-    make_unique_for_overwrite<AlignedGetValueAndDerivativePerThreadStruct[]>(numWorkUnitsUsed);
+  if (this->m_GetValueAndDerivativePerThreadVariables == nullptr ||
+      this->m_NumberOfGetValueAndDerivativePerThreadVariables != numWorkUnitsUsed)
+  {
+    this->m_GetValueAndDerivativePerThreadVariables =
+      make_unique_for_overwrite<AlignedGetValueAndDerivativePerThreadStruct[]>(numWorkUnitsUsed);
+    this->m_NumberOfGetValueAndDerivativePerThreadVariables = numWorkUnitsUsed;
+  }
+
+  this->m_UseFixedImageSampleCache =
+    this->SupportsFixedImageSampleCache() && this->m_Associate->PrepareFixedImageSampleCache();
 
   if (this->m_Associate->GetComputeDerivative())
   {
@@ -178,24 +187,73 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   const VirtualPointType & virtualPoint,
   const ThreadIdType       threadId)
 {
-  FixedImagePointType     mappedFixedPoint;
-  FixedImagePixelType     mappedFixedPixelValue;
-  FixedImageGradientType  mappedFixedImageGradient;
-  MovingImagePointType    mappedMovingPoint;
-  MovingImagePixelType    mappedMovingPixelValue;
-  MovingImageGradientType mappedMovingImageGradient;
-  bool                    pointIsValid = false;
-  MeasureType             metricValueResult;
+  FixedImagePointType    mappedFixedPoint;
+  FixedImagePixelType    mappedFixedPixelValue;
+  FixedImageGradientType mappedFixedImageGradient;
+
+  const bool pointIsValid = this->EvaluateFixedImageSample(virtualPoint,
+                                                           mappedFixedPoint,
+                                                           mappedFixedPixelValue,
+                                                           mappedFixedImageGradient,
+                                                           this->m_Associate->GetComputeDerivative() &&
+                                                             this->m_Associate->GetGradientSourceIncludesFixed());
+  if (!pointIsValid)
+  {
+    return pointIsValid;
+  }
+
+  return this->ProcessVirtualPointWithFixedImageSample(
+    virtualIndex, virtualPoint, mappedFixedPoint, mappedFixedPixelValue, mappedFixedImageGradient, threadId);
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+bool
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ProcessCachedVirtualPoint(FixedImageSampleType & fixedImageSample, const ThreadIdType threadId)
+{
+  if (!fixedImageSample.IsEvaluated)
+  {
+    /* The gradient is cached whenever the metric may use it, so that an
+     * entry filled by GetValue() can be reused by GetValueAndDerivative(). */
+    fixedImageSample.IsValid = this->EvaluateFixedImageSample(fixedImageSample.VirtualPoint,
+                                                              fixedImageSample.MappedFixedPoint,
+                                                              fixedImageSample.MappedFixedPixelValue,
+                                                              fixedImageSample.MappedFixedImageGradient,
+                                                              this->m_Associate->GetGradientSourceIncludesFixed());
+    fixedImageSample.IsEvaluated = true;
+  }
+  if (!fixedImageSample.IsValid)
+  {
+    return false;
+  }
 
-  /* Transform the point into fixed and moving spaces, and evaluate.
+  return this->ProcessVirtualPointWithFixedImageSample(fixedImageSample.VirtualIndex,
+                                                       fixedImageSample.VirtualPoint,
+                                                       fixedImageSample.MappedFixedPoint,
+                                                       fixedImageSample.MappedFixedPixelValue,
+                                                       fixedImageSample.MappedFixedImageGradient,
+                                                       threadId);
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+bool
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  EvaluateFixedImageSample(const VirtualPointType & virtualPoint,
+                           FixedImagePointType &    mappedFixedPoint,
+                           FixedImagePixelType &    mappedFixedPixelValue,
+                           FixedImageGradientType & mappedFixedImageGradient,
+                           bool                     computeGradient) const
+{
+  bool pointIsValid = false;
+
+  /* Transform the point into fixed space, and evaluate.
    * Do this in a try block to catch exceptions and print more useful info
    * then we otherwise get when exceptions are caught in MultiThreaderBase. */
   try
   {
     pointIsValid =
       this->m_Associate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, mappedFixedPixelValue);
-    if (pointIsValid && this->m_Associate->GetComputeDerivative() &&
-        this->m_Associate->GetGradientSourceIncludesFixed())
+    if (pointIsValid && computeGradient)
     {
       this->m_Associate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, mappedFixedImageGradient);
     }
@@ -208,10 +266,24 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
     ExceptionObject err(__FILE__, __LINE__, msg);
     throw err;
   }
-  if (!pointIsValid)
-  {
-    return pointIsValid;
-  }
+  return pointIsValid;
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+bool
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ProcessVirtualPointWithFixedImageSample(const VirtualIndexType &       virtualIndex,
+                                          const VirtualPointType &       virtualPoint,
+                                          const FixedImagePointType &    mappedFixedPoint,
+                                          const FixedImagePixelType &    mappedFixedPixelValue,
+                                          const FixedImageGradientType & mappedFixedImageGradient,
+                                          const ThreadIdType             threadId)
+{
+  MovingImagePointType    mappedMovingPoint;
+  MovingImagePixelType    mappedMovingPixelValue;
+  MovingImageGradientType mappedMovingImageGradient;
+  bool                    pointIsValid = false;
+  MeasureType             metricValueResult;
 
   try
   {
@@ -147,9 +147,48 @@ public:
   itkGetConstReferenceMacro(NumberOfHistogramBins, SizeValueType);
   /** @ITKEndGrouping */
 
+  /** This variable selects the method to be used for computing the metric
+   * derivatives with respect to the parameters of a transform without local
+   * support. The choice is a trade-off between computation speed and memory.
+   *
+   * UseExplicitPDFDerivatives = True
+   * will compute the metric derivative by first calculating the derivatives of
+   * each one of the joint PDF bins with respect to each one of the transform
+   * parameters, and then accumulating these contributions in the final metric
+   * derivative by using a bin-specific weight. The memory required for the
+   * intermediate derivatives is (number of histogram bins)^2 times the number
+   * of transform parameters, plus a buffer per thread. This method is well
+   * suited for transforms with a small number of parameters.
+   *
+   * UseExplicitPDFDerivatives = False
+   * will first compute the joint PDF and the weight of each one of its bins,
+   * and then revisit the samples to accumulate their weighted contributions
+   * directly into a derivative array per thread. Only the parameters with a
+   * non-zero Jacobian at a sample are updated; for a cubic BSplineTransform
+   * these are found from the support of the sample, without evaluating the
+   * full Jacobian. The per-thread derivatives are summed in parallel over the
+   * parameters. This needs two passes over the samples, but its memory grows
+   * only with the number of parameters times the number of threads, so it is
+   * well suited for transforms with a large number of parameters, such as
+   * BSplineTransforms.
+   *
+   * Transforms with local support, such as displacement field transforms,
+   * always use the latter approach within a single pass. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseExplicitPDFDerivatives, bool);
+  itkGetConstReferenceMacro(UseExplicitPDFDerivatives, bool);
+  itkBooleanMacro(UseExplicitPDFDerivatives);
+  /** @ITKEndGrouping */
+
   void
   Initialize() override;
 
+  /** Calculate and return both the value and the derivative. When the
+   * derivatives of the joint PDF are implicit, this is done in two passes
+   * over the samples. \sa SetUseExplicitPDFDerivatives */
+  void
+  GetValueAndDerivative(MeasureType & value, DerivativeType & derivative) const override;
+
   /** The marginal PDFs are stored as std::vector. */
   // NOTE:  floating point precision is not as stable.
   // Double precision proves faster and more robust in real-world testing.
@@ -176,8 +215,8 @@ public:
   /**
    * Get the internal JointPDFDeriviative image that was used in
    * creating the metric derivative value.
-   * This is only created when a global support transform is used, and
-   * derivatives are requested.
+   * This is only created when a global support transform is used,
+   * UseExplicitPDFDerivatives is ON, and derivatives are requested.
    */
   const typename JointPDFDerivativesType::Pointer
   GetJointPDFDerivatives() const
@@ -234,8 +273,17 @@ protected:
   OffsetValueType
   ComputeSingleFixedImageParzenWindowIndex(const FixedImagePixelType & value) const;
 
+  /** Whether the derivatives of the joint PDF are implicit, i.e. whether the
+   * derivative is computed in a second pass over the samples. */
+  [[nodiscard]] bool
+  UsesImplicitPDFDerivatives() const
+  {
+    return !this->m_UseExplicitPDFDerivatives && !this->HasLocalSupport();
+  }
+
   /** Variables to define the marginal and joint histograms. */
   SizeValueType m_NumberOfHistogramBins{ 50 };
+  bool          m_UseExplicitPDFDerivatives{ true };
   PDFValueType  m_MovingImageNormalizedMin{};
   PDFValueType  m_FixedImageNormalizedMin{};
   PDFValueType  m_FixedImageTrueMin{};
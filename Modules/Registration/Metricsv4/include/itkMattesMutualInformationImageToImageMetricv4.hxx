@@ -338,13 +338,43 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TInternalComputationValueType,
                                             TMetricTraits>::FinalizeThread(const ThreadIdType threadId)
 {
-  if (this->GetComputeDerivative() && (!this->HasLocalSupport()))
+  if (this->GetComputeDerivative() && (!this->HasLocalSupport()) && this->m_UseExplicitPDFDerivatives)
   {
     this->m_ThreaderDerivativeManager[threadId].BlockAndReduce();
   }
 }
 
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::GetValueAndDerivative(MeasureType &    value,
+                                                                                  DerivativeType & derivative) const
+{
+  if (!this->UsesImplicitPDFDerivatives())
+  {
+    Superclass::GetValueAndDerivative(value, derivative);
+    return;
+  }
+
+  // First pass: compute the joint PDF, the metric value, and the pRatio of
+  // each joint PDF bin.
+  Superclass::GetValue();
+
+  // Second pass: accumulate the derivative contributions of the samples,
+  // weighted by the pRatio of the bins they fall into. The value is kept
+  // from the first pass.
+  Superclass::GetValueAndDerivative(value, derivative);
+}
+
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -468,6 +498,13 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
               this->m_PRatioArray[index] = pRatio * nFactor;
             }
           }
+          else if (this->UsesImplicitPDFDerivatives())
+          {
+            // Collect the pRatio per pdf indices, for the second pass that
+            // computes the derivative.
+            const OffsetValueType index = movingIndex + (fixedIndex * this->m_NumberOfHistogramBins);
+            this->m_PRatioArray[index] = pRatio * nFactor;
+          }
         } // end if( jointPDFValue > closeToZero && movingImageMarginalPDF > closeToZero )
       } // end for-loop over moving index
     } // end conditional for fixedMarginalPDF > close to zero
@@ -555,6 +592,8 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TMetricTraits>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(UseExplicitPDFDerivatives);
 }
 
 template <typename TFixedImage,
@@ -19,6 +19,7 @@
 #define itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_h
 
 #include "itkImageToImageMetricv4GetValueAndDerivativeThreader.h"
+#include "itkBSplineBaseTransform.h"
 
 #include <mutex>
 
@@ -86,6 +87,12 @@ public:
 
   using JacobianType = typename TMattesMutualInformationMetric::JacobianType;
 
+  /** Type of the cubic BSpline transform, whose sparse Jacobian is used for
+   * the implicit PDF derivatives. */
+  using MovingBSplineTransformType = BSplineBaseTransform<typename MovingTransformType::ParametersValueType,
+                                                          TMattesMutualInformationMetric::VirtualImageDimension,
+                                                          3>;
+
 protected:
   MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader()
     : m_MattesAssociate(nullptr)
@@ -120,10 +127,26 @@ protected:
                                              const PDFValueType &            cubicBSplineDerivativeValue,
                                              DerivativeValueType *           localSupportDerivativeResultPtr) const;
 
+  /** Accumulate the derivative contribution of a point into the per-thread
+   * derivative, when the PDF derivatives are implicit. pRatioDerivative is
+   * the sum of the pRatio of the affected joint PDF bins, weighted by the
+   * derivative of the Parzen window. */
+  void
+  AccumulateImplicitPDFDerivatives(const VirtualPointType &        virtualPoint,
+                                   const MovingImageGradientType & movingImageGradient,
+                                   const PDFValueType              pRatioDerivative,
+                                   const ThreadIdType              threadId) const;
+
 private:
   /** Internal pointer to the Mattes metric object in use by this threader.
    *  This will avoid costly dynamic casting in tight loops. */
   TMattesMutualInformationMetric * m_MattesAssociate{};
+
+  /** Whether this execution is the second pass of the implicit PDF derivatives. */
+  bool m_ComputeImplicitPDFDerivatives{ false };
+
+  /** The moving transform, if it is a cubic BSpline transform. */
+  const MovingBSplineTransformType * m_MovingBSplineTransform{};
 };
 
 } // end namespace itk
@@ -44,6 +44,17 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     itkExceptionStringMacro("Dynamic casting of associate pointer failed.");
   }
 
+  this->m_ComputeImplicitPDFDerivatives =
+    this->m_MattesAssociate->GetComputeDerivative() && this->m_MattesAssociate->UsesImplicitPDFDerivatives();
+  if (this->m_ComputeImplicitPDFDerivatives)
+  {
+    /* The joint PDF and the pRatio of its bins are kept from the first pass,
+     * and the per-thread derivatives are allocated by the superclass. */
+    this->m_MovingBSplineTransform =
+      dynamic_cast<const MovingBSplineTransformType *>(this->m_MattesAssociate->GetMovingTransform());
+    return;
+  }
+
   /* Porting: these next blocks of code are from MattesMutualImageToImageMetric::Initialize */
 
   /*
@@ -129,8 +140,17 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   //
   if (!this->m_MattesAssociate->GetComputeDerivative())
   {
-    // We only need these if we're computing derivatives.
-    this->m_MattesAssociate->m_PRatioArray.clear();
+    // We only need these if we're computing derivatives, except for the
+    // pRatio of the first pass of the implicit PDF derivatives.
+    if (this->m_MattesAssociate->UsesImplicitPDFDerivatives())
+    {
+      this->m_MattesAssociate->m_PRatioArray.assign(
+        this->m_MattesAssociate->m_NumberOfHistogramBins * this->m_MattesAssociate->m_NumberOfHistogramBins, 0.0);
+    }
+    else
+    {
+      this->m_MattesAssociate->m_PRatioArray.clear();
+    }
     this->m_MattesAssociate->m_JointPdfIndex1DArray.clear();
     this->m_MattesAssociate->m_LocalDerivativeByParzenBin.clear();
     this->m_MattesAssociate->m_JointPDFDerivatives = nullptr;
@@ -269,6 +289,27 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   const OffsetValueType fixedImageParzenWindowIndex =
     this->m_MattesAssociate->ComputeSingleFixedImageParzenWindowIndex(fixedImageValue);
 
+  if (this->m_ComputeImplicitPDFDerivatives)
+  {
+    // The joint PDF is known from the first pass, so the pRatio of the four
+    // affected bins can be applied right away.
+    const PDFValueType * pRatioPtr = this->m_MattesAssociate->m_PRatioArray.data() +
+                                     (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_NumberOfHistogramBins) +
+                                     pdfMovingIndex;
+    PDFValueType movingImageParzenWindowArg =
+      static_cast<PDFValueType>(pdfMovingIndex) - static_cast<PDFValueType>(movingImageParzenWindowTerm);
+    PDFValueType pRatioDerivative = 0.0;
+    for (; pdfMovingIndex <= pdfMovingIndexMax; ++pdfMovingIndex)
+    {
+      pRatioDerivative += *(pRatioPtr++) * CubicBSplineDerivativeFunctionType::FastEvaluate(movingImageParzenWindowArg);
+      movingImageParzenWindowArg += 1.0;
+    }
+    this->AccumulateImplicitPDFDerivatives(virtualPoint, movingImageGradient, pRatioDerivative, threadId);
+
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
+    return false;
+  }
+
   // Since a zero-order BSpline (box car) kernel is used for
   // the fixed image marginal pdf, we need only increment the
   // fixedImageParzenWindowIndex by value of 1.0.
@@ -410,6 +451,56 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomain
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
+                                                                         TImageToImageMetric,
+                                                                         TMattesMutualInformationMetric>::
+  AccumulateImplicitPDFDerivatives(const VirtualPointType &        virtualPoint,
+                                   const MovingImageGradientType & movingImageGradient,
+                                   const PDFValueType              pRatioDerivative,
+                                   const ThreadIdType              threadId) const
+{
+  auto & derivatives = this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives;
+
+  if (this->m_MovingBSplineTransform != nullptr)
+  {
+    // Only the coefficients whose support contains the point have a non-zero
+    // Jacobian, and each of them affects a single dimension.
+    typename MovingBSplineTransformType::WeightsType             weights;
+    typename MovingBSplineTransformType::ParameterIndexArrayType indices;
+    this->m_MovingBSplineTransform->ComputeJacobianFromBSplineWeightsWithRespectToPosition(
+      virtualPoint, weights, indices);
+    const NumberOfParametersType numberOfParametersPerDimension =
+      this->m_MovingBSplineTransform->GetNumberOfParametersPerDimension();
+    for (SizeValueType dim = 0; dim < this->m_MattesAssociate->MovingImageDimension; ++dim)
+    {
+      const PDFValueType           gradientTerm = movingImageGradient[dim] * pRatioDerivative;
+      const NumberOfParametersType dimensionOffset = dim * numberOfParametersPerDimension;
+      for (unsigned int k = 0; k < MovingBSplineTransformType::NumberOfWeights; ++k)
+      {
+        derivatives[indices[k] + dimensionOffset] -= weights[k] * gradientTerm;
+      }
+    }
+    return;
+  }
+
+  JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+  JacobianType & jacobianPositional =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+  this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+    virtualPoint, jacobian, jacobianPositional);
+  for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement; ++mu)
+  {
+    PDFValueType innerProduct = 0.0;
+    for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+    {
+      innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+    }
+    derivatives[mu] -= innerProduct * pRatioDerivative;
+  }
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
 void
 MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -428,6 +519,26 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
       this->m_GetValueAndDerivativePerThreadVariables[workUnitID].NumberOfValidPoints;
   }
 
+  if (this->m_ComputeImplicitPDFDerivatives)
+  {
+    // The value is known from the first pass. Sum the per-thread derivatives,
+    // in parallel over the parameters.
+    DerivativeType & derivative = *(this->m_MattesAssociate->m_DerivativeResult);
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      this->m_CachedNumberOfParameters,
+      [this, &derivative, localNumberOfWorkUnitsUsed](SizeValueType parameter) {
+        typename Superclass::CompensatedDerivativeValueType sum;
+        for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+        {
+          sum += this->m_GetValueAndDerivativePerThreadVariables[workUnitID].CompensatedDerivatives[parameter].GetSum();
+        }
+        derivative[parameter] += sum.GetSum();
+      },
+      nullptr);
+    return;
+  }
+
   /* Porting: This code is from
    * MattesMutualInformationImageToImageMetric::GetValueAndDerivativeThreadPostProcess */
   /* Post-processing that is common the GetValue and GetValueAndDerivative */
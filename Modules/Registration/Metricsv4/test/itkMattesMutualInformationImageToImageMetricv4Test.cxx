@@ -22,6 +22,7 @@
 #include "itkBSplineInterpolateImageFunction.h"
 #include "itkTextOutput.h"
 #include "itkBSplineSmoothingOnUpdateDisplacementFieldTransform.h"
+#include "itkBSplineTransform.h"
 #include "itkImageMaskSpatialObject.h"
 #include "itkTimeProbe.h"
 #include "itkTestingMacros.h"
@@ -224,6 +225,8 @@ TestMattesMetricWithAffineTransform(TInterpolator * const interpolator, const bo
   metric->SetNumberOfHistogramBins(numberOfHistogramBins);
   ITK_TEST_SET_GET_VALUE(numberOfHistogramBins, metric->GetNumberOfHistogramBins());
 
+  ITK_TEST_SET_GET_BOOLEAN(metric, UseExplicitPDFDerivatives, true);
+
   // this test doesn't pass when using gradient image filters,
   // presumably because of different derivative scaling created
   // by the filter output. The derivative results match those
@@ -433,6 +436,142 @@ TestMattesMetricWithAffineTransform(TInterpolator * const interpolator, const bo
   return EXIT_SUCCESS;
 }
 
+/**
+ *  Checks that the derivative computed with implicit PDF derivatives equals
+ *  the one computed with explicit PDF derivatives, for a BSplineTransform
+ *  (which uses its sparse Jacobian) and an AffineTransform.
+ */
+template <typename TImage, typename TTransform>
+[[nodiscard]] int
+TestMattesMetricImplicitPDFDerivatives(TImage *     fixedImage,
+                                       TImage *     movingImage,
+                                       TTransform * transform,
+                                       const bool   useSampling)
+{
+  using MetricType = itk::MattesMutualInformationImageToImageMetricv4<TImage, TImage>;
+
+  auto metric = MetricType::New();
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetMovingTransform(transform);
+  metric->SetNumberOfHistogramBins(32);
+  if (useSampling)
+  {
+    using PointSetType = typename MetricType::FixedSampledPointSetType;
+    auto pointSet = PointSetType::New();
+
+    unsigned int count = 0;
+    for (itk::ImageRegionIteratorWithIndex<TImage> it(fixedImage, fixedImage->GetLargestPossibleRegion());
+         !it.IsAtEnd();
+         ++it, ++count)
+    {
+      if (count % 3 == 0)
+      {
+        typename PointSetType::PointType point;
+        fixedImage->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+        pointSet->SetPoint(pointSet->GetNumberOfPoints(), point);
+      }
+    }
+    metric->SetFixedSampledPointSet(pointSet);
+    metric->SetUseSampledPointSet(true);
+  }
+  metric->Initialize();
+
+  typename MetricType::MeasureType    explicitValue;
+  typename MetricType::DerivativeType explicitDerivative;
+  metric->GetValueAndDerivative(explicitValue, explicitDerivative);
+  if (metric->GetJointPDFDerivatives().IsNull())
+  {
+    std::cerr << "The explicit PDF derivatives were not computed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  metric->UseExplicitPDFDerivativesOff();
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3 })
+  {
+    metric->SetMaximumNumberOfWorkUnits(numberOfWorkUnits);
+    typename MetricType::MeasureType    implicitValue;
+    typename MetricType::DerivativeType implicitDerivative;
+    metric->GetValueAndDerivative(implicitValue, implicitDerivative);
+    if (metric->GetJointPDFDerivatives().IsNotNull())
+    {
+      std::cerr << "The explicit PDF derivatives were computed needlessly." << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!itk::Math::FloatAlmostEqual(explicitValue, implicitValue, 8) ||
+        !itk::Math::FloatAlmostEqual(implicitValue, metric->GetValue(), 8))
+    {
+      std::cerr << "Values differ: " << explicitValue << " != " << implicitValue << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (implicitDerivative.size() != explicitDerivative.size())
+    {
+      std::cerr << "Derivative sizes differ." << std::endl;
+      return EXIT_FAILURE;
+    }
+    const double scale = explicitDerivative.inf_norm();
+    if (scale == 0.0 || (implicitDerivative - explicitDerivative).inf_norm() > 1e-10 * scale)
+    {
+      std::cerr << "Derivatives differ by " << (implicitDerivative - explicitDerivative).inf_norm() << " with "
+                << numberOfWorkUnits << " work units (scale " << scale << ")." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+[[nodiscard]] int
+TestMattesMetricImplicitPDFDerivatives()
+{
+  using ImageType = itk::Image<double, 2>;
+
+  auto makeImage = [](const double shift) {
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 64, 48 } });
+    image->SetSpacing(itk::MakeVector(1.5, 1.0));
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      const double x = (it.GetIndex()[0] - 30.0 - shift) / 20.0;
+      const double y = (it.GetIndex()[1] - 22.0) / 15.0;
+      it.Set(200.0 * std::exp(-(x * x + y * y)) + 10.0 * std::sin(0.3 * it.GetIndex()[0]));
+    }
+    return image;
+  };
+  const auto fixedImage = makeImage(0.0);
+  const auto movingImage = makeImage(3.0);
+
+  using BSplineTransformType = itk::BSplineTransform<double, 2, 3>;
+  auto bsplineTransform = BSplineTransformType::New();
+  bsplineTransform->SetTransformDomainOrigin(fixedImage->GetOrigin());
+  bsplineTransform->SetTransformDomainPhysicalDimensions(itk::MakeVector(64 * 1.5, 48.0));
+  bsplineTransform->SetTransformDomainMeshSize(BSplineTransformType::MeshSizeType::Filled(5));
+  BSplineTransformType::ParametersType parameters(bsplineTransform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.8 * std::sin(1.7 * i);
+  }
+  bsplineTransform->SetParameters(parameters);
+
+  using AffineTransformType = itk::AffineTransform<double, 2>;
+  auto affineTransform = AffineTransformType::New();
+  affineTransform->Rotate2D(0.05);
+  affineTransform->Translate(itk::MakeVector(-1.5, 0.5));
+
+  for (const bool useSampling : { false, true })
+  {
+    if (TestMattesMetricImplicitPDFDerivatives(
+          fixedImage.GetPointer(), movingImage.GetPointer(), bsplineTransform.GetPointer(), useSampling) ||
+        TestMattesMetricImplicitPDFDerivatives(
+          fixedImage.GetPointer(), movingImage.GetPointer(), affineTransform.GetPointer(), useSampling))
+    {
+      std::cerr << "Implicit PDF derivatives test failed, useSampling: " << useSampling << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
 /**
  * Test entry point.
  */
@@ -567,6 +706,12 @@ itkMattesMutualInformationImageToImageMetricv4Test(int, char *[])
     return EXIT_FAILURE;
   }
 
+  std::cout << "Test metric with implicit PDF derivatives." << std::endl;
+  if (TestMattesMetricImplicitPDFDerivatives())
+  {
+    return EXIT_FAILURE;
+  }
+
   std::cout << "Test passed" << std::endl;
   return EXIT_SUCCESS;
 }
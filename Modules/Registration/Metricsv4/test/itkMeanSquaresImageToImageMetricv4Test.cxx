@@ -16,8 +16,172 @@
  *
  *=========================================================================*/
 #include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkImageMaskSpatialObject.h"
 #include "itkTranslationTransform.h"
 #include "itkMath.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+/* Verify that caching the fixed-image side of the samples does not change the
+ * metric value and derivative, for dense and sparse sampling, while the moving
+ * transform changes as in an optimization and after the fixed transform or the
+ * fixed mask changes. Also verify that the cache is reused in the first case,
+ * and rebuilt in the others. */
+int
+TestMeanSquaresFixedImageSampleCache(bool useSampledPointSet)
+{
+  constexpr unsigned int Dimension = 2;
+  using ImageType = itk::Image<double, Dimension>;
+  using TransformType = itk::TranslationTransform<double, Dimension>;
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType, ImageType>;
+  using PointSetType = MetricType::FixedSampledPointSetType;
+
+  const ImageType::RegionType region{ ImageType::SizeType::Filled(24) };
+
+  auto fixedImage = ImageType::New();
+  fixedImage->SetRegions(region);
+  fixedImage->Allocate();
+  auto movingImage = ImageType::New();
+  movingImage->SetRegions(region);
+  movingImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(fixedImage, region); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - 11.0;
+    const double y = it.GetIndex()[1] - 12.0;
+    it.Set(std::exp(-(x * x + y * y) / 30.0));
+    movingImage->SetPixel(it.GetIndex(), std::exp(-((x - 1.5) * (x - 1.5) + (y + 0.5) * (y + 0.5)) / 25.0));
+  }
+
+  auto pointSet = PointSetType::New();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(fixedImage, region); !it.IsAtEnd(); ++it)
+  {
+    if ((it.GetIndex()[0] + 2 * it.GetIndex()[1]) % 3 == 0)
+    {
+      PointSetType::PointType point;
+      fixedImage->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+      pointSet->SetPoint(pointSet->GetNumberOfPoints(), point);
+    }
+  }
+
+  auto fixedTransform = TransformType::New();
+  auto movingTransform = TransformType::New();
+  fixedTransform->SetIdentity();
+  movingTransform->SetIdentity();
+
+  MetricType::Pointer metrics[2];
+  for (unsigned int m = 0; m < 2; ++m)
+  {
+    metrics[m] = MetricType::New();
+    metrics[m]->SetFixedImage(fixedImage);
+    metrics[m]->SetMovingImage(movingImage);
+    metrics[m]->SetFixedTransform(fixedTransform);
+    metrics[m]->SetMovingTransform(movingTransform);
+    metrics[m]->SetGradientSource(MetricType::GRADIENT_SOURCE_BOTH);
+    metrics[m]->SetUseSampledPointSet(useSampledPointSet);
+    metrics[m]->SetFixedSampledPointSet(pointSet);
+    metrics[m]->SetUseFixedImageSampleCache(m == 1);
+    metrics[m]->SetMaximumNumberOfWorkUnits(3);
+    metrics[m]->Initialize();
+  }
+  ITK_TEST_SET_GET_BOOLEAN(metrics[1], UseFixedImageSampleCache, true);
+
+  const auto compare = [&metrics](const char * label) -> bool {
+    MetricType::MeasureType    values[2];
+    MetricType::DerivativeType derivatives[2];
+    for (unsigned int m = 0; m < 2; ++m)
+    {
+      metrics[m]->GetValueAndDerivative(values[m], derivatives[m]);
+    }
+    bool match = itk::Math::AlmostEquals(values[0], values[1]) && metrics[0]->GetNumberOfValidPoints() > 0 &&
+                 metrics[0]->GetNumberOfValidPoints() == metrics[1]->GetNumberOfValidPoints();
+    for (unsigned int p = 0; p < derivatives[0].GetSize(); ++p)
+    {
+      match = match && std::abs(derivatives[0][p] - derivatives[1][p]) <= 1e-12 * std::abs(derivatives[0][p]);
+    }
+    const MetricType::MeasureType valueOnly = metrics[1]->GetValue();
+    match = match && itk::Math::AlmostEquals(values[0], valueOnly);
+    if (!match)
+    {
+      std::cerr << "Fixed image sample cache changed the result (" << label << "): " << values[0] << ' '
+                << derivatives[0] << " vs " << values[1] << ' ' << derivatives[1] << std::endl;
+    }
+    return match;
+  };
+
+  TransformType::ParametersType parameters(Dimension);
+  itk::ModifiedTimeType         cacheMTime = 0;
+  for (unsigned int iteration = 0; iteration < 4; ++iteration)
+  {
+    parameters[0] = 0.4 * iteration;
+    parameters[1] = -0.3 * iteration;
+    movingTransform->SetParameters(parameters);
+    if (!compare("moving transform updated"))
+    {
+      return EXIT_FAILURE;
+    }
+    if (iteration == 0)
+    {
+      cacheMTime = metrics[1]->GetFixedImageSampleCacheMTime();
+    }
+    ITK_TEST_EXPECT_EQUAL(metrics[1]->GetFixedImageSampleCacheMTime(), cacheMTime);
+  }
+
+  /* The cache must be rebuilt once the fixed transform changes. */
+  parameters[0] = 0.7;
+  parameters[1] = 0.2;
+  fixedTransform->SetParameters(parameters);
+  if (!compare("fixed transform updated"))
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(metrics[1]->GetFixedImageSampleCacheMTime() > cacheMTime);
+  cacheMTime = metrics[1]->GetFixedImageSampleCacheMTime();
+
+  /* And once the fixed mask is set, or modified. */
+  using MaskImageType = itk::Image<unsigned char, Dimension>;
+  using MaskType = itk::ImageMaskSpatialObject<Dimension>;
+  const auto makeMaskImage = [&region](itk::IndexValueType first) {
+    auto maskImage = MaskImageType::New();
+    maskImage->SetRegions(region);
+    maskImage->AllocateInitialized();
+    for (itk::ImageRegionIteratorWithIndex<MaskImageType> it(maskImage, region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(it.GetIndex()[0] >= first ? 1 : 0);
+    }
+    return maskImage;
+  };
+  auto mask = MaskType::New();
+  mask->SetImage(makeMaskImage(5));
+  mask->Update();
+  for (const auto & metric : metrics)
+  {
+    metric->SetFixedImageMask(mask);
+  }
+  if (!compare("fixed mask set"))
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(metrics[1]->GetFixedImageSampleCacheMTime() > cacheMTime);
+  cacheMTime = metrics[1]->GetFixedImageSampleCacheMTime();
+  if (!compare("fixed mask unchanged"))
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_EQUAL(metrics[1]->GetFixedImageSampleCacheMTime(), cacheMTime);
+
+  mask->SetImage(makeMaskImage(9));
+  mask->Update();
+  if (!compare("fixed mask modified"))
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(metrics[1]->GetFixedImageSampleCacheMTime() > cacheMTime);
+  return EXIT_SUCCESS;
+}
+
+} // namespace
 
 /* Simple test to verify that class builds and runs.
  * Results are not verified. See ImageToImageMetricv4Test
@@ -172,6 +336,13 @@ itkMeanSquaresImageToImageMetricv4Test(int, char ** const)
     return EXIT_FAILURE;
   }
 
+  std::cout << "Testing the fixed image sample cache." << std::endl;
+  if (TestMeanSquaresFixedImageSampleCache(false) == EXIT_FAILURE ||
+      TestMeanSquaresFixedImageSampleCache(true) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
   std::cout << "Test passed." << std::endl;
   return EXIT_SUCCESS;
 }
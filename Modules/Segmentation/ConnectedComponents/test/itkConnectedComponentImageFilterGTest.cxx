@@ -25,6 +25,8 @@ using itk::print_helper::operator<<;
 #include "itkConnectedComponentImageFilter.h"
 
 #include <bitset>
+#include <queue>
+#include <random>
 
 namespace
 {
@@ -48,6 +50,63 @@ CreateTestImageA()
 
   return image;
 }
+
+// Labels the connected components by flood fill, numbering them in the order
+// of their first pixel, and skipping the background value.
+template <typename TImage, typename TLabelImage>
+std::vector<typename TLabelImage::PixelType>
+FloodFillComponents(const TImage *                  image,
+                    bool                            fullyConnected,
+                    typename TLabelImage::PixelType backgroundValue,
+                    itk::SizeValueType &            numberOfObjects)
+{
+  using IndexType = typename TImage::IndexType;
+  const auto                                   region = image->GetLargestPossibleRegion();
+  const itk::SizeValueType                     numberOfPixels = region.GetNumberOfPixels();
+  std::vector<typename TLabelImage::PixelType> labels(numberOfPixels, backgroundValue);
+  std::vector<bool>                            visited(numberOfPixels, false);
+  numberOfObjects = 0;
+  for (itk::SizeValueType pixel = 0; pixel < numberOfPixels; ++pixel)
+  {
+    if (visited[pixel] || image->GetBufferPointer()[pixel] == 0)
+    {
+      continue;
+    }
+    const auto label = static_cast<typename TLabelImage::PixelType>(
+      numberOfObjects < static_cast<itk::SizeValueType>(backgroundValue) ? numberOfObjects : numberOfObjects + 1);
+    ++numberOfObjects;
+    std::queue<itk::SizeValueType> queue;
+    queue.push(pixel);
+    visited[pixel] = true;
+    while (!queue.empty())
+    {
+      const IndexType index = image->ComputeIndex(static_cast<itk::OffsetValueType>(queue.front()));
+      labels[queue.front()] = label;
+      queue.pop();
+      for (unsigned int n = 0; n < 27; ++n)
+      {
+        IndexType    neighbor = index;
+        unsigned int distance = 0;
+        for (unsigned int d = 0, remainder = n; d < 3; ++d, remainder /= 3)
+        {
+          neighbor[d] += static_cast<itk::IndexValueType>(remainder % 3) - 1;
+          distance += (remainder % 3 != 1);
+        }
+        if (distance == 0 || (!fullyConnected && distance > 1) || !region.IsInside(neighbor))
+        {
+          continue;
+        }
+        const auto neighborPixel = static_cast<itk::SizeValueType>(image->ComputeOffset(neighbor));
+        if (!visited[neighborPixel] && image->GetBufferPointer()[neighborPixel] != 0)
+        {
+          visited[neighborPixel] = true;
+          queue.push(neighborPixel);
+        }
+      }
+    }
+  }
+  return labels;
+}
 } // namespace
 
 
@@ -82,3 +141,43 @@ TEST(ConnectedComponentImageFilter, Checkerboard3D)
   ++it;
   EXPECT_TRUE(it.IsAtEnd());
 }
+
+TEST(ConnectedComponentImageFilter, LabelsDoNotDependOnNumberOfWorkUnits)
+{
+  // Enough lines to merge the labels of many runs in several blocks
+  using ImageType = itk::Image<unsigned char, 3>;
+  using LabelImageType = itk::Image<unsigned int, 3>;
+  const auto image = ImageType::CreateInitialized(itk::MakeSize(24u, 700u, 20u));
+
+  std::mt19937                       generator(7);
+  std::uniform_int_distribution<int> distribution(0, 99);
+  for (unsigned char * pixel = image->GetBufferPointer(); pixel != image->GetBufferPointer() + 24 * 700 * 20; ++pixel)
+  {
+    *pixel = (distribution(generator) < 40) ? 1 : 0;
+  }
+
+  for (const bool fullyConnected : { false, true })
+  {
+    for (const LabelImageType::PixelType backgroundValue : { 0u, 5u })
+    {
+      itk::SizeValueType expectedObjectCount = 0;
+      const auto         expected =
+        FloodFillComponents<ImageType, LabelImageType>(image, fullyConnected, backgroundValue, expectedObjectCount);
+      for (const itk::ThreadIdType numberOfWorkUnits : { 1u, 3u, 16u })
+      {
+        auto connected = itk::ConnectedComponentImageFilter<ImageType, LabelImageType>::New();
+        connected->SetInput(image);
+        connected->SetFullyConnected(fullyConnected);
+        connected->SetBackgroundValue(backgroundValue);
+        connected->SetNumberOfWorkUnits(numberOfWorkUnits);
+        connected->Update();
+
+        const LabelImageType::PixelType * const labels = connected->GetOutput()->GetBufferPointer();
+        EXPECT_TRUE(std::equal(expected.cbegin(), expected.cend(), labels))
+          << "FullyConnected: " << fullyConnected << ", BackgroundValue: " << backgroundValue
+          << ", NumberOfWorkUnits: " << numberOfWorkUnits;
+        EXPECT_EQ(expectedObjectCount, connected->GetObjectCount());
+      }
+    }
+  }
+}
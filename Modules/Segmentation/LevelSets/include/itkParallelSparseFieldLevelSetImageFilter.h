@@ -500,10 +500,18 @@ protected:
   void
   ThreadedInitializeData(ThreadIdType ThreadId, const ThreadRegionType & ThreadRegion);
 
+  /** Choose the dimension along which the slabs of the threads are created,
+   *  from the active layer: the dimension whose planes hold the active pixels
+   *  in the most evenly divisible way. A thin front is then split across its
+   *  extent rather than across its thickness, which would leave most threads
+   *  with empty slabs. Between equally good dimensions, the greatest numbered
+   *  one is kept. */
+  void
+  ChooseSplitAxis();
+
   /** This performs the initial load distribution among the threads.  Every
    *  thread gets a slab of the data to work on. The slabs created along a specific
-   *  dimension.  Load balancing is performed along the greatest numbered dimension
-   *  (i.e. the 3rd dimension in the 3D case and the 2nd dimension in the 2D case).
+   *  dimension, chosen by ChooseSplitAxis().
    *  During the initializing of the sparse field layer an histogram is computed
    *  that stores the number of nodes in the active set for each index along the
    *  chosen dimension.  This histogram is used to divide the work "equally" among
@@ -680,7 +688,10 @@ protected:
    *  the small gain obtained by load balancing (if any) does not warrant the overhead for
    *  calling this method.
    *  How often this is done is controlled by a parameter LOAD_BALANCE_ITERATION_FREQUENCY
-   *  which is defined in the IterateThreaderCallback() function.
+   *  which is defined in the Iterate() function. It is also done as soon as the
+   *  active layer of a thread is half again as large as the average, at most every
+   *  MIN_LOAD_BALANCE_ITERATION_INTERVAL iterations, since the other threads then
+   *  wait for it a third of every iteration.
    *  A parameter that defines a degree of unbalancedness of the load among threads is
    *  MAX_PIXEL_DIFFERENCE_PERCENT which is defined in CheckLoadBalance(). */
   virtual void
@@ -28,6 +28,7 @@
 #include "itkMath.h"
 #include "itkPlatformMultiThreader.h"
 #include "itkPrintHelper.h"
+#include <algorithm>
 
 #include <atomic> // std::atomic_ref (C++20); defines __cpp_lib_atomic_ref when available
 #if !defined(__cpp_lib_atomic_ref) && defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
@@ -297,6 +298,8 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Initialize()
   m_NumOfWorkUnits = std::min(this->GetNumberOfWorkUnits(), this->GetMultiThreader()->GetMaximumNumberOfThreads());
   this->SetNumberOfWorkUnits(m_NumOfWorkUnits);
 
+  this->ChooseSplitAxis();
+
   // Cumulative frequency of number of pixels in each Z plane for the entire 3D
   // volume
   m_ZCumulativeFrequency = new int[m_ZSize];
@@ -656,6 +659,62 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::InitializeBac
   m_ShiftedImage = nullptr;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ChooseSplitAxis()
+{
+  const typename OutputImageType::RegionType reqRegion = m_OutputImage->GetRequestedRegion();
+
+  // Histograms of the active layer along every dimension
+  std::vector<std::vector<int>> histograms(ImageDimension);
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    histograms[d].resize(reqRegion.GetSize(d), 0);
+  }
+  SizeValueType numberOfActivePixels = 0;
+  for (auto it = m_Layers[0]->Begin(); it != m_Layers[0]->End(); ++it)
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      ++histograms[d][it->m_Index[d] - reqRegion.GetIndex(d)];
+    }
+    ++numberOfActivePixels;
+  }
+
+  // The slabs are made of whole planes, so the busiest thread has at least
+  // the active pixels of the fullest plane, and at least its share of all of
+  // them. The histograms along the split axis are indexed from 0, as the
+  // index of the requested region.
+  const SizeValueType share = (numberOfActivePixels + m_NumOfWorkUnits - 1) / m_NumOfWorkUnits;
+  unsigned int        splitAxis = m_SplitAxis;
+  SizeValueType       lowestLoad = NumericTraits<SizeValueType>::max();
+  for (unsigned int d = ImageDimension; d-- > 0;)
+  {
+    if (reqRegion.GetIndex(d) != 0)
+    {
+      continue;
+    }
+    const auto fullestPlane = static_cast<SizeValueType>(*std::max_element(histograms[d].begin(), histograms[d].end()));
+    const SizeValueType load = std::max(share, fullestPlane);
+    if (load < lowestLoad)
+    {
+      lowestLoad = load;
+      splitAxis = d;
+    }
+  }
+
+  if (splitAxis == m_SplitAxis)
+  {
+    return;
+  }
+
+  m_SplitAxis = splitAxis;
+  m_ZSize = reqRegion.GetSize(m_SplitAxis);
+  delete[] m_GlobalZHistogram;
+  m_GlobalZHistogram = new int[m_ZSize];
+  std::copy(histograms[m_SplitAxis].begin(), histograms[m_SplitAxis].end(), m_GlobalZHistogram);
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ComputeInitialThreadBoundaries()
@@ -1039,8 +1098,12 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Iterate()
   const typename TOutputImage::RegionType reqRegion = m_OutputImage->GetRequestedRegion();
 
   // Controls how often we check for balance of the load among the threads and
-  // perform load balancing (if needed) by redistributing the load.
+  // perform load balancing (if needed) by redistributing the load. The check
+  // is done earlier when a thread has half again as many active pixels as the
+  // average, but not more often than every MIN_LOAD_BALANCE_ITERATION_INTERVAL
+  // iterations, in case the planes are too coarse to balance the load.
   constexpr unsigned int LOAD_BALANCE_ITERATION_FREQUENCY{ 30 };
+  constexpr unsigned int MIN_LOAD_BALANCE_ITERATION_INTERVAL{ 5 };
 
   if (!this->m_IsInitialized)
   {
@@ -1083,6 +1146,7 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Iterate()
 
 
   unsigned int iter = this->GetElapsedIterations();
+  unsigned int lastLoadBalanceIteration = iter;
   while (!(this->Halt()))
   {
     mt->ParallelizeArray(
@@ -1175,8 +1239,23 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Iterate()
       nullptr);
 
 
-    if (this->GetElapsedIterations() % LOAD_BALANCE_ITERATION_FREQUENCY == 0)
+    bool loadIsUnbalanced = false;
+    if (this->GetElapsedIterations() - lastLoadBalanceIteration >= MIN_LOAD_BALANCE_ITERATION_INTERVAL)
+    {
+      SizeValueType total = 0;
+      SizeValueType max = 0;
+      for (unsigned int i = 0; i < this->m_NumOfWorkUnits; ++i)
+      {
+        const SizeValueType count = this->m_Data[i].m_Layers[0]->Size();
+        total += count;
+        max = std::max(max, count);
+      }
+      loadIsUnbalanced = 2 * max * this->m_NumOfWorkUnits > 3 * total;
+    }
+
+    if (this->GetElapsedIterations() % LOAD_BALANCE_ITERATION_FREQUENCY == 0 || loadIsUnbalanced)
     {
+      lastLoadBalanceIteration = this->GetElapsedIterations();
       this->CheckLoadBalance();
 
       if (this->m_BoundaryChanged)
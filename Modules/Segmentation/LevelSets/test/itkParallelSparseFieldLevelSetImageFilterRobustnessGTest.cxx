@@ -24,6 +24,7 @@
 #include "gtest/gtest.h"
 
 #include "itkCommand.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkLevelSetFunction.h"
 #include "itkParallelSparseFieldLevelSetImageFilter.h"
 
@@ -167,6 +168,12 @@ public:
   itkNewMacro(Self);
   itkSetMacro(Iterations, unsigned int);
 
+  unsigned int
+  GetSplitAxis() const
+  {
+    return this->m_SplitAxis;
+  }
+
   void
   SetDistanceTransform(itk::Image<float, 3> * im)
   {
@@ -380,3 +387,39 @@ TEST(ParallelSparseFieldLevelSetRobustness, ConcurrentMultiPipeline)
     }
   });
 }
+
+// Scenario 4: a thin front, flat across z, is split across its extent rather
+// than across its thickness, and evolves as with a single work unit.
+TEST(ParallelSparseFieldLevelSetRobustness, ThinFrontSplitAxis)
+{
+  using namespace PSFLSIFR;
+  const auto run = [](unsigned int workUnits, unsigned int & splitAxis) {
+    auto init = ImageType::New();
+    init->SetRegions(ImageType::RegionType(ImageType::SizeType{ DIM, DIM, DIM }));
+    init->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(init, init->GetRequestedRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(std::abs(static_cast<float>(it.GetIndex()[2]) - float{ DIM } / 2.0f) - 1.5f);
+    }
+    auto mf = MorphFilter::New();
+    mf->SetDistanceTransform(make_target_image());
+    mf->SetIterations(20);
+    mf->SetInput(init);
+    mf->GetMultiThreader()->SetMaximumNumberOfThreads(workUnits);
+    mf->SetNumberOfWorkUnits(workUnits);
+    mf->SetNumberOfLayers(3);
+    mf->SetIsoSurfaceValue(0.0);
+    mf->Update();
+    splitAxis = mf->GetSplitAxis();
+    ImageType::Pointer out = mf->GetOutput();
+    out->DisconnectPipeline();
+    return out;
+  };
+
+  unsigned int splitAxis = 0;
+  auto         reference = run(1, splitAxis);
+  EXPECT_EQ(splitAxis, 2u);
+  auto split = run(8, splitAxis);
+  EXPECT_NE(splitAxis, 2u);
+  EXPECT_NEAR(image_summary(split), image_summary(reference), 1e-3 * image_summary(reference));
+}
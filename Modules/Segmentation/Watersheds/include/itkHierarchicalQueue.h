@@ -0,0 +1,257 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHierarchicalQueue_h
+#define itkHierarchicalQueue_h
+
+#include "itkIntTypes.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class HierarchicalQueue
+ * \brief Hierarchical queue of the flooding algorithms, with a bucket per
+ * grey level.
+ *
+ * The elements are popped by increasing priority, and in the order they
+ * were pushed for equal priorities, like with a
+ * std::map<TPriority, std::queue<TElement>>, but without a tree lookup
+ * and a node allocation per element.
+ *
+ * The priorities are within the range given at construction, which is
+ * divided into at most MaximumNumberOfLevels levels, each of them being a
+ * bucket addressed directly by the priority. When each level holds a single
+ * priority, which is always the case for 8 and 16 bits integers, a level
+ * is a plain FIFO. Otherwise, as for floating point priorities, the
+ * priorities are quantized to find their level, and the elements of the
+ * level being popped are sorted by their exact priority.
+ *
+ * As in the flooding algorithms, once elements have been popped, an element
+ * pushed with a priority lower than the one of the last popped element is
+ * pushed at the priority of the last popped element: it is popped after the
+ * elements already queued at this priority. A NaN priority is handled as the
+ * minimum priority of the queue.
+ *
+ * \sa MorphologicalWatershedFromMarkersImageFilter
+ * \ingroup ITKWatersheds
+ */
+template <typename TPriority, typename TElement>
+class HierarchicalQueue
+{
+public:
+  using PriorityType = TPriority;
+  using ElementType = TElement;
+
+  /** Maximum number of levels of the queue. */
+  static constexpr SizeValueType MaximumNumberOfLevels = SizeValueType{ 1 } << 16;
+
+  /** Constructs an empty queue for the priorities between minimum and
+   * maximum. */
+  HierarchicalQueue(TPriority minimum, TPriority maximum)
+    : m_Minimum(minimum)
+  {
+    if constexpr (std::is_integral_v<TPriority>)
+    {
+      m_Exact = static_cast<double>(maximum) - static_cast<double>(minimum) < MaximumNumberOfLevels;
+    }
+    if (m_Exact)
+    {
+      m_Levels.resize(static_cast<SizeValueType>(maximum) - static_cast<SizeValueType>(minimum) + 1);
+    }
+    else
+    {
+      const double range = static_cast<double>(maximum) - static_cast<double>(minimum);
+      m_Scale = (range > 0.0) ? (MaximumNumberOfLevels - 1) / range : 0.0;
+      m_PendingLevels.resize(MaximumNumberOfLevels);
+    }
+  }
+
+  /** Whether each level holds a single priority. */
+  bool
+  IsExact() const
+  {
+    return m_Exact;
+  }
+
+  bool
+  IsEmpty() const
+  {
+    return m_Size == 0;
+  }
+
+  SizeValueType
+  GetSize() const
+  {
+    return m_Size;
+  }
+
+  /** Pushes an element, after the ones of the same priority. */
+  void
+  Push(TPriority priority, const TElement & element)
+  {
+    if constexpr (std::is_floating_point_v<TPriority>)
+    {
+      if (std::isnan(priority))
+      {
+        priority = m_Minimum;
+      }
+    }
+    if (m_Started && priority < m_LastPriority)
+    {
+      priority = m_LastPriority;
+    }
+    ++m_Size;
+    if (m_Exact)
+    {
+      m_Levels[static_cast<SizeValueType>(priority) - static_cast<SizeValueType>(m_Minimum)].Push(element);
+      return;
+    }
+    const SizeValueType level = this->GetQuantizedLevel(priority);
+    if (m_Started && level == m_CurrentLevel)
+    {
+      m_ActiveLevel[priority].Push(element);
+    }
+    else
+    {
+      m_PendingLevels[level].emplace_back(priority, element);
+    }
+  }
+
+  /** Removes the first element of the lowest priority, and returns its
+   * priority and the element. The queue must not be empty. */
+  std::pair<TPriority, TElement>
+  Pop()
+  {
+    m_Started = true;
+    --m_Size;
+    if (m_Exact)
+    {
+      while (m_CurrentLevel + 1 < m_Levels.size() && m_Levels[m_CurrentLevel].IsEmpty())
+      {
+        // Releases the memory of the levels which are done with.
+        m_Levels[m_CurrentLevel] = Level();
+        ++m_CurrentLevel;
+      }
+      m_LastPriority = static_cast<TPriority>(static_cast<SizeValueType>(m_Minimum) + m_CurrentLevel);
+      return { m_LastPriority, m_Levels[m_CurrentLevel].Pop() };
+    }
+
+    if (m_ActiveLevel.empty())
+    {
+      while (m_CurrentLevel + 1 < m_PendingLevels.size() && m_PendingLevels[m_CurrentLevel].empty())
+      {
+        ++m_CurrentLevel;
+      }
+      // Sorts the elements of the level by priority, keeping the order in
+      // which they were pushed for equal priorities.
+      for (const auto & [priority, element] : m_PendingLevels[m_CurrentLevel])
+      {
+        m_ActiveLevel[priority].Push(element);
+      }
+      std::vector<std::pair<TPriority, TElement>>().swap(m_PendingLevels[m_CurrentLevel]);
+    }
+    const auto front = m_ActiveLevel.begin();
+    m_LastPriority = front->first;
+    const TElement element = front->second.Pop();
+    if (front->second.IsEmpty())
+    {
+      m_ActiveLevel.erase(front);
+    }
+    return { m_LastPriority, element };
+  }
+
+private:
+  // A FIFO of elements, stored in a vector whose popped front is removed
+  // once it is as large as the rest of the queue.
+  class Level
+  {
+  public:
+    bool
+    IsEmpty() const
+    {
+      return m_Front == m_Elements.size();
+    }
+
+    void
+    Push(const TElement & element)
+    {
+      m_Elements.push_back(element);
+    }
+
+    TElement
+    Pop()
+    {
+      const TElement element = m_Elements[m_Front++];
+      if (m_Front == m_Elements.size())
+      {
+        m_Elements.clear();
+        m_Front = 0;
+      }
+      else if (m_Front >= 4096 && 2 * m_Front >= m_Elements.size())
+      {
+        m_Elements.erase(m_Elements.begin(), m_Elements.begin() + m_Front);
+        m_Front = 0;
+      }
+      return element;
+    }
+
+  private:
+    std::vector<TElement> m_Elements{};
+    size_t                m_Front{ 0 };
+  };
+
+  SizeValueType
+  GetQuantizedLevel(TPriority priority) const
+  {
+    const double level = (static_cast<double>(priority) - static_cast<double>(m_Minimum)) * m_Scale;
+    if (!(level > 0.0))
+    {
+      return 0;
+    }
+    // Also maps infinity to the last level
+    if (level >= static_cast<double>(MaximumNumberOfLevels - 1))
+    {
+      return MaximumNumberOfLevels - 1;
+    }
+    return static_cast<SizeValueType>(level);
+  }
+
+  TPriority     m_Minimum;
+  double        m_Scale{ 0.0 };
+  bool          m_Exact{ false };
+  bool          m_Started{ false };
+  TPriority     m_LastPriority{};
+  SizeValueType m_CurrentLevel{ 0 };
+  SizeValueType m_Size{ 0 };
+
+  // The levels, when each of them holds a single priority
+  std::vector<Level> m_Levels{};
+
+  // The elements of the quantized levels which are not popped yet, and the
+  // elements of the current quantized level, by priority.
+  std::vector<std::vector<std::pair<TPriority, TElement>>> m_PendingLevels{};
+  std::map<TPriority, Level>                               m_ActiveLevel{};
+};
+} // end namespace itk
+
+#endif
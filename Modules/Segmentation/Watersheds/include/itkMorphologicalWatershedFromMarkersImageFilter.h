@@ -64,6 +64,9 @@ namespace itk
  * The morphological watershed transform algorithm is described in
  * \cite soille2004c.
  *
+ * The flooding order is kept in a HierarchicalQueue of the pixel offsets,
+ * with a bucket per grey level for 8 and 16 bits images.
+ *
  * This code was contributed in the Insight Journal paper:
  * "The watershed transform in ITK - discussion and new developments"
  * by Beare R., Lehmann G.
@@ -72,7 +75,7 @@ namespace itk
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  * \author Richard Beare. Department of Medicine, Monash University, Melbourne, Australia.
  *
- * \sa WatershedImageFilter, MorphologicalWatershedImageFilter
+ * \sa WatershedImageFilter, MorphologicalWatershedImageFilter, HierarchicalQueue
  * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
  * \ingroup ITKWatersheds
  */
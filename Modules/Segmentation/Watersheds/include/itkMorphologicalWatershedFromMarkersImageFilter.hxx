@@ -19,14 +19,10 @@
 #define itkMorphologicalWatershedFromMarkersImageFilter_hxx
 
 #include <algorithm>
-#include <queue>
-#include <list>
+#include <vector>
 #include "itkProgressReporter.h"
-#include "itkImageRegionIterator.h"
-#include "itkConstShapedNeighborhoodIterator.h"
-#include "itkConstantBoundaryCondition.h"
-#include "itkSize.h"
-#include "itkConnectedComponentAlgorithm.h"
+#include "itkHierarchicalQueue.h"
+#include "itkMath.h"
 
 namespace itk
 {
@@ -82,7 +78,7 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
   // The 2 algorithms are very similar and so are integrated in the same filter.
 
   //---------------------------------------------------------------------------
-  // declare the vars common to the 2 algorithms: constants, iterators,
+  // declare the vars common to the 2 algorithms: constants, neighbors,
   // hierarchical queue, progress reporter, and status image
   // also allocate output images and verify preconditions
   //---------------------------------------------------------------------------
@@ -109,36 +105,98 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     itkExceptionStringMacro("Marker and input must have the same size.");
   }
 
+  // The whole images are buffered, so a pixel is identified by its offset in
+  // the buffers, which is the same in the three images.
+  using OffsetType = typename LabelImageType::OffsetType;
+  const typename LabelImageType::SizeType size = outputImage->GetBufferedRegion().GetSize();
+  const OffsetValueType *                 offsetTable = outputImage->GetOffsetTable();
+  const SizeValueType                     numberOfPixels = outputImage->GetBufferedRegion().GetNumberOfPixels();
+  const InputImagePixelType * const       input = inputImage->GetBufferPointer();
+  const LabelImagePixelType * const       marker = markerImage->GetBufferPointer();
+  LabelImagePixelType * const             output = outputImage->GetBufferPointer();
+
+  // The neighbors, in the order of the neighborhood
+  std::vector<OffsetType>      neighborOffsets;
+  std::vector<OffsetValueType> neighborBufferOffsets;
+  for (unsigned int n = 0; n < Math::UnsignedPower(3, ImageDimension); ++n)
+  {
+    OffsetType      offset;
+    OffsetValueType bufferOffset = 0;
+    unsigned int    numberOfNonZeroComponents = 0;
+    for (unsigned int d = 0, remainder = n; d < ImageDimension; ++d, remainder /= 3)
+    {
+      offset[d] = static_cast<OffsetValueType>(remainder % 3) - 1;
+      bufferOffset += offset[d] * offsetTable[d];
+      numberOfNonZeroComponents += (offset[d] != 0);
+    }
+    if (numberOfNonZeroComponents == 1 || (m_FullyConnected && numberOfNonZeroComponents > 1))
+    {
+      neighborOffsets.push_back(offset);
+      neighborBufferOffsets.push_back(bufferOffset);
+    }
+  }
+  const size_t numberOfNeighbors = neighborOffsets.size();
+
+  // The neighbors outside of the image are ignored. The neighbors of the
+  // pixels which are not on the border of the image are all inside.
+  IndexType  index{};
+  bool       onBorder = false;
+  const auto isNeighborInside = [&](size_t n) {
+    if (!onBorder)
+    {
+      return true;
+    }
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const IndexValueType neighborIndex = index[d] + neighborOffsets[n][d];
+      if (neighborIndex < 0 || neighborIndex >= static_cast<IndexValueType>(size[d]))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  const auto updateOnBorder = [&]() {
+    onBorder = false;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      onBorder = onBorder || index[d] == 0 || index[d] + 1 >= static_cast<IndexValueType>(size[d]);
+    }
+  };
+  // Moves to the pixel of the given offset
+  const auto setPixel = [&](OffsetValueType pixel) {
+    for (unsigned int d = ImageDimension - 1; d > 0; --d)
+    {
+      index[d] = pixel / offsetTable[d];
+      pixel -= index[d] * offsetTable[d];
+    }
+    index[0] = pixel;
+    updateOnBorder();
+  };
+  // Moves to the next pixel, in the order of the buffer
+  const auto nextPixel = [&]() {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if (++index[d] < static_cast<IndexValueType>(size[d]))
+      {
+        break;
+      }
+      index[d] = 0;
+    }
+    updateOnBorder();
+  };
+
+  if (numberOfPixels == 0)
+  {
+    return;
+  }
+
   // FAH (in french: File d'Attente Hierarchique)
-  using QueueType = std::queue<IndexType>;
-  using MapType = std::map<InputImagePixelType, QueueType>;
-  MapType fah;
-
-  // the radius which will be used for all the shaped iterators
-  constexpr auto radius = Size<ImageDimension>::Filled(1);
-
-  // iterator for the marker image
-  using MarkerIteratorType = ConstShapedNeighborhoodIterator<LabelImageType>;
-  typename MarkerIteratorType::ConstIterator nmIt;
-  MarkerIteratorType                         markerIt(radius, markerImage, markerImage->GetRequestedRegion());
-  // add a boundary constant to avoid adding pixels on the border in the fah
-  ConstantBoundaryCondition<LabelImageType> lcbc;
-  lcbc.SetConstant(NumericTraits<LabelImagePixelType>::max());
-  markerIt.OverrideBoundaryCondition(&lcbc);
-  setConnectivity(&markerIt, m_FullyConnected);
-
-  // iterator for the input image
-  using InputIteratorType = ConstShapedNeighborhoodIterator<InputImageType>;
-  InputIteratorType                         inputIt(radius, inputImage, inputImage->GetRequestedRegion());
-  typename InputIteratorType::ConstIterator niIt;
-  setConnectivity(&inputIt, m_FullyConnected);
-
-  // iterator for the output image
-  using OutputIteratorType = ShapedNeighborhoodIterator<LabelImageType>;
-  using OffsetType = typename OutputIteratorType::OffsetType;
-  typename OutputIteratorType::Iterator noIt;
-  OutputIteratorType                    outputIt(radius, outputImage, outputImage->GetRequestedRegion());
-  setConnectivity(&outputIt, m_FullyConnected);
+  // The pixels pushed with a value lower than the value of the last popped
+  // pixel are processed at the current level, after the pixels already
+  // queued at this level.
+  const auto [minimum, maximum] = std::minmax_element(input, input + numberOfPixels);
+  HierarchicalQueue<InputImagePixelType, OffsetValueType> fah(*minimum, *maximum);
 
   //---------------------------------------------------------------------------
   // Meyer's algorithm
@@ -151,68 +209,35 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     //  - init FAH with indexes of background pixels with marker pixel(s) in
     //    their neighborhood
 
-    ConstantBoundaryCondition<LabelImageType> lcbc2;
-    // outside pixel are watershed so they won't be use to find real watershed
-    // pixels
-    lcbc2.SetConstant(wsLabel);
-    outputIt.OverrideBoundaryCondition(&lcbc2);
-
-    // create a temporary image to store the state of each pixel (processed or
-    // not)
-    using StatusImageType = Image<bool, ImageDimension>;
-    auto statusImage = StatusImageType::New();
-    statusImage->SetRegions(markerImage->GetLargestPossibleRegion());
-    statusImage->Allocate();
-
-    // iterator for the status image
-    using StatusIteratorType = ShapedNeighborhoodIterator<StatusImageType>;
-    typename StatusIteratorType::Iterator      nsIt;
-    StatusIteratorType                         statusIt(radius, statusImage, outputImage->GetRequestedRegion());
-    ConstantBoundaryCondition<StatusImageType> bcbc;
-    bcbc.SetConstant(true); // outside pixel are already processed
-    statusIt.OverrideBoundaryCondition(&bcbc);
-    setConnectivity(&statusIt, m_FullyConnected);
-
-    // the status image must be initialized before the first stage. In the
-    // first stage, the set to true are the neighbors of the marker (and the
-    // marker) so it's difficult (impossible ?) to init the status image at
-    // the same time
-    // the overhead should be small
-    statusImage->FillBuffer(false);
-
-    for (markerIt.GoToBegin(), statusIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin(); !markerIt.IsAtEnd();
-         ++markerIt, ++outputIt)
+    // the state of each pixel: processed, or already in the fah
+    std::vector<bool> status(numberOfPixels, false);
+
+    updateOnBorder();
+    for (OffsetValueType pixel = 0; pixel < static_cast<OffsetValueType>(numberOfPixels); ++pixel, nextPixel())
     {
-      const LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+      const LabelImagePixelType markerPixel = marker[pixel];
       if (markerPixel != bgLabel)
       {
-        const IndexType idx = markerIt.GetIndex();
-
-        // move the iterators to the right place
-        const OffsetType shift = idx - statusIt.GetIndex();
-        statusIt += shift;
-        inputIt += shift;
-
         // this pixel belongs to a marker
         // mark it as already processed
-        statusIt.SetCenterPixel(true);
+        status[pixel] = true;
         // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
+        output[pixel] = markerPixel;
         // and increase progress because this pixel will not be used in the
         // flooding stage.
         progress.CompletedPixel();
 
         // search the background pixels in the neighborhood
-        for (nmIt = markerIt.Begin(), nsIt = statusIt.Begin(), niIt = inputIt.Begin(); nmIt != markerIt.End();
-             ++nmIt, ++nsIt, ++niIt)
+        for (size_t n = 0; n < numberOfNeighbors; ++n)
         {
-          if (!nsIt.Get() && nmIt.Get() == bgLabel)
+          const OffsetValueType neighbor = pixel + neighborBufferOffsets[n];
+          if (isNeighborInside(n) && !status[neighbor] && marker[neighbor] == bgLabel)
           {
             // this neighbor is a background pixel and is not already
-            // processed; add its index to fah
-            fah[niIt.Get()].push(markerIt.GetIndex() + nmIt.GetNeighborhoodOffset());
+            // processed; add its offset to fah
+            fah.Push(input[neighbor], neighbor);
             // mark it as already in the fah to avoid adding it several times
-            nsIt.Set(true);
+            status[neighbor] = true;
           }
         }
       }
@@ -220,90 +245,60 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
       {
         // Some pixels may be never processed so, by default, non marked pixels
         // must be marked as watershed
-        outputIt.SetCenterPixel(wsLabel);
+        output[pixel] = wsLabel;
       }
       // one more pixel done in the init stage
       progress.CompletedPixel();
     }
-    // fill the borders of the status image with "true"
-    // FillSides<StatusImageType>(statusImage, true);
-    // Now disable the boundary checks
-    // outputIt.NeedToUseBoundaryConditionOff();
-    // statusIt.NeedToUseBoundaryConditionOff();
-    // inputIt.NeedToUseBoundaryConditionOff();
     // end of init stage
 
     // flooding
-    // init all the iterators
-    outputIt.GoToBegin();
-    statusIt.GoToBegin();
-    inputIt.GoToBegin();
-
-    // and start flooding
-    while (!fah.empty())
+    while (!fah.IsEmpty())
     {
-      // store the current vars
-      const InputImagePixelType currentValue = fah.begin()->first;
-      QueueType                 currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase(fah.begin());
-
-      while (!currentQueue.empty())
+      const OffsetValueType pixel = fah.Pop().second;
+      setPixel(pixel);
+
+      // iterate over the neighbors. If there is only one marker value, give
+      // that value to the pixel, else keep it as is (watershed line)
+      LabelImagePixelType markerValue = wsLabel;
+      bool                collision = false;
+      for (size_t n = 0; n < numberOfNeighbors; ++n)
       {
-        const IndexType idx = currentQueue.front();
-        currentQueue.pop();
-
-        // move the iterators to the right place
-        const OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        statusIt += shift;
-        inputIt += shift;
-
-        // iterate over the neighbors. If there is only one marker value, give
-        // that value to the pixel, else keep it as is (watershed line)
-        LabelImagePixelType marker = wsLabel;
-        bool                collision = false;
-        for (noIt = outputIt.Begin(); noIt != outputIt.End(); ++noIt)
+        if (!isNeighborInside(n))
+        {
+          continue;
+        }
+        const LabelImagePixelType o = output[pixel + neighborBufferOffsets[n]];
+        if (o != wsLabel)
         {
-          const LabelImagePixelType o = noIt.Get();
-          if (o != wsLabel)
+          if (markerValue != wsLabel && o != markerValue)
           {
-            if (marker != wsLabel && o != marker)
-            {
-              collision = true;
-              break;
-            }
-
-            marker = o;
+            collision = true;
+            break;
           }
+
+          markerValue = o;
         }
-        if (!collision)
+      }
+      if (!collision)
+      {
+        // set the marker value
+        output[pixel] = markerValue;
+        // and propagate to the neighbors
+        for (size_t n = 0; n < numberOfNeighbors; ++n)
         {
-          // set the marker value
-          outputIt.SetCenterPixel(marker);
-          // and propagate to the neighbors
-          for (niIt = inputIt.Begin(), nsIt = statusIt.Begin(); niIt != inputIt.End(); ++niIt, ++nsIt)
+          const OffsetValueType neighbor = pixel + neighborBufferOffsets[n];
+          if (isNeighborInside(n) && !status[neighbor])
           {
-            if (!nsIt.Get())
-            {
-              // the pixel is not yet processed. add it to the fah
-              const InputImagePixelType GrayVal = niIt.Get();
-              if (GrayVal <= currentValue)
-              {
-                currentQueue.push(inputIt.GetIndex() + niIt.GetNeighborhoodOffset());
-              }
-              else
-              {
-                fah[GrayVal].push(inputIt.GetIndex() + niIt.GetNeighborhoodOffset());
-              }
-              // mark it as already in the fah
-              nsIt.Set(true);
-            }
+            // the pixel is not yet processed. add it to the fah
+            fah.Push(input[neighbor], neighbor);
+            // mark it as already in the fah
+            status[neighbor] = true;
           }
         }
-        // one more pixel in the flooding stage
-        progress.CompletedPixel();
       }
+      // one more pixel in the flooding stage
+      progress.CompletedPixel();
     }
   }
 
@@ -317,29 +312,20 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     //  - init FAH with indexes of pixels with background pixel in their
     //    neighborhood
 
-    ConstantBoundaryCondition<LabelImageType> lcbc2;
-    // outside pixel are watershed so they won't be use to find real watershed
-    // pixels
-    lcbc2.SetConstant(NumericTraits<LabelImagePixelType>::max());
-    outputIt.OverrideBoundaryCondition(&lcbc2);
-
-    for (markerIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin(); !markerIt.IsAtEnd(); ++markerIt, ++outputIt)
+    updateOnBorder();
+    for (OffsetValueType pixel = 0; pixel < static_cast<OffsetValueType>(numberOfPixels); ++pixel, nextPixel())
     {
-      const LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+      const LabelImagePixelType markerPixel = marker[pixel];
       if (markerPixel != bgLabel)
       {
-        const IndexType  idx = markerIt.GetIndex();
-        const OffsetType shift = idx - inputIt.GetIndex();
-        inputIt += shift;
-
         // this pixels belongs to a marker
         // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
+        output[pixel] = markerPixel;
         // search if it has background pixel in its neighborhood
         bool haveBgNeighbor = false;
-        for (nmIt = markerIt.Begin(); nmIt != markerIt.End(); ++nmIt)
+        for (size_t n = 0; n < numberOfNeighbors; ++n)
         {
-          if (nmIt.Get() == bgLabel)
+          if (isNeighborInside(n) && marker[pixel + neighborBufferOffsets[n]] == bgLabel)
           {
             haveBgNeighbor = true;
             break;
@@ -348,7 +334,7 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
         if (haveBgNeighbor)
         {
           // there is a background pixel in the neighborhood; add to fah
-          fah[inputIt.GetCenterPixel()].push(markerIt.GetIndex());
+          fah.Push(input[pixel], pixel);
         }
         else
         {
@@ -359,57 +345,30 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
       }
       else
       {
-        outputIt.SetCenterPixel(wsLabel);
+        output[pixel] = wsLabel;
       }
       progress.CompletedPixel();
     }
     // end of init stage
 
     // flooding
-    // init all the iterators
-    outputIt.GoToBegin();
-    inputIt.GoToBegin();
-
-    // and start flooding
-    while (!fah.empty())
+    while (!fah.IsEmpty())
     {
-      // store the current vars
-      const InputImagePixelType currentValue = fah.begin()->first;
-      QueueType                 currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase(fah.begin());
+      const OffsetValueType pixel = fah.Pop().second;
+      setPixel(pixel);
 
-      while (!currentQueue.empty())
+      const LabelImagePixelType currentMarker = output[pixel];
+      // iterate over neighbors to propagate the marker
+      for (size_t n = 0; n < numberOfNeighbors; ++n)
       {
-        const IndexType idx = currentQueue.front();
-        currentQueue.pop();
-
-        // move the iterators to the right place
-        const OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        inputIt += shift;
-
-        const LabelImagePixelType currentMarker = outputIt.GetCenterPixel();
-        // get the current value of the pixel
-        // iterate over neighbors to propagate the marker
-        for (noIt = outputIt.Begin(), niIt = inputIt.Begin(); noIt != outputIt.End(); ++noIt, ++niIt)
+        const OffsetValueType neighbor = pixel + neighborBufferOffsets[n];
+        if (isNeighborInside(n) && output[neighbor] == wsLabel)
         {
-          if (noIt.Get() == wsLabel)
-          {
-            // the pixel is not yet processed. It can be labeled with the
-            // current label
-            noIt.Set(currentMarker);
-            const InputImagePixelType GrayVal = niIt.Get();
-            if (GrayVal <= currentValue)
-            {
-              currentQueue.push(inputIt.GetIndex() + noIt.GetNeighborhoodOffset());
-            }
-            else
-            {
-              fah[GrayVal].push(inputIt.GetIndex() + noIt.GetNeighborhoodOffset());
-            }
-            progress.CompletedPixel();
-          }
+          // the pixel is not yet processed. It can be labeled with the
+          // current label
+          output[neighbor] = currentMarker;
+          fah.Push(input[neighbor], neighbor);
+          progress.CompletedPixel();
         }
       }
     }
@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHierarchicalQueue.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <queue>
+#include <random>
+
+namespace
+{
+// Floods with the hierarchical queue and with the map of queues it replaces
+// in the flooding algorithms, and checks that the elements are popped in the
+// same order.
+template <typename TPriority>
+bool
+FloodLikeMapOfQueues(TPriority minimum, TPriority maximum, bool expectedExact)
+{
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  const auto                             randomPriority = [&]() {
+    // Few distinct values, to have equal priorities
+    const double value = std::floor(uniform(generator) * 50.0) / 50.0;
+    return static_cast<TPriority>(static_cast<double>(minimum) +
+                                  value * (static_cast<double>(maximum) - static_cast<double>(minimum)));
+  };
+  itk::HierarchicalQueue<TPriority, int> queue(minimum, maximum);
+  std::map<TPriority, std::queue<int>>   reference;
+
+  if (queue.IsExact() != expectedExact)
+  {
+    std::cerr << "IsExact() is " << queue.IsExact() << " for [" << +minimum << ", " << +maximum << ']' << std::endl;
+    return false;
+  }
+
+  int element = 0;
+  for (; element < 1000; ++element)
+  {
+    const TPriority priority = randomPriority();
+    queue.Push(priority, element);
+    reference[priority].push(element);
+  }
+
+  while (!reference.empty())
+  {
+    const TPriority currentPriority = reference.begin()->first;
+    std::queue<int> currentQueue = reference.begin()->second;
+    reference.erase(reference.begin());
+    while (!currentQueue.empty())
+    {
+      if (queue.IsEmpty())
+      {
+        std::cerr << "The queue is empty before " << currentQueue.front() << std::endl;
+        return false;
+      }
+      const auto [priority, popped] = queue.Pop();
+      if (priority != currentPriority || popped != currentQueue.front())
+      {
+        std::cerr << "Popped " << popped << " at " << +priority << " instead of " << currentQueue.front() << " at "
+                  << +currentPriority << std::endl;
+        return false;
+      }
+      currentQueue.pop();
+
+      // Pushes neighbors, some of them lower than the current priority
+      for (unsigned int n = 0; n < 2 && element < 20000; ++n, ++element)
+      {
+        const TPriority neighborPriority = randomPriority();
+        queue.Push(neighborPriority, element);
+        if (neighborPriority <= currentPriority)
+        {
+          currentQueue.push(element);
+        }
+        else
+        {
+          reference[neighborPriority].push(element);
+        }
+      }
+    }
+  }
+  if (!queue.IsEmpty())
+  {
+    std::cerr << queue.GetSize() << " elements are left in the queue" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Checks that a NaN priority is popped as the minimum priority before popping, and as the priority of the last
+// popped element after, as the priorities lower than this one.
+template <typename TPriority>
+bool
+PopsNaNAsLowestPriority()
+{
+  const TPriority                        nan = std::numeric_limits<TPriority>::quiet_NaN();
+  itk::HierarchicalQueue<TPriority, int> queue(-1, 1);
+  queue.Push(0.5, 1);
+  queue.Push(nan, 2);
+  queue.Push(std::numeric_limits<TPriority>::infinity(), 3);
+  bool success = queue.Pop() == std::make_pair(TPriority{ -1 }, 2);
+  success = queue.Pop() == std::make_pair(TPriority{ 0.5 }, 1) && success;
+  queue.Push(nan, 4);
+  queue.Push(-0.5, 5);
+  success = queue.Pop() == std::make_pair(TPriority{ 0.5 }, 4) && success;
+  success = queue.Pop() == std::make_pair(TPriority{ 0.5 }, 5) && success;
+  success = queue.Pop() == std::make_pair(std::numeric_limits<TPriority>::infinity(), 3) && success;
+  success = queue.IsEmpty() && success;
+  if (!success)
+  {
+    std::cerr << "NaN priorities are not popped as the lowest ones" << std::endl;
+  }
+  return success;
+}
+} // namespace
+
+int
+itkHierarchicalQueueTest(int, char *[])
+{
+  bool success = true;
+  success = FloodLikeMapOfQueues<unsigned char>(0, 255, true) && success;
+  success = FloodLikeMapOfQueues<short>(-1000, 30000, true) && success;
+  success = FloodLikeMapOfQueues<int>(-100000, 100000, false) && success;
+  success = FloodLikeMapOfQueues<float>(-1.5f, 2.5f, false) && success;
+  success = FloodLikeMapOfQueues<double>(3.0, 3.0, false) && success;
+  success = PopsNaNAsLowestPriority<float>() && success;
+  success = PopsNaNAsLowestPriority<double>() && success;
+
+  if (!success)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}